@@ -930,11 +930,8 @@ uint32_t BitstreamExtractorApp::decode()
         ch = 1;
         bitstreamFileOut.write( &ch, 1 );
 
-        // create output NAL unit
-        OutputNALUnit out (nalu.m_nalUnitType, nalu.m_nuhLayerId, nalu.m_temporalId);
-        out.m_Bitstream.getFIFO() = nalu.getBitstream().getFifo();
-        // write with start code emulation prevention
-        writeNaluContent (bitstreamFileOut, out);
+        // write the input NAL unit unchanged, with its emulation prevention bytes
+        writeNalUnitEBSP(bitstreamFileOut, nalu);
       }
 
       // update status of previous slice
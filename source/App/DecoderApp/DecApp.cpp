@@ -396,6 +396,7 @@ uint32_t DecApp::decode()
         if( ( m_cDecLib.getVPS() != nullptr && ( m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet( &nalu ) ) ) || m_cDecLib.getVPS() == nullptr )
         {
           m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].open( reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
+          m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setQueueDepth( m_ioQueueDepth );
         }
       }
       // update file bitdepth shift if recon bitdepth changed between sequences
@@ -443,6 +444,7 @@ uint32_t DecApp::decode()
         if ((m_cDecLib.getVPS() != nullptr && (m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))) || m_cDecLib.getVPS() == nullptr)
         {
           m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].open(SEIFGSFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon);   // write mode
+          m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].setQueueDepth(m_ioQueueDepth);
         }
       }
       // update file bitdepth shift if recon bitdepth changed between sequences
@@ -489,6 +491,7 @@ uint32_t DecApp::decode()
         if ((m_cDecLib.getVPS() != nullptr && (m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))) || m_cDecLib.getVPS() == nullptr)
         {
           m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].open(SEICTIFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon); // write mode
+          m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].setQueueDepth(m_ioQueueDepth);
         }
       }
       if (!m_annotatedRegionsSEIFileName.empty())
@@ -615,6 +618,7 @@ void DecApp::xCreateDecLib()
   initROM();
 
   // create decoder class
+  m_cDecLib.setNumThreads( m_numThreads );
   m_cDecLib.create();
 
   // initialize decoder class
@@ -121,6 +121,8 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
                                                                                    "\t3: enable bit and tool statistic\n")
 #endif
   ("MCTSCheck",                m_mctsCheck,                           false,       "If enabled, the decoder checks for violations of mc_exact_sample_value_match_flag in Temporal MCTS ")
+  ("NumThreads",               m_numThreads,                          1,           "Number of threads reconstructing the CTU rows of tiles in parallel to parsing (1: sequential decoding)")
+  ("IOQueueDepth",             m_ioQueueDepth,                        0,           "Number of decoded frames written behind to the output YUV files by separate I/O threads (0: synchronous file I/O)")
   ("targetSubPicIdx",          m_targetSubPicIdx,                     0,           "Specify which subpicture shall be written to output, using subpic index, 0: disabled, subpicIdx=m_targetSubPicIdx-1 \n" )
   ( "UpscaledOutput",          m_upscaledOutput,                          0,       "Upscaled output for RPR" )
 #if GDR_LEAK_TEST
@@ -163,6 +165,16 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 #endif
 
   g_mctsDecCheckEnabled = m_mctsCheck;
+  if( m_numThreads < 1 )
+  {
+    msg( ERROR, "NumThreads must be at least 1\n" );
+    return false;
+  }
+  if( m_ioQueueDepth < 0 )
+  {
+    msg( ERROR, "IOQueueDepth must not be negative\n" );
+    return false;
+  }
   // Chroma output bit-depth
   if( m_outputBitDepth[CHANNEL_TYPE_LUMA] != 0 && m_outputBitDepth[CHANNEL_TYPE_CHROMA] == 0 )
   {
@@ -272,6 +284,8 @@ DecAppCfg::DecAppCfg()
 , m_packedYUVMode(false)
 , m_statMode(0)
 , m_mctsCheck(false)
+, m_numThreads(1)
+, m_ioQueueDepth(0)
 {
   for (uint32_t channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
   {
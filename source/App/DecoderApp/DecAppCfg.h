@@ -87,6 +87,8 @@ protected:
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
   int           m_statMode;                           ///< Config statistic mode (0 - bit stat, 1 - tool stat, 3 - both)
   bool          m_mctsCheck;
+  int           m_numThreads;                         ///< number of threads reconstructing CTU rows in parallel to parsing
+  int           m_ioQueueDepth;                       ///< number of frames written behind by I/O threads (0: synchronous I/O)
 
   int          m_upscaledOutput;                     ////< Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
   int           m_targetSubPicIdx;                    ///< Specify which subpicture shall be write to output, using subpicture index
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <iomanip>
+#include <sstream>
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
@@ -55,9 +56,10 @@ using namespace std;
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
 
-EncApp::EncApp( fstream& bitStream, EncLibCommon* encLibCommon )
+EncApp::EncApp( fstream& bitStream, WriteBehindQueue* bitstreamQueue, EncLibCommon* encLibCommon )
   : m_cEncLib( encLibCommon )
   , m_bitstream( bitStream )
+  , m_bitstreamQueue( bitstreamQueue )
 {
   m_iFrameRcvd = 0;
   m_totalBytes = 0;
@@ -610,6 +612,8 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
   m_cEncLib.setMinSearchWindow                                   ( m_minSearchWindow );
   m_cEncLib.setRestrictMESampling                                ( m_bRestrictMESampling );
+  m_cEncLib.setUseHierarchicalME                                 ( m_hierarchicalME );
+  m_cEncLib.setUseMotionSearchCache                              ( m_motionSearchCache );
 
   //====== Quality control ========
   m_cEncLib.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
@@ -743,6 +747,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setUseCiip                                        ( m_ciip );
   m_cEncLib.setUseGeo                                            ( m_Geo );
   m_cEncLib.setUseHashME                                         ( m_HashME );
+  m_cEncLib.setUseHashMEIncremental                              ( m_HashMEIncremental );
 
   m_cEncLib.setAllowDisFracMMVD                                  ( m_allowDisFracMMVD );
   m_cEncLib.setUseAffineAmvr                                     ( m_AffineAmvr );
@@ -1109,6 +1114,10 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setDriSEINonlinearModel                              (m_driSEINonlinearModel);
   m_cEncLib.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
   m_cEncLib.setEntryPointPresentFlag                             ( m_entryPointPresentFlag );
+  m_cEncLib.setNumWppThreads                                     ( m_numWppThreads );
+  m_cEncLib.setEnsureWppBitEqual                                 ( m_ensureWppBitEqual );
+  m_cEncLib.setNumFrameThreads                                   ( m_numFrameThreads );
+  m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
   m_cEncLib.setTMVPModeId                                        ( m_TMVPModeId );
   m_cEncLib.setSliceLevelRpl                                     ( m_sliceLevelRpl  );
   m_cEncLib.setSliceLevelDblk                                    ( m_sliceLevelDblk );
@@ -1251,6 +1260,7 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
   const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
   m_cVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_sourceWidth - m_sourcePadding[0], sourceHeight - m_sourcePadding[1], m_InputChromaFormatIDC);
 #endif
+  m_cVideoIOYuvInputFile.setQueueDepth( m_ioQueueDepth );
   if (!m_reconFileName.empty())
   {
     if (m_packedYUVMode && ((m_outputBitDepth[CH_L] != 10 && m_outputBitDepth[CH_L] != 12)
@@ -1278,6 +1288,7 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
       }
     }
     m_cVideoIOYuvReconFile.open( reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth );  // write mode
+    m_cVideoIOYuvReconFile.setQueueDepth( m_ioQueueDepth );
   }
 
   // create the encoder
@@ -1356,7 +1367,7 @@ void EncApp::createLib( const int layerIdx )
                           sourceHeight, m_sourcePadding, m_bClipInputVideoToRec709Range, m_inputFileName,
                           m_chromaFormatIDC, m_inputColourSpaceConvert, m_iQP, m_gopBasedTemporalFilterStrengths,
                           m_gopBasedTemporalFilterPastRefs, m_gopBasedTemporalFilterFutureRefs, m_firstValidFrame,
-                          m_lastValidFrame);
+                          m_lastValidFrame, m_gopBasedTemporalFilterNumThreads);
   }
   if ( m_fgcSEIAnalysisEnabled )
   {
@@ -1373,7 +1384,7 @@ void EncApp::createLib( const int layerIdx )
                                sourceHeight, m_sourcePadding, m_bClipInputVideoToRec709Range, m_inputFileName,
                                m_chromaFormatIDC, m_inputColourSpaceConvert, m_iQP, filteredFramesAndStrengths,
                                m_gopBasedTemporalFilterPastRefs, m_gopBasedTemporalFilterFutureRefs, m_firstValidFrame,
-                               m_lastValidFrame);
+                               m_lastValidFrame, m_gopBasedTemporalFilterNumThreads);
   }
 }
 
@@ -1591,6 +1602,18 @@ void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList )
 
 void EncApp::outputAU( const AccessUnit& au )
 {
+  if( m_bitstreamQueue->isActive() )
+  {
+    // the access unit is serialized here, the file is written by the I/O thread
+    std::ostringstream auStream;
+    const vector<uint32_t>& stats = writeAnnexBAccessUnit( auStream, au );
+    rateStatsAccum( au, stats );
+    const std::string auData = auStream.str();
+    m_bitstreamQueue->write( reinterpret_cast<const uint8_t*>( auData.data() ), auData.size() );
+    m_bitstreamQueue->commit();
+    return;
+  }
+
   const vector<uint32_t>& stats = writeAnnexBAccessUnit(m_bitstream, au);
   rateStatsAccum(au, stats);
   m_bitstream.flush();
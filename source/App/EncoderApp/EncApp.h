@@ -75,6 +75,7 @@ private:
   uint32_t          m_essentialBytes;
   uint32_t          m_totalBytes;
   fstream&          m_bitstream;
+  WriteBehindQueue* m_bitstreamQueue;             ///< write-behind of the bitstream shared by all layers, inactive for synchronous output
 #if JVET_O0756_CALCULATE_HDRMETRICS
   std::chrono::duration<long long, ratio<1, 1000000000>> m_metricTime;
 #endif
@@ -107,7 +108,7 @@ private:
   bool m_flush;
 
 public:
-  EncApp( fstream& bitStream, EncLibCommon* encLibCommon );
+  EncApp( fstream& bitStream, WriteBehindQueue* bitstreamQueue, EncLibCommon* encLibCommon );
   virtual ~EncApp();
 
   int   getMaxLayers() const { return m_maxLayers; }
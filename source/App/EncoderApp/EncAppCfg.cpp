@@ -802,6 +802,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("FrameRate,-fr",                                   m_iFrameRate,                                         0, "Frame rate")
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
+  ("IOQueueDepth",                                    m_ioQueueDepth,                                       0, "Number of frames read ahead from the input file and written behind to the reconstruction and bitstream files by separate I/O threads (0: synchronous file I/O)")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
@@ -996,6 +997,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("CIIP",                                            m_ciip,                                           false, "Enable CIIP mode")
   ("Geo",                                             m_Geo,                                            false, "Enable geometric partitioning mode (0:off, 1:on)")
   ("HashME",                                          m_HashME,                                         false, "Enable hash motion estimation (0:off, 1:on)")
+  ("HashMEIncremental",                               m_HashMEIncremental,                               true, "Keep the block hashes of the last hashed picture and only hash the changed regions again, uses about 70 bytes per luma sample (0:off, 1:on)")
 
   ("AllowDisFracMMVD",                                m_allowDisFracMMVD,                               false, "Disable fractional MVD in MMVD mode adaptively")
   ("AffineAmvr",                                      m_AffineAmvr,                                     false, "Eanble AMVR for affine inter mode")
@@ -1077,6 +1079,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("BipredSearchRange",                               m_bipredSearchRange,                                  4, "Motion search range for bipred refinement")
   ("MinSearchWindow",                                 m_minSearchWindow,                                    8, "Minimum motion search window size for the adaptive window ME")
   ("RestrictMESampling",                              m_bRestrictMESampling,                            false, "Restrict ME Sampling for selective inter motion search")
+  ("HierarchicalME",                                  m_hierarchicalME,                                 false, "Seed the TZ search with a coarse to fine search on subsampled reference pictures and narrow its search (0:off, 1:on)")
+  ("MotionSearchCache",                               m_motionSearchCache,                              false, "Seed the TZ search with the motion vectors of overlapping blocks searched before in the same CTU and refine those of enclosing blocks locally (0:off, 1:on)")
   ("ClipForBiPredMEEnabled",                          m_bClipForBiPredMeEnabled,                        false, "Enables clipping in the Bi-Pred ME. It is disabled to reduce encoder run-time")
   ("FastMEAssumingSmootherMVEnabled",                 m_bFastMEAssumingSmootherMVEnabled,                true, "Enables fast ME assuming a smoother MV.")
 
@@ -1231,6 +1235,11 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("Log2ParallelMergeLevel",                          m_log2ParallelMergeLevel,                            2u, "Parallel merge estimation region")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
   ("EntryPointsPresent",                              m_entryPointPresentFlag,                           true, "0: entry points is not present; 1 entry points may be present in slice header")
+  ("NumWppThreads",                                   m_numWppThreads,                                      1, "Number of threads used to encode CTU rows in parallel (requires WaveFrontSynchro)")
+  ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                              false, "Produce the same bitstream independent of NumWppThreads by resetting CTU order dependent encoder state at CTU row starts")
+  ("NumFrameThreads",                                 m_numFrameThreads,                                    1, "Number of pictures of a GOP without references among each other that are encoded in parallel")
+  ("NumSplitThreads",                                 m_numSplitThreads,                                    1, "Number of threads evaluating the split candidates of large CUs in parallel (1: sequential mode decision, >1 requires AllowNonIdenticalSplitSearch)")
+  ("AllowNonIdenticalSplitSearch",                    m_allowNonIdenticalSplitSearch,                   false, "Allow NumSplitThreads > 1, its mode decision and bitstream differ from the sequential search")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 m_scalingListFileName,                       string(""), "Scaling list file name. Use an empty string to produce help.")
   ("DisableScalingMatrixForLFNST",                    m_disableScalingMatrixForLfnstBlks,                true, "Disable scaling matrices, when enabled, for LFNST-coded blocks")
@@ -1613,6 +1622,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
     ("TemporalFilter",               m_gopBasedTemporalFilterEnabled,                     false, "Enable GOP based temporal filter. Disabled per default")
     ("TemporalFilterPastRefs",       m_gopBasedTemporalFilterPastRefs,          TF_DEFAULT_REFS, "Number of past references for temporal prefilter")
     ("TemporalFilterFutureRefs",     m_gopBasedTemporalFilterFutureRefs,        TF_DEFAULT_REFS, "Number of future references for temporal prefilter")
+    ("TemporalFilterThreads",        m_gopBasedTemporalFilterNumThreads,                      1, "Number of threads of the temporal prefilter (1: single threaded)")
     ("FirstValidFrame",              m_firstValidFrame,                                       0, "First valid frame")
     ("LastValidFrame",               m_lastValidFrame,                                  MAX_INT, "Last valid frame")
     ("TemporalFilterStrengthFrame*", m_gopBasedTemporalFilterStrengths, std::map<int, double>(), "Strength for every * frame in GOP based temporal filter, where * is an integer."
@@ -3097,6 +3107,16 @@ int EncAppCfg::xAutoDetermineProfile()
   return 0;
 }
 
+/** check that the configuration can be encoded concurrently with other sessions
+    the bitstream debugging, fast forward and POC switching options keep their state in function statics,
+    and the upscaled output uses static scaling windows
+ */
+bool EncAppCfg::isSessionSafe() const
+{
+  return m_decodeBitstreams[0].empty() && m_decodeBitstreams[1].empty() && m_debugCTU < 0 && m_switchPOC < 0
+         && m_fastForwardToPOC < 0 && m_upscaledOutput == 0;
+}
+
 bool EncAppCfg::xCheckParameter()
 {
   msg( NOTICE, "\n" );
@@ -3278,7 +3298,33 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_bipredSearchRange < 0 ,                                                   "Bi-prediction refinement search range must be more than 0" );
   xConfirmPara( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
   xConfirmPara( m_iMaxDeltaQP > MAX_DELTA_QP,                                               "Absolute Delta QP exceeds supported range (0 to 7)" );
+  xConfirmPara( m_numWppThreads < 1,                                                        "NumWppThreads must be at least 1" );
+  xConfirmPara( m_numWppThreads > 1 && !m_entropyCodingSyncEnabledFlag,                     "NumWppThreads > 1 requires WaveFrontSynchro" );
+  xConfirmPara( m_numWppThreads > 1 && m_RCEnableRateControl,                               "NumWppThreads > 1 cannot be used together with rate control" );
+  xConfirmPara( m_numWppThreads > 1 && m_MCTSEncConstraint,                                 "NumWppThreads > 1 cannot be used together with MCTSEncConstraint" );
+  xConfirmPara( m_numWppThreads > 1 && m_wcgChromaQpControl.enabled,                        "NumWppThreads > 1 cannot be used together with WCGPPSEnable" );
+  xConfirmPara( m_ioQueueDepth < 0,                                                         "IOQueueDepth must not be negative" );
+  xConfirmPara( m_numFrameThreads < 1,                                                      "NumFrameThreads must be at least 1" );
+  xConfirmPara( m_numFrameThreads > 1 && m_isField,                                         "NumFrameThreads > 1 cannot be used together with field coding" );
+  xConfirmPara( m_numFrameThreads > 1 && m_compositeRefEnabled,                             "NumFrameThreads > 1 cannot be used together with composite reference" );
+  xConfirmPara( m_numFrameThreads > 1 && m_maxLayers > 1,                                   "NumFrameThreads > 1 cannot be used together with multiple layers" );
+  xConfirmPara( m_numFrameThreads > 1 && m_resChangeInClvsEnabled,                          "NumFrameThreads > 1 cannot be used together with reference picture resampling" );
+  xConfirmPara( m_numFrameThreads > 1 && m_tsrcRicePresentFlag,                             "NumFrameThreads > 1 cannot be used together with TSRCRicePresent" );
+  xConfirmPara( m_numFrameThreads > 1 && m_subPicInfoPresentFlag,                           "NumFrameThreads > 1 cannot be used together with subpictures" );
+  xConfirmPara( m_numSplitThreads < 1,                                                      "NumSplitThreads must be at least 1" );
+  xConfirmPara( m_numSplitThreads > 1 && !m_allowNonIdenticalSplitSearch,                   "NumSplitThreads > 1 produces a bitstream different from the sequential mode decision and requires AllowNonIdenticalSplitSearch=1" );
+  xConfirmPara( m_numSplitThreads > 1 && ( m_numWppThreads > 1 || m_numFrameThreads > 1 ),  "NumSplitThreads > 1 cannot be used together with NumWppThreads > 1 or NumFrameThreads > 1" );
+  xConfirmPara( m_numSplitThreads > 1 && m_RCEnableRateControl,                             "NumSplitThreads > 1 cannot be used together with rate control" );
+  xConfirmPara( m_numSplitThreads > 1 && m_IBCMode,                                         "NumSplitThreads > 1 cannot be used together with IBC" );
+  xConfirmPara( m_numSplitThreads > 1 && m_wcgChromaQpControl.enabled,                      "NumSplitThreads > 1 cannot be used together with WCGPPSEnable" );
+  xConfirmPara( m_numSplitThreads > 1 && m_smoothQPReductionEnable,                         "NumSplitThreads > 1 cannot be used together with SmoothQPReductionEnable" );
+  xConfirmPara( m_numSplitThreads > 1 && m_lumaLevelToDeltaQPMapping.mode,                  "NumSplitThreads > 1 cannot be used together with luma-level-based delta QP" );
+#if GDR_ENABLED
+  xConfirmPara( m_numSplitThreads > 1 && m_gdrEnabled,                                      "NumSplitThreads > 1 cannot be used together with GDR" );
+#endif
 #if ENABLE_QPA
+  xConfirmPara( m_numWppThreads > 1 && m_bUsePerceptQPA,                                    "NumWppThreads > 1 cannot be used together with perceptual QPA" );
+  xConfirmPara( m_numSplitThreads > 1 && m_bUsePerceptQPA,                                  "NumSplitThreads > 1 cannot be used together with perceptual QPA" );
   xConfirmPara( m_bUsePerceptQPA && m_uiDeltaQpRD > 0,                                      "Perceptual QPA cannot be used together with slice-level multiple-QP optimization" );
 #endif
 #if SHARP_LUMA_DELTA_QP
@@ -4379,6 +4425,7 @@ bool EncAppCfg::xCheckParameter()
     xConfirmPara(
       m_gopBasedTemporalFilterPastRefs <= 0 && m_gopBasedTemporalFilterFutureRefs <= 0,
       "Either TemporalFilterPastRefs or TemporalFilterFutureRefs must be larger than 0 when TemporalFilter is enabled");
+    xConfirmPara(m_gopBasedTemporalFilterNumThreads < 1, "TemporalFilterThreads must be at least 1");
 
     if ((m_gopBasedTemporalFilterPastRefs != 0 && m_gopBasedTemporalFilterPastRefs != TF_DEFAULT_REFS)
         || (m_gopBasedTemporalFilterFutureRefs != 0 && m_gopBasedTemporalFilterFutureRefs != TF_DEFAULT_REFS))
@@ -4596,6 +4643,8 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "ASR:%d ", m_bUseASR                            );
   msg( VERBOSE, "MinSearchWindow:%d ", m_minSearchWindow        );
   msg( VERBOSE, "RestrictMESampling:%d ", m_bRestrictMESampling );
+  msg( VERBOSE, "HierarchicalME:%d ", m_hierarchicalME          );
+  msg( VERBOSE, "MotionSearchCache:%d ", m_motionSearchCache    );
   msg( VERBOSE, "FEN:%d ", int(m_fastInterSearchMode)           );
   msg( VERBOSE, "ECU:%d ", m_bUseEarlyCU                        );
   msg( VERBOSE, "FDM:%d ", m_useFastDecisionForMerge            );
@@ -4618,6 +4667,8 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "PME:%d ", m_log2ParallelMergeLevel);
   const int iWaveFrontSubstreams = m_entropyCodingSyncEnabledFlag ? (m_sourceHeight + m_uiMaxCUHeight - 1) / m_uiMaxCUHeight : 1;
   msg( VERBOSE, " WaveFrontSynchro:%d WaveFrontSubstreams:%d", m_entropyCodingSyncEnabledFlag?1:0, iWaveFrontSubstreams);
+  msg( VERBOSE, " WppThreads:%d EnsureWppBitEqual:%d FrameThreads:%d SplitThreads:%d", m_numWppThreads, m_ensureWppBitEqual ? 1 : 0, m_numFrameThreads, m_numSplitThreads );
+  msg( VERBOSE, " IOQueueDepth:%d", m_ioQueueDepth );
   msg( VERBOSE, " ScalingList:%d ", m_useScalingListId );
   msg( VERBOSE, "TMVPMode:%d ", m_TMVPModeId );
   msg( VERBOSE, " DQ:%d ", m_depQuantEnabledFlag);
@@ -4683,6 +4734,10 @@ void EncAppCfg::xPrintParameter()
     msg(VERBOSE, "PLT:%d ", m_PLTMode);
     msg(VERBOSE, "IBC:%d ", m_IBCMode);
   msg( VERBOSE, "HashME:%d ", m_HashME );
+  if( m_HashME )
+  {
+    msg( VERBOSE, "HashMEIncremental:%d ", m_HashMEIncremental );
+  }
   msg( VERBOSE, "WrapAround:%d ", m_wrapAround);
   if( m_wrapAround )
   {
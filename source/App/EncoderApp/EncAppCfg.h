@@ -95,6 +95,7 @@ protected:
   int       m_iFrameRate;                                     ///< source frame-rates (Hz)
   uint32_t      m_FrameSkip;                                      ///< number of skipped frames from the beginning
   uint32_t      m_temporalSubsampleRatio;                         ///< temporal subsample ratio, 2 means code every two frames
+  int       m_ioQueueDepth;                                   ///< number of frames read ahead / written behind by I/O threads (0: synchronous I/O)
   int       m_sourceWidth;                                   ///< source width in pixel
   int       m_sourceHeight;                                  ///< source height in pixel (when interlaced = field height)
 #if EXTENSION_360_VIDEO
@@ -371,6 +372,7 @@ protected:
   bool      m_ciip;
   bool      m_Geo;
   bool      m_HashME;
+  bool      m_HashMEIncremental;
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
   bool      m_AffineAmvrEncOpt;
@@ -479,6 +481,8 @@ protected:
   bool      m_bDisableIntraPUsInInterSlices;                  ///< Flag for disabling intra predicted PUs in inter slices.
   MESearchMethod m_motionEstimationSearchMethod;
   bool      m_bRestrictMESampling;                            ///< Restrict sampling for the Selective ME
+  bool      m_hierarchicalME;                                 ///< seed the TZ search with a search on the subsampled reference pictures
+  bool      m_motionSearchCache;                              ///< seed the TZ search with the results of overlapping blocks of the same CTU
   int       m_iSearchRange;                                   ///< ME search range
   int       m_bipredSearchRange;                              ///< ME search range for bipred refinement
   int       m_minSearchWindow;                                ///< ME minimum search window size for the Adaptive Window ME
@@ -508,6 +512,11 @@ protected:
   bool      m_singleSlicePerSubPicFlag;
   bool      m_entropyCodingSyncEnabledFlag;
   bool      m_entryPointPresentFlag;                          ///< flag for the presence of entry points
+  int       m_numWppThreads;                                  ///< number of threads used for wavefront parallel CTU row encoding
+  bool      m_ensureWppBitEqual;                              ///< produce identical bitstreams regardless of the number of WPP threads
+  int       m_numFrameThreads;                                ///< number of pictures of a GOP encoded in parallel
+  int       m_numSplitThreads;                                ///< number of threads evaluating the split candidates of a CU in parallel
+  bool      m_allowNonIdenticalSplitSearch;                   ///< accept a parallel split search that differs from the sequential mode decision
 
   bool      m_bFastUDIUseMPMEnabled;
   bool      m_bFastMEForGenBLowDelayEnabled;
@@ -843,6 +852,7 @@ protected:
   bool                  m_gopBasedTemporalFilterEnabled;
   int                   m_gopBasedTemporalFilterPastRefs;
   int                   m_gopBasedTemporalFilterFutureRefs;
+  int                   m_gopBasedTemporalFilterNumThreads;            ///< number of threads of the GOP-based Temporal Filter
   std::map<int, double> m_gopBasedTemporalFilterStrengths;             ///< Filter strength per frame for the GOP-based Temporal Filter
 
   int         m_maxLayers;
@@ -910,6 +920,10 @@ public:
   void  create    ();                                         ///< create option handling class
   void  destroy   ();                                         ///< destroy option handling class
   bool  parseCfg  ( int argc, char* argv[] );                ///< parse configuration file to fill member variables
+  bool  isSessionSafe() const;                                ///< check that no process-wide debug state is used, required for concurrent sessions
+
+  const std::string& getBitstreamFileName() const { return m_bitstreamFileName; }
+  int   getIOQueueDepth() const { return m_ioQueueDepth; }
 
 };// END CLASS DEFINITION EncAppCfg
 
@@ -0,0 +1,274 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncSession.cpp
+    \brief    Encoder session class
+*/
+
+#include "EncSession.h"
+
+//! \ingroup EncoderApp
+//! \{
+
+EncSession::EncSession()
+{
+}
+
+EncSession::~EncSession()
+{
+  destroy();
+}
+
+/** \param  argc        number of arguments
+    \param  argv        array of arguments, "-l<idx> <option>" is only passed to layer idx
+    \retval             false on a configuration error
+ */
+bool EncSession::create( int argc, char* argv[] )
+{
+  PelStorage::setThreadMemoryAccount( &m_memoryAccount );
+
+  m_encApp.resize( 1, nullptr );
+  bool resized = false;
+  int layerIdx = 0;
+
+  std::vector<char*> layerArgv( argc );
+
+  do
+  {
+    m_encApp[layerIdx] = new EncApp( m_bitstream, &m_bitstreamQueue, &m_encLibCommon );
+    // create application encoder class per layer
+    m_encApp[layerIdx]->create();
+
+    // parse configuration per layer
+    try
+    {
+      int j = 0;
+      for( int i = 0; i < argc; i++ )
+      {
+        if( argv[i][0] == '-' && argv[i][1] == 'l' )
+        {
+          if (argc <= i + 1)
+          {
+            THROW("Command line parsing error: missing parameter after -lx\n");
+          }
+          int numParams = 1; // count how many parameters are consumed
+          // check for long parameters, which start with "--"
+          const std::string param = argv[i + 1];
+          if (param.rfind("--", 0) != 0)
+          {
+            // only short parameters have a second parameter for the value
+            if (argc <= i + 2)
+            {
+              THROW("Command line parsing error: missing parameter after -lx\n");
+            }
+            numParams++;
+          }
+          // check if correct layer index
+          if( argv[i][2] == std::to_string( layerIdx ).c_str()[0] )
+          {
+            layerArgv[j] = argv[i + 1];
+            if (numParams > 1)
+            {
+              layerArgv[j + 1] = argv[i + 2];
+            }
+            j+= numParams;
+          }
+          i += numParams;
+        }
+        else
+        {
+          layerArgv[j] = argv[i];
+          j++;
+        }
+      }
+
+      if( !m_encApp[layerIdx]->parseCfg( j, layerArgv.data() ) )
+      {
+        m_encApp[layerIdx]->destroy();
+        delete m_encApp[layerIdx];
+        m_encApp.resize( layerIdx );
+        PelStorage::setThreadMemoryAccount( nullptr );
+        return false;
+      }
+    }
+    catch( df::program_options_lite::ParseFailure &e )
+    {
+      std::cerr << "Error parsing option \"" << e.arg << "\" with argument \"" << e.val << "\"." << std::endl;
+      m_encApp[layerIdx]->destroy();
+      delete m_encApp[layerIdx];
+      m_encApp.resize( layerIdx );
+      PelStorage::setThreadMemoryAccount( nullptr );
+      return false;
+    }
+
+    m_encApp[layerIdx]->createLib( layerIdx );
+
+    if( !resized )
+    {
+      m_encApp.resize( m_encApp[layerIdx]->getMaxLayers(), nullptr );
+      resized = true;
+    }
+
+    layerIdx++;
+  } while( layerIdx < m_encApp.size() );
+
+  if (layerIdx > 1)
+  {
+    VPS* vps = m_encApp[0]->getVPS();
+    //check chroma format and bit-depth for dependent layers
+    for (uint32_t i = 0; i < layerIdx; i++)
+    {
+      int curLayerChromaFormatIdc = m_encApp[i]->getChromaFormatIDC();
+      int curLayerBitDepth = m_encApp[i]->getBitDepth();
+      for (uint32_t j = 0; j < layerIdx; j++)
+      {
+        if (vps->getDirectRefLayerFlag(i, j))
+        {
+          int refLayerChromaFormatIdcInVPS = m_encApp[j]->getChromaFormatIDC();
+          CHECK(curLayerChromaFormatIdc != refLayerChromaFormatIdcInVPS, "The chroma formats of the current layer and the reference layer are different");
+          int refLayerBitDepthInVPS = m_encApp[j]->getBitDepth();
+          CHECK(curLayerBitDepth != refLayerBitDepthInVPS, "The bit-depth of the current layer and the reference layer are different");
+        }
+      }
+    }
+  }
+
+  if( m_encApp[0]->getIOQueueDepth() > 0 )
+  {
+    m_bitstreamQueue.start( [this]( const uint8_t* src, size_t size ) {
+      m_bitstream.write( reinterpret_cast<const char*>( src ), size );
+      m_bitstream.flush();
+      return !m_bitstream.fail();
+    }, m_encApp[0]->getIOQueueDepth() );
+  }
+
+  PelStorage::setThreadMemoryAccount( nullptr );
+  return true;
+}
+
+bool EncSession::encode()
+{
+  PelStorage::setThreadMemoryAccount( &m_memoryAccount );
+
+  // call encoding function per layer
+  bool eos = false;
+
+#ifndef _DEBUG
+  try
+  {
+#endif
+    while( !eos )
+    {
+      // read GOP
+      bool keepLoop = true;
+      while( keepLoop )
+      {
+        for( auto & encApp : m_encApp )
+        {
+          keepLoop = encApp->encodePrep( eos );
+        }
+      }
+
+      // encode GOP
+      keepLoop = true;
+      while( keepLoop )
+      {
+        for( auto & encApp : m_encApp )
+        {
+          keepLoop = encApp->encode();
+        }
+      }
+    }
+#ifndef _DEBUG
+  }
+  catch( Exception &e )
+  {
+    std::cerr << e.what() << std::endl;
+    PelStorage::setThreadMemoryAccount( nullptr );
+    return false;
+  }
+  catch( const std::bad_alloc &e )
+  {
+    std::cout << "Memory allocation failed: " << e.what() << std::endl;
+    PelStorage::setThreadMemoryAccount( nullptr );
+    return false;
+  }
+#endif
+
+  PelStorage::setThreadMemoryAccount( nullptr );
+  return true;
+}
+
+void EncSession::destroy()
+{
+  // write the pending access units before the bitstream file is closed
+  m_bitstreamQueue.stop();
+
+  for( auto & encApp : m_encApp )
+  {
+    encApp->destroyLib();
+
+    // destroy application encoder class per layer
+    encApp->destroy();
+
+    delete encApp;
+  }
+  m_encApp.clear();
+}
+
+bool EncSession::isSessionSafe() const
+{
+  for( auto & encApp : m_encApp )
+  {
+    if( !encApp->isSessionSafe() )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if JVET_O0756_CALCULATE_HDRMETRICS
+std::chrono::duration<long long, ratio<1, 1000000000>> EncSession::getMetricTime() const
+{
+  auto metricTime = m_encApp[0]->getMetricTime();
+
+  for( int layerIdx = 1; layerIdx < m_encApp.size(); layerIdx++ )
+  {
+    metricTime += m_encApp[layerIdx]->getMetricTime();
+  }
+  return metricTime;
+}
+#endif
+
+//! \}
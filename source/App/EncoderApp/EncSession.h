@@ -0,0 +1,82 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncSession.h
+    \brief    Encoder session class (header)
+*/
+
+#ifndef __ENCSESSION__
+#define __ENCSESSION__
+
+#include <fstream>
+#include <vector>
+
+#include "EncApp.h"
+#include "EncoderLib/EncLibCommon.h"
+
+//! \ingroup EncoderApp
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// one encoding of a (multi-layer) bitstream, several sessions can be encoded concurrently in one process
+class EncSession
+{
+private:
+  std::fstream          m_bitstream;
+  WriteBehindQueue      m_bitstreamQueue;         ///< write-behind of the bitstream, started for IOQueueDepth > 0
+  EncLibCommon          m_encLibCommon;
+  std::vector<EncApp*>  m_encApp;                 ///< encoder application per layer
+  PelMemoryAccount      m_memoryAccount;          ///< pel buffers allocated by this session
+
+public:
+  EncSession();
+  ~EncSession();
+
+  bool  create          ( int argc, char* argv[] );   ///< parse the configuration and create the encoders of all layers
+  bool  encode          ();                           ///< encode all pictures, returns false on error
+  void  destroy         ();
+
+  bool  isSessionSafe   () const;
+  const std::string& getBitstreamFileName() const { return m_encApp[0]->getBitstreamFileName(); }
+  size_t getPeakPelMemory() const { return m_memoryAccount.peak; }
+#if JVET_O0756_CALCULATE_HDRMETRICS
+  std::chrono::duration<long long, ratio<1, 1000000000>> getMetricTime() const;
+#endif
+};// END CLASS DEFINITION EncSession
+
+//! \}
+
+#endif // __ENCSESSION__
@@ -40,8 +40,11 @@
 #include <chrono>
 #include <ctime>
 
-#include "EncoderLib/EncLibCommon.h"
-#include "EncApp.h"
+#include <fstream>
+#include <sstream>
+
+#include "EncSession.h"
+#include "CommonLib/ThreadPool.h"
 #include "Utilities/program_options_lite.h"
 
 //! \ingroup EncoderApp
@@ -77,6 +80,117 @@ static void printMacroSettings()
   }
 }
 
+/** encode the sessions listed in a file concurrently, one command line per line
+    \param  appName           name passed as first argument to each session
+    \param  sessionList       file with the command lines of the sessions
+    \param  numSessionThreads number of sessions encoded in parallel (0: all)
+ */
+static int encodeSessionList( const char* appName, const std::string& sessionList, int numSessionThreads )
+{
+  std::ifstream listFile( sessionList );
+  if( !listFile )
+  {
+    std::cerr << "Unable to open session list \"" << sessionList << "\"." << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<std::string>> sessionArgs;
+  std::string line;
+  while( std::getline( listFile, line ) )
+  {
+    std::istringstream lineStream( line );
+    std::vector<std::string> args( 1, appName );
+    std::string arg;
+    while( lineStream >> arg )
+    {
+      args.push_back( arg );
+    }
+    if( args.size() > 1 && args[1][0] != '#' )
+    {
+      sessionArgs.push_back( args );
+    }
+  }
+
+  // the sessions are created and destroyed on this thread, only the encoding runs concurrently
+  std::vector<EncSession*> sessions;
+  int ret = 0;
+  for( auto &args : sessionArgs )
+  {
+    std::vector<char*> sessionArgv;
+    for( auto &arg : args )
+    {
+      sessionArgv.push_back( &arg[0] );
+    }
+
+    EncSession* session = new EncSession;
+    sessions.push_back( session );
+    if( !session->create( ( int ) sessionArgv.size(), sessionArgv.data() ) )
+    {
+      ret = 1;
+      break;
+    }
+    if( !session->isSessionSafe() )
+    {
+      std::cerr << "Session " << sessions.size() - 1 << ": DecodeBitstream, DebugCTU, SwitchPOC, FastForwardToPOC and UpscaledOutput are not supported with SessionList." << std::endl;
+      ret = 1;
+      break;
+    }
+    for( int i = 0; i + 1 < sessions.size(); i++ )
+    {
+      if( sessions[i]->getBitstreamFileName() == session->getBitstreamFileName() )
+      {
+        std::cerr << "Session " << sessions.size() - 1 << ": bitstream file \"" << session->getBitstreamFileName() << "\" is already written by session " << i << "." << std::endl;
+        ret = 1;
+        break;
+      }
+    }
+    if( ret )
+    {
+      break;
+    }
+  }
+
+  if( !ret )
+  {
+    const int numSessions = ( int ) sessions.size();
+    std::vector<bool>   sessionOk  ( numSessions, false );
+    std::vector<double> sessionTime( numSessions, 0.0 );
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    ThreadPool sessionPool;
+    sessionPool.create( numSessionThreads > 0 ? std::min( numSessionThreads, numSessions ) : numSessions );
+    for( int i = 0; i < numSessions; i++ )
+    {
+      sessionPool.addJob( [&, i]( int )
+      {
+        auto sessionStart = std::chrono::steady_clock::now();
+        sessionOk[i]      = sessions[i]->encode();
+        sessionTime[i]    = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - sessionStart ).count() / 1000.0;
+      } );
+    }
+    sessionPool.waitForJobs();
+    sessionPool.destroy();
+
+    auto encTime = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - startTime ).count();
+
+    printf( "\n\nSession summary\n" );
+    for( int i = 0; i < numSessions; i++ )
+    {
+      printf( " %3d %-40s %s %12.3f sec. [elapsed] %10.1f MB pel buffers [peak]\n", i, sessions[i]->getBitstreamFileName().c_str(),
+              sessionOk[i] ? "ok    " : "failed", sessionTime[i], sessions[i]->getPeakPelMemory() / ( 1024.0 * 1024.0 ) );
+      ret |= sessionOk[i] ? 0 : EXIT_FAILURE;
+    }
+    printf( " Total Time: %12.3f sec. [elapsed]\n", encTime / 1000.0 );
+  }
+
+  for( auto &session : sessions )
+  {
+    delete session;
+  }
+  return ret;
+}
+
 // ====================================================================================================================
 // Main function
 // ====================================================================================================================
@@ -89,14 +203,22 @@ int main(int argc, char* argv[])
   fprintf( stdout, NVM_ONOS );
   fprintf( stdout, NVM_COMPILEDBY );
   fprintf( stdout, NVM_BITS );
+  std::string sessionList;
+  int numSessionThreads;
 #if ENABLE_SIMD_OPT
   std::string SIMD;
+#endif
   df::program_options_lite::Options opts;
   opts.addOptions()
+#if ENABLE_SIMD_OPT
     ( "SIMD", SIMD, string( "" ), "" )
+#endif
+    ( "SessionList", sessionList, string( "" ), "" )
+    ( "NumSessionThreads", numSessionThreads, 0, "" )
     ( "c", df::program_options_lite::parseConfigFile, "" );
   df::program_options_lite::SilentReporter err;
   df::program_options_lite::scanArgv( opts, argc, ( const char** ) argv, err );
+#if ENABLE_SIMD_OPT
   fprintf( stdout, "[SIMD=%s] ", read_x86_extension( SIMD ) );
 #endif
 #if ENABLE_TRACING
@@ -104,111 +226,21 @@ int main(int argc, char* argv[])
 #endif
   fprintf( stdout, "\n" );
 
-  std::fstream bitstream;
-  EncLibCommon encLibCommon;
-
-  std::vector<EncApp*> pcEncApp(1);
-  bool resized = false;
-  int layerIdx = 0;
-
   initROM();
   TComHash::initBlockSizeToIndex();
 
-  char** layerArgv = new char*[argc];
-
-  do
+  if( !sessionList.empty() )
   {
-    pcEncApp[layerIdx] = new EncApp( bitstream, &encLibCommon );
-    // create application encoder class per layer
-    pcEncApp[layerIdx]->create();
-
-    // parse configuration per layer
-    try
-    {
-      int j = 0;
-      for( int i = 0; i < argc; i++ )
-      {
-        if( argv[i][0] == '-' && argv[i][1] == 'l' )
-        {
-          if (argc <= i + 1)
-          {
-            THROW("Command line parsing error: missing parameter after -lx\n");
-          }
-          int numParams = 1; // count how many parameters are consumed
-          // check for long parameters, which start with "--"
-          const std::string param = argv[i + 1];
-          if (param.rfind("--", 0) != 0)
-          {
-            // only short parameters have a second parameter for the value
-            if (argc <= i + 2)
-            {
-              THROW("Command line parsing error: missing parameter after -lx\n");
-            }
-            numParams++;
-          }
-          // check if correct layer index
-          if( argv[i][2] == std::to_string( layerIdx ).c_str()[0] )
-          {
-            layerArgv[j] = argv[i + 1];
-            if (numParams > 1)
-            {
-              layerArgv[j + 1] = argv[i + 2];
-            }
-            j+= numParams;
-          }
-          i += numParams;
-        }
-        else
-        {
-          layerArgv[j] = argv[i];
-          j++;
-        }
-      }
-
-      if( !pcEncApp[layerIdx]->parseCfg( j, layerArgv ) )
-      {
-        pcEncApp[layerIdx]->destroy();
-        return 1;
-      }
-    }
-    catch( df::program_options_lite::ParseFailure &e )
-    {
-      std::cerr << "Error parsing option \"" << e.arg << "\" with argument \"" << e.val << "\"." << std::endl;
-      return 1;
-    }
-
-    pcEncApp[layerIdx]->createLib( layerIdx );
-
-    if( !resized )
-    {
-      pcEncApp.resize( pcEncApp[layerIdx]->getMaxLayers() );
-      resized = true;
-    }
-
-    layerIdx++;
-  } while( layerIdx < pcEncApp.size() );
+    const int ret = encodeSessionList( argv[0], sessionList, numSessionThreads );
+    destroyROM();
+    return ret;
+  }
 
-  delete[] layerArgv;
+  EncSession session;
 
-  if (layerIdx > 1)
+  if( !session.create( argc, argv ) )
   {
-    VPS* vps = pcEncApp[0]->getVPS();
-    //check chroma format and bit-depth for dependent layers
-    for (uint32_t i = 0; i < layerIdx; i++)
-    {
-      int curLayerChromaFormatIdc = pcEncApp[i]->getChromaFormatIDC();
-      int curLayerBitDepth = pcEncApp[i]->getBitDepth();
-      for (uint32_t j = 0; j < layerIdx; j++)
-      {
-        if (vps->getDirectRefLayerFlag(i, j))
-        {
-          int refLayerChromaFormatIdcInVPS = pcEncApp[j]->getChromaFormatIDC();
-          CHECK(curLayerChromaFormatIdc != refLayerChromaFormatIdcInVPS, "The chroma formats of the current layer and the reference layer are different");
-          int refLayerBitDepthInVPS = pcEncApp[j]->getBitDepth();
-          CHECK(curLayerBitDepth != refLayerBitDepthInVPS, "The bit-depth of the current layer and the reference layer are different");
-        }
-      }
-    }
+    return 1;
   }
 
 #if PRINT_MACRO_VALUES
@@ -221,76 +253,17 @@ int main(int argc, char* argv[])
   fprintf(stdout, " started @ %s", std::ctime(&startTime2) );
   clock_t startClock = clock();
 
-  // call encoding function per layer
-  bool eos = false;
-
-  while( !eos )
+  if( !session.encode() )
   {
-    // read GOP
-    bool keepLoop = true;
-    while( keepLoop )
-    {
-      for( auto & encApp : pcEncApp )
-      {
-#ifndef _DEBUG
-        try
-        {
-#endif
-          keepLoop = encApp->encodePrep( eos );
-#ifndef _DEBUG
-        }
-        catch( Exception &e )
-        {
-          std::cerr << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-        catch( const std::bad_alloc &e )
-        {
-          std::cout << "Memory allocation failed: " << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-#endif
-      }
-    }
-
-    // encode GOP
-    keepLoop = true;
-    while( keepLoop )
-    {
-      for( auto & encApp : pcEncApp )
-      {
-#ifndef _DEBUG
-        try
-        {
-#endif
-          keepLoop = encApp->encode();
-#ifndef _DEBUG
-        }
-        catch( Exception &e )
-        {
-          std::cerr << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-        catch( const std::bad_alloc &e )
-        {
-          std::cout << "Memory allocation failed: " << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-#endif
-      }
-    }
+    return EXIT_FAILURE;
   }
+
   // ending time
   clock_t endClock = clock();
   auto endTime = std::chrono::steady_clock::now();
   std::time_t endTime2 = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 #if JVET_O0756_CALCULATE_HDRMETRICS
-  auto metricTime = pcEncApp[0]->getMetricTime();
-
-  for( int layerIdx = 1; layerIdx < pcEncApp.size(); layerIdx++ )
-  {
-    metricTime += pcEncApp[layerIdx]->getMetricTime();
-  }
+  auto metricTime     = session.getMetricTime();
   auto totalTime      = std::chrono::duration_cast<std::chrono::milliseconds>( endTime - startTime ).count();
   auto encTime        = std::chrono::duration_cast<std::chrono::milliseconds>( endTime - startTime - metricTime ).count();
   auto metricTimeuser = std::chrono::duration_cast<std::chrono::milliseconds>( metricTime ).count();
@@ -298,21 +271,11 @@ int main(int argc, char* argv[])
   auto encTime = std::chrono::duration_cast<std::chrono::milliseconds>( endTime - startTime).count();
 #endif
 
-  for( auto & encApp : pcEncApp )
-  {
-    encApp->destroyLib();
-
-    // destroy application encoder class per layer
-    encApp->destroy();
-
-    delete encApp;
-  }
+  session.destroy();
 
   // destroy ROM
   destroyROM();
 
-  pcEncApp.clear();
-
   printf( "\n finished @ %s", std::ctime(&endTime2) );
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
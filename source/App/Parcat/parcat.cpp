@@ -35,8 +35,15 @@
 #include <vector>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <cassert>
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include "CommonLib/CommonDef.h"
+#include "DecoderLib/AnnexBread.h"
 #include "DecoderLib/NALread.h"
 #include "VLCReader.h"
 #if ENABLE_TRACING
@@ -87,63 +94,6 @@ void ParcatHLSyntaxReader::parsePictureHeaderUpToPoc ( ParameterSetManager *para
   return;
 }
 
-/**
- Find the beginning and end of a NAL (Network Abstraction Layer) unit in a byte buffer containing H264 bitstream data.
- @param[in]   buf        the buffer
- @param[in]   size       the size of the buffer
- @param[out]  nal_start  the beginning offset of the nal
- @param[out]  nal_end    the end offset of the nal
- @return                 the length of the nal, or 0 if did not find start of nal, or -1 if did not find end of nal
- */
-// DEPRECATED - this will be replaced by a similar function with a slightly different API
-int find_nal_unit(const uint8_t* buf, int size, int* nal_start, int* nal_end)
-{
-  int i;
-  // find start
-  *nal_start = 0;
-  *nal_end = 0;
-
-  i = 0;
-  while (   //( next_bits( 24 ) != 0x000001 && next_bits( 32 ) != 0x00000001 )
-    (buf[i] != 0 || buf[i+1] != 0 || buf[i+2] != 0x01) &&
-    (buf[i] != 0 || buf[i+1] != 0 || buf[i+2] != 0 || buf[i+3] != 0x01)
-    )
-  {
-    i++; // skip leading zero
-    if (i+4 >= size) { return 0; } // did not find nal start
-  }
-
-  if  (buf[i] != 0 || buf[i+1] != 0 || buf[i+2] != 0x01) // ( next_bits( 24 ) != 0x000001 )
-  {
-    i++;
-  }
-
-  if  (buf[i] != 0 || buf[i+1] != 0 || buf[i+2] != 0x01) { /* error, should never happen */ return 0; }
-  i+= 3;
-  *nal_start = i;
-
-  while (//( next_bits( 24 ) != 0x000000 && next_bits( 24 ) != 0x000001 )
-    i+3 < size &&
-    (buf[i] != 0 || buf[i+1] != 0 || buf[i+2] != 0) &&
-    (buf[i] != 0 || buf[i+1] != 0 || buf[i+2] != 0x01)
-    )
-  {
-    i++;
-    // FIXME the next line fails when reading a nal that ends exactly at the end of the data
-  }
-
-  if (i+3 == size)
-  {
-    *nal_end = size;
-  }
-  else
-  {
-    *nal_end = i;
-  }
-
-  return (*nal_end - *nal_start);
-}
-
 const bool verbose = false;
 
 const char * NALU_TYPE[] =
@@ -205,53 +155,85 @@ int calc_poc(int iPOClsb, int prevTid0POC, int getBitsForPOC, int nalu_type)
   return iPOCmsb + iPOClsb;
 }
 
-std::vector<uint8_t> filter_segment(const std::vector<uint8_t> & v, int idx, int * poc_base, int * last_idr_poc)
+/**
+ Location of a POC LSB in the output of a segment, which is written once the POC base of the segment is known.
+ */
+struct PocPatch
+{
+  size_t offset;    ///< offset of the two bytes that contain the POC LSB
+  int    hi_bits;   ///< number of bits before the POC LSB
+  int    low_bits;  ///< number of bits after the POC LSB
+  int    poc;       ///< POC relative to the POC base of the segment
+};
+
+/**
+ Filtered segment, its POC LSBs are relative to the start of the segment.
+ */
+struct FilteredSegment
 {
-  const uint8_t * p = v.data();
-  const uint8_t * buf = v.data();
-  int sz = (int) v.size();
-  int nal_start, nal_end;
-  int off = 0;
+  std::vector<uint8_t>  data;
+  std::vector<PocPatch> poc_patches;
+  int                   num_pocs = 0;
+  bool                  ready    = false;
+};
+
+void filter_segment(const char * path, int idx, FilteredSegment & segment)
+{
+  std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+  if (!file)
+  {
+    fprintf(stderr, "Error: could not open input file: %s", path);
+    exit(1);
+  }
+  InputByteStream bytestream(file);
+
   int cnt[MAX_VPS_LAYERS] = { 0 };
   bool idr_found[MAX_VPS_LAYERS] = { false };
   bool is_pre_sei_before_idr = true;
 
-  std::vector<uint8_t> out;
-  out.reserve(v.size());
+  std::vector<uint8_t> & out = segment.data;
 
   int bits_for_poc = 8;
   bool skip_next_sei = false;
   bool change_poc = false;
   bool first_idr_slice_after_ph_nal = false;
 
-  while(find_nal_unit(p, sz, &nal_start, &nal_end) > 0)
+  ParameterSetManager parameterSetManager;
+  uint32_t num_trailing_zeros = 0;
+  bool eof = false;
+
+  while (!eof)
   {
-    if(verbose)
+    AnnexBStats stats = AnnexBStats();
+    InputNALUnit inp_nalu;
+    std::vector<uint8_t> & nalu_bs = inp_nalu.getBitstream().getFifo();
+    eof = byteStreamNALUnit(bytestream, nalu_bs, stats);
+    // the start code of a NAL unit is preceded by the trailing zeros of the previous one
+    const uint32_t num_start_code_zeros = num_trailing_zeros + stats.m_numLeadingZero8BitsBytes + stats.m_numZeroByteBytes + stats.m_numStartCodePrefixBytes - 1;
+    num_trailing_zeros = stats.m_numTrailingZero8BitsBytes;
+    if (nalu_bs.size() < 2)
     {
-       printf( "!! Found NAL at offset %lld (0x%04llX), size %lld (0x%04llX) \n",
-          (long long int)(off + (p - buf)),
-          (long long int)(off + (p - buf)),
-          (long long int)(nal_end - nal_start),
-          (long long int)(nal_end - nal_start) );
+      continue;
     }
 
-    p += nal_start;
+    if(verbose)
+    {
+       printf( "!! Found NAL, size %lld (0x%04llX) \n",
+          (long long int)nalu_bs.size(),
+          (long long int)nalu_bs.size() );
+    }
 
-    std::vector<uint8_t> nalu(p, p + nal_end - nal_start);
+    std::vector<uint8_t> nalu = nalu_bs;
     int nalu_type = nalu[1] >> 3;
 #if ENABLE_TRACING
     printf ("NALU Type: %d (%s)\n", nalu_type, NALU_TYPE[nalu_type]);
 #endif
     int poc = -1;
     int poc_lsb = -1;
-    int new_poc = -1;
+    PocPatch poc_patch = { 0, 0, 0, -1 };
 
     HLSyntaxReader HLSReader;
-    static ParameterSetManager parameterSetManager;
     ParcatHLSyntaxReader parcatHLSReader;
-    InputNALUnit inp_nalu;
-    std::vector<uint8_t> & nalu_bs = inp_nalu.getBitstream().getFifo();
-    nalu_bs = nalu;
     read(inp_nalu);
 
     if( inp_nalu.m_nalUnitType == NAL_UNIT_SPS )
@@ -278,7 +260,6 @@ std::vector<uint8_t> filter_segment(const std::vector<uint8_t> & v, int idx, int
     if(nalu_type == NAL_UNIT_CODED_SLICE_IDR_W_RADL || nalu_type == NAL_UNIT_CODED_SLICE_IDR_N_LP)
     {
       poc = 0;
-      new_poc = *poc_base + poc;
       if (first_idr_slice_after_ph_nal)
       {
         cnt[nalu_layerId]--;
@@ -311,20 +292,9 @@ std::vector<uint8_t> filter_segment(const std::vector<uint8_t> & v, int idx, int
         poc_lsb = (data >> low_bits) & 0xff;
         poc = poc_lsb; //calc_poc(poc_lsb, 0, bits_for_poc, nalu_type);
 
-        new_poc = poc + *poc_base;
-        // int picOrderCntLSB = (pcSlice->getPOC()-pcSlice->getLastIDR()+(1<<pcSlice->getSPS()->getBitsForPOC())) & ((1<<pcSlice->getSPS()->getBitsForPOC())-1);
-        unsigned picOrderCntLSB = (new_poc - *last_idr_poc + (1 << bits_for_poc)) & ((1 << bits_for_poc) - 1);
-
-        int low = data & ((1 << low_bits) - 1);
-        int hi = data >> (16 - hi_bits);
-        data = (hi << (16 - hi_bits)) | (picOrderCntLSB << low_bits) | low;
+        // the POC LSB is written with the POC base of the segment when the segment is output
+        poc_patch = { size_t(byte_offset), hi_bits, low_bits, poc };
 
-        nalu[byte_offset] = data >> 8;
-        nalu[byte_offset + 1] = data & 0xff;
-
-#if ENABLE_TRACING
-        std::cout << "Changed poc " << poc << " to " << new_poc << std::endl;
-#endif
         ++cnt[nalu_layerId];
         change_poc = false;
       }
@@ -343,7 +313,13 @@ std::vector<uint8_t> filter_segment(const std::vector<uint8_t> & v, int idx, int
     }
     else
     {
-      out.insert(out.end(), p - nal_start, p);
+      out.insert(out.end(), num_start_code_zeros, 0x00);
+      out.push_back(0x01);
+      if (poc_patch.poc >= 0)
+      {
+        poc_patch.offset += out.size();
+        segment.poc_patches.push_back(poc_patch);
+      }
       out.insert(out.end(), nalu.begin(), nalu.end());
     }
 
@@ -351,42 +327,37 @@ std::vector<uint8_t> filter_segment(const std::vector<uint8_t> & v, int idx, int
     {
       skip_next_sei = false;
     }
-
-
-    p += (nal_end - nal_start);
-    sz -= nal_end;
   }
 
-  *poc_base += *std::max_element(std::begin(cnt), std::end(cnt));
-  return out;
+  segment.num_pocs = *std::max_element(std::begin(cnt), std::end(cnt));
 }
 
-std::vector<uint8_t> process_segment(const char * path, int idx, int * poc_base, int * last_idr_poc)
+void write_segment(FILE * fdo, FilteredSegment & segment, int * poc_base, int * last_idr_poc)
 {
-  FILE * fdi = fopen(path, "rb");
-
-  if (fdi == NULL)
+  const int bits_for_poc = 8;
+  for (const PocPatch & patch : segment.poc_patches)
   {
-    fprintf(stderr, "Error: could not open input file: %s", path);
-    exit(1);
-  }
+    int new_poc = patch.poc + *poc_base;
+    // int picOrderCntLSB = (pcSlice->getPOC()-pcSlice->getLastIDR()+(1<<pcSlice->getSPS()->getBitsForPOC())) & ((1<<pcSlice->getSPS()->getBitsForPOC())-1);
+    unsigned picOrderCntLSB = (new_poc - *last_idr_poc + (1 << bits_for_poc)) & ((1 << bits_for_poc) - 1);
 
-  fseek(fdi, 0, SEEK_END);
-  int full_sz = ftell(fdi);
-  fseek(fdi, 0, SEEK_SET);
+    uint8_t * nalu = segment.data.data() + patch.offset;
+    uint16_t data = (nalu[0] << 8) | nalu[1];
+    int low = data & ((1 << patch.low_bits) - 1);
+    int hi = data >> (16 - patch.hi_bits);
+    data = (hi << (16 - patch.hi_bits)) | (picOrderCntLSB << patch.low_bits) | low;
 
-  std::vector<uint8_t> v(full_sz);
+    nalu[0] = data >> 8;
+    nalu[1] = data & 0xff;
 
-  size_t sz = fread((char*) v.data(), 1, full_sz, fdi);
-  fclose(fdi);
-
-  if(sz != full_sz)
-  {
-    fprintf(stderr, "Error: input file was not read completely.");
-    exit(1);
+#if ENABLE_TRACING
+    std::cout << "Changed poc " << patch.poc << " to " << new_poc << std::endl;
+#endif
   }
+  *poc_base += segment.num_pocs;
 
-  return filter_segment(v, idx, poc_base, last_idr_poc);
+  fwrite(segment.data.data(), 1, segment.data.size(), fdo);
+  std::vector<uint8_t>().swap(segment.data);
 }
 
 int main(int argc, char * argv[])
@@ -397,10 +368,17 @@ int main(int argc, char * argv[])
 
   g_trace_ctx = tracing_init(tracingFile, tracingRule);
 #endif
-  if(argc < 3)
+  int num_threads = 1;
+  int first_arg = 1;
+  if (argc > 2 && strcmp(argv[1], "-j") == 0)
+  {
+    num_threads = std::max(atoi(argv[2]), 1);
+    first_arg = 3;
+  }
+  if(argc - first_arg < 2)
   {
     printf("parcat version VTM %s\n", VTM_VERSION);
-    printf("usage: %s <bitstream1> [<bitstream2> ...] <outfile>\n", argv[0]);
+    printf("usage: %s [-j <threads>] <bitstream1> [<bitstream2> ...] <outfile>\n", argv[0]);
     return -1;
   }
 
@@ -415,11 +393,55 @@ int main(int argc, char * argv[])
 
   initROM();
 
-  for(int i = 1; i < argc - 1; ++i)
+  // the segments are filtered concurrently, at most 2 * num_threads of them are held in memory until they are
+  // written in order
+  const int num_segments = argc - 1 - first_arg;
+  const int max_pending  = 2 * num_threads;
+  std::vector<FilteredSegment> segments(num_segments);
+  std::mutex                   mutex;
+  std::condition_variable      cond;
+  int                          next_segment = 0;
+  int                          num_written  = 0;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < std::min(num_threads, num_segments); t++)
   {
-    std::vector<uint8_t> v = process_segment(argv[i], i, &poc_base, &last_idr_poc);
+    workers.emplace_back([&]()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true)
+      {
+        cond.wait(lock, [&]() { return next_segment >= num_segments || next_segment < num_written + max_pending; });
+        if (next_segment >= num_segments)
+        {
+          return;
+        }
+        const int i = next_segment++;
+        lock.unlock();
+        filter_segment(argv[first_arg + i], i + 1, segments[i]);
+        lock.lock();
+        segments[i].ready = true;
+        cond.notify_all();
+      }
+    });
+  }
 
-    fwrite(v.data(), 1, v.size(), fdo);
+  for (int i = 0; i < num_segments; ++i)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [&]() { return segments[i].ready; });
+    }
+    write_segment(fdo, segments[i], &poc_base, &last_idr_poc);
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      num_written++;
+      cond.notify_all();
+    }
+  }
+  for (auto & worker : workers)
+  {
+    worker.join();
   }
 
   fclose(fdo);
@@ -219,7 +219,7 @@ bool StreamMergeApp::isNewPicture(std::ifstream *bitstreamFile, InputByteStream
   }
 
   // save stream position for backup
-  std::streampos location = bitstreamFile->tellg();
+  bytestream->beginLookahead();
 
   // look ahead until picture start location is determined
   while (!finished && !!(*bitstreamFile))
@@ -291,10 +291,8 @@ bool StreamMergeApp::isNewPicture(std::ifstream *bitstreamFile, InputByteStream
     }
   }
 
-  // restore previous stream location - minus 3 due to the need for the annexB parser to read three extra bytes
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location - std::streamoff(3));
-  bytestream->reset();
+  // restore previous stream location
+  bytestream->endLookahead();
 
   // return TRUE if next NAL unit is the start of a new picture
   return ret;
@@ -315,7 +313,7 @@ bool StreamMergeApp::isNewAccessUnit(bool newPicture, std::ifstream *bitstreamFi
   }
 
   // save stream position for backup
-  std::streampos location = bitstreamFile->tellg();
+  bytestream->beginLookahead();
 
   // look ahead until access unit start location is determined
   while (!finished && !!(*bitstreamFile))
@@ -369,9 +367,7 @@ bool StreamMergeApp::isNewAccessUnit(bool newPicture, std::ifstream *bitstreamFi
   }
 
   // restore previous stream location
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
+  bytestream->endLookahead();
 
   // return TRUE if next NAL unit is the start of a new picture
   return ret;
@@ -425,9 +421,11 @@ bool StreamMergeApp::preInjectNalu(MergeLayer &layer, InputNALUnit &inNalu, Outp
 
 /**
   - Decode NAL unit if it is parameter set or picture header, or decode slice header of VLC NAL unit
+  - Returns false if the NAL unit is not rewritten and its payload is forwarded unchanged
  */
-void StreamMergeApp::decodeAndRewriteNalu(MergeLayer &layer, InputNALUnit &inNalu, OutputNALUnit &outNalu)
+bool StreamMergeApp::decodeAndRewriteNalu(MergeLayer &layer, InputNALUnit &inNalu, OutputNALUnit &outNalu)
 {
+  bool           rewritten = true;
   HLSyntaxReader hlsReader;
   HLSWriter      hlsWriter;
   hlsReader.setBitstream(&inNalu.getBitstream());
@@ -519,14 +517,12 @@ void StreamMergeApp::decodeAndRewriteNalu(MergeLayer &layer, InputNALUnit &inNal
       msg(INFO, "NNN");   // Any other NAL unit that is not handled above
     }
     msg(INFO, " with index %i", inNalu.m_nalUnitType);
-    // Copy payload from input nalu to output nalu. Code copied from SubpicMergeApp::copyInputNaluToOutputNalu().
-    vector<uint8_t> &inFifo  = inNalu.getBitstream().getFifo();
-    vector<uint8_t> &outFifo = outNalu.m_Bitstream.getFIFO();
-    outFifo                  = vector<uint8_t>(inFifo.begin() + 2, inFifo.end());
+    rewritten = false;
     break;
   }
   }
   msg(INFO, "\n");
+  return rewritten;
 }
 
 uint32_t StreamMergeApp::mergeStreams()
@@ -613,8 +609,16 @@ uint32_t StreamMergeApp::mergeStreams()
         OutputNALUnit outNalu((NalUnitType) inNalu.m_nalUnitType);
         inputNaluHeaderToOutputNalu(inNalu, outNalu);
         outNalu.m_nuhLayerId = layer.id;
-        decodeAndRewriteNalu(layer, inNalu, outNalu);
-        outAccessUnit.push_back(new NALUnitEBSP(outNalu));
+        if (decodeAndRewriteNalu(layer, inNalu, outNalu))
+        {
+          outAccessUnit.push_back(new NALUnitEBSP(outNalu));
+        }
+        else
+        {
+          // forward the payload unchanged, only the layer ID of the header is rewritten
+          inNalu.m_nuhLayerId = layer.id;
+          outAccessUnit.push_back(new NALUnitEBSP(inNalu));
+        }
 
         if (inNalu.isVcl())
         {
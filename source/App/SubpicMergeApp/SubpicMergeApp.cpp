@@ -147,10 +147,8 @@ bool SubpicMergeApp::isNewPicture(std::ifstream *bitstreamFile, InputByteStream
   // save stream position for backup
 #if RExt__DECODER_DEBUG_STATISTICS
   CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
-  std::streampos location = bitstreamFile->tellg() - std::streampos(bytestream->GetNumBufferedBytes());
-#else
-  std::streampos location = bitstreamFile->tellg();
 #endif
+  bytestream->beginLookahead();
 
   // look ahead until picture start location is determined
   while (!finished && !!(*bitstreamFile))
@@ -222,17 +220,11 @@ bool SubpicMergeApp::isNewPicture(std::ifstream *bitstreamFile, InputByteStream
     }
   }
 
-  // restore previous stream location - minus 3 due to the need for the annexB parser to read three extra bytes
+  // restore previous stream location
+  bytestream->endLookahead();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
   CodingStatistics::SetStatistics(*backupStats);
   delete backupStats;
-#else
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location-std::streamoff(3));
-  bytestream->reset();
 #endif
 
   // return TRUE if next NAL unit is the start of a new picture
@@ -818,20 +810,6 @@ void SubpicMergeApp::updateSliceHeadersForMergedStream(ParameterSetManager &psMa
   }
 }
 
-/**
-  - Copy input NAL unit to ouput NAL unit
-*/
-void SubpicMergeApp::copyInputNaluToOutputNalu(OutputNALUnit &outNalu, InputNALUnit &inNalu)
-{
-  // Copy nal header info
-  outNalu = inNalu;
-
-  // Copy payload
-  std::vector<uint8_t> &inFifo = inNalu.getBitstream().getFifo();
-  std::vector<uint8_t> &outFifo = outNalu.m_Bitstream.getFIFO();
-  outFifo = std::vector<uint8_t>(inFifo.begin() + 2, inFifo.end());
-}
-
 /**
   - Copy NAL unit with NAL unit type naluType to access unit
 */
@@ -843,9 +821,7 @@ void SubpicMergeApp::copyNalUnitsToAccessUnit(AccessUnit &accessUnit, std::vecto
     {
       if (!(naluType == NAL_UNIT_SUFFIX_SEI && inNalu.getBitstream().getFifo().at(2) == SEI::DECODED_PICTURE_HASH))  // Don't copy decoded_picture_hash SEI
       {
-        OutputNALUnit outNalu((NalUnitType)naluType);
-        copyInputNaluToOutputNalu(outNalu, inNalu);
-        accessUnit.push_back(new NALUnitEBSP(outNalu));
+        accessUnit.push_back(new NALUnitEBSP(inNalu));
       }
     }
   }
@@ -105,7 +105,6 @@ private:
   void getTileDimensions(std::vector<int> &tileWidths, std::vector<int> &tileHeights);
   void generateMergedStreamPPSes(ParameterSetManager &psManager, std::vector<PPS*> &ppsList);
   void updateSliceHeadersForMergedStream(ParameterSetManager &psManager);
-  void copyInputNaluToOutputNalu(OutputNALUnit &outNalu, InputNALUnit &inNalu);
   void copyNalUnitsToAccessUnit(AccessUnit &accessUnit, std::vector<InputNALUnit> &nalus, int naluType);
   bool getMixedNalPicFlag();
   Subpicture &selectSubpicForPicHeader(bool isMixedNaluPic);
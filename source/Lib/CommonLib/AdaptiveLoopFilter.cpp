@@ -46,6 +46,8 @@ constexpr int AdaptiveLoopFilter::AlfNumClippingValues[];
 
 AdaptiveLoopFilter::AdaptiveLoopFilter()
   : m_classifier( nullptr )
+  , m_alfCtuFilterIndex( nullptr )
+  , m_lastSliceIdx( 0xFFFFFFFF )
 {
   for (size_t i = 0; i < NUM_DIRECTIONS; i++)
   {
@@ -399,7 +401,7 @@ void AdaptiveLoopFilter::applyCcAlfFilter(CodingStructure &cs, ComponentID compI
   }
 }
 
-void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
+void AdaptiveLoopFilter::ALFPrepareCtuRows(CodingStructure& cs)
 {
 
   // set clipping range
@@ -411,23 +413,82 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
     m_ctuEnableFlag[compIdx] = cs.picture->getAlfCtuEnableFlag( compIdx );
     m_ctuAlternative[compIdx] = cs.picture->getAlfCtuAlternativeData( compIdx );
   }
-  short* alfCtuFilterIndex = nullptr;
-  uint32_t lastSliceIdx = 0xFFFFFFFF;
+  m_alfCtuFilterIndex = nullptr;
+  m_lastSliceIdx = 0xFFFFFFFF;
+}
+
+void AdaptiveLoopFilter::ALFProcessCtuRow(CodingStructure& cs, const int ctuRow)
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int margin = MAX_ALF_FILTER_LENGTH >> 1;
+  PelUnitBuf recYuv = cs.getRecoBuf();
+  PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
+
+  // copy the SAO output of the row below (and of the row itself for the first row), the lines above were copied
+  // with the previous row and might already be overwritten by its ALF output
+  const int lumaStart = ctuRow == 0 ? 0 : ( ctuRow + 1 ) * pcv.maxCUHeight;
+  const int lumaEnd   = std::min<int>( ( ctuRow + 2 ) * pcv.maxCUHeight, pcv.lumaHeight );
+  for( int compIdx = 0; compIdx < getNumberValidComponents( cs.area.chromaFormat ) && lumaStart < lumaEnd; compIdx++ )
+  {
+    const ComponentID compID = ComponentID( compIdx );
+    const int scaleY    = getComponentScaleY( compID, cs.area.chromaFormat );
+    const int lineStart = lumaStart >> scaleY;
+    const int lineEnd   = lumaEnd >> scaleY;
+    PelBuf dst = tmpYuv.get( compID );
+    PelBuf lines = dst.subBuf( 0, lineStart, dst.width, lineEnd - lineStart );
+    lines.copyFrom( recYuv.get( compID ).subBuf( 0, lineStart, dst.width, lineEnd - lineStart ) );
+    lines.extendBorderPel( margin, 0 );
+
+    // extend the first and last picture line including the left and right margins
+    for( int y = 0; y < margin && lineStart == 0; y++ )
+    {
+      ::memcpy( dst.bufAt( -margin, -y - 1 ), dst.bufAt( -margin, 0 ), sizeof( Pel ) * ( dst.width + 2 * margin ) );
+    }
+    for( int y = 0; y < margin && lineEnd == dst.height; y++ )
+    {
+      ::memcpy( dst.bufAt( -margin, dst.height + y ), dst.bufAt( -margin, dst.height - 1 ), sizeof( Pel ) * ( dst.width + 2 * margin ) );
+    }
+  }
+
+  xFilterCtuRows( cs, ctuRow, ctuRow + 1 );
+}
+
+void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
+{
+  ALFPrepareCtuRows( cs );
 
   PelUnitBuf recYuv = cs.getRecoBuf();
   m_tempBuf.copyFrom( recYuv );
   PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
   tmpYuv.extendBorderPel( MAX_ALF_FILTER_LENGTH >> 1 );
 
+  // the slice of the last APS change stays active as before the row-wise filtering
+  if( Slice* lastSlice = xFilterCtuRows( cs, 0, cs.pcv->heightInCtus ) )
+  {
+    cs.slice = lastSlice;
+  }
+}
+
+/**
+ - filters the CTU rows [ctuRowStart, ctuRowEnd), cs.slice is not changed as the decoder deblocks the following rows
+   concurrently
+ - returns the slice of the last APS change, nullptr without one
+*/
+Slice* AdaptiveLoopFilter::xFilterCtuRows(CodingStructure& cs, const int ctuRowStart, const int ctuRowEnd)
+{
+  Slice* lastSlice = nullptr;
+  PelUnitBuf recYuv = cs.getRecoBuf();
+  PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
+
   const PreCalcValues& pcv = *cs.pcv;
 
-  int ctuIdx = 0;
+  int ctuIdx = ctuRowStart * pcv.widthInCtus;
   bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
   int numHorVirBndry = 0, numVerVirBndry = 0;
   int horVirBndryPos[] = { 0, 0, 0 };
   int verVirBndryPos[] = { 0, 0, 0 };
 
-  for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  for( int yPos = ctuRowStart * pcv.maxCUHeight; yPos < std::min<int>( ctuRowEnd * pcv.maxCUHeight, pcv.lumaHeight ); yPos += pcv.maxCUHeight )
   {
     for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
     {
@@ -442,14 +503,14 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
       }
 
       // reload ALF APS each time the slice changes during raster scan filtering
-      if(ctuIdx == 0 || lastSliceIdx != cu->slice->getSliceID() || alfCtuFilterIndex==nullptr)
+      if(ctuIdx == 0 || m_lastSliceIdx != cu->slice->getSliceID() || m_alfCtuFilterIndex==nullptr)
       {
-        cs.slice = cu->slice;
-        reconstructCoeffAPSs(cs, true, cu->slice->getAlfEnabledFlag(COMPONENT_Cb) || cu->slice->getAlfEnabledFlag(COMPONENT_Cr), false);
-        alfCtuFilterIndex = cu->slice->getPic()->getAlfCtbFilterIndex();
+        lastSlice = cu->slice;
+        reconstructCoeffAPSs(*cu->slice, true, cu->slice->getAlfEnabledFlag(COMPONENT_Cb) || cu->slice->getAlfEnabledFlag(COMPONENT_Cr), false);
+        m_alfCtuFilterIndex = cu->slice->getPic()->getAlfCtbFilterIndex();
         m_ccAlfFilterParam = cu->slice->m_ccAlfFilterParam;
       }
-      lastSliceIdx = cu->slice->getSliceID();
+      m_lastSliceIdx = cu->slice->getSliceID();
 
       const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
       const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
@@ -502,7 +563,7 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
               const Area blkSrc( 0, 0, w, h );
               const Area blkDst( xStart, yStart, w, h );
               deriveClassification( m_classifier, buf.get(COMPONENT_Y), blkDst, blkSrc );
-              short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+              short filterSetIndex = m_alfCtuFilterIndex[ctuIdx];
               short *coeff;
               Pel *clip;
               if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
@@ -566,7 +627,7 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
         {
           Area blk( xPos, yPos, width, height );
           deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk, blk );
-          short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+          short filterSetIndex = m_alfCtuFilterIndex[ctuIdx];
           short *coeff;
           Pel *clip;
           if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
@@ -617,19 +678,21 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
       ctuIdx++;
     }
   }
+
+  return lastSlice;
 }
 
-void AdaptiveLoopFilter::reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo)
+void AdaptiveLoopFilter::reconstructCoeffAPSs(Slice& slice, bool luma, bool chroma, bool isRdo)
 {
   //luma
-  APS** aps = cs.slice->getAlfAPSs();
+  APS** aps = slice.getAlfAPSs();
   AlfParam alfParamTmp;
   APS* curAPS;
   if (luma)
   {
-    for (int i = 0; i < cs.slice->getNumAlfApsIdsLuma(); i++)
+    for (int i = 0; i < slice.getNumAlfApsIdsLuma(); i++)
     {
-      int apsIdx = cs.slice->getAlfApsIdsLuma()[i];
+      int apsIdx = slice.getAlfApsIdsLuma()[i];
       curAPS = aps[apsIdx];
       CHECK(curAPS == NULL, "invalid APS");
       alfParamTmp = curAPS->getAlfAPSParam();
@@ -642,7 +705,7 @@ void AdaptiveLoopFilter::reconstructCoeffAPSs(CodingStructure& cs, bool luma, bo
   //chroma
   if (chroma)
   {
-    int apsIdxChroma = cs.slice->getAlfApsIdChroma();
+    int apsIdxChroma = slice.getAlfApsIdChroma();
     curAPS = aps[apsIdxChroma];
     m_alfParamChroma = &curAPS->getAlfAPSParam();
     alfParamTmp = *m_alfParamChroma;
@@ -82,9 +82,14 @@ public:
 
   AdaptiveLoopFilter();
   virtual ~AdaptiveLoopFilter() {}
-  void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo);
+  void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo) { reconstructCoeffAPSs(*cs.slice, luma, chroma, isRdo); }
+  void reconstructCoeffAPSs(Slice& slice, bool luma, bool chroma, bool isRdo);
   void reconstructCoeff(AlfParam& alfParam, ChannelType channel, const bool isRdo, const bool isRedo = false);
   void ALFProcess(CodingStructure& cs);
+  /// prepare the CTU row wise ALF of a picture
+  void ALFPrepareCtuRows(CodingStructure& cs);
+  /// ALF of one CTU row, the rows have to be processed in order and the SAO of the row below has to be finished
+  void ALFProcessCtuRow(CodingStructure& cs, const int ctuRow);
   void create( const int picWidth, const int picHeight, const ChromaFormat format, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
   static void deriveClassificationBlk(AlfClassifier **classifier, int **laplacian[NUM_DIRECTIONS],
@@ -131,6 +136,7 @@ public:
 
 protected:
   bool isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad );
+  Slice* xFilterCtuRows( CodingStructure& cs, const int ctuRowStart, const int ctuRowEnd );
   static constexpr int   m_scaleBits = 7; // 8-bits
   CcAlfFilterParam       m_ccAlfFilterParam;
   uint8_t*               m_ccAlfFilterControl[2];
@@ -172,6 +178,8 @@ protected:
   int                          m_alfVBChmaCTUHeight;
   ChromaFormat                 m_chromaFormat;
   ClpRngs                      m_clpRngs;
+  short*                       m_alfCtuFilterIndex;
+  uint32_t                     m_lastSliceIdx;
 };
 
 #endif
@@ -349,6 +349,8 @@ PelBufferOps::PelBufferOps()
   profGradFilter = gradFilterCore <false>;
   applyPROF      = applyPROFCore;
   roundIntVector = nullptr;
+  mctfInterp     = mctfInterpCore;
+  mctfSse        = mctfSseCore;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -387,6 +389,68 @@ void paddingCore(Pel *ptr, int stride, int width, int height, int padSize)
     memcpy(ptrTemp2 + (i * stride), (ptrTemp2), numBytes);
   }
 }
+
+/** separable 6-tap interpolation of the motion compensated temporal filter
+    the taps 1..6 of the 8-tap filters are applied, the horizontal stage is kept at full precision
+    \param src  integer position of the top-left sample of the block
+ */
+void mctfInterpCore(const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, const Pel maxVal)
+{
+  CHECKD( width > 64 || height > 64, "Block size not supported" );
+  int tempArray[64 + 6][64];
+
+  const Pel* srcRow = src - 2 * srcStride - 2;
+  for (int y = 0; y < height + 5; y++, srcRow += srcStride)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Pel* rowStart = srcRow + x;
+      int sum = 0;
+      sum += xFilter[1] * rowStart[0];
+      sum += xFilter[2] * rowStart[1];
+      sum += xFilter[3] * rowStart[2];
+      sum += xFilter[4] * rowStart[3];
+      sum += xFilter[5] * rowStart[4];
+      sum += xFilter[6] * rowStart[5];
+      tempArray[y][x] = sum;
+    }
+  }
+
+  for (int y = 0; y < height; y++, dst += dstStride)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      int sum = 0;
+      sum += yFilter[1] * tempArray[y    ][x];
+      sum += yFilter[2] * tempArray[y + 1][x];
+      sum += yFilter[3] * tempArray[y + 2][x];
+      sum += yFilter[4] * tempArray[y + 3][x];
+      sum += yFilter[5] * tempArray[y + 4][x];
+      sum += yFilter[6] * tempArray[y + 5][x];
+      sum = (sum + (1 << 11)) >> 12;
+      dst[x] = sum < 0 ? 0 : (sum > maxVal ? maxVal : sum);
+    }
+  }
+}
+
+/** sum of squared differences, stops after the first row at which maxError is exceeded */
+int mctfSseCore(const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, const int maxError)
+{
+  int error = 0;
+  for (int y = 0; y < height; y++, org += orgStride, cur += curStride)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const int diff = org[x] - cur[x];
+      error += diff * diff;
+    }
+    if (error > maxError)
+    {
+      return error;
+    }
+  }
+  return error;
+}
 template<>
 void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBuf<const Pel> &other2, const ClpRng& clpRng, const int8_t bcwIdx)
 {
@@ -760,7 +824,11 @@ void AreaBuf<Pel>::subtract( const Pel val )
 #endif
 
 
+thread_local PelMemoryAccount* PelStorage::s_memoryAccount = nullptr;
+
 PelStorage::PelStorage()
+  : m_memoryAccount( nullptr )
+  , m_memorySize   ( 0 )
 {
   for( uint32_t i = 0; i < MAX_NUM_COMPONENT; i++ )
   {
@@ -785,6 +853,7 @@ void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, c
   chromaFormat = _chromaFormat;
 
   const uint32_t numCh = getNumberValidComponents( _chromaFormat );
+  m_memorySize = 0;
 
   unsigned extHeight = _area.height;
   unsigned extWidth  = _area.width;
@@ -818,9 +887,16 @@ void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, c
     CHECK( !area, "Trying to create a buffer with zero area" );
 
     m_origin[i] = ( Pel* ) xMalloc( Pel, area );
+    m_memorySize += area * sizeof( Pel );
     Pel* topLeft = m_origin[i] + totalWidth * ymargin + xmargin;
     bufs.push_back( PelBuf( topLeft, totalWidth, _area.width >> scaleX, _area.height >> scaleY ) );
   }
+
+  m_memoryAccount = s_memoryAccount;
+  if( m_memoryAccount )
+  {
+    m_memoryAccount->add( m_memorySize );
+  }
 }
 
 void PelStorage::createFromBuf( PelUnitBuf buf )
@@ -853,6 +929,8 @@ void PelStorage::swap( PelStorage& other )
     std::swap( bufs[i].stride, other.bufs[i].stride );
     std::swap( m_origin[i],    other.m_origin[i] );
   }
+  std::swap( m_memoryAccount, other.m_memoryAccount );
+  std::swap( m_memorySize,    other.m_memorySize );
 }
 
 void PelStorage::destroy()
@@ -866,6 +944,12 @@ void PelStorage::destroy()
       m_origin[i] = nullptr;
     }
   }
+  if( m_memoryAccount )
+  {
+    m_memoryAccount->sub( m_memorySize );
+    m_memoryAccount = nullptr;
+  }
+  m_memorySize = 0;
   bufs.clear();
 }
 
@@ -44,6 +44,7 @@
 #include "MotionInfo.h"
 
 #include <string.h>
+#include <atomic>
 #include <type_traits>
 #include <typeinfo>
 
@@ -83,12 +84,16 @@ struct PelBufferOps
   void (*profGradFilter) (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, const int bitDepth);
   void (*applyPROF)      (Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, const Pel* gradX, const Pel* gradY, int gradStride, const int* dMvX, const int* dMvY, int dMvStride, const bool& bi, int shiftNum, Pel offset, const ClpRng& clpRng);
   void (*roundIntVector) (int* v, int size, unsigned int nShift, const int dmvLimit);
+  void (*mctfInterp)     (const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, const Pel maxVal);
+  int  (*mctfSse)        (const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, const int maxError);
 };
 
 extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
+void mctfInterpCore(const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, const Pel maxVal);
+int  mctfSseCore(const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, const int maxError);
 
 template<typename T>
 struct AreaBuf : public Size
@@ -1005,8 +1010,26 @@ const UnitBuf<const T> UnitBuf<T>::subBuf( const UnitArea& subArea ) const
 struct UnitArea;
 struct CompArea;
 
+// pel buffer memory accounted to one encoder session
+struct PelMemoryAccount
+{
+  std::atomic<size_t> current{ 0 };
+  std::atomic<size_t> peak   { 0 };
+
+  void add( size_t size )
+  {
+    const size_t now = current += size;
+    size_t prev = peak;
+    while( now > prev && !peak.compare_exchange_weak( prev, now ) );
+  }
+  void sub( size_t size ) { current -= size; }
+};
+
 struct PelStorage : public PelUnitBuf
 {
+  // storages created by the calling thread are accounted to the given account (nullptr: none)
+  static void setThreadMemoryAccount( PelMemoryAccount* account ) { s_memoryAccount = account; }
+
   PelStorage();
   ~PelStorage();
 
@@ -1029,6 +1052,10 @@ struct PelStorage : public PelUnitBuf
 private:
 
   Pel *m_origin[MAX_NUM_COMPONENT];
+  PelMemoryAccount* m_memoryAccount;
+  size_t            m_memorySize;
+
+  static thread_local PelMemoryAccount* s_memoryAccount;
 };
 
 struct CompStorage : public PelBuf
@@ -44,8 +44,6 @@
 #include "UnitPartitioner.h"
 
 
-XUCache g_globalUnitCache = XUCache();
-
 const UnitScale UnitScaleArray[NUM_CHROMA_FORMAT][MAX_NUM_COMPONENT] =
 {
   { {2,2}, {0,0}, {0,0} },  // 4:0:0
@@ -71,6 +69,7 @@ CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tu
   , tmpColorSpaceCost(MAX_DOUBLE)
   , firstColorSpaceSelected(true)
   , resetIBCBuffer (false)
+  , m_ctuSizedPredResi( true )
 {
   for( uint32_t i = 0; i < MAX_NUM_COMPONENT; i++ )
   {
@@ -962,12 +961,13 @@ CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType effCh
 {
   const CompArea &_blk = area.blocks[effChType];
 
-  if( !_blk.contains( pos ) || (treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
+  // the tree type of the picture level structure is not read, the decoder changes it while parsing and the CTUs are
+  // reconstructed in parallel
+  if( !_blk.contains( pos ) || ( parent && treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA ) )
   {
     //keep this check, which is helpful to identify bugs
-    if( treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
+    if( parent && treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
     {
-      CHECK( parent == nullptr, "parent shall be valid; consider using function getLumaCU()" );
       CHECK( parent->treeType != TREE_D, "wrong parent treeType " );
     }
     if (parent)
@@ -998,11 +998,10 @@ const CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType
 {
   const CompArea &_blk = area.blocks[effChType];
 
-  if( !_blk.contains( pos ) || (treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
+  if( !_blk.contains( pos ) || ( parent && treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA ) )
   {
-    if( treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
+    if( parent && treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
     {
-      CHECK( parent == nullptr, "parent shall be valid; consider using function getLumaCU()" );
       CHECK( parent->treeType != TREE_D, "wrong parent treeType" );
     }
     if (parent)
@@ -1603,6 +1602,38 @@ void CodingStructure::createInternals(const UnitArea& _unit, const bool isTopLay
   initStructData();
 }
 
+void CodingStructure::initCtuRowMotionLuts()
+{
+  ctuRowMotionLuts.resize( pcv->heightInCtus * pps->getNumTileColumns() );
+  for( auto &lut : ctuRowMotionLuts )
+  {
+    lut.lut.resize( 0 );
+    lut.lutIbc.resize( 0 );
+  }
+}
+
+LutMotionCand& CodingStructure::getMotionLut( const Position& lumaPos )
+{
+  if( ctuRowMotionLuts.empty() )
+  {
+    return motionLut;
+  }
+  const uint32_t ctuX = lumaPos.x >> pcv->maxCUWidthLog2;
+  const uint32_t ctuY = lumaPos.y >> pcv->maxCUHeightLog2;
+  return ctuRowMotionLuts[ctuY * pps->getNumTileColumns() + pps->ctuToTileCol( ctuX )];
+}
+
+const LutMotionCand& CodingStructure::getMotionLut( const Position& lumaPos ) const
+{
+  if( ctuRowMotionLuts.empty() )
+  {
+    return motionLut;
+  }
+  const uint32_t ctuX = lumaPos.x >> pcv->maxCUWidthLog2;
+  const uint32_t ctuY = lumaPos.y >> pcv->maxCUHeightLog2;
+  return ctuRowMotionLuts[ctuY * pps->getNumTileColumns() + pps->ctuToTileCol( ctuX )];
+}
+
 void CodingStructure::addMiToLut(static_vector<MotionInfo, MAX_NUM_HMVP_CANDS> &lut, const MotionInfo &mi)
 {
   size_t currCnt = lut.size();
@@ -1729,6 +1760,7 @@ void CodingStructure::rebindPicBufs()
   {
     m_reco.destroy();
   }
+  m_ctuSizedPredResi = picture->hasCtuSizedTempBuffers();
   if (!picture->M_BUFS(0, PIC_PREDICTION).bufs.empty())
   {
     m_pred.createFromBuf(picture->M_BUFS(0, PIC_PREDICTION));
@@ -2290,7 +2322,7 @@ PelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &type )
   cFinal.relativeTo( area.blocks[compID] );
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( !parent && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
+  if( !parent && m_ctuSizedPredResi && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
@@ -2324,7 +2356,7 @@ const CPelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &t
   cFinal.relativeTo( area.blocks[compID] );
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( !parent && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
+  if( !parent && m_ctuSizedPredResi && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
@@ -2360,17 +2392,29 @@ const CPelUnitBuf CodingStructure::getBuf( const UnitArea &unit, const PictureTy
   }
 }
 
+// a CTU following the current one in decoding order has nothing coded yet, its part of the index maps is not read as
+// the decoder may be parsing it while the current CTU is reconstructed (units of other tiles are never returned)
+static inline bool isInFollowingCtu( const Position &pos, const Position &curPos, const ChannelType chType, const ChromaFormat chromaFormat, const int ctuSizeBit )
+{
+  const int ctuNbX   = ( pos.x    << getChannelTypeScaleX( chType, chromaFormat ) ) >> ctuSizeBit;
+  const int ctuNbY   = ( pos.y    << getChannelTypeScaleY( chType, chromaFormat ) ) >> ctuSizeBit;
+  const int ctuCurrX = ( curPos.x << getChannelTypeScaleX( chType, chromaFormat ) ) >> ctuSizeBit;
+  const int ctuCurrY = ( curPos.y << getChannelTypeScaleY( chType, chromaFormat ) ) >> ctuSizeBit;
+  return ctuNbY > ctuCurrY || ( ctuNbY == ctuCurrY && ctuNbX > ctuCurrX );
+}
+
 const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const CodingUnit& curCu, const ChannelType _chType ) const
 {
-  const CodingUnit* cu = getCU( pos, _chType );
-  // exists       same slice and tile                  cu precedes curCu in encoding order
-  //                                                  (thus, is either from parent CS in RD-search or its index is lower)
+  const int ctuSizeBit = floorLog2( curCu.cs->sps->getMaxCUWidth() );
+  const CodingUnit* cu = isInFollowingCtu( pos, curCu.blocks[_chType], _chType, curCu.chromaFormat, ctuSizeBit ) ? nullptr : getCU( pos, _chType );
+  // exists       cu precedes curCu in encoding order        same slice and tile
+  //              (thus, is either from parent CS in RD-search or its index is lower)
+  // the order test comes first, units parsed ahead of a reconstruction job must not be read any further
   const bool wavefrontsEnabled = curCu.slice->getSPS()->getEntropyCodingSyncEnabledFlag();
-  int ctuSizeBit = floorLog2(curCu.cs->sps->getMaxCUWidth());
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curCu.chromaFormat );
   int xCurr = curCu.blocks[_chType].x << getChannelTypeScaleX( _chType, curCu.chromaFormat );
   bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
-  if( cu && CU::isSameSliceAndTile( *cu, curCu ) && ( cu->cs != curCu.cs || cu->idx <= curCu.idx ) && addCheck)
+  if( cu && ( cu->cs != curCu.cs || cu->idx <= curCu.idx ) && CU::isSameSliceAndTile( *cu, curCu ) && addCheck)
   {
     return cu;
   }
@@ -2393,15 +2437,15 @@ const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const P
 
 const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, const PredictionUnit& curPu, const ChannelType _chType ) const
 {
-  const PredictionUnit* pu = getPU( pos, _chType );
-  // exists       same slice and tile                  pu precedes curPu in encoding order
-  //                                                  (thus, is either from parent CS in RD-search or its index is lower)
+  const int ctuSizeBit = floorLog2( curPu.cs->sps->getMaxCUWidth() );
+  const PredictionUnit* pu = isInFollowingCtu( pos, curPu.blocks[_chType], _chType, curPu.chromaFormat, ctuSizeBit ) ? nullptr : getPU( pos, _chType );
+  // exists       pu precedes curPu in encoding order        same slice and tile
+  //              (thus, is either from parent CS in RD-search or its index is lower)
   const bool wavefrontsEnabled = curPu.cu->slice->getSPS()->getEntropyCodingSyncEnabledFlag();
-  int ctuSizeBit = floorLog2(curPu.cs->sps->getMaxCUWidth());
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curPu.chromaFormat );
   int xCurr = curPu.blocks[_chType].x << getChannelTypeScaleX( _chType, curPu.chromaFormat );
   bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
-  if( pu && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && ( pu->cs != curPu.cs || pu->idx <= curPu.idx ) && addCheck )
+  if( pu && ( pu->cs != curPu.cs || pu->idx <= curPu.idx ) && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && addCheck )
   {
     return pu;
   }
@@ -2413,15 +2457,15 @@ const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, con
 
 const TransformUnit* CodingStructure::getTURestricted( const Position &pos, const TransformUnit& curTu, const ChannelType _chType ) const
 {
-  const TransformUnit* tu = getTU( pos, _chType );
-  // exists       same slice and tile                  tu precedes curTu in encoding order
-  //                                                  (thus, is either from parent CS in RD-search or its index is lower)
+  const int ctuSizeBit = floorLog2( curTu.cs->sps->getMaxCUWidth() );
+  const TransformUnit* tu = isInFollowingCtu( pos, curTu.blocks[_chType], _chType, curTu.chromaFormat, ctuSizeBit ) ? nullptr : getTU( pos, _chType );
+  // exists       tu precedes curTu in encoding order        same slice and tile
+  //              (thus, is either from parent CS in RD-search or its index is lower)
   const bool wavefrontsEnabled = curTu.cu->slice->getSPS()->getEntropyCodingSyncEnabledFlag();
-  int ctuSizeBit = floorLog2(curTu.cs->sps->getMaxCUWidth());
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curTu.chromaFormat );
   int xCurr = curTu.blocks[_chType].x << getChannelTypeScaleX( _chType, curTu.chromaFormat );
   bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
-  if( tu && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && ( tu->cs != curTu.cs || tu->idx <= curTu.idx ) && addCheck )
+  if( tu && ( tu->cs != curTu.cs || tu->idx <= curTu.idx ) && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && addCheck )
   {
     return tu;
   }
@@ -65,7 +65,6 @@ enum PictureType
   PIC_FILTERED_ORIGINAL_INPUT,
   NUM_PIC_TYPES
 };
-extern XUCache g_globalUnitCache;
 
 // ---------------------------------------------------------------------------
 // coding structure
@@ -228,7 +227,11 @@ public:
   std::vector< TransformUnit*> tus;
 
   LutMotionCand motionLut;
+  std::vector<LutMotionCand> ctuRowMotionLuts;    ///< HMVP tables of the CTU rows of each tile, used instead of motionLut when CTU rows are reconstructed in parallel
 
+  void initCtuRowMotionLuts();
+  LutMotionCand&       getMotionLut( const Position& lumaPos );
+  const LutMotionCand& getMotionLut( const Position& lumaPos ) const;
   void addMiToLut(static_vector<MotionInfo, MAX_NUM_HMVP_CANDS>& lut, const MotionInfo &mi);
 
   PLTBuf prevPLT;
@@ -260,6 +263,7 @@ private:
   PelStorage m_resi;
   PelStorage m_reco;
   PelStorage m_orgr;
+  bool       m_ctuSizedPredResi;  ///< the prediction and residual buffers of the picture are addressed modulo the CTU size
 
   TCoeff *m_coeffs [ MAX_NUM_COMPONENT ];
   Pel    *m_pcmbuf [ MAX_NUM_COMPONENT ];
@@ -140,6 +140,8 @@ static const double MAX_DOUBLE =                             1.7e+308; ///< max.
 // Most of these should not be changed - they resolve the meaning of otherwise magic numbers.
 
 static const int MAX_GOP =                                         64; ///< max. value of hierarchical GOP size
+static const int PARL_SPLIT_MAX_NUM_JOBS =                          6; ///< max. number of parallel split jobs: no split, QT, BT_H, BT_V, TT_H, TT_V
+static const int PARL_SPLIT_MIN_SIZE =                            32; ///< min. luma width and height of a CU whose split candidates are evaluated in parallel
 static const int MAX_NUM_REF_PICS =                                29; ///< max. number of pictures used for reference
 static const int MAX_NUM_REF =                                     16; ///< max. number of entries in picture reference list
 static const int MAX_QP =                                          63;
@@ -432,6 +434,11 @@ static const int CHROMA_REFINEMENT_CANDIDATES = 8; /// 8 candidates BV to choose
 static const int IBC_FAST_METHOD_NOINTRA_IBCCBF0 = 0x01;
 static const int IBC_FAST_METHOD_BUFFERBV = 0X02;
 static const int IBC_FAST_METHOD_ADAPTIVE_SEARCHRANGE = 0X04;
+static const int ME_PYRAMID_LEVELS = 2; ///< number of subsampled levels of the reference pictures for the hierarchical motion estimation
+static const int ME_CACHE_NUM_CANDS = 3; ///< maximum number of cached motion vectors of overlapping blocks tested as TZ search start points
+static const int ME_CACHE_SEARCH_RANGE = 8; ///< TZ search range around a cached motion vector of an enclosing block
+static const int MC_WINDOW_MARGIN = 8; ///< integer-pel margin around the block of the interpolation windows shared by MMVD candidates
+static const int MC_NUM_WINDOWS = 4; ///< number of interpolation windows kept for the MMVD candidates of a block
 static constexpr int MV_EXPONENT_BITCOUNT    = 4;
 static constexpr int MV_MANTISSA_BITCOUNT    = 6;
 static constexpr int MV_MANTISSA_UPPER_LIMIT = ((1 << (MV_MANTISSA_BITCOUNT - 1)) - 1);
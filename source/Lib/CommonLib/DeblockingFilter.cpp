@@ -94,6 +94,12 @@ static bool isAvailableAbove( const CodingUnit& cu, const CodingUnit& cu2, const
 
 DeblockingFilter::DeblockingFilter()
 {
+  m_pelFilterLumaLines   = xPelFilterLumaLines;
+  m_pelFilterChromaLines = xPelFilterChromaLines;
+
+#if ENABLE_SIMD_OPT_DBLF && defined( TARGET_SIMD_X86 )
+  initDeblockingFilterX86();
+#endif
 }
 
 DeblockingFilter::~DeblockingFilter()
@@ -161,37 +167,8 @@ void DeblockingFilter::deblockingFilterPic( CodingStructure& cs
   {
     for( int x = 0; x < pcv.widthInCtus; x++ )
     {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-      memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-      memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-      memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_VER );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
-      }
+      cs.slice = cs.getCU( Position( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2 ), CH_L )->slice;
+      xDeblockCtu( cs, x, y, EDGE_VER );
     }
   }
 
@@ -200,37 +177,8 @@ void DeblockingFilter::deblockingFilterPic( CodingStructure& cs
   {
     for( int x = 0; x < pcv.widthInCtus; x++ )
     {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-      memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-      memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-      memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_HOR );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_HOR );
-        }
-      }
+      cs.slice = cs.getCU( Position( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2 ), CH_L )->slice;
+      xDeblockCtu( cs, x, y, EDGE_HOR );
     }
   }
 
@@ -253,10 +201,70 @@ void DeblockingFilter::resetFilterLengths()
   memset(m_transformEdge, false, sizeof(m_transformEdge));
 }
 
+void DeblockingFilter::deblockingFilterCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  m_shiftHor = ::getComponentScaleX( COMPONENT_Cb, cs.pcv->chrFormat );
+  m_shiftVer = ::getComponentScaleY( COMPONENT_Cb, cs.pcv->chrFormat );
+
+  // the horizontal edges of a CTU row only read the vertically filtered samples of the row itself and the already
+  // finished row above, so filtering row by row gives the same result as the picture-level edge order
+  for( int x = 0; x < pcv.widthInCtus; x++ )
+  {
+    xDeblockCtu( cs, x, ctuRow, EDGE_VER );
+  }
+  for( int x = 0; x < pcv.widthInCtus; x++ )
+  {
+    xDeblockCtu( cs, x, ctuRow, EDGE_HOR );
+  }
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
 
+/**
+ Deblocking of the edges of one direction in a CTU
+
+ \param ctuX             horizontal CTU position
+ \param ctuY             vertical CTU position
+ \param edgeDir          the direction of the edges
+*/
+void DeblockingFilter::xDeblockCtu( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+  memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+  memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
+  memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
+  memset( m_transformEdge, false, sizeof(m_transformEdge) );
+  m_ctuXLumaSamples = ctuX << pcv.maxCUWidthLog2;
+  m_ctuYLumaSamples = ctuY << pcv.maxCUHeightLog2;
+
+  const UnitArea ctuArea( pcv.chrFormat, Area( ctuX << pcv.maxCUWidthLog2, ctuY << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
+
+  // CU-based deblocking
+  for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+  {
+    xDeblockCU( currCU, edgeDir );
+  }
+
+  if( CS::isDualITree( cs ) )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+    memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
+    memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
+    memset( m_transformEdge, false, sizeof(m_transformEdge) );
+
+    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
+    {
+      xDeblockCU( currCU, edgeDir );
+    }
+  }
+}
+
 /**
  Deblocking filter process in CU-based (the same function as conventional's)
 
@@ -946,7 +954,7 @@ void DeblockingFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeD
   const Slice   &slice    = *(cu.slice);
   const bool    spsPaletteEnabledFlag          = sps.getPLTMode();
   const int     bitDepthLuma                   = sps.getBitDepth(CHANNEL_TYPE_LUMA);
-  const ClpRng& clpRng( cu.cs->slice->clpRng(COMPONENT_Y) );
+  const ClpRng& clpRng( slice.clpRng(COMPONENT_Y) );
 
   int          iQP          = 0;
   unsigned     uiNumParts   = ( ( ( edgeDir == EDGE_VER ) ? lumaArea.height / pcv.minCUHeight : lumaArea.width / pcv.minCUWidth ) );
@@ -1125,10 +1133,7 @@ void DeblockingFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeD
             if (swL)
             {
               useLongtapFilter = true;
-              for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-              {
-                xPelFilterLuma(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
-              }
+              m_pelFilterLumaLines(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4), iOffset, iSrcStep, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
             }
 
           }
@@ -1167,11 +1172,8 @@ void DeblockingFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeD
                    && xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + 3), iOffset, 2 * d3,
                                           iBeta, iTc);
             }
-            for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-            {
-              xPelFilterLuma(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, sw,
-                             bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng);
-            }
+            m_pelFilterLumaLines(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4), iOffset, iSrcStep, iTc, sw,
+                                 bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng, false, false, 7, 7);
           }
         }
       }
@@ -1311,7 +1313,7 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdge
       {
         if ((bS[chromaIdx] == 2) || (largeBoundary && (bS[chromaIdx] == 1)))
         {
-          const ClpRng &clpRng(cu.cs->slice->clpRng(ComponentID(chromaIdx + 1)));
+          const ClpRng &clpRng(slice.clpRng(ComponentID(chromaIdx + 1)));
           Pel *         piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
 
           const TransformUnit &tuQ = *cuQ.cs->getTU(
@@ -1369,20 +1371,16 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdge
                                 piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength + ((subSamplingShift == 1) ? 1 : 3)),
                                 iOffset, 2 * d3, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary);
 
-              for (unsigned step = 0; step < uiLoopLength; step++)
-              {
-                xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, sw,
-                                 bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-              }
+              m_pelFilterChromaLines(piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength), iOffset, iSrcStep, uiLoopLength,
+                                     iTc, sw, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary,
+                                     isChromaHorCTBBoundary);
             }
           }
           if (!useLongFilter)
           {
-            for (unsigned step = 0; step < uiLoopLength; step++)
-            {
-              xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, false,
-                               bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-            }
+            m_pelFilterChromaLines(piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength), iOffset, iSrcStep, uiLoopLength,
+                                   iTc, false, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary,
+                                   isChromaHorCTBBoundary);
           }
         }
       }
@@ -1406,7 +1404,7 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdge
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void DeblockingFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc) const
+inline void DeblockingFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc)
 {
   const char tc7[7] = { 6, 5, 4, 3, 2, 1, 1 };
   const char tc3[3] = { 6, 4, 2 };
@@ -1430,7 +1428,7 @@ inline void DeblockingFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset,
   }
 }
 
-inline void DeblockingFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc) const
+inline void DeblockingFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc)
 {
   CHECK(numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function");
   Pel* srcP = src-offset;
@@ -1504,7 +1502,7 @@ inline void DeblockingFilter::xFilteringPandQ(Pel* src, int offset, int numberPS
   xBilinearFilter(srcP,srcQ,offset,refMiddle,refP,refQ,numberPSide,numberQSide,dbCoeffsP,dbCoeffsQ,tc);
 }
 
-inline void DeblockingFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ) const
+inline void DeblockingFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ)
 {
   int delta;
 
@@ -1604,7 +1602,7 @@ inline void DeblockingFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, cons
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void DeblockingFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const
+inline void DeblockingFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary)
 {
   int delta;
 
@@ -1664,6 +1662,22 @@ inline void DeblockingFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, co
   }
 }
 
+void DeblockingFilter::xPelFilterLumaLines(Pel* piSrc, const int iOffset, const int step, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ)
+{
+  for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++, piSrc += step)
+  {
+    xPelFilterLuma(piSrc, iOffset, tc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterSecondP, bFilterSecondQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
+  }
+}
+
+void DeblockingFilter::xPelFilterChromaLines(Pel* piSrc, const int iOffset, const int step, const int numLines, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary)
+{
+  for (int i = 0; i < numLines; i++, piSrc += step)
+  {
+    xPelFilterChroma(piSrc, iOffset, tc, sw, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
+  }
+}
+
 /**
  - Decision between strong and weak filter
  .
@@ -89,10 +89,24 @@ private:
                                                const TransformUnit &currTU, const int firstComponent);
   void xSetMaxFilterLengthPQForCodingSubBlocks( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const PredictionUnit& currPU, const bool& mvSubBlocks, const int& subBlockSize, const Area& areaPu );
 
-  inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc ) const;
-  inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc ) const;
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;
-  inline void xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const;
+  static inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc );
+  static inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc );
+  static inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 );
+  static inline void xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary);
+
+  /// filter the DEBLOCK_SMALLEST_BLOCK / 2 luma lines of an edge segment, the lines are step samples apart
+  static void xPelFilterLumaLines  ( Pel* piSrc, const int iOffset, const int step, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ );
+  /// filter numLines chroma lines of an edge segment, the lines are step samples apart
+  static void xPelFilterChromaLines( Pel* piSrc, const int iOffset, const int step, const int numLines, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary );
+
+  void ( *m_pelFilterLumaLines )  ( Pel* piSrc, const int iOffset, const int step, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ );
+  void ( *m_pelFilterChromaLines )( Pel* piSrc, const int iOffset, const int step, const int numLines, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary );
+
+#if ENABLE_SIMD_OPT_DBLF && defined( TARGET_SIMD_X86 )
+  void initDeblockingFilterX86();
+  template <X86_VEXT vext>
+  void _initDeblockingFilterX86();
+#endif
   inline bool xUseStrongFiltering(Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7, bool isChromaHorCTBBoundary = false) const;//move the computation outside the function
   inline unsigned BsSet(unsigned val, const ComponentID compIdx) const;
   inline unsigned BsGet(unsigned val, const ComponentID compIdx) const;
@@ -105,6 +119,8 @@ private:
   static const uint16_t sm_tcTable[MAX_QP + 3];
   static const uint8_t sm_betaTable[MAX_QP + 1];
 
+  void xDeblockCtu                 ( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir );
+
 public:
 
   DeblockingFilter();
@@ -121,6 +137,8 @@ public:
 
   /// picture-level deblocking filter
   void deblockingFilterPic        ( CodingStructure& cs );
+  /// deblocking filter of one CTU row, the rows have to be processed in order and the row below has to be reconstructed
+  void deblockingFilterCtuRow     ( CodingStructure& cs, const int ctuRow );
 
   static int getBeta              ( const int qp )
   {
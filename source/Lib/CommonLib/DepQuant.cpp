@@ -37,6 +37,7 @@
 #include "UnitTools.h"
 
 #include <bitset>
+#include <mutex>
 
 #include "ContextModelling.h"
 
@@ -68,8 +69,6 @@ namespace DQIntern
   };
 
 
-  enum ScanPosType { SCAN_ISCSBB = 0, SCAN_SOCSBB = 1, SCAN_EOCSBB = 2 };
-
   struct ScanInfo
   {
     ScanInfo() {}
@@ -131,7 +130,8 @@ namespace DQIntern
   public:
     Rom() : m_scansInitialized(false) {}
     ~Rom() { xUninitScanArrays(); }
-    void                init        ()                       { xInitScanArrays(); }
+    // the tables are shared by all encoder instances in the process
+    void                init        ()                       { std::call_once( m_initFlag, [this] { xInitScanArrays(); } ); }
     const NbInfoSbb*    getNbInfoSbb( int hd, int vd ) const { return m_scanId2NbInfoSbbArray[hd][vd]; }
     const NbInfoOut*    getNbInfoOut( int hd, int vd ) const { return m_scanId2NbInfoOutArray[hd][vd]; }
     const TUParameters* getTUPars   ( const CompArea& area, const ComponentID compID ) const
@@ -143,6 +143,7 @@ namespace DQIntern
     void  xUninitScanArrays ();
   private:
     bool          m_scansInitialized;
+    std::once_flag m_initFlag;
     NbInfoSbb*    m_scanId2NbInfoSbbArray[ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ];
     NbInfoOut*    m_scanId2NbInfoOutArray[ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ];
     TUParameters* m_tuParameters         [ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ][ MAX_NUM_CHANNEL_TYPE ];
@@ -600,30 +601,6 @@ namespace DQIntern
 
 
 
-  /*================================================================================*/
-  /*=====                                                                      =====*/
-  /*=====   D A T A   S T R U C T U R E S                                      =====*/
-  /*=====                                                                      =====*/
-  /*================================================================================*/
-
-
-  struct PQData
-  {
-    TCoeff  absLevel;
-    int64_t deltaDist;
-  };
-
-
-  struct Decision
-  {
-    int64_t rdCost;
-    TCoeff  absLevel;
-    int     prevId;
-  };
-
-
-
-
   /*================================================================================*/
   /*=====                                                                      =====*/
   /*=====   P R E - Q U A N T I Z E R                                          =====*/
@@ -852,14 +829,7 @@ namespace DQIntern
     uint8_t                     m_memory[ 8 * ( MAX_TB_SIZEY * MAX_TB_SIZEY + MLS_GRP_NUM ) ];
   };
 
-#if JVET_V0106_DEP_QUANT_ENC_OPT
-#define RICEMAX 64
-#define RICE_ORDER_MAX 16
   const int32_t g_goRiceBits[RICE_ORDER_MAX][RICEMAX] =
-#else
-#define RICEMAX 32
-  const int32_t g_goRiceBits[4][RICEMAX] =
-#endif
   {
 #if JVET_V0106_DEP_QUANT_ENC_OPT
     { 32768, 65536, 98304, 131072, 163840, 196608, 262144, 262144, 327680, 327680, 327680, 327680, 393216, 393216, 393216, 393216, 393216, 393216, 393216, 393216, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288 },
@@ -890,7 +860,7 @@ namespace DQIntern
   {
     friend class CommonCtx;
   public:
-    State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId );
+    State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId, StateMem& stateMem );
 
     template<uint8_t numIPos>
     inline void updateState(const ScanInfo &scanInfo, const State *prevStates, const Decision &decision, const int baseLevel, const bool extRiceFlag);
@@ -899,148 +869,28 @@ namespace DQIntern
 
     inline void init()
     {
-      m_rdCost        = std::numeric_limits<int64_t>::max()>>1;
-      m_numSigSbb     = 0;
-      m_remRegBins    = 4;  // just large enough for last scan pos
+      m_mem.rdCost    [m_stateId] = std::numeric_limits<int64_t>::max()>>1;
+      m_mem.numSigSbb [m_stateId] = 0;
+      m_mem.remRegBins[m_stateId] = 4;  // just large enough for last scan pos
       m_refSbbCtxId   = -1;
-      m_sigFracBits   = m_sigFracBitsArray[ 0 ];
-      m_coeffFracBits = m_gtxFracBitsArray[ 0 ];
-      m_goRicePar     = 0;
-      m_goRiceZero    = 0;
-    }
-    void checkRdCosts( const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, Decision& decisionA, Decision& decisionB ) const
-    {
-      const int32_t*  goRiceTab = g_goRiceBits[m_goRicePar];
-      int64_t         rdCostA   = m_rdCost + pqDataA.deltaDist;
-      int64_t         rdCostB   = m_rdCost + pqDataB.deltaDist;
-      int64_t         rdCostZ   = m_rdCost;
-      if (m_remRegBins >= 4)
-      {
-        if (pqDataA.absLevel < 4)
-        {
-          rdCostA += m_coeffFracBits.bits[pqDataA.absLevel];
-        }
-        else
-        {
-          const TCoeff value = (pqDataA.absLevel - 4) >> 1;
-          rdCostA +=
-            m_coeffFracBits.bits[pqDataA.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
-        }
-        if (pqDataB.absLevel < 4)
-        {
-          rdCostB += m_coeffFracBits.bits[pqDataB.absLevel];
-        }
-        else
-        {
-          const TCoeff value = (pqDataB.absLevel - 4) >> 1;
-          rdCostB +=
-            m_coeffFracBits.bits[pqDataB.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
-        }
-        if (spt == SCAN_ISCSBB)
-        {
-          rdCostA += m_sigFracBits.intBits[1];
-          rdCostB += m_sigFracBits.intBits[1];
-          rdCostZ += m_sigFracBits.intBits[0];
-        }
-        else if (spt == SCAN_SOCSBB)
-        {
-          rdCostA += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[1];
-          rdCostB += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[1];
-          rdCostZ += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[0];
-        }
-        else if (m_numSigSbb)
-        {
-          rdCostA += m_sigFracBits.intBits[1];
-          rdCostB += m_sigFracBits.intBits[1];
-          rdCostZ += m_sigFracBits.intBits[0];
-        }
-        else
-        {
-          rdCostZ = decisionA.rdCost;
-        }
-      }
-      else
-      {
-        rdCostA +=
-          (1 << SCALE_BITS)
-          + goRiceTab[pqDataA.absLevel <= m_goRiceZero ? pqDataA.absLevel - 1
-                                                       : (pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1)];
-        rdCostB +=
-          (1 << SCALE_BITS)
-          + goRiceTab[pqDataB.absLevel <= m_goRiceZero ? pqDataB.absLevel - 1
-                                                       : (pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1)];
-        rdCostZ += goRiceTab[m_goRiceZero];
-      }
-      if (rdCostA < decisionA.rdCost)
-      {
-        decisionA.rdCost   = rdCostA;
-        decisionA.absLevel = pqDataA.absLevel;
-        decisionA.prevId   = m_stateId;
-      }
-      if (rdCostZ < decisionA.rdCost)
-      {
-        decisionA.rdCost   = rdCostZ;
-        decisionA.absLevel = 0;
-        decisionA.prevId   = m_stateId;
-      }
-      if (rdCostB < decisionB.rdCost)
-      {
-        decisionB.rdCost   = rdCostB;
-        decisionB.absLevel = pqDataB.absLevel;
-        decisionB.prevId   = m_stateId;
-      }
-    }
-
-    inline void checkRdCostStart(int32_t lastOffset, const PQData &pqData, Decision &decision) const
-    {
-      int64_t rdCost = pqData.deltaDist + lastOffset;
-      if (pqData.absLevel < 4)
-      {
-        rdCost += m_coeffFracBits.bits[pqData.absLevel];
-      }
-      else
-      {
-        const TCoeff value = (pqData.absLevel - 4) >> 1;
-        rdCost += m_coeffFracBits.bits[pqData.absLevel - (value << 1)] + g_goRiceBits[m_goRicePar][value < RICEMAX ? value : RICEMAX-1];
-      }
-      if( rdCost < decision.rdCost )
-      {
-        decision.rdCost   = rdCost;
-        decision.absLevel = pqData.absLevel;
-        decision.prevId   = -1;
-      }
+      setSigFracBits  ( m_sigFracBitsArray[ 0 ] );
+      setCoeffFracBits( m_gtxFracBitsArray[ 0 ] );
+      m_mem.goRicePar [m_stateId] = 0;
+      m_mem.goRiceZero[m_stateId] = 0;
     }
 
-    inline void checkRdCostSkipSbb(Decision &decision) const
-    {
-      int64_t rdCost = m_rdCost + m_sbbFracBits.intBits[0];
-      if( rdCost < decision.rdCost )
-      {
-        decision.rdCost   = rdCost;
-        decision.absLevel = 0;
-        decision.prevId   = 4+m_stateId;
-      }
-    }
+    inline const StateMem& mem() const { return m_mem; }
 
-    inline void checkRdCostSkipSbbZeroOut(Decision &decision) const
-    {
-      int64_t rdCost = m_rdCost + m_sbbFracBits.intBits[0];
-      decision.rdCost = rdCost;
-      decision.absLevel = 0;
-      decision.prevId = 4 + m_stateId;
-    }
+  private:
+    inline void setSigFracBits  ( const BinFracBits&   fracBits ) { m_mem.sigBits[m_stateId][0] = fracBits.intBits[0]; m_mem.sigBits[m_stateId][1] = fracBits.intBits[1]; }
+    inline void setSbbFracBits  ( const BinFracBits&   fracBits ) { m_mem.sbbBits[m_stateId][0] = fracBits.intBits[0]; m_mem.sbbBits[m_stateId][1] = fracBits.intBits[1]; }
+    inline void setCoeffFracBits( const CoeffFracBits& fracBits ) { ::memcpy( m_mem.coeffBits[m_stateId], fracBits.bits, sizeof( fracBits.bits ) ); }
+    inline void copySbbFracBits ( const State&         other    ) { m_mem.sbbBits[m_stateId][0] = other.m_mem.sbbBits[other.m_stateId][0]; m_mem.sbbBits[m_stateId][1] = other.m_mem.sbbBits[other.m_stateId][1]; }
 
   private:
-    int64_t                   m_rdCost;
+    StateMem&                 m_mem;
     uint16_t                  m_absLevelsAndCtxInit[24];  // 16x8bit for abs levels + 16x16bit for ctx init id
-    int8_t                    m_numSigSbb;
-    int                       m_remRegBins;
     int8_t                    m_refSbbCtxId;
-    BinFracBits               m_sbbFracBits;
-    BinFracBits               m_sigFracBits;
-    CoeffFracBits             m_coeffFracBits;
-    int8_t                    m_goRicePar;
-    int8_t                    m_goRiceZero;
     const int8_t              m_stateId;
     const BinFracBits*const   m_sigFracBitsArray;
     const CoeffFracBits*const m_gtxFracBitsArray;
@@ -1076,48 +926,54 @@ namespace DQIntern
     return g_riceShift[rangeIdx];
   }
 
-  State::State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId )
-    : m_sbbFracBits     { { 0, 0 } }
+  State::State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId, StateMem& stateMem )
+    : m_mem             ( stateMem )
     , m_stateId         ( stateId )
     , m_sigFracBitsArray( rateEst.sigFlagBits(stateId) )
     , m_gtxFracBitsArray( rateEst.gtxFracBits(stateId) )
     , m_commonCtx       ( commonCtx )
   {
+    m_mem.sbbBits[m_stateId][0] = 0;
+    m_mem.sbbBits[m_stateId][1] = 0;
   }
 
   template<uint8_t numIPos>
   inline void State::updateState(const ScanInfo &scanInfo, const State *prevStates, const Decision &decision, const int baseLevel, const bool extRiceFlag)
   {
-    m_rdCost = decision.rdCost;
+    const int s       = m_stateId;
+    int32_t&  remRegBins = m_mem.remRegBins[s];
+    int32_t&  goRicePar  = m_mem.goRicePar [s];
+    m_mem.rdCost[s]   = decision.rdCost;
     if( decision.prevId > -2 )
     {
       if( decision.prevId >= 0 )
       {
-        const State*  prvState  = prevStates            +   decision.prevId;
-        m_numSigSbb             = prvState->m_numSigSbb + !!decision.absLevel;
-        m_refSbbCtxId           = prvState->m_refSbbCtxId;
-        m_sbbFracBits           = prvState->m_sbbFracBits;
-        m_remRegBins            = prvState->m_remRegBins - 1;
-        m_goRicePar             = prvState->m_goRicePar;
-        if( m_remRegBins >= 4 )
+        const State*    prvState  = prevStates            +   decision.prevId;
+        const StateMem& prvMem    = prvState->m_mem;
+        m_mem.numSigSbb[s]        = prvMem.numSigSbb[decision.prevId] + !!decision.absLevel;
+        m_refSbbCtxId             = prvState->m_refSbbCtxId;
+        copySbbFracBits( *prvState );
+        remRegBins                = prvMem.remRegBins[decision.prevId] - 1;
+        goRicePar                 = prvMem.goRicePar [decision.prevId];
+        if( remRegBins >= 4 )
         {
-          m_remRegBins -= (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
+          remRegBins -= (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
         }
         ::memcpy( m_absLevelsAndCtxInit, prvState->m_absLevelsAndCtxInit, 48*sizeof(uint8_t) );
       }
       else
       {
-        m_numSigSbb     =  1;
-        m_refSbbCtxId   = -1;
+        m_mem.numSigSbb[s] =  1;
+        m_refSbbCtxId      = -1;
         int ctxBinSampleRatio = (scanInfo.chType == CHANNEL_TYPE_LUMA) ? MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_LUMA : MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_CHROMA;
-        m_remRegBins = (effWidth * effHeight *ctxBinSampleRatio) / 16 - (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
+        remRegBins = (effWidth * effHeight *ctxBinSampleRatio) / 16 - (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
         ::memset( m_absLevelsAndCtxInit, 0, 48*sizeof(uint8_t) );
       }
 
       uint8_t* levels               = reinterpret_cast<uint8_t*>(m_absLevelsAndCtxInit);
       levels[ scanInfo.insidePos ]  = (uint8_t)std::min<TCoeff>( 255, decision.absLevel );
 
-      if (m_remRegBins >= 4)
+      if (remRegBins >= 4)
       {
         TCoeff  tinit = m_absLevelsAndCtxInit[8 + scanInfo.nextInsidePos];
         TCoeff  sumAbs1 = (tinit >> 3) & 31;
@@ -1155,8 +1011,8 @@ namespace DQIntern
         }
 #undef UPDATE
         TCoeff sumGt1 = sumAbs1 - sumNum;
-        m_sigFracBits = m_sigFracBitsArray[scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 )];
-        m_coeffFracBits = m_gtxFracBitsArray[scanInfo.gtxCtxOffsetNext + (sumGt1 < 4 ? sumGt1 : 4)];
+        setSigFracBits  ( m_sigFracBitsArray[scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 )] );
+        setCoeffFracBits( m_gtxFracBitsArray[scanInfo.gtxCtxOffsetNext + (sumGt1 < 4 ? sumGt1 : 4)] );
 
         TCoeff  sumAbs = m_absLevelsAndCtxInit[8 + scanInfo.nextInsidePos] >> 8;
 #define UPDATE(k) {TCoeff t=levels[scanInfo.nextNbInfoSbb.inPos[k]]; sumAbs+=t; }
@@ -1196,13 +1052,12 @@ namespace DQIntern
           unsigned currentShift = templateAbsCompare(sumAbs);
           sumAbs = sumAbs >> currentShift;
           int sumAll = std::max(std::min(31, (int)sumAbs - (int)baseLevel), 0);
-          m_goRicePar = g_goRiceParsCoeff[sumAll];
-          m_goRicePar += currentShift;
+          goRicePar = int8_t( g_goRiceParsCoeff[sumAll] + currentShift );
         }
         else
         {
           int sumAll = std::max(std::min(31, (int)sumAbs - 4 * 5), 0);
-          m_goRicePar = g_goRiceParsCoeff[sumAll];
+          goRicePar = int8_t( g_goRiceParsCoeff[sumAll] );
         }
       }
       else
@@ -1245,15 +1100,14 @@ namespace DQIntern
           unsigned currentShift = templateAbsCompare(sumAbs);
           sumAbs = sumAbs >> currentShift;
           sumAbs = std::min<TCoeff>(31, sumAbs);
-          m_goRicePar = g_goRiceParsCoeff[sumAbs];
-          m_goRicePar += currentShift;
+          goRicePar = int8_t( g_goRiceParsCoeff[sumAbs] + currentShift );
         }
         else
         {
           sumAbs = std::min<TCoeff>(31, sumAbs);
-          m_goRicePar = g_goRiceParsCoeff[sumAbs];
+          goRicePar = int8_t( g_goRiceParsCoeff[sumAbs] );
         }
-        m_goRiceZero = g_goRicePosCoeff0(m_stateId, m_goRicePar);
+        m_mem.goRiceZero[s] = int8_t( g_goRicePosCoeff0(m_stateId, goRicePar) );
       }
     }
   }
@@ -1261,7 +1115,7 @@ namespace DQIntern
   inline void State::updateStateEOS(const ScanInfo &scanInfo, const State *prevStates, const State *skipStates,
                                     const Decision &decision)
   {
-    m_rdCost = decision.rdCost;
+    m_mem.rdCost[m_stateId] = decision.rdCost;
     if( decision.prevId > -2 )
     {
       const State* prvState = 0;
@@ -1269,18 +1123,18 @@ namespace DQIntern
       {
         CHECK( decision.absLevel != 0, "cannot happen" );
         prvState    = skipStates + ( decision.prevId - 4 );
-        m_numSigSbb = 0;
+        m_mem.numSigSbb[m_stateId] = 0;
         ::memset( m_absLevelsAndCtxInit, 0, 16*sizeof(uint8_t) );
       }
       else if( decision.prevId  >= 0 )
       {
         prvState    = prevStates            +   decision.prevId;
-        m_numSigSbb = prvState->m_numSigSbb + !!decision.absLevel;
+        m_mem.numSigSbb[m_stateId] = prvState->m_mem.numSigSbb[decision.prevId] + !!decision.absLevel;
         ::memcpy( m_absLevelsAndCtxInit, prvState->m_absLevelsAndCtxInit, 16*sizeof(uint8_t) );
       }
       else
       {
-        m_numSigSbb = 1;
+        m_mem.numSigSbb[m_stateId] = 1;
         ::memset( m_absLevelsAndCtxInit, 0, 16*sizeof(uint8_t) );
       }
       reinterpret_cast<uint8_t*>(m_absLevelsAndCtxInit)[ scanInfo.insidePos ] = (uint8_t)std::min<TCoeff>( 255, decision.absLevel );
@@ -1291,8 +1145,8 @@ namespace DQIntern
       TCoeff  sumNum  =   tinit        & 7;
       TCoeff  sumAbs1 = ( tinit >> 3 ) & 31;
       TCoeff  sumGt1  = sumAbs1        - sumNum;
-      m_sigFracBits   = m_sigFracBitsArray[ scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 ) ];
-      m_coeffFracBits = m_gtxFracBitsArray[ scanInfo.gtxCtxOffsetNext + ( sumGt1  < 4 ? sumGt1  : 4 ) ];
+      setSigFracBits  ( m_sigFracBitsArray[ scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 ) ] );
+      setCoeffFracBits( m_gtxFracBitsArray[ scanInfo.gtxCtxOffsetNext + ( sumGt1  < 4 ? sumGt1  : 4 ) ] );
     }
   }
 
@@ -1311,23 +1165,25 @@ namespace DQIntern
       ::memset( sbbFlags,                  0, scanInfo.numSbb*sizeof(uint8_t) );
       ::memset( levels + scanInfo.scanIdx, 0, setCpSize );
     }
-    sbbFlags[ scanInfo.sbbPos ] = !!currState.m_numSigSbb;
+    StateMem&   currMem   = currState.m_mem;
+    const int   currId    = currState.m_stateId;
+    sbbFlags[ scanInfo.sbbPos ] = !!currMem.numSigSbb[currId];
     ::memcpy( levels + scanInfo.scanIdx, currState.m_absLevelsAndCtxInit, scanInfo.sbbSize*sizeof(uint8_t) );
 
     const int       sigNSbb   = ( ( scanInfo.nextSbbRight ? sbbFlags[ scanInfo.nextSbbRight ] : false ) || ( scanInfo.nextSbbBelow ? sbbFlags[ scanInfo.nextSbbBelow ] : false ) ? 1 : 0 );
-    currState.m_numSigSbb     = 0;
+    currMem.numSigSbb[currId] = 0;
     if (prevState)
     {
-      currState.m_remRegBins = prevState->m_remRegBins;
+      currMem.remRegBins[currId] = prevState->m_mem.remRegBins[prevState->m_stateId];
     }
     else
     {
       int ctxBinSampleRatio = (scanInfo.chType == CHANNEL_TYPE_LUMA) ? MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_LUMA : MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_CHROMA;
-      currState.m_remRegBins = (currState.effWidth * currState.effHeight *ctxBinSampleRatio) / 16;
+      currMem.remRegBins[currId] = (currState.effWidth * currState.effHeight *ctxBinSampleRatio) / 16;
     }
-    currState.m_goRicePar     = 0;
+    currMem.goRicePar[currId] = 0;
     currState.m_refSbbCtxId   = currState.m_stateId;
-    currState.m_sbbFracBits   = m_sbbFlagBits[ sigNSbb ];
+    currState.setSbbFracBits( m_sbbFlagBits[ sigNSbb ] );
 
     uint16_t          templateCtxInit[16];
     const int         scanBeg   = scanInfo.scanIdx - scanInfo.sbbSize;
@@ -1370,6 +1226,138 @@ namespace DQIntern
 
 
 
+  /*================================================================================*/
+  /*=====                                                                      =====*/
+  /*=====   T R E L L I S   D E C I S I O N                                    =====*/
+  /*=====                                                                      =====*/
+  /*================================================================================*/
+
+  static inline void checkRdCosts( const StateMem& mem, const int s, const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, Decision& decisionA, Decision& decisionB )
+  {
+    const int32_t*  goRiceTab = g_goRiceBits[mem.goRicePar[s]];
+    const int32_t*  coeffBits = mem.coeffBits[s];
+    int64_t         rdCostA   = mem.rdCost[s] + pqDataA.deltaDist;
+    int64_t         rdCostB   = mem.rdCost[s] + pqDataB.deltaDist;
+    int64_t         rdCostZ   = mem.rdCost[s];
+    if (mem.remRegBins[s] >= 4)
+    {
+      if (pqDataA.absLevel < 4)
+      {
+        rdCostA += coeffBits[pqDataA.absLevel];
+      }
+      else
+      {
+        const TCoeff value = (pqDataA.absLevel - 4) >> 1;
+        rdCostA += coeffBits[pqDataA.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
+      }
+      if (pqDataB.absLevel < 4)
+      {
+        rdCostB += coeffBits[pqDataB.absLevel];
+      }
+      else
+      {
+        const TCoeff value = (pqDataB.absLevel - 4) >> 1;
+        rdCostB += coeffBits[pqDataB.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
+      }
+      if (spt == SCAN_ISCSBB)
+      {
+        rdCostA += mem.sigBits[s][1];
+        rdCostB += mem.sigBits[s][1];
+        rdCostZ += mem.sigBits[s][0];
+      }
+      else if (spt == SCAN_SOCSBB)
+      {
+        rdCostA += mem.sbbBits[s][1] + mem.sigBits[s][1];
+        rdCostB += mem.sbbBits[s][1] + mem.sigBits[s][1];
+        rdCostZ += mem.sbbBits[s][1] + mem.sigBits[s][0];
+      }
+      else if (mem.numSigSbb[s])
+      {
+        rdCostA += mem.sigBits[s][1];
+        rdCostB += mem.sigBits[s][1];
+        rdCostZ += mem.sigBits[s][0];
+      }
+      else
+      {
+        rdCostZ = decisionA.rdCost;
+      }
+    }
+    else
+    {
+      rdCostA +=
+        (1 << SCALE_BITS)
+        + goRiceTab[pqDataA.absLevel <= mem.goRiceZero[s] ? pqDataA.absLevel - 1
+                                                          : (pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1)];
+      rdCostB +=
+        (1 << SCALE_BITS)
+        + goRiceTab[pqDataB.absLevel <= mem.goRiceZero[s] ? pqDataB.absLevel - 1
+                                                          : (pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1)];
+      rdCostZ += goRiceTab[mem.goRiceZero[s]];
+    }
+    if (rdCostA < decisionA.rdCost)
+    {
+      decisionA.rdCost   = rdCostA;
+      decisionA.absLevel = pqDataA.absLevel;
+      decisionA.prevId   = s;
+    }
+    if (rdCostZ < decisionA.rdCost)
+    {
+      decisionA.rdCost   = rdCostZ;
+      decisionA.absLevel = 0;
+      decisionA.prevId   = s;
+    }
+    if (rdCostB < decisionB.rdCost)
+    {
+      decisionB.rdCost   = rdCostB;
+      decisionB.absLevel = pqDataB.absLevel;
+      decisionB.prevId   = s;
+    }
+  }
+
+  static inline void checkRdCostStart( const StateMem& mem, int32_t lastOffset, const PQData &pqData, Decision &decision )
+  {
+    int64_t rdCost = pqData.deltaDist + lastOffset;
+    if (pqData.absLevel < 4)
+    {
+      rdCost += mem.coeffBits[0][pqData.absLevel];
+    }
+    else
+    {
+      const TCoeff value = (pqData.absLevel - 4) >> 1;
+      rdCost += mem.coeffBits[0][pqData.absLevel - (value << 1)] + g_goRiceBits[mem.goRicePar[0]][value < RICEMAX ? value : RICEMAX-1];
+    }
+    if( rdCost < decision.rdCost )
+    {
+      decision.rdCost   = rdCost;
+      decision.absLevel = pqData.absLevel;
+      decision.prevId   = -1;
+    }
+  }
+
+  static inline void checkRdCostSkipSbb( const StateMem& mem, const int s, Decision &decision )
+  {
+    int64_t rdCost = mem.rdCost[s] + mem.sbbBits[s][0];
+    if( rdCost < decision.rdCost )
+    {
+      decision.rdCost   = rdCost;
+      decision.absLevel = 0;
+      decision.prevId   = 4+s;
+    }
+  }
+
+  static inline void checkRdCostSkipSbbZeroOut( const StateMem& mem, const int s, Decision &decision )
+  {
+    decision.rdCost   = mem.rdCost[s] + mem.sbbBits[s][0];
+    decision.absLevel = 0;
+    decision.prevId   = 4+s;
+  }
+
+#define DINIT(l,p) {std::numeric_limits<int64_t>::max()>>2,l,p}
+  static const Decision startDec[8] = {DINIT(-1,-2),DINIT(-1,-2),DINIT(-1,-2),DINIT(-1,-2),DINIT(0,4),DINIT(0,5),DINIT(0,6),DINIT(0,7)};
+#undef  DINIT
+
+
+
   /*================================================================================*/
   /*=====                                                                      =====*/
   /*=====   T C Q                                                              =====*/
@@ -1378,7 +1366,9 @@ namespace DQIntern
   class DepQuant : private RateEstimator
   {
   public:
-    DepQuant();
+    typedef void ( *DecideFunc )( const PQData*, const StateMem&, const StateMem&, const StateMem&, const ScanPosType, const int32_t, Decision* );
+
+    DepQuant( DecideFunc decide );
 
     void    quant   ( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff );
     void    dequant ( const TransformUnit& tu, CoeffBuf& recCoeff, const ComponentID compID, const QpParam& cQP, bool enableScalingLists, int* quantCoeff );
@@ -1391,7 +1381,9 @@ namespace DQIntern
     void    xDecide           ( const ScanPosType spt, const TCoeff absCoeff, const int lastOffset, Decision* decisions, bool zeroOut, TCoeff quantCoeff );
 
   private:
+    DecideFunc  m_decide;
     CommonCtx   m_commonCtx;
+    StateMem    m_stateMem [ 4 ];   // rate data of the current, previous, skip and start states
     State       m_allStates[ 12 ];
     State*      m_currStates;
     State*      m_prevStates;
@@ -1402,15 +1394,17 @@ namespace DQIntern
   };
 
 
-#define TINIT(x) {*this,m_commonCtx,x}
-  DepQuant::DepQuant()
+#define TINIT(x,g) {*this,m_commonCtx,x,m_stateMem[g]}
+  DepQuant::DepQuant( DecideFunc decide )
     : RateEstimator ()
+    , m_decide      ( decide )
     , m_commonCtx   ()
-    , m_allStates   {TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3)}
+    , m_stateMem    ()
+    , m_allStates   {TINIT(0,0),TINIT(1,0),TINIT(2,0),TINIT(3,0),TINIT(0,1),TINIT(1,1),TINIT(2,1),TINIT(3,1),TINIT(0,2),TINIT(1,2),TINIT(2,2),TINIT(3,2)}
     , m_currStates  (  m_allStates      )
     , m_prevStates  (  m_currStates + 4 )
     , m_skipStates  (  m_prevStates + 4 )
-    , m_startState  TINIT(0)
+    , m_startState  TINIT(0,3)
   {}
 #undef TINIT
 
@@ -1421,43 +1415,25 @@ namespace DQIntern
   }
 
 
-#define DINIT(l,p) {std::numeric_limits<int64_t>::max()>>2,l,p}
-  static const Decision startDec[8] = {DINIT(-1,-2),DINIT(-1,-2),DINIT(-1,-2),DINIT(-1,-2),DINIT(0,4),DINIT(0,5),DINIT(0,6),DINIT(0,7)};
-#undef  DINIT
-
-
   void DepQuant::xDecide( const ScanPosType spt, const TCoeff absCoeff, const int lastOffset, Decision* decisions, bool zeroOut, TCoeff quanCoeff)
   {
-    ::memcpy( decisions, startDec, 8*sizeof(Decision) );
-
     if( zeroOut )
     {
+      ::memcpy( decisions, startDec, 8*sizeof(Decision) );
       if( spt==SCAN_EOCSBB )
       {
-        m_skipStates[0].checkRdCostSkipSbbZeroOut( decisions[0] );
-        m_skipStates[1].checkRdCostSkipSbbZeroOut( decisions[1] );
-        m_skipStates[2].checkRdCostSkipSbbZeroOut( decisions[2] );
-        m_skipStates[3].checkRdCostSkipSbbZeroOut( decisions[3] );
+        const StateMem& skipMem = m_skipStates->mem();
+        checkRdCostSkipSbbZeroOut( skipMem, 0, decisions[0] );
+        checkRdCostSkipSbbZeroOut( skipMem, 1, decisions[1] );
+        checkRdCostSkipSbbZeroOut( skipMem, 2, decisions[2] );
+        checkRdCostSkipSbbZeroOut( skipMem, 3, decisions[3] );
       }
       return;
     }
 
     PQData  pqData[4];
     m_quant.preQuantCoeff( absCoeff, pqData, quanCoeff );
-    m_prevStates[0].checkRdCosts( spt, pqData[0], pqData[2], decisions[0], decisions[2]);
-    m_prevStates[1].checkRdCosts( spt, pqData[0], pqData[2], decisions[2], decisions[0]);
-    m_prevStates[2].checkRdCosts( spt, pqData[3], pqData[1], decisions[1], decisions[3]);
-    m_prevStates[3].checkRdCosts( spt, pqData[3], pqData[1], decisions[3], decisions[1]);
-    if( spt==SCAN_EOCSBB )
-    {
-      m_skipStates[0].checkRdCostSkipSbb(decisions[0]);
-      m_skipStates[1].checkRdCostSkipSbb(decisions[1]);
-      m_skipStates[2].checkRdCostSkipSbb(decisions[2]);
-      m_skipStates[3].checkRdCostSkipSbb(decisions[3]);
-    }
-
-    m_startState.checkRdCostStart( lastOffset, pqData[0], decisions[0] );
-    m_startState.checkRdCostStart( lastOffset, pqData[2], decisions[2] );
+    m_decide( pqData, m_prevStates->mem(), m_skipStates->mem(), m_startState.mem(), spt, lastOffset, decisions );
   }
 
   void DepQuant::xDecideAndUpdate( const TCoeff absCoeff, const ScanInfo &scanInfo, bool zeroOut, TCoeff quantCoeff, int effWidth, int effHeight, bool reverseLast )
@@ -1574,6 +1550,20 @@ namespace DQIntern
     }
     const TCoeff defaultQuantisationCoefficient = (TCoeff)m_quant.getQScale();
     const TCoeff thres = m_quant.getLastThreshold();
+    if( !enableScalingLists )
+    {
+      // all-zero early exit: if no coefficient exceeds the threshold for a last position, no start position exists
+      const TCoeff thresTmp = TCoeff( thres / ( 4 * defaultQuantisationCoefficient ) );
+      TCoeff       maxAbs   = 0;
+      for( int k = 0; k < numCoeff; k++ )
+      {
+        maxAbs = std::max<TCoeff>( maxAbs, abs( tCoeff[k] ) );
+      }
+      if( maxAbs <= thresTmp )
+      {
+        return;
+      }
+    }
     for( ; firstTestPos >= 0; firstTestPos-- )
     {
       if (zeroOutforThres && (tuPars.m_scanId2BlkPos[firstTestPos].x >= ((tuPars.m_width == 32 && zeroOut) ? 16 : 32)
@@ -1663,7 +1653,13 @@ DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
 {
   const DepQuant* dq = dynamic_cast<const DepQuant*>( other );
   CHECK( other && !dq, "The DepQuant cast must be successfull!" );
-  p = new DQIntern::DepQuant();
+
+  m_decide = decideCore;
+#if ENABLE_SIMD_OPT_DQ && defined( TARGET_SIMD_X86 )
+  initDepQuantX86();
+#endif
+
+  p = new DQIntern::DepQuant( m_decide );
   if( enc )
   {
     DQIntern::g_Rom.init();
@@ -1704,6 +1700,28 @@ void DepQuant::quant( TransformUnit &tu, const ComponentID &compID, const CCoeff
   }
 }
 
+void DepQuant::decideCore( const DQIntern::PQData* pqData, const DQIntern::StateMem& prevStates, const DQIntern::StateMem& skipStates, const DQIntern::StateMem& startState, const DQIntern::ScanPosType spt, const int32_t lastOffset, DQIntern::Decision* decisions )
+{
+  using namespace DQIntern;
+
+  ::memcpy( decisions, startDec, 8*sizeof(Decision) );
+
+  checkRdCosts( prevStates, 0, spt, pqData[0], pqData[2], decisions[0], decisions[2] );
+  checkRdCosts( prevStates, 1, spt, pqData[0], pqData[2], decisions[2], decisions[0] );
+  checkRdCosts( prevStates, 2, spt, pqData[3], pqData[1], decisions[1], decisions[3] );
+  checkRdCosts( prevStates, 3, spt, pqData[3], pqData[1], decisions[3], decisions[1] );
+  if( spt==SCAN_EOCSBB )
+  {
+    checkRdCostSkipSbb( skipStates, 0, decisions[0] );
+    checkRdCostSkipSbb( skipStates, 1, decisions[1] );
+    checkRdCostSkipSbb( skipStates, 2, decisions[2] );
+    checkRdCostSkipSbb( skipStates, 3, decisions[3] );
+  }
+
+  checkRdCostStart( startState, lastOffset, pqData[0], decisions[0] );
+  checkRdCostStart( startState, lastOffset, pqData[2], decisions[2] );
+}
+
 void DepQuant::dequant( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP )
 {
   const bool useRegularResidualCoding = tu.cu->slice->getTSResidualCodingDisabledFlag() || tu.mtsIdx[compID] != MTS_SKIP;
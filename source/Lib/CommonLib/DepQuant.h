@@ -45,6 +45,45 @@
 
 
 
+namespace DQIntern
+{
+#if JVET_V0106_DEP_QUANT_ENC_OPT
+#define RICEMAX 64
+#define RICE_ORDER_MAX 16
+#else
+#define RICEMAX 32
+#define RICE_ORDER_MAX 4
+#endif
+  extern const int32_t g_goRiceBits[RICE_ORDER_MAX][RICEMAX];
+
+  enum ScanPosType { SCAN_ISCSBB = 0, SCAN_SOCSBB = 1, SCAN_EOCSBB = 2 };
+
+  struct PQData
+  {
+    TCoeff  absLevel;
+    int64_t deltaDist;
+  };
+
+  struct Decision
+  {
+    int64_t rdCost;
+    TCoeff  absLevel;
+    int     prevId;
+  };
+
+  // rate relevant data of the four states of one trellis stage (structure of arrays, one lane per state)
+  struct StateMem
+  {
+    int64_t   rdCost    [4];
+    int32_t   coeffBits [4][8];   // gt1/par/gt2 fraction bits of the levels 0..5 (padded)
+    int32_t   sigBits   [4][2];
+    int32_t   sbbBits   [4][2];
+    int32_t   goRicePar [4];
+    int32_t   goRiceZero[4];
+    int32_t   remRegBins[4];
+    int32_t   numSigSbb [4];
+  };
+}
 
 
 class DepQuant : public QuantRDOQ
@@ -56,6 +95,16 @@ public:
   virtual void quant  ( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx );
   virtual void dequant( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
+  static void decideCore( const DQIntern::PQData* pqData, const DQIntern::StateMem& prevStates, const DQIntern::StateMem& skipStates, const DQIntern::StateMem& startState, const DQIntern::ScanPosType spt, const int32_t lastOffset, DQIntern::Decision* decisions );
+
+  void ( *m_decide )( const DQIntern::PQData* pqData, const DQIntern::StateMem& prevStates, const DQIntern::StateMem& skipStates, const DQIntern::StateMem& startState, const DQIntern::ScanPosType spt, const int32_t lastOffset, DQIntern::Decision* decisions );
+
+#if ENABLE_SIMD_OPT_DQ && defined( TARGET_SIMD_X86 )
+  void initDepQuantX86();
+  template <X86_VEXT vext>
+  void _initDepQuantX86();
+#endif
+
 private:
   void* p;
 };
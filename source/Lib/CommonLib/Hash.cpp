@@ -57,6 +57,7 @@ TCRCCalculatorLight::TCRCCalculatorLight(uint32_t bits, uint32_t truncPoly)
   m_finalResultMask = (1 << bits) - 1;
 
   xInitTable();
+  xInitSliceTable();
 }
 
 TCRCCalculatorLight::~TCRCCalculatorLight()
@@ -94,6 +95,34 @@ void TCRCCalculatorLight::xInitTable()
   }
 }
 
+void TCRCCalculatorLight::xInitSliceTable()
+{
+  for (uint32_t value = 0; value < 256; value++)
+  {
+    m_sliceTable[0][value] = m_table[value] & m_finalResultMask;
+  }
+  for (int k = 1; k < m_maxSliceLength; k++)
+  {
+    for (uint32_t value = 0; value < 256; value++)
+    {
+      const uint32_t remainder = m_sliceTable[k - 1][value];
+      m_sliceTable[k][value] = ((remainder << 8) ^ m_table[(remainder >> (m_bits - 8)) & 0xff]) & m_finalResultMask;
+    }
+  }
+}
+
+uint32_t TCRCCalculatorLight::computeCRC(const unsigned char* curData, uint32_t dataLength) const
+{
+  CHECKD(dataLength > m_maxSliceLength, "Data exceeds the slice tables");
+  // the CRC is linear, each byte contributes its remainder shifted through the zero bytes following it
+  uint32_t remainder = 0;
+  for (uint32_t i = 0; i < dataLength; i++)
+  {
+    remainder ^= m_sliceTable[dataLength - 1 - i][curData[i]];
+  }
+  return remainder;
+}
+
 void TCRCCalculatorLight::processData(unsigned char* curData, uint32_t dataLength)
 {
   for (uint32_t i = 0; i < dataLength; i++)
@@ -107,45 +136,31 @@ void TCRCCalculatorLight::processData(unsigned char* curData, uint32_t dataLengt
 
 TComHash::TComHash()
 {
-  m_lookupTable = NULL;
   tableHasContent = false;
   for (int i = 0; i < 5; i++)
   {
     hashPic[i] = NULL;
   }
+
+  m_blockHash2x2Row = blockHash2x2RowCore;
+  m_blockHashRow    = blockHashRowCore;
+#if ENABLE_SIMD_OPT_HASH && defined( TARGET_SIMD_X86 )
+  initHashX86();
+#endif
 }
 
 TComHash::~TComHash()
 {
   clearAll();
-  if (m_lookupTable != NULL)
-  {
-    delete[] m_lookupTable;
-    m_lookupTable = NULL;
-  }
 }
 
 void TComHash::create(int picWidth, int picHeight)
 {
-  if (m_lookupTable)
-  {
-    clearAll();
-  }
-  if (!hashPic[0])
-  {
-    for (int k = 0; k < 5; k++)
-    {
-      hashPic[k] = new uint16_t[picWidth*picHeight];
-    }
-  }
-  if (m_lookupTable)
+  clearAll();
+  for (int k = 0; k < 5; k++)
   {
-    return;
+    hashPic[k] = new uint16_t[picWidth*picHeight];
   }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  m_lookupTable = new std::vector<BlockHash>*[maxAddr];
-  memset(m_lookupTable, 0, sizeof(std::vector<BlockHash>*) * maxAddr);
-  tableHasContent = false;
 }
 
 void TComHash::clearAll()
@@ -159,83 +174,142 @@ void TComHash::clearAll()
     }
   }
   tableHasContent = false;
-  if (m_lookupTable == NULL)
-  {
-    return;
-  }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  for (int i = 0; i < maxAddr; i++)
+  m_lookupTable.clear();
+}
+
+int TComHash::count(uint32_t hashValue)
+{
+  return static_cast<int>(m_lookupTable.count(hashValue));
+}
+
+int TComHash::count(uint32_t hashValue) const
+{
+  return static_cast<int>(m_lookupTable.count(hashValue));
+}
+
+MapIterator TComHash::getFirstIterator(uint32_t hashValue)
+{
+  return m_lookupTable.begin(hashValue);
+}
+
+const MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
+{
+  return m_lookupTable.begin(hashValue);
+}
+
+bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2)
+{
+  const MapIterator itEnd = m_lookupTable.end(hashValue1);
+  for (MapIterator it = m_lookupTable.begin(hashValue1); it != itEnd; it++)
   {
-    if (m_lookupTable[i] != NULL)
+    if ((*it).hashValue2 == hashValue2)
     {
-      delete m_lookupTable[i];
-      m_lookupTable[i] = NULL;
+      return true;
     }
   }
+  return false;
 }
 
-void TComHash::addToTable(uint32_t hashValue, const BlockHash& blockHash)
+void TComHash::blockHash2x2RowCore(const Pel* src, const ptrdiff_t stride, const int shift, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* hash1, uint32_t* hash2, bool* rowSame, bool* colSame)
 {
-  if (m_lookupTable[hashValue] == NULL)
-  {
-    m_lookupTable[hashValue] = new std::vector<BlockHash>;
-    m_lookupTable[hashValue]->push_back(blockHash);
-  }
-  else
+  const Pel* srcBelow = src + stride;
+  for (int x = 0; x < num; x++)
   {
-    m_lookupTable[hashValue]->push_back(blockHash);
+    const unsigned char p0 = static_cast<unsigned char>(src[x] >> shift);
+    const unsigned char p1 = static_cast<unsigned char>(src[x + 1] >> shift);
+    const unsigned char p2 = static_cast<unsigned char>(srcBelow[x] >> shift);
+    const unsigned char p3 = static_cast<unsigned char>(srcBelow[x + 1] >> shift);
+
+    rowSame[x] = p0 == p1 && p2 == p3;
+    colSame[x] = p0 == p2 && p1 == p3;
+
+    hash1[x] = sliceTable1[3 * 256 + p0] ^ sliceTable1[2 * 256 + p1] ^ sliceTable1[256 + p2] ^ sliceTable1[p3];
+    hash2[x] = sliceTable2[3 * 256 + p0] ^ sliceTable2[2 * 256 + p1] ^ sliceTable2[256 + p2] ^ sliceTable2[p3];
   }
 }
 
-int TComHash::count(uint32_t hashValue)
+static inline uint32_t xCrcOfSubBlockHashes(const uint32_t* sliceTable, const uint32_t* src, const ptrdiff_t offsetRight, const ptrdiff_t offsetBelow)
 {
-  if (m_lookupTable[hashValue] == NULL)
+  const uint32_t p[4] = { src[0], src[offsetRight], src[offsetBelow], src[offsetBelow + offsetRight] };
+  const unsigned char* bytes = (const unsigned char*)p;
+
+  uint32_t crc = 0;
+  for (int i = 0; i < 4 * sizeof(uint32_t); i++)
   {
-    return 0;
+    crc ^= sliceTable[(4 * sizeof(uint32_t) - 1 - i) * 256 + bytes[i]];
   }
-  else
+  return crc;
+}
+
+void TComHash::blockHashRowCore(const uint32_t* src1, const uint32_t* src2, const ptrdiff_t offsetRight, const ptrdiff_t offsetBelow, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* dst1, uint32_t* dst2)
+{
+  for (int x = 0; x < num; x++)
   {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
+    dst1[x] = xCrcOfSubBlockHashes(sliceTable1, src1 + x, offsetRight, offsetBelow);
+    dst2[x] = xCrcOfSubBlockHashes(sliceTable2, src2 + x, offsetRight, offsetBelow);
   }
 }
 
-int TComHash::count(uint32_t hashValue) const
+void TComHash::xGenerateBlock2x2HashRow(const PelUnitBuf &curPicBuf, int picWidth, const BitDepths& bitDepths, int yPos, int xBeg, int xEnd, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3])
 {
-  if (m_lookupTable[hashValue] == NULL)
+  const int pos = yPos * picWidth + xBeg;
+
+  if ((curPicBuf).chromaFormat != CHROMA_444)
   {
-    return 0;
+    const CPelBuf luma = (curPicBuf).get(COMPONENT_Y);
+    m_blockHash2x2Row(luma.bufAt(xBeg, yPos), luma.stride, bitDepths.recon[CHANNEL_TYPE_LUMA] - 8, xEnd - xBeg, m_crcCalculator1.getSliceTable(), m_crcCalculator2.getSliceTable(),
+                      picBlockHash[0] + pos, picBlockHash[1] + pos, picBlockSameInfo[0] + pos, picBlockSameInfo[1] + pos);
+    return;
   }
-  else
+
+  const int length = 2 * 2 * 3;
+  unsigned char p[length];
+
+  for (int xPos = xBeg, i = pos; xPos < xEnd; xPos++, i++)
   {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
+    TComHash::getPixelsIn1DCharArrayByBlock2x2(curPicBuf, p, xPos, yPos, bitDepths, true);
+    picBlockSameInfo[0][i] = isBlock2x2RowSameValue(p, true);
+    picBlockSameInfo[1][i] = isBlock2x2ColSameValue(p, true);
+
+    picBlockHash[0][i] = m_crcCalculator1.computeCRC(p, length);
+    picBlockHash[1][i] = m_crcCalculator2.computeCRC(p, length);
   }
 }
 
-MapIterator TComHash::getFirstIterator(uint32_t hashValue)
+void TComHash::xGenerateBlockHashRow(int picWidth, int width, int height, int yPos, int xBeg, int xEnd, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3])
 {
-  return m_lookupTable[hashValue]->begin();
-}
+  const int srcWidth   = width >> 1;
+  const int quadWidth  = width >> 2;
+  const int srcHeight  = height >> 1;
+  const int quadHeight = height >> 2;
+  const int srcBelow   = srcHeight * picWidth;
+  const int quadBelow  = quadHeight * picWidth;
+  const int begPos     = yPos * picWidth + xBeg;
+  const int endPos     = yPos * picWidth + xEnd;
 
-const MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
-{
-  return m_lookupTable[hashValue]->begin();
-}
+  m_blockHashRow(srcPicBlockHash[0] + begPos, srcPicBlockHash[1] + begPos, srcWidth, srcBelow, xEnd - xBeg, m_crcCalculator1.getSliceTable(), m_crcCalculator2.getSliceTable(),
+                 dstPicBlockHash[0] + begPos, dstPicBlockHash[1] + begPos);
 
-bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2)
-{
-  if (m_lookupTable[hashValue1] == NULL)
+  const bool* srcRowSame = srcPicBlockSameInfo[0];
+  const bool* srcColSame = srcPicBlockSameInfo[1];
+
+  for (int pos = begPos; pos < endPos; pos++)
   {
-    return false;
+    // non short-circuit evaluation, the loop is vectorized by the compiler
+    dstPicBlockSameInfo[0][pos] = srcRowSame[pos] & srcRowSame[pos + quadWidth] & srcRowSame[pos + srcWidth]
+      & srcRowSame[pos + srcBelow] & srcRowSame[pos + srcBelow + quadWidth] & srcRowSame[pos + srcBelow + srcWidth];
+
+    dstPicBlockSameInfo[1][pos] = srcColSame[pos] & srcColSame[pos + srcWidth] & srcColSame[pos + quadBelow]
+      & srcColSame[pos + quadBelow + srcWidth] & srcColSame[pos + srcBelow] & srcColSame[pos + srcBelow + srcWidth];
   }
-  std::vector<BlockHash>::iterator it;
-  for (it = m_lookupTable[hashValue1]->begin(); it != m_lookupTable[hashValue1]->end(); it++)
+
+  if (width >= 4)
   {
-    if ((*it).hashValue2 == hashValue2)
+    for (int pos = begPos; pos < endPos; pos++)
     {
-      return true;
+      dstPicBlockSameInfo[2][pos] = (!dstPicBlockSameInfo[0][pos] && !dstPicBlockSameInfo[1][pos]);
     }
   }
-  return false;
 }
 
 void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3])
@@ -245,33 +319,10 @@ void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWid
   int xEnd = picWidth - width + 1;
   int yEnd = picHeight - height + 1;
 
-  int length = width * 2;
-  bool includeChroma = false;
-  if ((curPicBuf).chromaFormat == CHROMA_444)
-  {
-    length *= 3;
-    includeChroma = true;
-  }
-  unsigned char* p = new unsigned char[length];
-
-  int pos = 0;
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
-    for (int xPos = 0; xPos < xEnd; xPos++)
-    {
-      TComHash::getPixelsIn1DCharArrayByBlock2x2(curPicBuf, p, xPos, yPos, bitDepths, includeChroma);
-      picBlockSameInfo[0][pos] = isBlock2x2RowSameValue(p, includeChroma);
-      picBlockSameInfo[1][pos] = isBlock2x2ColSameValue(p, includeChroma);
-
-      picBlockHash[0][pos] = TComHash::getCRCValue1(p, length * sizeof(unsigned char));
-      picBlockHash[1][pos] = TComHash::getCRCValue2(p, length * sizeof(unsigned char));
-
-      pos++;
-    }
-    pos += width - 1;
+    xGenerateBlock2x2HashRow(curPicBuf, picWidth, bitDepths, yPos, 0, xEnd, picBlockHash, picBlockSameInfo);
   }
-
-  delete[] p;
 }
 
 void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3])
@@ -279,55 +330,9 @@ void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, in
   int xEnd = picWidth - width + 1;
   int yEnd = picHeight - height + 1;
 
-  int srcWidth = width >> 1;
-  int quadWidth = width >> 2;
-  int srcHeight = height >> 1;
-  int quadHeight = height >> 2;
-
-  int length = 4 * sizeof(uint32_t);
-
-  uint32_t p[4];
-  int pos = 0;
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
-    for (int xPos = 0; xPos < xEnd; xPos++)
-    {
-      p[0] = srcPicBlockHash[0][pos];
-      p[1] = srcPicBlockHash[0][pos + srcWidth];
-      p[2] = srcPicBlockHash[0][pos + srcHeight * picWidth];
-      p[3] = srcPicBlockHash[0][pos + srcHeight * picWidth + srcWidth];
-      dstPicBlockHash[0][pos] = TComHash::getCRCValue1((unsigned char*)p, length);
-
-      p[0] = srcPicBlockHash[1][pos];
-      p[1] = srcPicBlockHash[1][pos + srcWidth];
-      p[2] = srcPicBlockHash[1][pos + srcHeight * picWidth];
-      p[3] = srcPicBlockHash[1][pos + srcHeight * picWidth + srcWidth];
-      dstPicBlockHash[1][pos] = TComHash::getCRCValue2((unsigned char*)p, length);
-
-      dstPicBlockSameInfo[0][pos] = srcPicBlockSameInfo[0][pos] && srcPicBlockSameInfo[0][pos + quadWidth] && srcPicBlockSameInfo[0][pos + srcWidth]
-        && srcPicBlockSameInfo[0][pos + srcHeight * picWidth] && srcPicBlockSameInfo[0][pos + srcHeight * picWidth + quadWidth] && srcPicBlockSameInfo[0][pos + srcHeight * picWidth + srcWidth];
-
-      dstPicBlockSameInfo[1][pos] = srcPicBlockSameInfo[1][pos] && srcPicBlockSameInfo[1][pos + srcWidth] && srcPicBlockSameInfo[1][pos + quadHeight * picWidth]
-        && srcPicBlockSameInfo[1][pos + quadHeight * picWidth + srcWidth] && srcPicBlockSameInfo[1][pos + srcHeight * picWidth] && srcPicBlockSameInfo[1][pos + srcHeight * picWidth + srcWidth];
-
-      pos++;
-    }
-    pos += width - 1;
-  }
-
-  if (width >= 4)
-  {
-    pos = 0;
-
-    for (int yPos = 0; yPos < yEnd; yPos++)
-    {
-      for (int xPos = 0; xPos < xEnd; xPos++)
-      {
-        dstPicBlockSameInfo[2][pos] = (!dstPicBlockSameInfo[0][pos] && !dstPicBlockSameInfo[1][pos]);
-        pos++;
-      }
-      pos += width - 1;
-    }
+    xGenerateBlockHashRow(picWidth, width, height, yPos, 0, xEnd, srcPicBlockHash, dstPicBlockHash, srcPicBlockSameInfo, dstPicBlockSameInfo);
   }
 }
 
@@ -346,12 +351,26 @@ void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIs
   crcMask -= 1;
   int blockIdx = floorLog2(width) - 2;
 
+  // the keys of a block size are counted first, so the blocks of each key are stored contiguously
+  for (int yPos = 0; yPos < yEnd; yPos++)
+  {
+    for (int xPos = 0, pos = yPos * picWidth; xPos < xEnd; xPos++, pos++)
+    {
+      hashPic[blockIdx][pos] = (uint16_t)(srcHash[1][pos] & crcMask);
+      //valid data
+      if (srcIsAdded[pos])
+      {
+        m_lookupTable.countKey((srcHash[0][pos] & crcMask) + addValue);
+      }
+    }
+  }
+  m_lookupTable.allocate();
+
   for (int xPos = 0; xPos < xEnd; xPos++)
   {
     for (int yPos = 0; yPos < yEnd; yPos++)
     {
       int pos = yPos * picWidth + xPos;
-      hashPic[blockIdx][pos] = (uint16_t)(srcHash[1][pos] & crcMask);
       //valid data
       if (srcIsAdded[pos])
       {
@@ -362,7 +381,7 @@ void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIs
         uint32_t hashValue1 = (srcHash[0][pos] & crcMask) + addValue;
         blockHash.hashValue2 = srcHash[1][pos];
 
-        addToTable(hashValue1, blockHash);
+        m_lookupTable.insert(hashValue1, blockHash);
       }
     }
   }
@@ -691,15 +710,189 @@ void TComHash::initBlockSizeToIndex()
 
 uint32_t TComHash::getCRCValue1(unsigned char* p, int length)
 {
-  m_crcCalculator1.reset();
-  m_crcCalculator1.processData(p, length);
-  return m_crcCalculator1.getCRC();
+  return m_crcCalculator1.computeCRC(p, length);
 }
 
 uint32_t TComHash::getCRCValue2(unsigned char* p, int length)
 {
-  m_crcCalculator2.reset();
-  m_crcCalculator2.processData(p, length);
-  return m_crcCalculator2.getCRC();
+  return m_crcCalculator2.computeCRC(p, length);
+}
+// ====================================================================================================================
+// Incremental block hash pyramid
+// ====================================================================================================================
+
+TComHashPyramid::TComHashPyramid()
+  : m_valid(false)
+  , m_picWidth(0)
+  , m_picHeight(0)
+  , m_chromaFormat(NUM_CHROMA_FORMAT)
+{
+  for (int level = 0; level < m_numLevels; level++)
+  {
+    m_hash[level][0] = m_hash[level][1] = nullptr;
+    m_sameInfo[level][0] = m_sameInfo[level][1] = m_sameInfo[level][2] = nullptr;
+  }
+}
+
+TComHashPyramid::~TComHashPyramid()
+{
+  destroy();
+}
+
+void TComHashPyramid::destroy()
+{
+  for (int level = 0; level < m_numLevels; level++)
+  {
+    for (int i = 0; i < 2; i++)
+    {
+      delete[] m_hash[level][i];
+      m_hash[level][i] = nullptr;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      delete[] m_sameInfo[level][i];
+      m_sameInfo[level][i] = nullptr;
+    }
+  }
+  m_prevPicBuf.destroy();
+  m_changedBeg.clear();
+  m_changedEnd.clear();
+
+  m_valid        = false;
+  m_picWidth     = 0;
+  m_picHeight    = 0;
+  m_chromaFormat = NUM_CHROMA_FORMAT;
+}
+
+void TComHashPyramid::xCreate(ChromaFormat chromaFormat, int picWidth, int picHeight)
+{
+  destroy();
+
+  m_picWidth     = picWidth;
+  m_picHeight    = picHeight;
+  m_chromaFormat = chromaFormat;
+
+  for (int level = 0; level < m_numLevels; level++)
+  {
+    for (int i = 0; i < 2; i++)
+    {
+      m_hash[level][i] = new uint32_t[picWidth * picHeight];
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      m_sameInfo[level][i] = new bool[picWidth * picHeight];
+    }
+  }
+  // only the luma samples are hashed for the subsampled chroma formats
+  m_prevPicBuf.create(chromaFormat == CHROMA_444 ? CHROMA_444 : CHROMA_400, Area(0, 0, picWidth, picHeight));
+  m_changedBeg.resize(picHeight);
+  m_changedEnd.resize(picHeight);
+}
+
+void TComHashPyramid::xFindChangedColumns(const PelUnitBuf &curPicBuf)
+{
+  const int numComp = getNumberValidComponents(m_prevPicBuf.chromaFormat);
+
+  for (int y = 0; y < m_picHeight; y++)
+  {
+    int beg = m_picWidth;
+    int end = 0;
+
+    for (int comp = 0; comp < numComp; comp++)
+    {
+      const ComponentID compID = ComponentID(comp);
+      const Pel*        cur    = (curPicBuf).get(compID).bufAt(0, y);
+      const Pel*        prev   = m_prevPicBuf.get(compID).bufAt(0, y);
+
+      if (memcmp(cur, prev, m_picWidth * sizeof(Pel)) == 0)
+      {
+        continue;
+      }
+
+      int first = 0;
+      while (cur[first] == prev[first])
+      {
+        first++;
+      }
+      int last = m_picWidth;
+      while (cur[last - 1] == prev[last - 1])
+      {
+        last--;
+      }
+      beg = std::min(beg, first);
+      end = std::max(end, last);
+    }
+
+    m_changedBeg[y] = beg;
+    m_changedEnd[y] = end;
+  }
+}
+
+void TComHashPyramid::addPictureToHashMap(TComHash& hashMap, const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths& bitDepths)
+{
+  if (picWidth != m_picWidth || picHeight != m_picHeight || (curPicBuf).chromaFormat != m_chromaFormat)
+  {
+    xCreate((curPicBuf).chromaFormat, picWidth, picHeight);
+  }
+
+  if (m_valid && bitDepths.recon[CHANNEL_TYPE_LUMA] == m_bitDepths.recon[CHANNEL_TYPE_LUMA] && bitDepths.recon[CHANNEL_TYPE_CHROMA] == m_bitDepths.recon[CHANNEL_TYPE_CHROMA])
+  {
+    xFindChangedColumns(curPicBuf);
+  }
+  else
+  {
+    std::fill(m_changedBeg.begin(), m_changedBeg.end(), 0);
+    std::fill(m_changedEnd.begin(), m_changedEnd.end(), picWidth);
+  }
+
+  // a block at (x,y) of size s is hashed again, if one of the samples in [x, x+s) x [y, y+s) changed
+  for (int level = 0; level < m_numLevels; level++)
+  {
+    const int size = 2 << level;
+    const int xEnd = picWidth - size + 1;
+    const int yEnd = picHeight - size + 1;
+
+    for (int yPos = 0; yPos < yEnd; yPos++)
+    {
+      int beg = picWidth;
+      int end = 0;
+      for (int y = yPos; y < yPos + size; y++)
+      {
+        beg = std::min(beg, m_changedBeg[y]);
+        end = std::max(end, m_changedEnd[y]);
+      }
+      if (beg >= end)
+      {
+        continue;
+      }
+
+      const int xBeg = std::max(0, beg - size + 1);
+      const int xLim = std::min(xEnd, end);
+
+      if (level == 0)
+      {
+        hashMap.xGenerateBlock2x2HashRow(curPicBuf, picWidth, bitDepths, yPos, xBeg, xLim, m_hash[0], m_sameInfo[0]);
+      }
+      else
+      {
+        hashMap.xGenerateBlockHashRow(picWidth, size, size, yPos, xBeg, xLim, m_hash[level - 1], m_hash[level], m_sameInfo[level - 1], m_sameInfo[level]);
+      }
+    }
+  }
+
+  for (int level = 1; level < m_numLevels; level++)
+  {
+    const int size = 2 << level;
+    hashMap.addToHashMapByRowWithPrecalData(m_hash[level], m_sameInfo[level][2], picWidth, picHeight, size, size);
+  }
+
+  for (int comp = 0; comp < getNumberValidComponents(m_prevPicBuf.chromaFormat); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf     cur    = (curPicBuf).get(compID);
+    m_prevPicBuf.getBuf(compID).copyFrom(CPelBuf(cur.buf, cur.stride, picWidth, picHeight));
+  }
+  m_bitDepths = bitDepths;
+  m_valid     = true;
 }
 //! \}
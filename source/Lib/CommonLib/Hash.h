@@ -43,6 +43,7 @@
 
 #include "CommonLib/Buffer.h"
 #include "CommonLib/CommonDef.h"
+#include "CommonLib/HashMultiMap.h"
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/UnitPartitioner.h"
@@ -56,7 +57,7 @@ struct BlockHash
   uint32_t hashValue2;
 };
 
-typedef std::vector<BlockHash>::iterator MapIterator;
+typedef const BlockHash* MapIterator;
 
 // ====================================================================================================================
 // Class definitions
@@ -73,9 +74,14 @@ public:
   void processData(unsigned char* curData, uint32_t dataLength);
   void reset() { m_remainder = 0; }
   uint32_t getCRC() { return m_remainder & m_finalResultMask; }
+  uint32_t computeCRC(const unsigned char* curData, uint32_t dataLength) const;
+  const uint32_t* getSliceTable() const { return &m_sliceTable[0][0]; }
+
+  static const int m_maxSliceLength = 16;
 
 private:
   void xInitTable();
+  void xInitSliceTable();
 
 private:
   uint32_t m_remainder;
@@ -83,8 +89,11 @@ private:
   uint32_t m_bits;
   uint32_t m_table[256];
   uint32_t m_finalResultMask;
+  uint32_t m_sliceTable[m_maxSliceLength][256];   // m_sliceTable[k][v]: remainder of the byte v followed by k zero bytes
 };
 
+struct TComHashPyramid;
+
 
 struct TComHash
 {
@@ -93,7 +102,6 @@ public:
   ~TComHash();
   void create(int picWidth, int picHeight);
   void clearAll();
-  void addToTable(uint32_t hashValue, const BlockHash& blockHash);
   int count(uint32_t hashValue);
   int count(uint32_t hashValue) const;
   MapIterator getFirstIterator(uint32_t hashValue);
@@ -119,8 +127,26 @@ public:
   static bool isHorizontalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
   static bool isVerticalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
 
+  static void blockHash2x2RowCore(const Pel* src, const ptrdiff_t stride, const int shift, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* hash1, uint32_t* hash2, bool* rowSame, bool* colSame);
+  static void blockHashRowCore(const uint32_t* src1, const uint32_t* src2, const ptrdiff_t offsetRight, const ptrdiff_t offsetBelow, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* dst1, uint32_t* dst2);
+
+  void (*m_blockHash2x2Row)(const Pel* src, const ptrdiff_t stride, const int shift, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* hash1, uint32_t* hash2, bool* rowSame, bool* colSame);
+  void (*m_blockHashRow)(const uint32_t* src1, const uint32_t* src2, const ptrdiff_t offsetRight, const ptrdiff_t offsetBelow, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* dst1, uint32_t* dst2);
+
+#if ENABLE_SIMD_OPT_HASH && defined( TARGET_SIMD_X86 )
+  void initHashX86();
+  template <X86_VEXT vext>
+  void _initHashX86();
+#endif
+
 private:
-  std::vector<BlockHash>** m_lookupTable;
+  friend struct TComHashPyramid;
+
+  void xGenerateBlock2x2HashRow(const PelUnitBuf &curPicBuf, int picWidth, const BitDepths& bitDepths, int yPos, int xBeg, int xEnd, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3]);
+  void xGenerateBlockHashRow(int picWidth, int width, int height, int yPos, int xBeg, int xEnd, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3]);
+
+private:
+  HashMultiMap<BlockHash> m_lookupTable;
   bool tableHasContent;
   uint16_t* hashPic[5];//4x4 ~ 64x64
 
@@ -133,4 +159,34 @@ private:
   static TCRCCalculatorLight m_crcCalculator2;
 };
 
+
+// block hash values of all block sizes of the previously hashed picture, only the regions that differ from it are hashed again
+struct TComHashPyramid
+{
+public:
+  TComHashPyramid();
+  ~TComHashPyramid();
+  void destroy();
+  void invalidate() { m_valid = false; }
+  void addPictureToHashMap(TComHash& hashMap, const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths& bitDepths);
+
+private:
+  void xCreate(ChromaFormat chromaFormat, int picWidth, int picHeight);
+  void xFindChangedColumns(const PelUnitBuf &curPicBuf);
+
+private:
+  static const int m_numLevels = 6;   // 2x2 ~ 64x64
+
+  bool               m_valid;
+  int                m_picWidth;
+  int                m_picHeight;
+  ChromaFormat       m_chromaFormat;
+  BitDepths          m_bitDepths;
+  PelStorage         m_prevPicBuf;
+  uint32_t*          m_hash[m_numLevels][2];
+  bool*              m_sameInfo[m_numLevels][3];
+  std::vector<int>   m_changedBeg;   // first changed column of each row, m_picWidth if unchanged
+  std::vector<int>   m_changedEnd;   // last changed column of each row plus one
+};
+
 #endif // __HASH__
@@ -0,0 +1,205 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     HashMultiMap.h
+    \brief    flat multimap from 32 bit hash values to the blocks carrying them
+*/
+
+#ifndef __HASHMULTIMAP__
+#define __HASHMULTIMAP__
+
+#include "CommonLib/CommonDef.h"
+
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// open addressing multimap, built in batches and cleared as a whole
+///  - the keys of a batch are counted first, then the values are inserted; a key can only be part of one batch
+///  - the values of a key are stored contiguously in insertion order, the keys are kept in the order they were counted
+///  - clearing keeps the allocated memory, the table is only reset when the generation counter wraps around
+template<typename TValue>
+class HashMultiMap
+{
+private:
+  struct Slot
+  {
+    uint32_t key;
+    uint32_t generation;   // the slot is occupied when it matches m_generation
+    uint32_t begin;        // first value of the key in m_values, NOT_ALLOCATED while its batch is being counted
+    uint32_t size;         // counted values of the key, after allocate() the number of inserted values
+  };
+
+  static const uint32_t NOT_ALLOCATED = 0xffffffff;
+
+public:
+  HashMultiMap() : m_mask( 0 ), m_shift( 0 ), m_generation( 1 ), m_batchBegin( 0 ) {}
+
+  void clear()
+  {
+    m_keys.clear();
+    m_values.clear();
+    m_batchBegin = 0;
+    if( ++m_generation == 0 )
+    {
+      std::fill( m_slots.begin(), m_slots.end(), Slot{ 0, 0, 0, 0 } );
+      m_generation = 1;
+    }
+  }
+
+  void countKey( uint32_t key )
+  {
+    if( 2 * ( m_keys.size() + 1 ) > m_slots.size() )
+    {
+      xGrow();
+    }
+    Slot& slot = xProbe( key );
+    if( slot.generation != m_generation )
+    {
+      slot = Slot{ key, m_generation, NOT_ALLOCATED, 0 };
+      m_keys.push_back( key );
+    }
+    CHECKD( slot.begin != NOT_ALLOCATED, "Key is part of a previous batch" );
+    slot.size++;
+  }
+
+  /// reserves the values of the keys counted since the last call
+  void allocate()
+  {
+    uint32_t begin = uint32_t( m_values.size() );
+    for( size_t k = m_batchBegin; k < m_keys.size(); k++ )
+    {
+      Slot& slot = xProbe( m_keys[k] );
+      slot.begin = begin;
+      begin     += slot.size;
+      slot.size  = 0;
+    }
+    m_values.resize( begin );
+    m_batchBegin = m_keys.size();
+  }
+
+  void insert( uint32_t key, const TValue& value )
+  {
+    Slot& slot = xProbe( key );
+    CHECKD( slot.generation != m_generation, "Key has not been counted" );
+    m_values[slot.begin + slot.size++] = value;
+  }
+
+  size_t count( uint32_t key ) const
+  {
+    const Slot* slot = xFind( key );
+    return slot ? slot->size : 0;
+  }
+
+  const TValue* begin( uint32_t key ) const
+  {
+    const Slot* slot = xFind( key );
+    return slot ? &m_values[slot->begin] : nullptr;
+  }
+
+  const TValue* end( uint32_t key ) const
+  {
+    const Slot* slot = xFind( key );
+    return slot ? &m_values[slot->begin] + slot->size : nullptr;
+  }
+
+  const std::vector<uint32_t>& getKeys() const { return m_keys; }
+
+private:
+  // Fibonacci hashing, the upper bits of the product are used as slot index
+  size_t xSlotIdx( uint32_t key ) const { return size_t( ( key * 0x9E3779B1u ) >> m_shift ) & m_mask; }
+
+  Slot& xProbe( uint32_t key )
+  {
+    size_t idx = xSlotIdx( key );
+    while( m_slots[idx].generation == m_generation && m_slots[idx].key != key )
+    {
+      idx = ( idx + 1 ) & m_mask;
+    }
+    return m_slots[idx];
+  }
+
+  const Slot* xFind( uint32_t key ) const
+  {
+    if( m_slots.empty() )
+    {
+      return nullptr;
+    }
+    for( size_t idx = xSlotIdx( key ); m_slots[idx].generation == m_generation; idx = ( idx + 1 ) & m_mask )
+    {
+      if( m_slots[idx].key == key )
+      {
+        return &m_slots[idx];
+      }
+    }
+    return nullptr;
+  }
+
+  void xGrow()
+  {
+    std::vector<Slot> oldSlots( std::max<size_t>( 2 * m_slots.size(), 4096 ), Slot{ 0, 0, 0, 0 } );
+    oldSlots.swap( m_slots );
+    const uint32_t oldGeneration = m_generation;
+
+    m_mask       = m_slots.size() - 1;
+    m_shift      = 32 - floorLog2( uint32_t( m_slots.size() ) );
+    m_generation = 1;
+    for( const Slot& slot : oldSlots )
+    {
+      if( slot.generation == oldGeneration )
+      {
+        Slot& newSlot      = xProbe( slot.key );
+        newSlot            = slot;
+        newSlot.generation = m_generation;
+      }
+    }
+  }
+
+private:
+  std::vector<Slot>     m_slots;
+  size_t                m_mask;
+  int                   m_shift;
+  uint32_t              m_generation;
+  std::vector<uint32_t> m_keys;
+  size_t                m_batchBegin;   // first key of the batch not allocated yet
+  std::vector<TValue>   m_values;
+};
+
+//! \}
+
+#endif // __HASHMULTIMAP__
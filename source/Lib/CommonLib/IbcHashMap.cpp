@@ -208,6 +208,7 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
   const Pel* pelCb = NULL;
   const Pel* pelCr = NULL;
 
+  // the hashes of all positions are counted first, so the positions of each hash are stored contiguously
   Position pos;
   for (pos.y = 0; pos.y + MIN_PU_SIZE <= pic.Y().height; pos.y++)
   {
@@ -237,10 +238,19 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
       }
 
       // hash table
-      m_hash2Pos[hashValue].push_back(pos);
+      m_hash2Pos.countKey(hashValue);
       m_pos2Hash[pos.y][pos.x] = hashValue;
     }
   }
+
+  m_hash2Pos.allocate();
+  for (pos.y = 0; pos.y + MIN_PU_SIZE <= pic.Y().height; pos.y++)
+  {
+    for (pos.x = 0; pos.x + MIN_PU_SIZE <= pic.Y().width; pos.x++)
+    {
+      m_hash2Pos.insert(m_pos2Hash[pos.y][pos.x], pos);
+    }
+  }
 }
 
 void IbcHashMap::rebuildPicHashMap(const PelUnitBuf& pic)
@@ -280,21 +290,21 @@ bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand,
     for (SizeType x = 0; x < lumaArea.width && minSize > 1; x += MIN_PU_SIZE)
     {
       unsigned int hash = m_pos2Hash[lumaArea.pos().y + y][lumaArea.pos().x + x];
-      if (m_hash2Pos[hash].size() < minSize)
+      const size_t numPos = m_hash2Pos.count(hash);
+      if (numPos < minSize)
       {
-        minSize = m_hash2Pos[hash].size();
+        minSize = numPos;
         targetHashOneBlock = hash;
         targetBlockOffsetInCu.repositionTo(Position(x, y));
       }
     }
   }
 
-  if (m_hash2Pos[targetHashOneBlock].size() > 1)
+  if (m_hash2Pos.count(targetHashOneBlock) > 1)
   {
-    std::vector<Position>& candOneBlock = m_hash2Pos[targetHashOneBlock];
-
     // check whether whole block match
-    for (std::vector<Position>::iterator refBlockPos = candOneBlock.begin(); refBlockPos != candOneBlock.end(); refBlockPos++)
+    const Position* candEnd = m_hash2Pos.end(targetHashOneBlock);
+    for (const Position* refBlockPos = m_hash2Pos.begin(targetHashOneBlock); refBlockPos != candEnd; refBlockPos++)
     {
       Position topLeft = refBlockPos->offset(-targetBlockOffsetInCu.x, -targetBlockOffsetInCu.y);
       Position bottomRight = topLeft.offset(lumaArea.width - 1, lumaArea.height - 1);
@@ -346,7 +356,7 @@ int IbcHashMap::getHashHitRatio(const Area& lumaArea)
     for (int x = lumaArea.x; x < maxX; x += MIN_PU_SIZE)
     {
       const unsigned int hash = m_pos2Hash[y][x];
-      hit += (m_hash2Pos[hash].size() > 1);
+      hit += (m_hash2Pos.count(hash) > 1);
       total++;
     }
   }
@@ -368,11 +378,10 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
     mostSelHash[i] = 0;
   }
 
-  for (std::unordered_map<unsigned int, std::vector<Position>>::iterator it = m_hash2Pos.begin(); it != m_hash2Pos.end(); ++it)
+  // the hash values are visited in the order of their first occurrence in the picture, so ties are resolved deterministically
+  for (const unsigned int hash: m_hash2Pos.getKeys())
   {
-    unsigned int hash = it->first;
-    int usage = (int)it->second.size();
-    assert(usage == m_hash2Pos[hash].size());
+    int usage = (int)m_hash2Pos.count(hash);
 
     int insertPos = -1;
     for (insertPos = 0; insertPos < numExcludedHashValue; insertPos++)
@@ -417,7 +426,7 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
         continue;
       }
 
-      hit += (m_hash2Pos[hash].size() > 1);
+      hit += (m_hash2Pos.count(hash) > 1);
       total++;
     }
   }
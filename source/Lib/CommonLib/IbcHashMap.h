@@ -40,13 +40,13 @@
 
 // Include files
 #include "CommonLib/CommonDef.h"
+#include "CommonLib/HashMultiMap.h"
 #include "CommonLib/IntraPrediction.h"
 #include "CommonLib/InterPrediction.h"
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/UnitPartitioner.h"
 
-#include <unordered_map>
 #include <vector>
 //! \ingroup EncoderLib
 //! \{
@@ -61,7 +61,7 @@ private:
   int     m_picWidth;
   int     m_picHeight;
   unsigned int**  m_pos2Hash;
-  std::unordered_map<unsigned int, std::vector<Position>> m_hash2Pos;
+  HashMultiMap<Position> m_hash2Pos;
 
   unsigned int xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc);
 
@@ -66,7 +66,15 @@ InterPrediction::InterPrediction()
 , m_gradY1(nullptr)
 , m_subPuMC(false)
 , m_IBCBufferWidth(0)
+, m_mcWindowsEnabled(false)
+, m_mcWindowTmp(nullptr)
+, m_numMcWindows(0)
+, m_nextMcWindow(0)
 {
+  for( int i = 0; i < MC_NUM_WINDOWS; i++ )
+  {
+    m_mcWindowBuf[i] = nullptr;
+  }
   for( uint32_t ch = 0; ch < MAX_NUM_COMPONENT; ch++ )
   {
     for( uint32_t refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
@@ -155,6 +163,14 @@ void InterPrediction::destroy()
     m_cRefSamplesDMVRL1[ch] = nullptr;
   }
   m_IBCBuffer.destroy();
+
+  for( int i = 0; i < MC_NUM_WINDOWS; i++ )
+  {
+    xFree( m_mcWindowBuf[i] );
+    m_mcWindowBuf[i] = nullptr;
+  }
+  xFree( m_mcWindowTmp );
+  m_mcWindowTmp = nullptr;
 }
 
 void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC, const int ctuSize )
@@ -218,6 +234,16 @@ void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC, cons
       m_cRefSamplesDMVRL1[ch] = (Pel*)xMalloc(Pel, (MAX_CU_SIZE + (2 * DMVR_NUM_ITERATION) + NTAPS_LUMA) * (MAX_CU_SIZE + (2 * DMVR_NUM_ITERATION) + NTAPS_LUMA));
     }
   }
+  if( m_mcWindowTmp == nullptr )
+  {
+    const int winSize = MAX_CU_SIZE + 2 * MC_WINDOW_MARGIN;
+    for( int i = 0; i < MC_NUM_WINDOWS; i++ )
+    {
+      m_mcWindowBuf[i] = ( Pel* ) xMalloc( Pel, winSize * winSize );
+    }
+    m_mcWindowTmp = ( Pel* ) xMalloc( Pel, winSize * ( winSize + NTAPS_LUMA - 1 ) );
+  }
+  resetMcWindows();
 #if !JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_if.initInterpolationFilter( true );
 #endif
@@ -292,15 +318,17 @@ void InterPrediction::xSubPuMC( PredictionUnit& pu, PelUnitBuf& predBuf, const R
     puWidth = numPartLine == 1 ? puSize.width : 1 << ATMVP_SUB_BLOCK_SIZE;
   }
 
+  // the sub-PUs are predicted as regular blocks of a copy of the CU, the CU itself is read by the parser while the
+  // decoder reconstructs in parallel
+  CodingUnit subCu = *pu.cu;
+  subCu.affine     = false;
+
   PredictionUnit subPu;
 
   subPu.cs        = pu.cs;
-  subPu.cu        = pu.cu;
+  subPu.cu        = &subCu;
   subPu.mergeType = MRG_TYPE_DEFAULT_N;
 
-  bool isAffine = pu.cu->affine;
-  subPu.cu->affine = false;
-
   // join sub-pus containing the same motion
   bool verMC = puSize.height > puSize.width;
   int  fstStart = (!verMC ? puPos.y : puPos.x);
@@ -351,8 +379,6 @@ void InterPrediction::xSubPuMC( PredictionUnit& pu, PelUnitBuf& predBuf, const R
     }
   }
   m_subPuMC = false;
-
-  pu.cu->affine = isAffine;
 }
 
 void InterPrediction::xSubPuBio(PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList /*= REF_PIC_LIST_X*/, PelUnitBuf* yuvDstTmp /*= NULL*/)
@@ -691,6 +717,12 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
 
   bool useAltHpelIf = pu.cu->imv == IMV_HPEL;
 
+  if( m_mcWindowsEnabled && isLuma( compID ) && !isIBC && !wrapRef && !bioApplied && !dmvrWidth && !bilinearMC && srcPadBuf == NULL && scalingRatio == SCALE_1X
+    && xPredInterBlkWindow( pu, refPic, mv, dstPic.bufs[compID], bi, clpRng, useAltHpelIf ) )
+  {
+    return;
+  }
+
   if( !isIBC && xPredInterBlkRPR( scalingRatio, *pu.cs->pps, CompArea( compID, chFmt, pu.blocks[compID], Size( dstPic.bufs[compID].width, dstPic.bufs[compID].height ) ), refPic, mv, dstPic.bufs[compID].buf, dstPic.bufs[compID].stride, bi, wrapRef, clpRng, 0, useAltHpelIf ) )
   {
     CHECK( bilinearMC, "DMVR should be disabled with RPR" );
@@ -838,6 +870,104 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
   }
 }
 
+void InterPrediction::enableMcWindows( const PredictionUnit& pu, const MvField baseMv[NUM_REF_PIC_LIST_01] )
+{
+  for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+  {
+    m_mcWindowRefPic[refList] = baseMv[refList].refIdx < 0 ? nullptr : pu.cu->slice->getRefPic( RefPicList( refList ), baseMv[refList].refIdx )->unscaledPic;
+    m_mcWindowBaseMv[refList] = baseMv[refList].mv;
+  }
+  m_mcWindowsEnabled = !pu.cs->pps->getWrapAroundEnabledFlag();
+}
+
+bool InterPrediction::xPredInterBlkWindow( const PredictionUnit& pu, const Picture* refPic, const Mv& mv, PelBuf& dstBuf, const bool bi, const ClpRng& clpRng, const bool useAltHpelIf )
+{
+  const int fracMask = ( 1 << MV_FRACTIONAL_BITS_INTERNAL ) - 1;
+  const int width    = pu.lwidth();
+  const int height   = pu.lheight();
+
+  if( dstBuf.width != width || dstBuf.height != height )
+  {
+    return false;
+  }
+
+  // the vector has to differ from a base vector of the same reference picture by an integer-pel offset inside the margin
+  const Mv* baseMv = nullptr;
+  for( int refList = 0; refList < NUM_REF_PIC_LIST_01 && !baseMv; refList++ )
+  {
+    const Mv diff = mv - m_mcWindowBaseMv[refList];
+    if( m_mcWindowRefPic[refList] == refPic && ( ( diff.hor | diff.ver ) & fracMask ) == 0
+      && abs( diff.hor >> MV_FRACTIONAL_BITS_INTERNAL ) <= MC_WINDOW_MARGIN && abs( diff.ver >> MV_FRACTIONAL_BITS_INTERNAL ) <= MC_WINDOW_MARGIN )
+    {
+      baseMv = &m_mcWindowBaseMv[refList];
+    }
+  }
+  if( !baseMv )
+  {
+    return false;
+  }
+
+  const int winWidth  = width + 2 * MC_WINDOW_MARGIN;
+  const int winHeight = height + 2 * MC_WINDOW_MARGIN;
+  const int baseX     = baseMv->hor >> MV_FRACTIONAL_BITS_INTERNAL;
+  const int baseY     = baseMv->ver >> MV_FRACTIONAL_BITS_INTERNAL;
+
+  int winIdx = 0;
+  for( ; winIdx < m_numMcWindows; winIdx++ )
+  {
+    const McWindow& win = m_mcWindow[winIdx];
+    if( win.refPic == refPic && win.baseMv == *baseMv && win.bi == bi && win.useAltHpelIf == useAltHpelIf )
+    {
+      break;
+    }
+  }
+
+  if( winIdx == m_numMcWindows )
+  {
+    // the window must not reach further into the padding than a clipped vector
+    const Mv marginMv( MC_WINDOW_MARGIN << MV_FRACTIONAL_BITS_INTERNAL, MC_WINDOW_MARGIN << MV_FRACTIONAL_BITS_INTERNAL );
+    Mv       minMv = *baseMv - marginMv;
+    Mv       maxMv = *baseMv + marginMv;
+    clipMv( minMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
+    clipMv( maxMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
+    if( minMv != *baseMv - marginMv || maxMv != *baseMv + marginMv )
+    {
+      return false;
+    }
+
+    winIdx = m_nextMcWindow;
+    m_nextMcWindow = ( m_nextMcWindow + 1 ) % MC_NUM_WINDOWS;
+    m_numMcWindows = std::max( m_numMcWindows, m_nextMcWindow == 0 ? MC_NUM_WINDOWS : m_nextMcWindow );
+    m_mcWindow[winIdx] = { refPic, *baseMv, bi, useAltHpelIf };
+
+    const int     xFrac  = baseMv->hor & fracMask;
+    const int     yFrac  = baseMv->ver & fracMask;
+    const bool    rndRes = !bi;
+    const CPelBuf refBuf = refPic->getRecoBuf( CompArea( COMPONENT_Y, pu.chromaFormat, pu.Y().pos().offset( baseX - MC_WINDOW_MARGIN, baseY - MC_WINDOW_MARGIN ), Size( winWidth, winHeight ) ), false );
+    Pel*          winBuf = m_mcWindowBuf[winIdx];
+
+    if( yFrac == 0 )
+    {
+      m_if.filterHor( COMPONENT_Y, refBuf.buf, refBuf.stride, winBuf, winWidth, winWidth, winHeight, xFrac, rndRes, clpRng, 0, false, useAltHpelIf );
+    }
+    else if( xFrac == 0 )
+    {
+      m_if.filterVer( COMPONENT_Y, refBuf.buf, refBuf.stride, winBuf, winWidth, winWidth, winHeight, yFrac, true, rndRes, clpRng, 0, false, useAltHpelIf );
+    }
+    else
+    {
+      const int vFilterHalf = ( NTAPS_LUMA >> 1 ) - 1;
+      m_if.filterHor( COMPONENT_Y, refBuf.buf - vFilterHalf * refBuf.stride, refBuf.stride, m_mcWindowTmp, winWidth, winWidth, winHeight + NTAPS_LUMA - 1, xFrac, false, clpRng, 0, false, useAltHpelIf );
+      m_if.filterVer( COMPONENT_Y, m_mcWindowTmp + vFilterHalf * winWidth, winWidth, winBuf, winWidth, winWidth, winHeight, yFrac, false, rndRes, clpRng, 0, false, useAltHpelIf );
+    }
+  }
+
+  const int offsetX = MC_WINDOW_MARGIN + ( mv.hor >> MV_FRACTIONAL_BITS_INTERNAL ) - baseX;
+  const int offsetY = MC_WINDOW_MARGIN + ( mv.ver >> MV_FRACTIONAL_BITS_INTERNAL ) - baseY;
+  dstBuf.copyFrom( CPelBuf( m_mcWindowBuf[winIdx] + offsetY * winWidth + offsetX, winWidth, width, height ) );
+  return true;
+}
+
 bool InterPrediction::isSubblockVectorSpreadOverLimit( int a, int b, int c, int d, int predType )
 {
   int s4 = ( 4 << 11 );
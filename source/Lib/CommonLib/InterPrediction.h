@@ -113,6 +113,26 @@ protected:
 
   int                  m_IBCBufferWidth;
   PelStorage           m_IBCBuffer;
+
+  // luma interpolation windows around the base vectors, shared by the MMVD candidates with integer-pel offsets
+  struct McWindow
+  {
+    const Picture*     refPic;
+    Mv                 baseMv;
+    bool               bi;
+    bool               useAltHpelIf;
+  };
+  bool                 m_mcWindowsEnabled;
+  const Picture*       m_mcWindowRefPic       [NUM_REF_PIC_LIST_01];
+  Mv                   m_mcWindowBaseMv       [NUM_REF_PIC_LIST_01];
+  McWindow             m_mcWindow             [MC_NUM_WINDOWS];
+  Pel*                 m_mcWindowBuf          [MC_NUM_WINDOWS];
+  Pel*                 m_mcWindowTmp;
+  int                  m_numMcWindows;
+  int                  m_nextMcWindow;
+
+  bool xPredInterBlkWindow      ( const PredictionUnit& pu, const Picture* refPic, const Mv& mv, PelBuf& dstBuf, const bool bi, const ClpRng& clpRng, const bool useAltHpelIf );
+
   void xIntraBlockCopy          (PredictionUnit &pu, PelUnitBuf &predBuf, const ComponentID compID);
   int             rightShiftMSB(int numer, int    denom);
   void            applyBiOptFlow(const PredictionUnit &pu, const CPelUnitBuf &yuvSrc0, const CPelUnitBuf &yuvSrc1, const int &refIdx0, const int &refIdx1, PelUnitBuf &yuvDst, const BitDepths &clipBitDepths);
@@ -197,6 +217,11 @@ public:
   bool isLumaBvValid(const int ctuSize, const int xCb, const int yCb, const int width, const int height, const int xBv, const int yBv);
 
   bool xPredInterBlkRPR( const std::pair<int, int>& scalingRatio, const PPS& pps, const CompArea &blk, const Picture* refPic, const Mv& mv, Pel* dst, const int dstStride, const bool bi, const bool wrapRef, const ClpRng& clpRng, const int filterIndex, const bool useAltHpelIf = false );
+
+  // the luma prediction of following motion compensations whose vectors have the phase of the base vectors is cut out of shared windows
+  void enableMcWindows( const PredictionUnit& pu, const MvField baseMv[NUM_REF_PIC_LIST_01] );
+  void disableMcWindows() { m_mcWindowsEnabled = false; }
+  void resetMcWindows() { m_numMcWindows = 0; m_nextMcWindow = 0; }
 };
 
 //! \}
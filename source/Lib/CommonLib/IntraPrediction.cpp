@@ -86,6 +86,17 @@ IntraPrediction::IntraPrediction()
 
   m_piTemp = nullptr;
   m_pMdlmTemp = nullptr;
+
+  m_predIntraPlanar       = xPredIntraPlanarCore;
+  m_sumRefSamples         = xSumRefSamplesCore;
+  m_pdpcPlanarDc          = xPdpcPlanarDcCore;
+  m_predIntraAngLumaRow   = xPredIntraAngLumaRowCore;
+  m_predIntraAngChromaRow = xPredIntraAngChromaRowCore;
+  m_filterRefSamples      = xFilterRefSamplesCore;
+
+#if ENABLE_SIMD_OPT_INTRAPRED && defined( TARGET_SIMD_X86 )
+  initIntraPredictionX86();
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -153,7 +164,7 @@ Pel IntraPrediction::xGetPredValDc( const CPelBuf &pSrc, const Size &dstSize )
 {
   CHECK( dstSize.width == 0 || dstSize.height == 0, "Empty area provided" );
 
-  int idx, sum = 0;
+  int sum = 0;
   Pel dcVal;
   const int width  = dstSize.width;
   const int height = dstSize.height;
@@ -163,17 +174,11 @@ Pel IntraPrediction::xGetPredValDc( const CPelBuf &pSrc, const Size &dstSize )
 
   if ( width >= height )
   {
-    for( idx = 0; idx < width; idx++ )
-    {
-      sum += pSrc.at(m_ipaParam.multiRefIndex + 1 + idx, 0);
-    }
+    sum += m_sumRefSamples( pSrc.bufAt( m_ipaParam.multiRefIndex + 1, 0 ), width );
   }
   if ( width <= height )
   {
-    for( idx = 0; idx < height; idx++ )
-    {
-      sum += pSrc.at(m_ipaParam.multiRefIndex + 1 + idx, 1);
-    }
+    sum += m_sumRefSamples( pSrc.bufAt( m_ipaParam.multiRefIndex + 1, 1 ), height );
   }
 
   dcVal = (sum + divOffset) >> divShift;
@@ -247,18 +252,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
     if (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX)
     {
-      for (int y = 0; y < iHeight; y++)
-      {
-        const int wT   = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(y + 1, 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const int wL    = 32 >> std::min(31, ((x << 1) >> scale));
-          const Pel top   = srcBuf.at(x + 1, 0);
-          const Pel val   = dstBuf.at(x, y);
-          dstBuf.at(x, y) = val + ((wL * (left - val) + wT * (top - val) + 32) >> 6);
-        }
-      }
+      m_pdpcPlanarDc( srcBuf.bufAt( 1, 0 ), srcBuf.bufAt( 1, 1 ), dstBuf.buf, dstBuf.stride, iWidth, iHeight, scale );
     }
   }
 }
@@ -291,9 +285,14 @@ void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred
 //NOTE: Bit-Limit - 24-bit source
 void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
 {
-  const uint32_t width  = pDst.width;
-  const uint32_t height = pDst.height;
+  CHECK(pDst.width > MAX_CU_SIZE, "width greater than limit");
+  CHECK(pDst.height > MAX_CU_SIZE, "height greater than limit");
+
+  m_predIntraPlanar( pSrc.bufAt( 1, 0 ), pSrc.bufAt( 1, 1 ), pDst.buf, pDst.stride, pDst.width, pDst.height );
+}
 
+void IntraPrediction::xPredIntraPlanarCore( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height )
+{
   const uint32_t log2W = floorLog2( width );
   const uint32_t log2H = floorLog2( height );
 
@@ -301,16 +300,14 @@ void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
   const uint32_t offset = 1 << (log2W + log2H);
 
   // Get left and above reference column and row
-  CHECK(width > MAX_CU_SIZE, "width greater than limit");
   for( int k = 0; k < width + 1; k++ )
   {
-    topRow[k] = pSrc.at( k + 1, 0 );
+    topRow[k] = top[k];
   }
 
-  CHECK(height > MAX_CU_SIZE, "height greater than limit");
   for( int k = 0; k < height + 1; k++ )
   {
-    leftColumn[k] = pSrc.at(k + 1, 1);
+    leftColumn[k] = left[k];
   }
 
   // Prepare intermediate variables used in interpolation
@@ -330,9 +327,8 @@ void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
   }
 
   const uint32_t finalShift = 1 + log2W + log2H;
-  const uint32_t stride     = pDst.stride;
-  Pel*       pred       = pDst.buf;
-  for( int y = 0; y < height; y++, pred += stride )
+  Pel*       pred       = dst;
+  for( int y = 0; y < height; y++, pred += dstStride )
   {
     int horPred = leftColumn[y];
 
@@ -353,6 +349,56 @@ void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const Cha
   pDst.fill( dcval );
 }
 
+int IntraPrediction::xSumRefSamplesCore( const Pel* ref, const int n )
+{
+  int sum = 0;
+  for( int idx = 0; idx < n; idx++ )
+  {
+    sum += ref[idx];
+  }
+  return sum;
+}
+
+void IntraPrediction::xPdpcPlanarDcCore( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const int scale )
+{
+  for (int y = 0; y < height; y++, dst += dstStride)
+  {
+    const int wT = 32 >> std::min(31, ((y << 1) >> scale));
+    for (int x = 0; x < width; x++)
+    {
+      const int wL  = 32 >> std::min(31, ((x << 1) >> scale));
+      const Pel val = dst[x];
+      dst[x]        = val + ((wL * (left[y] - val) + wT * (top[x] - val) + 32) >> 6);
+    }
+  }
+}
+
+void IntraPrediction::xPredIntraAngLumaRowCore( Pel* dst, const Pel* ref, const int width, const TFilterCoeff* f, const ClpRng& clpRng )
+{
+  for (int x = 0; x < width; x++)
+  {
+    const Pel val = (f[0] * ref[x] + f[1] * ref[x + 1] + f[2] * ref[x + 2] + f[3] * ref[x + 3] + 32) >> 6;
+
+    dst[x] = ClipPel(val, clpRng);   // always clip even though not always needed
+  }
+}
+
+void IntraPrediction::xPredIntraAngChromaRowCore( Pel* dst, const Pel* ref, const int width, const int deltaFract )
+{
+  for (int x = 0; x < width; x++)
+  {
+    dst[x] = ref[x] + ((deltaFract * (ref[x + 1] - ref[x]) + 16) >> 5);
+  }
+}
+
+void IntraPrediction::xFilterRefSamplesCore( const Pel* src, Pel* dst, const int length )
+{
+  for (int i = 1; i < length; i++)
+  {
+    dst[i] = (src[i - 1] + 2 * src[i] + src[i + 1] + 2) >> 2;
+  }
+}
+
 // Function for initialization of intra prediction parameters
 void IntraPrediction::initPredIntraParams(const PredictionUnit & pu, const CompArea area, const SPS& sps)
 {
@@ -576,32 +622,12 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
           const TFilterCoeff        intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
           const TFilterCoeff* const f                       = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
 
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[4];
-
-            p[0] = refMain[deltaInt + x];
-            p[1] = refMain[deltaInt + x + 1];
-            p[2] = refMain[deltaInt + x + 2];
-            p[3] = refMain[deltaInt + x + 3];
-
-            Pel val = (f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 32) >> 6;
-
-            pDsty[x] = ClipPel(val, clpRng);   // always clip even though not always needed
-          }
+          m_predIntraAngLumaRow(pDsty, refMain + deltaInt, width, f, clpRng);
         }
         else
         {
           // Do linear filtering
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[2];
-
-            p[0] = refMain[deltaInt + x + 1];
-            p[1] = refMain[deltaInt + x + 2];
-
-            pDsty[x] = p[0] + ((deltaFract * (p[1] - p[0]) + 16) >> 5);
-          }
+          m_predIntraAngChromaRow(pDsty, refMain + deltaInt + 1, width, deltaFract);
         }
       }
       else
@@ -1185,10 +1211,7 @@ void IntraPrediction::xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *
 
   refBufFiltered[0] = topLeft;
 
-  for (int i = 1; i < predSize; i++)
-  {
-    refBufFiltered[i] = (refBufUnfiltered[i - 1] + 2 * refBufUnfiltered[i] + refBufUnfiltered[i + 1] + 2) >> 2;
-  }
+  m_filterRefSamples(refBufUnfiltered, refBufFiltered, predSize);
   refBufFiltered[predSize] = refBufUnfiltered[predSize];
 
   refBufFiltered += predStride;
@@ -1196,10 +1219,7 @@ void IntraPrediction::xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *
 
   refBufFiltered[0] = topLeft;
 
-  for (int i = 1; i < predHSize; i++)
-  {
-    refBufFiltered[i] = (refBufUnfiltered[i - 1] + 2 * refBufUnfiltered[i] + refBufUnfiltered[i + 1] + 2) >> 2;
-  }
+  m_filterRefSamples(refBufUnfiltered, refBufFiltered, predHSize);
   refBufFiltered[predHSize] = refBufUnfiltered[predHSize];
 }
 
@@ -1809,7 +1829,7 @@ void IntraPrediction::xGetLMParameters(const PredictionUnit &pu, const Component
   }
 }
 
-void IntraPrediction::initIntraMip( const PredictionUnit &pu, const CompArea &area )
+void IntraPrediction::initIntraMip( const PredictionUnit &pu, const CompArea &area, const bool allModes )
 {
   CHECK( area.width > MIP_MAX_WIDTH || area.height > MIP_MAX_HEIGHT, "Error: block size not supported for MIP" );
 
@@ -1819,8 +1839,13 @@ void IntraPrediction::initIntraMip( const PredictionUnit &pu, const CompArea &ar
   const int  srcStride  = m_refBufferStride[area.compID];
   const int  srcHStride = 2;
 
-  m_matrixIntraPred.prepareInputForPred(CPelBuf(ptrSrc, srcStride, srcHStride), area,
-                                        pu.cu->slice->getSPS()->getBitDepth(toChannelType(area.compID)), area.compID);
+  const int  bitDepth   = pu.cu->slice->getSPS()->getBitDepth(toChannelType(area.compID));
+
+  m_matrixIntraPred.prepareInputForPred(CPelBuf(ptrSrc, srcStride, srcHStride), area, bitDepth, area.compID);
+  if( allModes )
+  {
+    m_matrixIntraPred.computeReducedPredAllModes(bitDepth);
+  }
 }
 
 void IntraPrediction::predIntraMip( const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu )
@@ -108,6 +108,32 @@ private:
   Pel* m_pMdlmTemp; // for MDLM mode
   MatrixIntraPrediction m_matrixIntraPred;
 
+  /// planar prediction from the top row top[0..width] and the left column left[0..height]
+  static void xPredIntraPlanarCore     ( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height );
+  /// sum of n reference samples, used for the DC value
+  static int  xSumRefSamplesCore       ( const Pel* ref, const int n );
+  /// position dependent combination of a planar or DC prediction with the top and left reference samples
+  static void xPdpcPlanarDcCore        ( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const int scale );
+  /// 4-tap (cubic or gauss) interpolation of one angular luma row, ref points to the first of the four taps
+  static void xPredIntraAngLumaRowCore ( Pel* dst, const Pel* ref, const int width, const TFilterCoeff* f, const ClpRng& clpRng );
+  /// linear interpolation of one angular chroma row
+  static void xPredIntraAngChromaRowCore( Pel* dst, const Pel* ref, const int width, const int deltaFract );
+  /// [1 2 1] smoothing of the reference samples 1..length-1
+  static void xFilterRefSamplesCore    ( const Pel* src, Pel* dst, const int length );
+
+  void ( *m_predIntraPlanar )       ( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height );
+  int  ( *m_sumRefSamples )         ( const Pel* ref, const int n );
+  void ( *m_pdpcPlanarDc )          ( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const int scale );
+  void ( *m_predIntraAngLumaRow )   ( Pel* dst, const Pel* ref, const int width, const TFilterCoeff* f, const ClpRng& clpRng );
+  void ( *m_predIntraAngChromaRow ) ( Pel* dst, const Pel* ref, const int width, const int deltaFract );
+  void ( *m_filterRefSamples )      ( const Pel* src, Pel* dst, const int length );
+
+#if ENABLE_SIMD_OPT_INTRAPRED && defined( TARGET_SIMD_X86 )
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
+
 
 
 protected:
@@ -161,7 +187,7 @@ public:
   void initIntraPatternChTypeISP  (const CodingUnit& cu, const CompArea& area, PelBuf& piReco, const bool forceRefFilterFlag = false); // use forceRefFilterFlag to get both filtered and unfiltered buffers
 
   // Matrix-based intra prediction
-  void initIntraMip               (const PredictionUnit &pu, const CompArea &area);
+  void initIntraMip               (const PredictionUnit &pu, const CompArea &area, const bool allModes = false); // use allModes when predicting many modes of the block
   void predIntraMip               (const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu);
 
   void geneWeightedPred           (const ComponentID compId, PelBuf &pred, const PredictionUnit &pu, Pel *srcBuf);
@@ -41,6 +41,31 @@
 #include "UnitTools.h"
 #include "MipData.h"
 
+// MIP matrices widened to 16 bit. The rows of the 16x16 matrices hold seven weights for the input samples 1..7
+// and are padded with a leading zero, so all rows of a size id have the input size as length.
+struct MipMatrices16Bit
+{
+  int16_t mip4x4  [16][16][4];
+  int16_t mip8x8  [ 8][16][8];
+  int16_t mip16x16[ 6][64][8];
+
+  MipMatrices16Bit()
+  {
+    std::copy( &mipMatrix4x4[0][0][0], &mipMatrix4x4[0][0][0] + sizeof( mipMatrix4x4 ), &mip4x4[0][0][0] );
+    std::copy( &mipMatrix8x8[0][0][0], &mipMatrix8x8[0][0][0] + sizeof( mipMatrix8x8 ), &mip8x8[0][0][0] );
+    for( int mode = 0; mode < 6; mode++ )
+    {
+      for( int row = 0; row < 64; row++ )
+      {
+        mip16x16[mode][row][0] = 0;
+        std::copy( mipMatrix16x16[mode][row], mipMatrix16x16[mode][row] + 7, &mip16x16[mode][row][1] );
+      }
+    }
+  }
+};
+
+static const MipMatrices16Bit g_mipMatrices16Bit;
+
 
 MatrixIntraPrediction::MatrixIntraPrediction():
   m_component(MAX_NUM_COMPONENT),
@@ -55,14 +80,22 @@ MatrixIntraPrediction::MatrixIntraPrediction():
   m_reducedBdrySize( 0 ),
   m_reducedPredSize( 0 ),
   m_upsmpFactorHor( 0 ),
-  m_upsmpFactorVer( 0 )
+  m_upsmpFactorVer( 0 ),
+  m_reducedPredAllModesValid( false )
 {
+  m_computeReducedPred     = computeReducedPredCore;
+  m_predictionUpsampling1D = predictionUpsampling1D;
+
+#if ENABLE_SIMD_OPT_MIP && defined( TARGET_SIMD_X86 )
+  initMatrixIntraPredictionX86();
+#endif
 }
 
 void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &pSrc, const Area &block, const int bitDepth,
                                                 const ComponentID compId)
 {
   m_component = compId;
+  m_reducedPredAllModesValid = false;
 
   // Step 1: Save block size and calculate dependent values
   initPredBlockParams(block);
@@ -123,19 +156,46 @@ void MatrixIntraPrediction::predBlock(int *const result, const int modeIdx, cons
   CHECK(m_component != compId, "Boundary has not been prepared for this component.");
 
   const bool needUpsampling = ( m_upsmpFactorHor > 1 ) || ( m_upsmpFactorVer > 1 );
+  const int  outputSize     = m_reducedPredSize * m_reducedPredSize;
 
-  const uint8_t* matrix = getMatrixData(modeIdx);
+  if( m_reducedPredAllModesValid )
+  {
+    const int* const reducedPred = m_reducedPredAllModes[transpose ? 1 : 0] + modeIdx * outputSize;
+    if( needUpsampling )
+    {
+      predictionUpsampling( result, reducedPred );
+    }
+    else
+    {
+      std::copy( reducedPred, reducedPred + outputSize, result );
+    }
+    return;
+  }
 
-  static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> bufReducedPred( m_reducedPredSize * m_reducedPredSize );
+  const int16_t* matrix = getMatrixData(modeIdx);
+
+  static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> bufReducedPred( outputSize );
   int* const       reducedPred     = needUpsampling ? bufReducedPred.data() : result;
   const int* const reducedBoundary = transpose ? m_reducedBoundaryTransposed.data() : m_reducedBoundary.data();
-  computeReducedPred(reducedPred, reducedBoundary, matrix, transpose, bitDepth);
+  computeReducedPred(reducedPred, reducedBoundary, matrix, outputSize, transpose, bitDepth);
   if( needUpsampling )
   {
     predictionUpsampling( result, reducedPred );
   }
 }
 
+void MatrixIntraPrediction::computeReducedPredAllModes(const int bitDepth)
+{
+  // the matrices of all modes of a size id are stored consecutively, so all modes form one matrix
+  const int numOutputs = getNumModesMip( m_blockSize ) * m_reducedPredSize * m_reducedPredSize;
+  CHECK( numOutputs > MIP_MAX_REDUCED_OUTPUT_ALL_MODES, "Too many MIP outputs" );
+
+  computeReducedPred( m_reducedPredAllModes[0], m_reducedBoundary.data(),           getMatrixData( 0 ), numOutputs, false, bitDepth );
+  computeReducedPred( m_reducedPredAllModes[1], m_reducedBoundaryTransposed.data(), getMatrixData( 0 ), numOutputs, true,  bitDepth );
+
+  m_reducedPredAllModesValid = true;
+}
+
 
 void MatrixIntraPrediction::initPredBlockParams(const Size& block)
 {
@@ -251,7 +311,7 @@ void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* con
     verSrc = horDst;
     verSrcStep *= m_upsmpFactorVer;
 
-    predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
+    m_predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
                             m_reducedPredSize, m_reducedPredSize,
                             1, m_reducedPredSize, 1, verSrcStep,
                             m_upsmpFactorVer, m_upsmpFactorHor );
@@ -259,35 +319,36 @@ void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* con
 
   if( m_upsmpFactorVer > 1 )
   {
-    predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
+    m_predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
                             m_reducedPredSize, m_blockSize.width,
                             verSrcStep, 1, m_blockSize.width, 1,
                             1, m_upsmpFactorVer );
   }
 }
 
-const uint8_t* MatrixIntraPrediction::getMatrixData(const int modeIdx) const
+const int16_t* MatrixIntraPrediction::getMatrixData(const int modeIdx) const
 {
   switch( m_sizeId )
   {
-  case 0: return &mipMatrix4x4[modeIdx][0][0];
+  case 0: return &g_mipMatrices16Bit.mip4x4[modeIdx][0][0];
 
-  case 1: return &mipMatrix8x8[modeIdx][0][0];
+  case 1: return &g_mipMatrices16Bit.mip8x8[modeIdx][0][0];
 
-  case 2: return &mipMatrix16x16[modeIdx][0][0];
+  case 2: return &g_mipMatrices16Bit.mip16x16[modeIdx][0][0];
 
   default: THROW( "Invalid mipSizeId" );
   }
 }
 
 void MatrixIntraPrediction::computeReducedPred( int*const result, const int* const input,
-                                                const uint8_t* matrix,
+                                                const int16_t* matrix, const int numOutputs,
                                                 const bool transpose, const int bitDepth )
 {
-  const int inputSize = 2 * m_reducedBdrySize;
+  const int inputSize  = getMatrixInputSize();
+  const int outputSize = m_reducedPredSize * m_reducedPredSize;
 
   // use local buffer for transposed result
-  static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredSize * m_reducedPredSize );
+  static_vector<int, MIP_MAX_REDUCED_OUTPUT_ALL_MODES> resBufTransposed( numOutputs );
   int*const resPtr = (transpose) ? resBufTransposed.data() : result;
 
   int sum = 0;
@@ -295,41 +356,44 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
   const int offset = (1 << (MIP_SHIFT_MATRIX - 1)) - MIP_OFFSET_MATRIX * sum;
   CHECK( inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four" );
 
-  const uint8_t *weight = matrix;
-  const int   inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
+  const int inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
+
+  m_computeReducedPred( resPtr, input, matrix, inputSize, numOutputs, offset, inputOffset, bitDepth );
 
-  const bool redSize = (m_sizeId == 2);
-  int posRes = 0;
-  for( int y = 0; y < m_reducedPredSize; y++ )
+  if( transpose )
   {
-    for( int x = 0; x < m_reducedPredSize; x++ )
+    for( int pos = 0; pos < numOutputs; pos += outputSize )
     {
-      if( redSize ) weight -= 1;
-      int tmp0 = redSize ? 0 : (input[0] * weight[0]);
-      int tmp1 = input[1] * weight[1];
-      int tmp2 = input[2] * weight[2];
-      int tmp3 = input[3] * weight[3];
-      for (int i = 4; i < inputSize; i += 4)
+      for( int y = 0; y < m_reducedPredSize; y++ )
       {
-        tmp0 += input[i]     * weight[i];
-        tmp1 += input[i + 1] * weight[i + 1];
-        tmp2 += input[i + 2] * weight[i + 2];
-        tmp3 += input[i + 3] * weight[i + 3];
+        for( int x = 0; x < m_reducedPredSize; x++ )
+        {
+          result[ pos + y * m_reducedPredSize + x ] = resPtr[ pos + x * m_reducedPredSize + y ];
+        }
       }
-      resPtr[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
-
-      weight += inputSize;
     }
   }
+}
 
-  if( transpose )
+void MatrixIntraPrediction::computeReducedPredCore( int* const result, const int* const input, const int16_t* matrix, const int inputSize, const int numOutputs,
+                                                    const int offset, const int inputOffset, const int bitDepth )
+{
+  const int16_t *weight = matrix;
+  for( int posRes = 0; posRes < numOutputs; posRes++ )
   {
-    for( int y = 0; y < m_reducedPredSize; y++ )
+    int tmp0 = input[0] * weight[0];
+    int tmp1 = input[1] * weight[1];
+    int tmp2 = input[2] * weight[2];
+    int tmp3 = input[3] * weight[3];
+    for (int i = 4; i < inputSize; i += 4)
     {
-      for( int x = 0; x < m_reducedPredSize; x++ )
-      {
-        result[ y * m_reducedPredSize + x ] = resPtr[ x * m_reducedPredSize + y ];
-      }
+      tmp0 += input[i]     * weight[i];
+      tmp1 += input[i + 1] * weight[i + 1];
+      tmp2 += input[i + 2] * weight[i + 2];
+      tmp3 += input[i + 3] * weight[i + 3];
     }
+    result[posRes] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
+
+    weight += inputSize;
   }
 }
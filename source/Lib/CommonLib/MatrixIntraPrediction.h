@@ -43,6 +43,10 @@
 
 static const int MIP_MAX_INPUT_SIZE             =  8;
 static const int MIP_MAX_REDUCED_OUTPUT_SAMPLES = 64;
+static const int MIP_MAX_REDUCED_OUTPUT_ALL_MODES = 6 * 64;   // number of modes times reduced output samples, maximum over the size ids
+
+static const uint8_t MIP_SHIFT_MATRIX  =  6;
+static const uint8_t MIP_OFFSET_MATRIX = 32;
 
 
 class MatrixIntraPrediction
@@ -53,6 +57,9 @@ public:
   void prepareInputForPred(const CPelBuf &pSrc, const Area &block, const int bitDepth, const ComponentID compId);
   void predBlock(int *const result, const int modeIdx, const bool transpose, const int bitDepth,
                  const ComponentID compId);
+  /// compute the reduced predictions of all modes, with and without transposition, of the prepared boundary
+  /// as one matrix product, subsequent predBlock calls only upsample
+  void computeReducedPredAllModes(const int bitDepth);
 
   private:
     ComponentID m_component;
@@ -71,6 +78,9 @@ public:
     unsigned int m_upsmpFactorHor;
     unsigned int m_upsmpFactorVer;
 
+    bool m_reducedPredAllModesValid;
+    int  m_reducedPredAllModes[2][MIP_MAX_REDUCED_OUTPUT_ALL_MODES];
+
     void initPredBlockParams(const Size& block);
 
     static void boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen);
@@ -83,12 +93,32 @@ public:
                                         const SizeType bndryStep,
                                         const unsigned int upsmpFactor );
 
-    const uint8_t* getMatrixData(const int modeIdx) const;
+    const int16_t* getMatrixData(const int modeIdx) const;
+    int            getMatrixInputSize() const { return 2 * m_reducedBdrySize; }
 
 
     void computeReducedPred( int*const result, const int* const input,
-                             const uint8_t* matrix,
+                             const int16_t* matrix, const int numOutputs,
                              const bool transpose, const int bitDepth );
+
+    /// numOutputs products of the matrix rows, padded to inputSize entries, with the input followed by the rounding, the offset and clipping
+    static void computeReducedPredCore( int* const result, const int* const input, const int16_t* matrix, const int inputSize, const int numOutputs,
+                                        const int offset, const int inputOffset, const int bitDepth );
+
+    void ( *m_computeReducedPred )   ( int* const result, const int* const input, const int16_t* matrix, const int inputSize, const int numOutputs,
+                                       const int offset, const int inputOffset, const int bitDepth );
+    void ( *m_predictionUpsampling1D )( int* const dst, const int* const src, const int* const bndry,
+                                        const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                        const SizeType srcStep, const SizeType srcStride,
+                                        const SizeType dstStep, const SizeType dstStride,
+                                        const SizeType bndryStep,
+                                        const unsigned int upsmpFactor );
+
+#if ENABLE_SIMD_OPT_MIP && defined( TARGET_SIMD_X86 )
+    void initMatrixIntraPredictionX86();
+    template <X86_VEXT vext>
+    void _initMatrixIntraPredictionX86();
+#endif
   };
 
 #endif //__MATRIXINTRAPPREDICTION__
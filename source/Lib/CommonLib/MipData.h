@@ -35,9 +35,6 @@
 \brief    weight and bias data for matrix-based intra prediction (MIP)
 */
 
-static const uint8_t MIP_SHIFT_MATRIX  =  6;
-static const uint8_t MIP_OFFSET_MATRIX = 32;
-
 ALIGN_DATA(MEMORY_ALIGN_DEF_SIZE, const uint8_t mipMatrix4x4[16][16][4]) =
 {
   {
@@ -120,6 +120,7 @@ struct NALUnit
 };
 
 struct OutputNALUnit;
+class InputNALUnit;
 
 /**
  * A single NALunit, with complete payload in EBSP format.
@@ -134,6 +135,13 @@ struct NALUnitEBSP : public NALUnit
    * emulation_prevention_three_byte symbols.
    */
   NALUnitEBSP(OutputNALUnit& nalu);
+
+  /**
+   * write the InputNALUnit nalu unchanged, restoring the
+   * emulation_prevention_three_byte symbols of the input
+   * instead of repeating the anti-emulation.
+   */
+  NALUnitEBSP(const InputNALUnit& nalu);
 };
 //! \}
 //! \}
@@ -73,10 +73,15 @@ Picture::Picture()
   m_spliceIdx = NULL;
   m_ctuNums = 0;
   layerId = NOT_VALID;
+#if !KEEP_PRED_AND_RESI_SIGNALS
+  m_ctuSizedTempBufs = true;
+#endif
+  m_hasSplitBufs = false;
   numSlices = 1;
   unscaledPic = nullptr;
   m_isMctfFiltered      = false;
   m_grainCharacteristic = NULL;
+  m_mePyramidValid      = false;
   m_grainBuf            = NULL;
 }
 
@@ -112,9 +117,15 @@ void Picture::destroy()
 {
   for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
   {
-    M_BUFS(jId, t).destroy();
+    M_BUFS(0, t).destroy();
   }
+  destroySplitBuffers();
   m_hashMap.clearAll();
+  for( int level = 0; level < ME_PYRAMID_LEVELS; level++ )
+  {
+    m_mePyramid[level].destroy();
+  }
+  m_mePyramidValid = false;
   if (cs)
   {
 #if GDR_ENABLED
@@ -150,16 +161,18 @@ void Picture::destroy()
   m_grainBuf           = NULL;
 }
 
-void Picture::createTempBuffers( const unsigned _maxCUSize )
+void Picture::createTempBuffers( const unsigned _maxCUSize, const bool pictureSized )
 {
 #if KEEP_PRED_AND_RESI_SIGNALS
   const Area a( Position{ 0, 0 }, lumaSize() );
 #else
-  const Area a = m_ctuArea.Y();
+  // picture sized buffers are needed when several CTUs are reconstructed at the same time
+  m_ctuSizedTempBufs = !pictureSized;
+  const Area a = pictureSized ? Area( Position{ 0, 0 }, lumaSize() ) : m_ctuArea.Y();
 #endif
 
-  M_BUFS( jId, PIC_PREDICTION                   ).create( chromaFormat, a,   _maxCUSize );
-  M_BUFS( jId, PIC_RESIDUAL                     ).create( chromaFormat, a,   _maxCUSize );
+  M_BUFS( 0, PIC_PREDICTION                     ).create( chromaFormat, a,   _maxCUSize );
+  M_BUFS( 0, PIC_RESIDUAL                       ).create( chromaFormat, a,   _maxCUSize );
 
   if (cs)
   {
@@ -183,6 +196,51 @@ void Picture::destroyTempBuffers()
   }
 }
 
+thread_local int Picture::s_splitJobId = 0;
+
+void Picture::createSplitBuffers( const unsigned _maxCUSize )
+{
+#if KEEP_PRED_AND_RESI_SIGNALS
+  const Area t( Position{ 0, 0 }, lumaSize() );
+#else
+  const Area t = m_ctuArea.Y();
+#endif
+  const Area a( Position{ 0, 0 }, lumaSize() );
+
+  for( int jId = 1; jId <= PARL_SPLIT_MAX_NUM_JOBS; jId++ )
+  {
+    M_BUFS( jId, PIC_RECONSTRUCTION ).create( chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    M_BUFS( jId, PIC_PREDICTION     ).create( chromaFormat, t, _maxCUSize );
+    M_BUFS( jId, PIC_RESIDUAL       ).create( chromaFormat, t, _maxCUSize );
+  }
+  m_hasSplitBufs = true;
+}
+
+void Picture::destroySplitBuffers()
+{
+  for( int jId = 1; jId <= PARL_SPLIT_MAX_NUM_JOBS; jId++ )
+  {
+    for( uint32_t t = 0; t < NUM_PIC_TYPES; t++ )
+    {
+      M_BUFS( jId, t ).destroy();
+    }
+  }
+  m_hasSplitBufs = false;
+}
+
+void Picture::copyRecoToSplitBuffer( const int jobId, const UnitArea& area )
+{
+  CHECK( jobId < 1 || jobId > PARL_SPLIT_MAX_NUM_JOBS, "Invalid split job id" );
+
+  const UnitArea clipped = clipArea( area, *this );
+  M_BUFS( jobId, PIC_RECONSTRUCTION ).getBuf( clipped ).copyFrom( M_BUFS( 0, PIC_RECONSTRUCTION ).getBuf( clipped ) );
+}
+
+int Picture::xGetSplitPicId( const PictureType type ) const
+{
+  return ( type == PIC_RECONSTRUCTION || type == PIC_PREDICTION || type == PIC_RESIDUAL ) ? s_splitJobId : 0;
+}
+
        PelBuf     Picture::getOrigBuf(const CompArea &blk)        { return getBuf(blk,  PIC_ORIGINAL); }
 const CPelBuf     Picture::getOrigBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_ORIGINAL); }
        PelUnitBuf Picture::getOrigBuf(const UnitArea &unit)       { return getBuf(unit, PIC_ORIGINAL); }
@@ -220,8 +278,8 @@ const CPelBuf     Picture::getRecoBuf(const ComponentID compID, bool wrap) const
 const CPelBuf     Picture::getRecoBuf(const CompArea &blk, bool wrap)      const { return getBuf(blk,                       wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
        PelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)           { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 const CPelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)     const { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
+       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return M_BUFS(getSplitPicId(wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
+const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return M_BUFS(getSplitPicId(wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 
 void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps )
 {
@@ -242,7 +300,7 @@ void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHead
   }
   else
   {
-    cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+    cs = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
     cs->sps = &sps;
     cs->create(chromaFormatIDC, Area(0, 0, iWidth, iHeight), true, (bool)sps.getPLTMode());
   }
@@ -1075,12 +1133,12 @@ void Picture::extendWrapBorder( const PPS *pps )
 
 PelBuf Picture::getBuf( const ComponentID compID, const PictureType &type )
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( getSplitPicId( type ), type ).getBuf( compID );
 }
 
 const CPelBuf Picture::getBuf( const ComponentID compID, const PictureType &type ) const
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( getSplitPicId( type ), type ).getBuf( compID );
 }
 
 PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
@@ -1091,17 +1149,17 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
   }
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( type == PIC_RESIDUAL || type == PIC_PREDICTION )
+  if( m_ctuSizedTempBufs && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     CompArea localBlk = blk;
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return M_BUFS( getSplitPicId( type ), type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return M_BUFS( getSplitPicId( type ), type ).getBuf( blk );
 }
 
 const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) const
@@ -1112,17 +1170,17 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
   }
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( type == PIC_RESIDUAL || type == PIC_PREDICTION )
+  if( m_ctuSizedTempBufs && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     CompArea localBlk = blk;
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return M_BUFS( getSplitPicId( type ), type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return M_BUFS( getSplitPicId( type ), type ).getBuf( blk );
 }
 
 PelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type )
@@ -1151,7 +1209,7 @@ const CPelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type
 
 Pel* Picture::getOrigin( const PictureType &type, const ComponentID compID ) const
 {
-  return M_BUFS( jId, type ).getOrigin( compID );
+  return M_BUFS( getSplitPicId( type ), type ).getOrigin( compID );
 }
 
 void Picture::createSpliceIdx(int nums)
@@ -1178,10 +1236,19 @@ bool Picture::getSpliceFull()
   return true;
 }
 
-void Picture::addPictureToHashMapForInter()
+void Picture::addPictureToHashMapForInter( TComHashPyramid* hashPyramid )
 {
   int picWidth = slices[0]->getPPS()->getPicWidthInLumaSamples();
   int picHeight = slices[0]->getPPS()->getPicHeightInLumaSamples();
+
+  if (hashPyramid)
+  {
+    m_hashMap.create(picWidth, picHeight);
+    hashPyramid->addPictureToHashMap(m_hashMap, getOrigBuf(), picWidth, picHeight, slices[0]->getSPS()->getBitDepths());
+    m_hashMap.setInitial();
+    return;
+  }
+
   uint32_t* blockHashValues[2][2];
   bool* bIsBlockSame[2][3];
 
@@ -1230,6 +1297,41 @@ void Picture::addPictureToHashMapForInter()
   }
 }
 
+void Picture::buildMePyramid()
+{
+  CPelBuf src = getRecoBuf( COMPONENT_Y );
+
+  for( int level = 0; level < ME_PYRAMID_LEVELS; level++ )
+  {
+    const int width  = src.width >> 1;
+    const int height = src.height >> 1;
+    if( m_mePyramid[level].bufs.empty() || m_mePyramid[level].Y().width != width || m_mePyramid[level].Y().height != height )
+    {
+      m_mePyramid[level].destroy();
+      m_mePyramid[level].create( CHROMA_400, Area( 0, 0, width, height ) );
+    }
+
+    PelBuf dst = m_mePyramid[level].Y();
+    subsampleMePyramidLevel( src, dst );
+    src = dst;
+  }
+  m_mePyramidValid = true;
+}
+
+void Picture::subsampleMePyramidLevel( const CPelBuf& src, const PelBuf& dst )
+{
+  for( int y = 0; y < dst.height; y++ )
+  {
+    const Pel* src0 = src.bufAt( 0, 2 * y );
+    const Pel* src1 = src0 + src.stride;
+    Pel*       dstY = dst.buf + y * dst.stride;
+    for( int x = 0; x < dst.width; x++ )
+    {
+      dstY[x] = ( src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+}
+
 void Picture::createGrainSynthesizer(bool firstPictureInSequence, SEIFilmGrainSynthesizer *grainCharacteristics, PelStorage *grainBuf, int width, int height, ChromaFormat fmt, int bitDepth)
 {
   m_grainCharacteristic = grainCharacteristics;
@@ -1286,7 +1388,7 @@ PelUnitBuf Picture::getDisplayBufFG(bool wrap)
     {
       msg(WARNING, "Film Grain synthesis is not performed. Error code: 0x%x \n", m_grainCharacteristic->m_errorCode);
     }
-    return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION);
+    return M_BUFS(getSplitPicId(wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION);
   }
 }
 
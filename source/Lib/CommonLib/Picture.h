@@ -57,7 +57,7 @@ class AQpLayer;
 
 typedef std::list<SEI*> SEIMessages;
 
-#define M_BUFS(JID,PID) m_bufs[PID]
+#define M_BUFS(JID,PID) getJobBufs(JID)[PID]
 
 struct Picture : public UnitArea
 {
@@ -67,8 +67,22 @@ struct Picture : public UnitArea
   void create(const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned margin, const bool bDecoder, const int layerId, const bool gopBasedTemporalFilterEnabled = false, const bool fgcSEIAnalysisEnabled = false);
   void destroy();
 
-  void createTempBuffers( const unsigned _maxCUSize );
+  void createTempBuffers( const unsigned _maxCUSize, const bool pictureSized = false );
   void destroyTempBuffers();
+#if KEEP_PRED_AND_RESI_SIGNALS
+  bool hasCtuSizedTempBuffers() const { return false; }
+#else
+  bool hasCtuSizedTempBuffers() const { return m_ctuSizedTempBufs; }
+#endif
+
+  void createSplitBuffers( const unsigned _maxCUSize );
+  void destroySplitBuffers();
+  void copyRecoToSplitBuffer( const int jobId, const UnitArea& area );
+
+  static void setSplitJobId( const int jobId ) { s_splitJobId = jobId; }
+  static int  getSplitJobId()                  { return s_splitJobId; }
+  // the thread local job id is only looked up for the picture whose CUs are split in parallel
+  int         getSplitPicId( const PictureType type ) const { return m_hasSplitBufs ? xGetSplitPicId( type ) : 0; }
 
   int                       m_padValue;
   bool                      m_isMctfFiltered;
@@ -218,13 +232,28 @@ public:
   bool mixedNaluTypesInPicFlag;
 
   PelStorage m_bufs[NUM_PIC_TYPES];
+  PelStorage m_splitBufs[PARL_SPLIT_MAX_NUM_JOBS][NUM_PIC_TYPES];   ///< reco/pred/resi of the parallel split jobs (encoder only)
+  bool       m_hasSplitBufs;                                             ///< the split job buffers are allocated
+  static thread_local int s_splitJobId;
+  int         xGetSplitPicId( const PictureType type ) const;
+        PelStorage* getJobBufs( const int jId )       { return jId > 0 ? m_splitBufs[jId - 1] : m_bufs; }
+  const PelStorage* getJobBufs( const int jId ) const { return jId > 0 ? m_splitBufs[jId - 1] : m_bufs; }
   const Picture*           unscaledPic;
 
   TComHash           m_hashMap;
   TComHash*          getHashMap() { return &m_hashMap; }
   const TComHash*    getHashMap() const { return &m_hashMap; }
-  void               addPictureToHashMapForInter();
+  void               addPictureToHashMapForInter( TComHashPyramid* hashPyramid = nullptr );
+
+  PelStorage         m_mePyramid[ME_PYRAMID_LEVELS];                ///< luma reconstruction subsampled by 2, 4, ... (encoder only)
+  bool               m_mePyramidValid;
+  void               buildMePyramid();
+  static void        subsampleMePyramidLevel( const CPelBuf& src, const PelBuf& dst );
+  void               invalidateMePyramid()                    { m_mePyramidValid = false; }
+  bool               hasMePyramid() const                     { return m_mePyramidValid; }
+  CPelBuf            getMePyramid( const int level ) const    { return m_mePyramid[level - 1].get( COMPONENT_Y ); }
 
+  XUCache            m_unitCache;                                   ///< units of cs, owned by the picture to be independent of other pictures
   CodingStructure*   cs;
   std::deque<Slice*> slices;
   SEIMessages        SEIs;
@@ -253,6 +282,7 @@ public:
 #if !KEEP_PRED_AND_RESI_SIGNALS
 private:
   UnitArea m_ctuArea;
+  bool     m_ctuSizedTempBufs;    ///< the prediction and residual buffers hold one CTU and are addressed modulo the CTU size
 #endif
 
 public:
@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <iomanip>
+#include <mutex>
 
 // ====================================================================================================================
 // Initialize / destroy functions
@@ -274,9 +275,18 @@ uint32_t g_log2SbbSize[MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1][2] =
   { { 4,0 },{ 3,1 },{ 2,2 },{ 2,2 },{ 2,2 },{ 2,2 },{ 2,2 },{ 2,2 } },
   { { 4,0 },{ 3,1 },{ 2,2 },{ 2,2 },{ 2,2 },{ 2,2 },{ 2,2 },{ 2,2 } }
 };
+static std::mutex s_romMutex;
+static int        s_romRefCount = 0;
+
 // initialize ROM variables
 void initROM()
 {
+  std::unique_lock<std::mutex> lock( s_romMutex );
+  if( s_romRefCount++ > 0 )
+  {
+    return;
+  }
+
   gp_sizeIdxInfo = new SizeIndexInfoLog2();
   gp_sizeIdxInfo->init(MAX_CU_SIZE);
 
@@ -418,8 +428,6 @@ void initROM()
 
   initGeoTemplate();
 
-  ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
-
   for (int qp = 0; qp < 57; qp++)
   {
     int qpRem = (qp + 12) % 6;
@@ -433,6 +441,13 @@ void initROM()
 
 void destroyROM()
 {
+  std::unique_lock<std::mutex> lock( s_romMutex );
+  CHECK( s_romRefCount <= 0, "ROM is not initialized" );
+  if( --s_romRefCount > 0 )
+  {
+    return;
+  }
+
   unsigned numWidths = gp_sizeIdxInfo->numAllWidths();
   unsigned numHeights = gp_sizeIdxInfo->numAllHeights();
 
@@ -686,9 +701,6 @@ const uint32_t g_scalingListId[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM] =
 };
 
 
-Mv   g_reusedUniMVs[32][32][8][8][2][33];
-bool g_isReusedUniMVsFilled[32][32][8][8];
-
 uint16_t g_paletteQuant[57];
 uint8_t g_paletteRunTopLut [5] = { 0, 1, 1, 2, 2 };
 uint8_t g_paletteRunLeftLut[5] = { 0, 1, 2, 3, 4 };
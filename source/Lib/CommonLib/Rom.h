@@ -52,6 +52,7 @@
 // Initialize / destroy functions
 // ====================================================================================================================
 
+// the tables are shared by all users in the process, they are created by the first initROM() and freed by the last destroyROM()
 void         initROM();
 void         destroyROM();
 
@@ -212,10 +213,6 @@ constexpr uint8_t g_tbMax[257] = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3,
 
 extern bool g_mctsDecCheckEnabled;
 
-class  Mv;
-extern Mv   g_reusedUniMVs[32][32][8][8][2][33];
-extern bool g_isReusedUniMVsFilled[32][32][8][8];
-
 extern uint16_t g_paletteQuant[57];
 extern uint8_t g_paletteRunTopLut[5];
 extern uint8_t g_paletteRunLeftLut[5];
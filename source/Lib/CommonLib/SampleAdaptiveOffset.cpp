@@ -113,6 +113,14 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
   m_numberOfComponents = 0;
+
+  m_offsetLineEO  = offsetLineEOCore;
+  m_offsetBlockBO = offsetBlockBOCore;
+  m_statsLineEO   = statsLineEOCore;
+
+#if ENABLE_SIMD_OPT_SAO && defined( TARGET_SIMD_X86 )
+  initSampleAdaptiveOffsetX86();
+#endif
 }
 
 
@@ -296,6 +304,19 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
                                           , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
   )
 {
+  if (typeIdx == SAO_TYPE_BO)
+  {
+    m_offsetBlockBO(srcBlk, resBlk, srcStride, resStride, width, height, offset, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2, clpRng);
+    return;
+  }
+  if (!isCtuCrossedByVirtualBoundaries)
+  {
+    xOffsetBlockEO(typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height, clpRng, isLeftAvail, isRightAvail,
+                   isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail);
+    return;
+  }
+
+  // virtual boundaries disable the filtering of single samples
   int x,y, startX, startY, endX, endY, edgeType;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
   int8_t signLeft, signRight, signDown;
@@ -525,18 +546,61 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
       }
     }
     break;
-  case SAO_TYPE_BO:
+  default:
     {
-      const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
+      THROW("Not a supported SAO types\n");
+    }
+  }
+}
+
+void SampleAdaptiveOffset::xOffsetBlockEO(int typeIdx, const int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height, const ClpRng& clpRng
+                                          , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail)
+{
+  const int startX = isLeftAvail ? 0 : 1;
+  const int endX   = isRightAvail ? width : (width - 1);
+
+  switch(typeIdx)
+  {
+  case SAO_TYPE_EO_0:
+    {
+      for (int y = 0; y < height; y++)
       {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
+        m_offsetLineEO(srcBlk + y * srcStride, resBlk + y * resStride, -1, 1, startX, endX, offset, clpRng);
+      }
+    }
+    break;
+  case SAO_TYPE_EO_90:
+    {
+      const int startY = isAboveAvail ? 0 : 1;
+      const int endY   = isBelowAvail ? height : height - 1;
+      for (int y = startY; y < endY; y++)
+      {
+        m_offsetLineEO(srcBlk + y * srcStride, resBlk + y * resStride, -srcStride, srcStride, 0, width, offset, clpRng);
+      }
+    }
+    break;
+  case SAO_TYPE_EO_135:
+    {
+      const ptrdiff_t nbOffset = srcStride + 1;
+      m_offsetLineEO(srcBlk, resBlk, -nbOffset, nbOffset, isAboveLeftAvail ? 0 : 1, isAboveAvail ? endX : 1, offset, clpRng);
+      for (int y = 1; y < height - 1; y++)
+      {
+        m_offsetLineEO(srcBlk + y * srcStride, resBlk + y * resStride, -nbOffset, nbOffset, startX, endX, offset, clpRng);
       }
+      m_offsetLineEO(srcBlk + (height - 1) * srcStride, resBlk + (height - 1) * resStride, -nbOffset, nbOffset,
+                     isBelowAvail ? startX : (width - 1), isBelowRightAvail ? width : (width - 1), offset, clpRng);
+    }
+    break;
+  case SAO_TYPE_EO_45:
+    {
+      const ptrdiff_t nbOffset = srcStride - 1;
+      m_offsetLineEO(srcBlk, resBlk, -nbOffset, nbOffset, isAboveAvail ? startX : (width - 1), isAboveRightAvail ? width : (width - 1), offset, clpRng);
+      for (int y = 1; y < height - 1; y++)
+      {
+        m_offsetLineEO(srcBlk + y * srcStride, resBlk + y * resStride, -nbOffset, nbOffset, startX, endX, offset, clpRng);
+      }
+      m_offsetLineEO(srcBlk + (height - 1) * srcStride, resBlk + (height - 1) * resStride, -nbOffset, nbOffset,
+                     isBelowLeftAvail ? 0 : 1, isBelowAvail ? endX : 1, offset, clpRng);
     }
     break;
   default:
@@ -546,6 +610,38 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   }
 }
 
+void SampleAdaptiveOffset::offsetLineEOCore(const Pel* srcLine, Pel* resLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng)
+{
+  for (int x = startX; x < endX; x++)
+  {
+    const int edgeType = sgn(srcLine[x] - srcLine[x + nbOffsetA]) + sgn(srcLine[x] - srcLine[x + nbOffsetB]) + 2;
+    resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
+  }
+}
+
+void SampleAdaptiveOffset::offsetBlockBOCore(const Pel* srcBlk, Pel* resBlk, const int srcStride, const int resStride, const int width, const int height, const int* offset, const int shiftBits, const ClpRng& clpRng)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      resBlk[x] = ClipPel<int>(srcBlk[x] + offset[srcBlk[x] >> shiftBits], clpRng);
+    }
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::statsLineEOCore(const Pel* srcLine, const Pel* orgLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, int64_t* diff, int64_t* count)
+{
+  for (int x = startX; x < endX; x++)
+  {
+    const int edgeType = sgn(srcLine[x] - srcLine[x + nbOffsetA]) + sgn(srcLine[x] - srcLine[x + nbOffsetB]) + 2;
+    diff [edgeType] += (orgLine[x] - srcLine[x]);
+    count[edgeType] ++;
+  }
+}
+
 void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs)
 {
   const uint32_t numberOfComponents = getNumberValidComponents( area.chromaFormat );
@@ -602,7 +698,7 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
       }
 
       offsetBlock( cs.sps->getBitDepth(toChannelType(compID)),
-                   cs.slice->clpRng(compID),
+                   cs.getCU( area.lumaPos(), CH_L )->slice->clpRng(compID),
                    ctbOffset.typeIdc, ctbOffset.offset
                   , srcBlk, resBlk, srcStride, resStride, compArea.width, compArea.height
                   , isLeftAvail, isRightAvail
@@ -615,8 +711,7 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
   } //compIdx
 }
 
-void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
-                                      )
+bool SampleAdaptiveOffset::SAOPrepareCtuRows( CodingStructure& cs, SAOBlkParam* saoBlkParams )
 {
   CHECK(!saoBlkParams, "No parameters present");
 
@@ -631,7 +726,44 @@ void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkP
       bAllDisabled = false;
     }
   }
-  if (bAllDisabled)
+  return !bAllDisabled;
+}
+
+void SampleAdaptiveOffset::SAOProcessCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  PelUnitBuf rec = cs.getRecoBuf();
+
+  // copy the deblocked samples of the row and the first line of the row below, the lines above were copied with the
+  // previous row and might already be overwritten by its SAO output
+  const int yPos   = ctuRow * pcv.maxCUHeight;
+  const int height = std::min<int>( pcv.maxCUHeight, pcv.lumaHeight - yPos );
+  for( uint32_t compIdx = 0; compIdx < getNumberValidComponents( cs.area.chromaFormat ); compIdx++ )
+  {
+    const ComponentID compID = ComponentID( compIdx );
+    const int scaleY     = ::getComponentScaleY( compID, cs.area.chromaFormat );
+    const int compHeight = pcv.lumaHeight >> scaleY;
+    const int lineStart  = ctuRow == 0 ? 0 : ( yPos >> scaleY ) + 1;
+    const int lineEnd    = std::min( ( ( yPos + height ) >> scaleY ) + 1, compHeight );
+    const int compWidth  = pcv.lumaWidth >> ::getComponentScaleX( compID, cs.area.chromaFormat );
+    m_tempBuf.get( compID ).subBuf( 0, lineStart, compWidth, lineEnd - lineStart ).copyFrom( rec.get( compID ).subBuf( 0, lineStart, compWidth, lineEnd - lineStart ) );
+  }
+
+  int ctuRsAddr = ctuRow * pcv.widthInCtus;
+  for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+  {
+    const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+
+    offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
+    ctuRsAddr++;
+  }
+}
+
+void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
+                                      )
+{
+  if( !SAOPrepareCtuRows( cs, saoBlkParams ) )
   {
     return;
   }
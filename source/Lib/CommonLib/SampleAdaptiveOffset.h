@@ -67,6 +67,10 @@ public:
   virtual ~SampleAdaptiveOffset();
   void SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                    );
+  /// prepare the CTU row wise SAO of a picture, returns false if SAO is disabled for all components
+  bool SAOPrepareCtuRows( CodingStructure& cs, SAOBlkParam* saoBlkParams );
+  /// SAO of one CTU row, the rows have to be processed in order and the row below has to be deblocked
+  void SAOProcessCtuRow( CodingStructure& cs, const int ctuRow );
   void create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift );
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
@@ -87,6 +91,8 @@ protected:
                   , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
                   , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
     );
+  void xOffsetBlockEO(int typeIdx, const int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height, const ClpRng& clpRng
+                     , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail);
   void invertQuantOffsets(ComponentID compIdx, int typeIdc, int typeAuxInfo, int* dstOffsets, int* srcOffsets);
   void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   int  getMergeList(CodingStructure& cs, int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
@@ -122,6 +128,26 @@ protected:
 
   std::vector<int8_t> m_signLineBuf1;
   std::vector<int8_t> m_signLineBuf2;
+
+  // The edge class of a sample is sgn( src[x] - src[x + nbOffsetA] ) + sgn( src[x] - src[x + nbOffsetB] ) + 2,
+  // offset, diff and count are indexed by it.
+
+  /// edge offset of the samples startX..endX-1 of a line
+  static void offsetLineEOCore ( const Pel* srcLine, Pel* resLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng );
+  /// band offset of a block
+  static void offsetBlockBOCore( const Pel* srcBlk, Pel* resBlk, const int srcStride, const int resStride, const int width, const int height, const int* offset, const int shiftBits, const ClpRng& clpRng );
+  /// adds the original minus source differences and the sample counts per edge class of the samples startX..endX-1 of a line
+  static void statsLineEOCore  ( const Pel* srcLine, const Pel* orgLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, int64_t* diff, int64_t* count );
+
+  void ( *m_offsetLineEO ) ( const Pel* srcLine, Pel* resLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng );
+  void ( *m_offsetBlockBO )( const Pel* srcBlk, Pel* resBlk, const int srcStride, const int resStride, const int width, const int height, const int* offset, const int shiftBits, const ClpRng& clpRng );
+  void ( *m_statsLineEO )  ( const Pel* srcLine, const Pel* orgLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, int64_t* diff, int64_t* count );
+
+#if ENABLE_SIMD_OPT_SAO && defined( TARGET_SIMD_X86 )
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
 private:
   bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
@@ -0,0 +1,176 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.cpp
+    \brief    simple thread pool and wavefront progress tracking
+*/
+
+#include "ThreadPool.h"
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// ThreadPool
+// ====================================================================================================================
+
+ThreadPool::ThreadPool()
+  : m_numPending( 0 )
+  , m_stop      ( false )
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+  destroy();
+}
+
+void ThreadPool::create( int numThreads )
+{
+  CHECK( !m_threads.empty(), "Thread pool already created" );
+  CHECK( numThreads < 1, "Thread pool requires at least one thread" );
+
+  m_stop = false;
+  for( int i = 0; i < numThreads; i++ )
+  {
+    m_threads.push_back( std::thread( &ThreadPool::xWorkerLoop, this, i ) );
+  }
+}
+
+void ThreadPool::destroy()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_jobAvailable.notify_all();
+
+  for( auto &thread : m_threads )
+  {
+    thread.join();
+  }
+  m_threads.clear();
+  m_jobs.clear();
+  m_numPending = 0;
+}
+
+void ThreadPool::addJob( Job job )
+{
+  CHECK( m_threads.empty(), "Thread pool not created" );
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_jobs.push_back( std::move( job ) );
+    m_numPending++;
+  }
+  m_jobAvailable.notify_one();
+}
+
+void ThreadPool::waitForJobs()
+{
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_jobsDone.wait( lock, [this] { return m_numPending == 0; } );
+    std::swap( exception, m_exception );
+  }
+  if( exception )
+  {
+    std::rethrow_exception( exception );
+  }
+}
+
+void ThreadPool::xWorkerLoop( int threadIdx )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true )
+  {
+    m_jobAvailable.wait( lock, [this] { return m_stop || !m_jobs.empty(); } );
+
+    if( m_jobs.empty() )
+    {
+      return;
+    }
+
+    Job job = std::move( m_jobs.front() );
+    m_jobs.pop_front();
+    lock.unlock();
+
+    std::exception_ptr exception;
+    try
+    {
+      job( threadIdx );
+    }
+    catch( ... )
+    {
+      exception = std::current_exception();
+    }
+
+    lock.lock();
+    if( exception && !m_exception )
+    {
+      m_exception = exception;
+    }
+    if( --m_numPending == 0 )
+    {
+      m_jobsDone.notify_all();
+    }
+  }
+}
+
+// ====================================================================================================================
+// WavefrontProgress
+// ====================================================================================================================
+
+void WavefrontProgress::init( int numRows )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_numDone.assign( numRows, 0 );
+}
+
+void WavefrontProgress::setDone( int row, int numCtus )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_numDone[row] = numCtus;
+  }
+  m_progress.notify_all();
+}
+
+void WavefrontProgress::waitFor( int row, int numCtus )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_progress.wait( lock, [&] { return m_numDone[row] >= numCtus; } );
+}
+
+//! \}
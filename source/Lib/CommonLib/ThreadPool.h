@@ -0,0 +1,108 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.h
+    \brief    simple thread pool and wavefront progress tracking (header)
+*/
+
+#ifndef __THREADPOOL__
+#define __THREADPOOL__
+
+#include "CommonDef.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// fixed size pool of worker threads processing a FIFO job queue
+class ThreadPool
+{
+public:
+  typedef std::function<void( int threadIdx )> Job;
+
+  ThreadPool();
+  ~ThreadPool();
+
+  void create       ( int numThreads );
+  void destroy      ();
+
+  int  getNumThreads() const { return (int)m_threads.size(); }
+
+  /// queue a job, the index of the executing worker (0..numThreads-1) is passed to the job
+  void addJob       ( Job job );
+  /// block until all queued jobs are finished, the first exception thrown by a job is re-thrown here
+  void waitForJobs  ();
+
+private:
+  void xWorkerLoop  ( int threadIdx );
+
+  std::vector<std::thread>  m_threads;
+  std::deque<Job>           m_jobs;
+  std::mutex                m_mutex;
+  std::condition_variable   m_jobAvailable;
+  std::condition_variable   m_jobsDone;
+  int                       m_numPending;
+  bool                      m_stop;
+  std::exception_ptr        m_exception;
+};
+
+/// progress of CTU rows processed in wavefront order, used to enforce the CTU lag between neighbouring rows
+class WavefrontProgress
+{
+public:
+  void init     ( int numRows );
+  /// mark the first numCtus CTUs of the row as finished
+  void setDone  ( int row, int numCtus );
+  /// block until at least numCtus CTUs of the row are finished
+  void waitFor  ( int row, int numCtus );
+
+private:
+  std::vector<int>          m_numDone;
+  std::mutex                m_mutex;
+  std::condition_variable   m_progress;
+};
+
+//! \}
+
+#endif // __THREADPOOL__
@@ -47,6 +47,7 @@
 #include <stdlib.h>
 #include <limits>
 #include <memory.h>
+#include <random>
 
 #include "QuantRDOQ.h"
 #include "DepQuant.h"
@@ -197,8 +198,151 @@ TrQuant::TrQuant() : m_quant( nullptr )
     m_fwdICT[ 3]  = fwdTransformCbCr< 3>;
     m_fwdICT[-3]  = fwdTransformCbCr<-3>;
   }
+
+  std::copy( &fastFwdTrans[0][0], &fastFwdTrans[0][0] + NUM_TRANS_TYPE * g_numTransformMatrixSizes, &m_fwdTrans[0][0] );
+  std::copy( &fastInvTrans[0][0], &fastInvTrans[0][0] + NUM_TRANS_TYPE * g_numTransformMatrixSizes, &m_invTrans[0][0] );
+  m_fwdLfnst = fwdLfnstCore;
+  m_invLfnst = invLfnstCore;
+
+#if ENABLE_SIMD_OPT_TRAFO && defined( TARGET_SIMD_X86 )
+  initTrQuantX86();
+#if !defined( NDEBUG )
+  static const bool simdTransformsChecked = xCheckSimdTransforms();
+  (void) simdTransformsChecked;
+#endif
+#endif
 }
 
+#if ENABLE_SIMD_OPT_TRAFO && defined( TARGET_SIMD_X86 ) && !defined( NDEBUG )
+/** debug builds compare the selected transform and LFNST kernels with the C implementations on random input once
+ * every table entry is run with the line counts, zero-out widths and shifts used by xT and xIT
+ */
+bool TrQuant::xCheckSimdTransforms() const
+{
+  std::mt19937 rng( 0x1234 );
+  std::uniform_int_distribution<TCoeff> coeffDist( -( 1 << 15 ), ( 1 << 15 ) - 1 );
+
+  static const int shifts[] = { 2, 7, 12 };
+  const TCoeff     clipMinimum = -( 1 << 15 );
+  const TCoeff     clipMaximum =  ( 1 << 15 ) - 1;
+
+  std::vector<TCoeff> src( MAX_TB_SIZEY * MAX_TB_SIZEY ), dstC( MAX_TB_SIZEY * MAX_TB_SIZEY ), dstSimd( MAX_TB_SIZEY * MAX_TB_SIZEY );
+
+  for( int trType = 0; trType < NUM_TRANS_TYPE; trType++ )
+  {
+    for( int sizeIdx = 0; sizeIdx < g_numTransformMatrixSizes; sizeIdx++ )
+    {
+      if( fastFwdTrans[trType][sizeIdx] == nullptr )
+      {
+        continue;
+      }
+      const int trSize = 2 << sizeIdx;
+
+      // zero-out of the basis functions: none, MTS 32, DCT-II 64 and the LFNST regions
+      std::vector<int> skips2 = { 0 };
+      if( trType != DCT2 && trSize == 32 )
+      {
+        skips2.push_back( 16 );
+      }
+      if( trType == DCT2 && trSize > JVET_C0024_ZERO_OUT_TH )
+      {
+        skips2.push_back( trSize - JVET_C0024_ZERO_OUT_TH );
+      }
+      if( trType == DCT2 && trSize > 4 )
+      {
+        skips2.push_back( trSize - 4 );
+      }
+      if( trType == DCT2 && trSize > 8 )
+      {
+        skips2.push_back( trSize - 8 );
+      }
+
+      for( int line = 1; line <= ( trType == DCT2 ? MAX_TB_SIZEY : 32 ); line <<= 1 )
+      {
+        // zero-out of the lines, given by the zero-out of the other direction
+        std::vector<int> skips = { 0 };
+        for( int lineSkip : { 16, line - JVET_C0024_ZERO_OUT_TH, line - 4, line - 8 } )
+        {
+          if( lineSkip > 0 && lineSkip < line && ( lineSkip != 16 || line == 32 ) )
+          {
+            skips.push_back( lineSkip );
+          }
+        }
+
+        for( const int skip : skips )
+        {
+          for( const int skip2 : skips2 )
+          {
+            for( const int shift : shifts )
+            {
+              // forward: line j holds the samples src[j * trSize + i], skipped lines are zero
+              for( int j = 0; j < line; j++ )
+              {
+                for( int i = 0; i < trSize; i++ )
+                {
+                  src[j * trSize + i] = j < line - skip ? coeffDist( rng ) : 0;
+                }
+              }
+              std::fill( dstC.begin(), dstC.end(), 0x5a5a );
+              std::fill( dstSimd.begin(), dstSimd.end(), 0x5a5a );
+              fastFwdTrans[trType][sizeIdx]( src.data(), dstC.data(), shift, line, skip, skip2 );
+              m_fwdTrans  [trType][sizeIdx]( src.data(), dstSimd.data(), shift, line, skip, skip2 );
+              CHECK( dstC != dstSimd, "SIMD forward transform " << trType << "/" << trSize << " (line " << line << ", skip " << skip << "/" << skip2 << ") differs from the C implementation" );
+
+              // inverse: basis function k of line j is src[k * line + j], skipped functions and lines are zero
+              for( int k = 0; k < trSize; k++ )
+              {
+                for( int j = 0; j < line; j++ )
+                {
+                  src[k * line + j] = k < trSize - skip2 && j < line - skip ? coeffDist( rng ) : 0;
+                }
+              }
+              std::fill( dstC.begin(), dstC.end(), 0x5a5a );
+              std::fill( dstSimd.begin(), dstSimd.end(), 0x5a5a );
+              fastInvTrans[trType][sizeIdx]( src.data(), dstC.data(), shift, line, skip, skip2, clipMinimum, clipMaximum );
+              m_invTrans  [trType][sizeIdx]( src.data(), dstSimd.data(), shift, line, skip, skip2, clipMinimum, clipMaximum );
+              CHECK( dstC != dstSimd, "SIMD inverse transform " << trType << "/" << trSize << " (line " << line << ", skip " << skip << "/" << skip2 << ") differs from the C implementation" );
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for( int size = 4; size <= 8; size += 4 )
+  {
+    const int trSize = size > 4 ? 48 : 16;
+    for( int mode = 0; mode < 4; mode++ )
+    {
+      for( int index = 0; index < 2; index++ )
+      {
+        const int8_t* trMat = size > 4 ? g_lfnst8x8[mode][index][0] : g_lfnst4x4[mode][index][0];
+        for( const int zeroOutSize : { 8, 16 } )
+        {
+          for( int i = 0; i < trSize; i++ )
+          {
+            src[i] = coeffDist( rng );
+          }
+          std::fill( dstC.begin(), dstC.end(), 0x5a5a );
+          std::fill( dstSimd.begin(), dstSimd.end(), 0x5a5a );
+          fwdLfnstCore( src.data(), dstC.data(), trMat, trSize, zeroOutSize );
+          m_fwdLfnst  ( src.data(), dstSimd.data(), trMat, trSize, zeroOutSize );
+          CHECK( dstC != dstSimd, "SIMD forward LFNST " << size << "x" << size << " differs from the C implementation" );
+
+          std::fill( dstC.begin(), dstC.end(), 0x5a5a );
+          std::fill( dstSimd.begin(), dstSimd.end(), 0x5a5a );
+          invLfnstCore( src.data(), dstC.data(), trMat, trSize, zeroOutSize, clipMinimum, clipMaximum );
+          m_invLfnst  ( src.data(), dstSimd.data(), trMat, trSize, zeroOutSize, clipMinimum, clipMaximum );
+          CHECK( dstC != dstSimd, "SIMD inverse LFNST " << size << "x" << size << " differs from the C implementation" );
+        }
+      }
+    }
+  }
+
+  return true;
+}
+#endif
+
 TrQuant::~TrQuant()
 {
   if( m_quant )
@@ -241,13 +385,19 @@ void TrQuant::fwdLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const
 {
   const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
   const int     trSize = ( size > 4 ) ? 48 : 16;
+  assert( index < 3 );
+
+  m_fwdLfnst( src, dst, trMat, trSize, zeroOutSize );
+}
+
+void TrQuant::fwdLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize )
+{
   TCoeff           coef;
   TCoeff*          out    = dst;
-  assert( index < 3 );
 
   for( int j = 0; j < zeroOutSize; j++ )
   {
-    TCoeff*          srcPtr   = src;
+    const TCoeff*    srcPtr   = src;
     const int8_t* trMatTmp = trMat;
     coef = 0;
     for( int i = 0; i < trSize; i++ )
@@ -267,15 +417,21 @@ void TrQuant::invLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const
   const TCoeff    outputMaximum         =  ( 1 << maxLog2TrDynamicRange ) - 1;
   const int8_t*   trMat                 =  ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
   const int       trSize                =  ( size > 4 ) ? 48 : 16;
+  assert( index < 3 );
+
+  m_invLfnst( src, dst, trMat, trSize, zeroOutSize, outputMinimum, outputMaximum );
+}
+
+void TrQuant::invLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
   TCoeff          resi;
   TCoeff*         out                   =  dst;
-  assert( index < 3 );
 
   for( int j = 0; j < trSize; j++ )
   {
     resi = 0;
     const int8_t* trMatTmp = trMat;
-    TCoeff*       srcPtr   = src;
+    const TCoeff* srcPtr   = src;
     for( int i = 0; i < zeroOutSize; i++ )
     {
       resi += *srcPtr++ * *trMatTmp;
@@ -780,22 +936,22 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
     CHECK( shift_2nd < 0, "Negative shift" );
     TCoeff *tmp = (TCoeff *) alloca(width * height * sizeof(TCoeff));
 
-    fastFwdTrans[trTypeHor][transformWidthIndex](block, tmp, shift_1st, height, 0, skipWidth);
-    fastFwdTrans[trTypeVer][transformHeightIndex](tmp, dstCoeff.buf, shift_2nd, width, skipWidth, skipHeight);
+    m_fwdTrans[trTypeHor][transformWidthIndex](block, tmp, shift_1st, height, 0, skipWidth);
+    m_fwdTrans[trTypeVer][transformHeightIndex](tmp, dstCoeff.buf, shift_2nd, width, skipWidth, skipHeight);
   }
   else if( height == 1 ) //1-D horizontal transform
   {
     const int      shift              = ((floorLog2(width )) + bitDepth + TRANSFORM_MATRIX_SHIFT) - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
     CHECK( shift < 0, "Negative shift" );
     CHECKD( ( transformWidthIndex < 0 ), "There is a problem with the width." );
-    fastFwdTrans[trTypeHor][transformWidthIndex]( block, dstCoeff.buf, shift, 1, 0, skipWidth );
+    m_fwdTrans[trTypeHor][transformWidthIndex]( block, dstCoeff.buf, shift, 1, 0, skipWidth );
   }
   else //if (iWidth == 1) //1-D vertical transform
   {
     int shift = ( ( floorLog2(height) ) + bitDepth + TRANSFORM_MATRIX_SHIFT ) - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
     CHECK( shift < 0, "Negative shift" );
     CHECKD( ( transformHeightIndex < 0 ), "There is a problem with the height." );
-    fastFwdTrans[trTypeVer][transformHeightIndex]( block, dstCoeff.buf, shift, 1, 0, skipHeight );
+    m_fwdTrans[trTypeVer][transformHeightIndex]( block, dstCoeff.buf, shift, 1, 0, skipHeight );
   }
 }
 
@@ -842,22 +998,22 @@ void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCo
     CHECK( shift_1st < 0, "Negative shift" );
     CHECK( shift_2nd < 0, "Negative shift" );
     TCoeff *tmp = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
-    fastInvTrans[trTypeVer][transformHeightIndex](pCoeff.buf, tmp, shift_1st, width, skipWidth, skipHeight, clipMinimum, clipMaximum);
-    fastInvTrans[trTypeHor][transformWidthIndex] (tmp,      block, shift_2nd, height,        0, skipWidth,  pelMinimum,  pelMaximum);
+    m_invTrans[trTypeVer][transformHeightIndex](pCoeff.buf, tmp, shift_1st, width, skipWidth, skipHeight, clipMinimum, clipMaximum);
+    m_invTrans[trTypeHor][transformWidthIndex] (tmp,      block, shift_2nd, height,        0, skipWidth,  pelMinimum,  pelMaximum);
   }
   else if( width == 1 ) //1-D vertical transform
   {
     int shift = ( TRANSFORM_MATRIX_SHIFT + maxLog2TrDynamicRange - 1 ) - bitDepth + COM16_C806_TRANS_PREC;
     CHECK( shift < 0, "Negative shift" );
     CHECK( ( transformHeightIndex < 0 ), "There is a problem with the height." );
-    fastInvTrans[trTypeVer][transformHeightIndex]( pCoeff.buf, block, shift + 1, 1, 0, skipHeight, pelMinimum, pelMaximum );
+    m_invTrans[trTypeVer][transformHeightIndex]( pCoeff.buf, block, shift + 1, 1, 0, skipHeight, pelMinimum, pelMaximum );
   }
   else //if(iHeight == 1) //1-D horizontal transform
   {
     const int      shift              = ( TRANSFORM_MATRIX_SHIFT + maxLog2TrDynamicRange - 1 ) - bitDepth + COM16_C806_TRANS_PREC;
     CHECK( shift < 0, "Negative shift" );
     CHECK( ( transformWidthIndex < 0 ), "There is a problem with the width." );
-    fastInvTrans[trTypeHor][transformWidthIndex]( pCoeff.buf, block, shift + 1, 1, 0, skipWidth, pelMinimum, pelMaximum );
+    m_invTrans[trTypeHor][transformWidthIndex]( pCoeff.buf, block, shift + 1, 1, 0, skipWidth, pelMinimum, pelMaximum );
   }
 
   Pel *resiBuf    = pResidual.buf;
@@ -129,6 +129,24 @@ private:
   void                      (**m_invICT)(PelBuf&,PelBuf&);
   std::pair<int64_t,int64_t>(**m_fwdICT)(const PelBuf&,const PelBuf&,PelBuf&,PelBuf&);
 
+  FwdTrans* m_fwdTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+  InvTrans* m_invTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+
+  static void fwdLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize );
+  static void invLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMinimum, const TCoeff outputMaximum );
+
+  void ( *m_fwdLfnst )( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize );
+  void ( *m_invLfnst )( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMinimum, const TCoeff outputMaximum );
+
+#if ENABLE_SIMD_OPT_TRAFO && defined( TARGET_SIMD_X86 )
+  void initTrQuantX86();
+  template <X86_VEXT vext>
+  void _initTrQuantX86();
+#if !defined( NDEBUG )
+  bool xCheckSimdTransforms() const;
+#endif
+#endif
+
 
   // forward Transform
   void xT               (const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, CoeffBuf &dstCoeff, const int width, const int height);
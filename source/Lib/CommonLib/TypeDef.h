@@ -43,6 +43,7 @@
 #endif
 
 #include <vector>
+#include <algorithm>
 #include <utility>
 #include <sstream>
 #include <cstddef>
@@ -189,6 +190,13 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the core and secondary transforms, no impact on RD performance
+#define ENABLE_SIMD_OPT_DBLF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRAPRED                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the planar, DC and angular intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_MIP                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the matrix based intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the SAO classification and offsetting, no impact on RD performance
+#define ENABLE_SIMD_OPT_DQ                              ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the dependent quantization trellis, no impact on RD performance
+#define ENABLE_SIMD_OPT_HASH                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the block hashes of the hash based motion estimation, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
@@ -1218,26 +1226,41 @@ public:
 // dynamic cache
 // ---------------------------------------------------------------------------
 
+// objects are allocated in chunks, which are only freed with the cache; released objects are kept for reuse
 template<typename T>
 class dynamic_cache
 {
-  std::vector<T*> m_cache;
+  static const size_t CHUNK_SIZE = 256;
+
+  std::vector<T*> m_chunks;                     // arena chunks of CHUNK_SIZE objects
+  std::vector<T*> m_cache;                      // released objects
+  size_t          m_numFresh;                   // objects at the end of the last chunk never handed out
+  size_t          m_numInUse;
+  size_t          m_peakInUse;
+  size_t          m_numReused;
 
 public:
+  dynamic_cache() : m_numFresh( 0 ), m_numInUse( 0 ), m_peakInUse( 0 ), m_numReused( 0 ) {}
+  dynamic_cache( const dynamic_cache& ) = delete;
+  dynamic_cache& operator=( const dynamic_cache& ) = delete;
+
   ~dynamic_cache()
   {
     deleteEntries();
   }
 
+  // all objects handed out have to be released before
   void deleteEntries()
   {
-    for( auto &p : m_cache )
+    for( auto &p : m_chunks )
     {
-      delete p;
+      delete[] p;
       p = nullptr;
     }
 
+    m_chunks.clear();
     m_cache.clear();
+    m_numFresh = m_numInUse = 0;
   }
 
   T* get()
@@ -1248,31 +1271,46 @@ public:
     {
       ret = m_cache.back();
       m_cache.pop_back();
+      m_numReused++;
     }
     else
     {
-      ret = new T;
+      if( m_numFresh == 0 )
+      {
+        m_chunks.push_back( new T[CHUNK_SIZE] );
+        m_numFresh = CHUNK_SIZE;
+      }
+      ret = m_chunks.back() + CHUNK_SIZE - m_numFresh--;
     }
 
+    m_numInUse++;
+    m_peakInUse = std::max( m_peakInUse, m_numInUse );
     return ret;
   }
 
   void cache( T* el )
   {
     m_cache.push_back( el );
+    m_numInUse--;
   }
 
   void cache( std::vector<T*>& vel )
   {
     m_cache.insert( m_cache.end(), vel.begin(), vel.end() );
+    m_numInUse -= vel.size();
     vel.clear();
   }
+
+  size_t getNumAllocated() const { return m_chunks.size() * CHUNK_SIZE; }
+  size_t getPeakInUse   () const { return m_peakInUse; }
+  size_t getNumReused   () const { return m_numReused; }
 };
 
 typedef dynamic_cache<struct CodingUnit    > CUCache;
 typedef dynamic_cache<struct PredictionUnit> PUCache;
 typedef dynamic_cache<struct TransformUnit > TUCache;
 
+/// CU, PU and TU storage of a tree of CodingStructures, it must only be used by one thread at a time
 struct XUCache
 {
   CUCache cuCache;
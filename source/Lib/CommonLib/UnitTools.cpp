@@ -399,7 +399,7 @@ void CU::saveMotionInHMVP( const CodingUnit& cu, const bool isToBeDone )
     bool enableHmvp = ((xBr >> log2ParallelMergeLevel) > (pu.cu->Y().x >> log2ParallelMergeLevel)) && ((yBr >> log2ParallelMergeLevel) > (pu.cu->Y().y >> log2ParallelMergeLevel));
     bool enableInsertion = CU::isIBC(cu) || enableHmvp;
     if (enableInsertion)
-    cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc : cu.cs->motionLut.lut, mi);
+    cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->getMotionLut(cu.lumaPos()).lutIbc : cu.cs->getMotionLut(cu.lumaPos()).lut, mi);
   }
 }
 
@@ -856,7 +856,7 @@ int PU::getWideAngle( const TransformUnit &tu, const uint32_t dirMode, const Com
   return predMode;
 }
 
-bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx &mrgCtx, const int &mrgCandIdx,
+bool PU::addMergeHMVPCand(const CodingStructure &cs, const LutMotionCand &motionLut, MergeCtx &mrgCtx, const int &mrgCandIdx,
                           const uint32_t maxNumMergeCandMin1, int &cnt, const bool isAvailableA1,
                           const MotionInfo miLeft, const bool isAvailableB1, const MotionInfo miAbove,
                           const bool ibcFlag, const bool isGt4x4
@@ -869,7 +869,7 @@ bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx &mrgCtx, const int
   const Slice& slice = *cs.slice;
   MotionInfo miNeighbor;
 
-  auto &lut = ibcFlag ? cs.motionLut.lutIbc : cs.motionLut.lut;
+  auto &lut = ibcFlag ? motionLut.lutIbc : motionLut.lut;
   int num_avai_candInLUT = (int)lut.size();
 
 #if GDR_ENABLED
@@ -1053,7 +1053,7 @@ void PU::getIBCMergeCandidates(const PredictionUnit &pu, MergeCtx& mrgCtx, const
   {
 #if GDR_ENABLED
     bool allCandSolidInAbove = true;
-    bool bFound = addMergeHMVPCand(cs, mrgCtx, mrgCandIdx, maxNumMergeCand, cnt
+    bool bFound = addMergeHMVPCand(cs, cs.getMotionLut(pu.lumaPos()), mrgCtx, mrgCandIdx, maxNumMergeCand, cnt
       , isAvailableA1, miLeft, isAvailableB1, miAbove
       , true
       , isGt4x4
@@ -1061,7 +1061,7 @@ void PU::getIBCMergeCandidates(const PredictionUnit &pu, MergeCtx& mrgCtx, const
       , allCandSolidInAbove
     );
 #else
-    bool bFound = addMergeHMVPCand(cs, mrgCtx, mrgCandIdx, maxNumMergeCand, cnt, isAvailableA1, miLeft, isAvailableB1,
+    bool bFound = addMergeHMVPCand(cs, cs.getMotionLut(pu.lumaPos()), mrgCtx, mrgCandIdx, maxNumMergeCand, cnt, isAvailableA1, miLeft, isAvailableB1,
                                    miAbove, true, isGt4x4);
 #endif
 
@@ -1538,10 +1538,10 @@ void PU::getInterMergeCandidates( const PredictionUnit &pu, MergeCtx& mrgCtx,
     allCandSolidInAbove = true;
 #endif
 #if GDR_ENABLED
-    bool bFound  = addMergeHMVPCand(cs, mrgCtx, mrgCandIdx, maxNumMergeCandMin1, cnt, isAvailableA1, miLeft,
+    bool bFound  = addMergeHMVPCand(cs, cs.getMotionLut(pu.lumaPos()), mrgCtx, mrgCandIdx, maxNumMergeCandMin1, cnt, isAvailableA1, miLeft,
                                    isAvailableB1, miAbove, CU::isIBC(*pu.cu), isGt4x4, pu, allCandSolidInAbove);
 #else
-    bool bFound  = addMergeHMVPCand(cs, mrgCtx, mrgCandIdx, maxNumMergeCandMin1, cnt, isAvailableA1, miLeft,
+    bool bFound  = addMergeHMVPCand(cs, cs.getMotionLut(pu.lumaPos()), mrgCtx, mrgCandIdx, maxNumMergeCandMin1, cnt, isAvailableA1, miLeft,
                                    isAvailableB1, miAbove, CU::isIBC(*pu.cu), isGt4x4);
 #endif
 
@@ -3079,7 +3079,8 @@ void PU::addAMVPHMVPCand(const PredictionUnit &pu, const RefPicList eRefPicList,
   const Slice &slice = *(*pu.cs).slice;
 
   MotionInfo neibMi;
-  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->motionLut.lutIbc : pu.cs->motionLut.lut;
+  const LutMotionCand &motionLut = pu.cs->getMotionLut(pu.lumaPos());
+  auto &lut = CU::isIBC(*pu.cu) ? motionLut.lutIbc : motionLut.lut;
   int num_avai_candInLUT = (int) lut.size();
   int num_allowedCand = std::min(MAX_NUM_HMVP_AVMPCANDS, num_avai_candInLUT);
   const RefPicList eRefPicList2nd = (eRefPicList == REF_PIC_LIST_0) ? REF_PIC_LIST_1 : REF_PIC_LIST_0;
@@ -1793,6 +1793,145 @@ void linTf_SSE_entry( const Pel* src, int srcStride, Pel *dst, int dstStride, in
   }
 }
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+template< X86_VEXT vext >
+void mctfInterp_SIMD( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, const Pel maxVal )
+{
+  if( width & 3 )
+  {
+    mctfInterpCore( src, srcStride, dst, dstStride, width, height, xFilter, yFilter, maxVal );
+    return;
+  }
+  CHECKD( height > 64, "Block size not supported" );
+
+  // pairs ( e[i], e[i+1] ) and ( e[i+2], e[i+3] ) of the 16 bit samples for the outputs i = 0..3
+  const __m128i shuffle01 = _mm_setr_epi8( 0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 6, 7, 6, 7, 8, 9 );
+  const __m128i shuffle23 = _mm_setr_epi8( 4, 5, 6, 7, 6, 7, 8, 9, 8, 9, 10, 11, 10, 11, 12, 13 );
+  const __m128i xCoeff12  = _mm_setr_epi16( xFilter[1], xFilter[2], xFilter[1], xFilter[2], xFilter[1], xFilter[2], xFilter[1], xFilter[2] );
+  const __m128i xCoeff34  = _mm_setr_epi16( xFilter[3], xFilter[4], xFilter[3], xFilter[4], xFilter[3], xFilter[4], xFilter[3], xFilter[4] );
+  const __m128i xCoeff56  = _mm_setr_epi16( xFilter[5], xFilter[6], xFilter[5], xFilter[6], xFilter[5], xFilter[6], xFilter[5], xFilter[6] );
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( width & 7 ) == 0 )
+  {
+    const __m256i shuffle01x2 = _mm256_broadcastsi128_si256( shuffle01 );
+    const __m256i shuffle23x2 = _mm256_broadcastsi128_si256( shuffle23 );
+    const __m256i xCoeff12x2  = _mm256_broadcastsi128_si256( xCoeff12 );
+    const __m256i xCoeff34x2  = _mm256_broadcastsi128_si256( xCoeff34 );
+    const __m256i xCoeff56x2  = _mm256_broadcastsi128_si256( xCoeff56 );
+    const __m256i vOffset     = _mm256_set1_epi32( 1 << 11 );
+    const __m256i vMax        = _mm256_set1_epi32( maxVal );
+    const __m256i vZero       = _mm256_setzero_si256();
+    __m256i yCoeff[6];
+    for( int k = 0; k < 6; k++ )
+    {
+      yCoeff[k] = _mm256_set1_epi32( yFilter[k + 1] );
+    }
+    __m256i tempArray[64 + 5];
+
+    for( int x = 0; x < width; x += 8 )
+    {
+      const Pel* srcRow = src - 2 * srcStride + x - 2;
+      for( int y = 0; y < height + 5; y++, srcRow += srcStride )
+      {
+        // lane 0 holds the samples of the outputs 0..3, lane 1 those of the outputs 4..7
+        const __m256i v0 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) srcRow ) ), _mm_loadu_si128( ( const __m128i* ) ( srcRow + 4 ) ), 1 );
+        const __m256i v1 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) ( srcRow + 4 ) ) ), _mm_loadu_si128( ( const __m128i* ) ( srcRow + 8 ) ), 1 );
+        __m256i sum = _mm256_madd_epi16( _mm256_shuffle_epi8( v0, shuffle01x2 ), xCoeff12x2 );
+        sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_shuffle_epi8( v0, shuffle23x2 ), xCoeff34x2 ) );
+        sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_shuffle_epi8( v1, shuffle01x2 ), xCoeff56x2 ) );
+        tempArray[y] = sum;
+      }
+
+      Pel* dstRow = dst + x;
+      for( int y = 0; y < height; y++, dstRow += dstStride )
+      {
+        __m256i sum = vOffset;
+        for( int k = 0; k < 6; k++ )
+        {
+          sum = _mm256_add_epi32( sum, _mm256_mullo_epi32( yCoeff[k], tempArray[y + k] ) );
+        }
+        sum = _mm256_min_epi32( vMax, _mm256_max_epi32( vZero, _mm256_srai_epi32( sum, 12 ) ) );
+        sum = _mm256_permute4x64_epi64( _mm256_packs_epi32( sum, sum ), 0x08 );
+        _mm_storeu_si128( ( __m128i* ) dstRow, _mm256_castsi256_si128( sum ) );
+      }
+    }
+    return;
+  }
+#endif
+
+  const __m128i vOffset = _mm_set1_epi32( 1 << 11 );
+  const __m128i vMax    = _mm_set1_epi32( maxVal );
+  const __m128i vZero   = _mm_setzero_si128();
+  __m128i yCoeff[6];
+  for( int k = 0; k < 6; k++ )
+  {
+    yCoeff[k] = _mm_set1_epi32( yFilter[k + 1] );
+  }
+  __m128i tempArray[64 + 5];
+
+  for( int x = 0; x < width; x += 4 )
+  {
+    const Pel* srcRow = src - 2 * srcStride + x - 2;
+    for( int y = 0; y < height + 5; y++, srcRow += srcStride )
+    {
+      const __m128i v0 = _mm_loadu_si128( ( const __m128i* ) srcRow );
+      const __m128i v1 = _mm_loadu_si128( ( const __m128i* ) ( srcRow + 4 ) );
+      __m128i sum = _mm_madd_epi16( _mm_shuffle_epi8( v0, shuffle01 ), xCoeff12 );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_shuffle_epi8( v0, shuffle23 ), xCoeff34 ) );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_shuffle_epi8( v1, shuffle01 ), xCoeff56 ) );
+      tempArray[y] = sum;
+    }
+
+    Pel* dstRow = dst + x;
+    for( int y = 0; y < height; y++, dstRow += dstStride )
+    {
+      __m128i sum = vOffset;
+      for( int k = 0; k < 6; k++ )
+      {
+        sum = _mm_add_epi32( sum, _mm_mullo_epi32( yCoeff[k], tempArray[y + k] ) );
+      }
+      sum = _mm_min_epi32( vMax, _mm_max_epi32( vZero, _mm_srai_epi32( sum, 12 ) ) );
+      _mm_storel_epi64( ( __m128i* ) dstRow, _mm_packs_epi32( sum, sum ) );
+    }
+  }
+}
+
+template< X86_VEXT vext >
+int mctfSse_SIMD( const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, const int maxError )
+{
+  if( width & 3 )
+  {
+    return mctfSseCore( org, orgStride, cur, curStride, width, height, maxError );
+  }
+
+  int error = 0;
+  for( int y = 0; y < height; y++, org += orgStride, cur += curStride )
+  {
+    __m128i sum = _mm_setzero_si128();
+    int x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) ( org + x ) ), _mm_loadu_si128( ( const __m128i* ) ( cur + x ) ) );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( diff, diff ) );
+    }
+    if( x < width )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* ) ( org + x ) ), _mm_loadl_epi64( ( const __m128i* ) ( cur + x ) ) );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( diff, diff ) );
+    }
+    sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x4e ) );
+    sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+    error += _mm_cvtsi128_si32( sum );
+    if( error > maxError )
+    {
+      return error;
+    }
+  }
+  return error;
+}
+#endif
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -1841,6 +1980,9 @@ void PelBufferOps::_initPelBufOpsX86()
 #endif
   profGradFilter = gradFilter_SSE<vext, false>;
   applyPROF      = applyPROF_SSE<vext>;
+
+  mctfInterp     = mctfInterp_SIMD<vext>;
+  mctfSse        = mctfSse_SIMD<vext>;
 #endif
   roundIntVector = roundIntVector_SIMD<vext>;
 }
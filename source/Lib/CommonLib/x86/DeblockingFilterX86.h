@@ -0,0 +1,453 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DeblockingFilterX86.h
+    \brief    SIMD edge filtering for the deblocking filter
+*/
+
+#include "CommonDefX86.h"
+#include "../DeblockingFilter.h"
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// The samples of up to four lines crossing an edge are kept as vectors of four 32 bit lanes, one lane per line.
+// p[k] holds the k-th sample in front of the edge and q[k] the k-th sample behind it.
+
+static inline __m128i simdDbClip3( const __m128i& minVal, const __m128i& maxVal, const __m128i& val )
+{
+  return _mm_min_epi32( _mm_max_epi32( val, minVal ), maxVal );
+}
+
+static inline __m128i simdDbClipTc( const __m128i& org, const __m128i& tc, const __m128i& val )
+{
+  return simdDbClip3( _mm_sub_epi32( org, tc ), _mm_add_epi32( org, tc ), val );
+}
+
+static inline __m128i simdDbLoadLine( const Pel* src, const int numLines )
+{
+  if( numLines == 4 )
+  {
+    return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) src ) );
+  }
+  Pel tmp[4] = { 0, 0, 0, 0 };
+  std::copy( src, src + numLines, tmp );
+  return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) tmp ) );
+}
+
+static inline void simdDbStoreLine( Pel* dst, const int numLines, const __m128i& val )
+{
+  if( numLines == 4 )
+  {
+    _mm_storel_epi64( ( __m128i* ) dst, _mm_packs_epi32( val, val ) );
+    return;
+  }
+  Pel tmp[4];
+  _mm_storel_epi64( ( __m128i* ) tmp, _mm_packs_epi32( val, val ) );
+  std::copy( tmp, tmp + numLines, dst );
+}
+
+// transposes eight consecutive samples of numLines rows into eight column vectors
+static inline void simdDbLoadColumns( const Pel* src, const int step, const int numLines, __m128i* col )
+{
+  __m128i r[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    r[i] = i < numLines ? _mm_loadu_si128( ( const __m128i* ) ( src + i * step ) ) : _mm_setzero_si128();
+  }
+  const __m128i t0 = _mm_unpacklo_epi16( r[0], r[1] );
+  const __m128i t1 = _mm_unpacklo_epi16( r[2], r[3] );
+  const __m128i t2 = _mm_unpackhi_epi16( r[0], r[1] );
+  const __m128i t3 = _mm_unpackhi_epi16( r[2], r[3] );
+  const __m128i u[4] = { _mm_unpacklo_epi32( t0, t1 ), _mm_unpackhi_epi32( t0, t1 ),
+                         _mm_unpacklo_epi32( t2, t3 ), _mm_unpackhi_epi32( t2, t3 ) };
+  for( int i = 0; i < 4; i++ )
+  {
+    col[2 * i]     = _mm_cvtepi16_epi32( u[i] );
+    col[2 * i + 1] = _mm_cvtepi16_epi32( _mm_srli_si128( u[i], 8 ) );
+  }
+}
+
+static inline void simdDbStoreColumns( Pel* dst, const int step, const int numLines, const __m128i* col )
+{
+  const __m128i v0 = _mm_packs_epi32( col[0], col[1] );
+  const __m128i v1 = _mm_packs_epi32( col[2], col[3] );
+  const __m128i v2 = _mm_packs_epi32( col[4], col[5] );
+  const __m128i v3 = _mm_packs_epi32( col[6], col[7] );
+  const __m128i w0 = _mm_unpacklo_epi16( v0, v1 );
+  const __m128i w1 = _mm_unpackhi_epi16( v0, v1 );
+  const __m128i w2 = _mm_unpacklo_epi16( v2, v3 );
+  const __m128i w3 = _mm_unpackhi_epi16( v2, v3 );
+  const __m128i x0 = _mm_unpacklo_epi16( w0, w1 );
+  const __m128i x1 = _mm_unpackhi_epi16( w0, w1 );
+  const __m128i x2 = _mm_unpacklo_epi16( w2, w3 );
+  const __m128i x3 = _mm_unpackhi_epi16( w2, w3 );
+  const __m128i r[4] = { _mm_unpacklo_epi64( x0, x2 ), _mm_unpackhi_epi64( x0, x2 ),
+                         _mm_unpacklo_epi64( x1, x3 ), _mm_unpackhi_epi64( x1, x3 ) };
+  for( int i = 0; i < numLines; i++ )
+  {
+    _mm_storeu_si128( ( __m128i* ) ( dst + i * step ), r[i] );
+  }
+}
+
+// loads the first numP samples in front of and the first numQ samples behind the edge, at most eight per side
+static inline void simdDbLoadSamples( const Pel* src, const int offset, const int step, const int numLines, const int numP, const int numQ, __m128i* p, __m128i* q )
+{
+  if( offset == 1 )
+  {
+    __m128i col[8];
+    simdDbLoadColumns( src - 4, step, numLines, col );
+    for( int k = 0; k < 4; k++ )
+    {
+      p[k] = col[3 - k];
+      q[k] = col[4 + k];
+    }
+    if( numP > 4 )
+    {
+      simdDbLoadColumns( src - 8, step, numLines, col );
+      for( int k = 4; k < 8; k++ )
+      {
+        p[k] = col[7 - k];
+      }
+    }
+    if( numQ > 4 )
+    {
+      simdDbLoadColumns( src, step, numLines, col );
+      for( int k = 4; k < 8; k++ )
+      {
+        q[k] = col[k];
+      }
+    }
+  }
+  else
+  {
+    for( int k = 0; k < numP; k++ )
+    {
+      p[k] = simdDbLoadLine( src - ( k + 1 ) * offset, numLines );
+    }
+    for( int k = 0; k < numQ; k++ )
+    {
+      q[k] = simdDbLoadLine( src + k * offset, numLines );
+    }
+  }
+}
+
+// writes back the first numP samples in front of and the first numQ samples behind the edge, all of them must have
+// been loaded. Vertical edges rewrite whole eight sample rows, horizontal edges only touch the given lines.
+static inline void simdDbStoreSamples( Pel* dst, const int offset, const int step, const int numLines, const int numP, const int numQ, const __m128i* p, const __m128i* q )
+{
+  if( offset == 1 )
+  {
+    __m128i col[8];
+    if( numP > 4 )
+    {
+      for( int k = 4; k < 8; k++ )
+      {
+        col[7 - k] = p[k];
+      }
+      for( int k = 0; k < 4; k++ )
+      {
+        col[7 - k] = p[k];
+      }
+      simdDbStoreColumns( dst - 8, step, numLines, col );
+    }
+    if( numQ > 4 )
+    {
+      for( int k = 0; k < 8; k++ )
+      {
+        col[k] = q[k];
+      }
+      simdDbStoreColumns( dst, step, numLines, col );
+    }
+    if( numP <= 4 || numQ <= 4 )
+    {
+      for( int k = 0; k < 4; k++ )
+      {
+        col[3 - k] = p[k];
+        col[4 + k] = q[k];
+      }
+      simdDbStoreColumns( dst - 4, step, numLines, col );
+    }
+  }
+  else
+  {
+    for( int k = 0; k < numP; k++ )
+    {
+      simdDbStoreLine( dst - ( k + 1 ) * offset, numLines, p[k] );
+    }
+    for( int k = 0; k < numQ; k++ )
+    {
+      simdDbStoreLine( dst + k * offset, numLines, q[k] );
+    }
+  }
+}
+
+static inline __m128i simdDbSum( const __m128i& val )
+{
+  return val;
+}
+
+template<typename... Args>
+static inline __m128i simdDbSum( const __m128i& val, const Args&... vals )
+{
+  return _mm_add_epi32( val, simdDbSum( vals... ) );
+}
+
+static inline __m128i simdDbRound( const __m128i& sum, const int shift )
+{
+  return _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 1 << ( shift - 1 ) ) ), shift );
+}
+
+// long luma filter, lane-wise equivalent of DeblockingFilter::xFilteringPandQ
+static inline void simdDbFilteringPandQ( const __m128i* p, const __m128i* q, const int numberPSide, const int numberQSide, const int tc, __m128i* fp, __m128i* fq )
+{
+  CHECK( numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function" );
+
+  static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int dbCoeffs3[3] = { 53, 32, 11 };
+  static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6 };
+  static const int tc7[7]       = { 6, 5, 4, 3, 2, 1, 1 };
+  static const int tc3[3]       = { 6, 4, 2 };
+
+  const __m128i refP = simdDbRound( _mm_add_epi32( p[numberPSide - 1], p[numberPSide] ), 1 );
+  const __m128i refQ = simdDbRound( _mm_add_epi32( q[numberQSide - 1], q[numberQSide] ), 1 );
+  __m128i refMiddle;
+
+  if( numberPSide == numberQSide )
+  {
+    if( numberPSide == 5 )
+    {
+      const __m128i sum = simdDbSum( p[0], q[0], p[1], q[1], p[2], q[2] );
+      refMiddle = simdDbRound( _mm_add_epi32( _mm_slli_epi32( sum, 1 ), simdDbSum( p[3], q[3], p[4], q[4] ) ), 4 );
+    }
+    else
+    {
+      refMiddle = simdDbRound( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( p[0], q[0] ), 1 ),
+                                              simdDbSum( p[1], q[1], p[2], q[2], p[3], q[3], p[4], q[4], p[5], q[5], p[6], q[6] ) ), 4 );
+    }
+  }
+  else
+  {
+    const __m128i* pt      = numberQSide > numberPSide ? q : p;
+    const __m128i* qt      = numberQSide > numberPSide ? p : q;
+    const int      largeNum = std::max( numberPSide, numberQSide );
+    const int      smallNum = std::min( numberPSide, numberQSide );
+
+    if( largeNum == 7 && smallNum == 5 )
+    {
+      const __m128i sum = simdDbSum( p[0], q[0], p[1], q[1] );
+      refMiddle = simdDbRound( _mm_add_epi32( _mm_slli_epi32( sum, 1 ), simdDbSum( p[2], q[2], p[3], q[3], p[4], q[4], p[5], q[5] ) ), 4 );
+    }
+    else if( largeNum == 7 && smallNum == 3 )
+    {
+      const __m128i sum = simdDbSum( pt[0], qt[0], qt[1], qt[2] );
+      refMiddle = simdDbRound( _mm_add_epi32( _mm_slli_epi32( sum, 1 ), simdDbSum( qt[0], pt[1], qt[1], pt[2], pt[3], pt[4], pt[5], pt[6] ) ), 4 );
+    }
+    else
+    {
+      refMiddle = simdDbRound( simdDbSum( p[0], q[0], p[1], q[1], p[2], q[2], p[3], q[3] ), 3 );
+    }
+  }
+
+  const int* dbCoeffsP = numberPSide == 7 ? dbCoeffs7 : ( numberPSide == 5 ) ? dbCoeffs5 : dbCoeffs3;
+  const int* dbCoeffsQ = numberQSide == 7 ? dbCoeffs7 : ( numberQSide == 5 ) ? dbCoeffs5 : dbCoeffs3;
+  const int* tcP       = numberPSide == 3 ? tc3 : tc7;
+  const int* tcQ       = numberQSide == 3 ? tc3 : tc7;
+
+  for( int pos = 0; pos < numberPSide; pos++ )
+  {
+    const __m128i val = _mm_add_epi32( _mm_mullo_epi32( refMiddle, _mm_set1_epi32( dbCoeffsP[pos] ) ), _mm_mullo_epi32( refP, _mm_set1_epi32( 64 - dbCoeffsP[pos] ) ) );
+    fp[pos] = simdDbClipTc( p[pos], _mm_set1_epi32( ( tc * tcP[pos] ) >> 1 ), simdDbRound( val, 6 ) );
+  }
+  for( int pos = 0; pos < numberQSide; pos++ )
+  {
+    const __m128i val = _mm_add_epi32( _mm_mullo_epi32( refMiddle, _mm_set1_epi32( dbCoeffsQ[pos] ) ), _mm_mullo_epi32( refQ, _mm_set1_epi32( 64 - dbCoeffsQ[pos] ) ) );
+    fq[pos] = simdDbClipTc( q[pos], _mm_set1_epi32( ( tc * tcQ[pos] ) >> 1 ), simdDbRound( val, 6 ) );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPelFilterLumaLines( Pel* piSrc, const int iOffset, const int step, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ )
+{
+  const int  numLines   = DEBLOCK_SMALLEST_BLOCK / 2;
+  const bool longFilter = sw && ( sidePisLarge || sideQisLarge );
+  // number of samples that may be modified on each side, the filters read one sample more
+  const int  numP       = longFilter && sidePisLarge ? maxFilterLengthP : 3;
+  const int  numQ       = longFilter && sideQisLarge ? maxFilterLengthQ : 3;
+
+  __m128i p[8], q[8];
+  simdDbLoadSamples( piSrc, iOffset, step, numLines, numP + 1, numQ + 1, p, q );
+
+  __m128i fp[8], fq[8];
+  std::copy( p, p + 8, fp );
+  std::copy( q, q + 8, fq );
+
+  if( longFilter )
+  {
+    simdDbFilteringPandQ( p, q, numP, numQ, tc, fp, fq );
+  }
+  else if( sw )
+  {
+    const __m128i tc1 = _mm_set1_epi32( tc );
+    const __m128i tc2 = _mm_set1_epi32( 2 * tc );
+    const __m128i tc3 = _mm_set1_epi32( 3 * tc );
+    const __m128i p0q0 = _mm_add_epi32( p[0], q[0] );
+
+    fp[0] = simdDbClipTc( p[0], tc3, simdDbRound( simdDbSum( p[2], _mm_slli_epi32( _mm_add_epi32( p[1], p0q0 ), 1 ), q[1] ), 3 ) );
+    fq[0] = simdDbClipTc( q[0], tc3, simdDbRound( simdDbSum( p[1], _mm_slli_epi32( _mm_add_epi32( q[1], p0q0 ), 1 ), q[2] ), 3 ) );
+    fp[1] = simdDbClipTc( p[1], tc2, simdDbRound( simdDbSum( p[2], p[1], p0q0 ), 2 ) );
+    fq[1] = simdDbClipTc( q[1], tc2, simdDbRound( simdDbSum( p0q0, q[1], q[2] ), 2 ) );
+    fp[2] = simdDbClipTc( p[2], tc1, simdDbRound( simdDbSum( _mm_slli_epi32( p[3], 1 ), _mm_mullo_epi32( p[2], _mm_set1_epi32( 3 ) ), p[1], p0q0 ), 3 ) );
+    fq[2] = simdDbClipTc( q[2], tc1, simdDbRound( simdDbSum( p0q0, q[1], _mm_mullo_epi32( q[2], _mm_set1_epi32( 3 ) ), _mm_slli_epi32( q[3], 1 ) ), 3 ) );
+  }
+  else
+  {
+    /* Weak filter */
+    const __m128i minVal = _mm_set1_epi32( clpRng.min );
+    const __m128i maxVal = _mm_set1_epi32( clpRng.max );
+    const __m128i vtc    = _mm_set1_epi32( tc );
+
+    __m128i delta = _mm_sub_epi32( _mm_mullo_epi32( _mm_sub_epi32( q[0], p[0] ), _mm_set1_epi32( 9 ) ),
+                                   _mm_mullo_epi32( _mm_sub_epi32( q[1], p[1] ), _mm_set1_epi32( 3 ) ) );
+    delta = simdDbRound( delta, 4 );
+
+    const __m128i filterMask = _mm_cmplt_epi32( _mm_abs_epi32( delta ), _mm_set1_epi32( iThrCut ) );
+    if( !_mm_testz_si128( filterMask, filterMask ) )
+    {
+      delta = simdDbClip3( _mm_sub_epi32( _mm_setzero_si128(), vtc ), vtc, delta );
+      fp[0] = _mm_blendv_epi8( p[0], simdDbClip3( minVal, maxVal, _mm_add_epi32( p[0], delta ) ), filterMask );
+      fq[0] = _mm_blendv_epi8( q[0], simdDbClip3( minVal, maxVal, _mm_sub_epi32( q[0], delta ) ), filterMask );
+
+      const __m128i tc2    = _mm_set1_epi32( tc >> 1 );
+      const __m128i negTc2 = _mm_sub_epi32( _mm_setzero_si128(), tc2 );
+      if( bFilterSecondP )
+      {
+        __m128i delta1 = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( simdDbRound( _mm_add_epi32( p[2], p[0] ), 1 ), p[1] ), delta ), 1 );
+        delta1 = simdDbClip3( negTc2, tc2, delta1 );
+        fp[1]  = _mm_blendv_epi8( p[1], simdDbClip3( minVal, maxVal, _mm_add_epi32( p[1], delta1 ) ), filterMask );
+      }
+      if( bFilterSecondQ )
+      {
+        __m128i delta2 = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( simdDbRound( _mm_add_epi32( q[2], q[0] ), 1 ), q[1] ), delta ), 1 );
+        delta2 = simdDbClip3( negTc2, tc2, delta2 );
+        fq[1]  = _mm_blendv_epi8( q[1], simdDbClip3( minVal, maxVal, _mm_add_epi32( q[1], delta2 ) ), filterMask );
+      }
+    }
+  }
+
+  if( bPartPNoFilter )
+  {
+    std::copy( p, p + 8, fp );
+  }
+  if( bPartQNoFilter )
+  {
+    std::copy( q, q + 8, fq );
+  }
+
+  simdDbStoreSamples( piSrc, iOffset, step, numLines, bPartPNoFilter && iOffset != 1 ? 0 : numP, bPartQNoFilter && iOffset != 1 ? 0 : numQ, fp, fq );
+}
+
+template<X86_VEXT vext>
+static void simdPelFilterChromaLines( Pel* piSrc, const int iOffset, const int step, const int numLines, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary )
+{
+  __m128i p[4], q[4];
+  simdDbLoadSamples( piSrc, iOffset, step, numLines, 4, 4, p, q );
+
+  __m128i fp[4], fq[4];
+  std::copy( p, p + 4, fp );
+  std::copy( q, q + 4, fq );
+
+  const __m128i vtc = _mm_set1_epi32( tc );
+  int numP = 1;
+  int numQ = 1;
+
+  if( sw )
+  {
+    const __m128i p0q0 = _mm_add_epi32( p[0], q[0] );
+    if( isChromaHorCTBBoundary )
+    {
+      fp[0] = simdDbClipTc( p[0], vtc, simdDbRound( simdDbSum( _mm_mullo_epi32( p[1], _mm_set1_epi32( 3 ) ), p[0], p0q0, q[1], q[2] ), 3 ) );
+      fq[0] = simdDbClipTc( q[0], vtc, simdDbRound( simdDbSum( _mm_slli_epi32( p[1], 1 ), p0q0, q[0], q[1], q[2], q[3] ), 3 ) );
+    }
+    else
+    {
+      numP  = 3;
+      fp[2] = simdDbClipTc( p[2], vtc, simdDbRound( simdDbSum( _mm_mullo_epi32( p[3], _mm_set1_epi32( 3 ) ), _mm_slli_epi32( p[2], 1 ), p[1], p0q0 ), 3 ) );
+      fp[1] = simdDbClipTc( p[1], vtc, simdDbRound( simdDbSum( _mm_slli_epi32( _mm_add_epi32( p[3], p[1] ), 1 ), p[2], p0q0, q[1] ), 3 ) );
+      fp[0] = simdDbClipTc( p[0], vtc, simdDbRound( simdDbSum( p[3], p[2], p[1], p[0], p0q0, q[1], q[2] ), 3 ) );
+      fq[0] = simdDbClipTc( q[0], vtc, simdDbRound( simdDbSum( p[2], p[1], p0q0, q[0], q[1], q[2], q[3] ), 3 ) );
+    }
+    numQ  = 3;
+    fq[1] = simdDbClipTc( q[1], vtc, simdDbRound( simdDbSum( p[1], p0q0, _mm_slli_epi32( _mm_add_epi32( q[1], q[3] ), 1 ), q[2] ), 3 ) );
+    fq[2] = simdDbClipTc( q[2], vtc, simdDbRound( simdDbSum( p0q0, q[1], _mm_slli_epi32( q[2], 1 ), _mm_mullo_epi32( q[3], _mm_set1_epi32( 3 ) ) ), 3 ) );
+  }
+  else
+  {
+    const __m128i minVal = _mm_set1_epi32( clpRng.min );
+    const __m128i maxVal = _mm_set1_epi32( clpRng.max );
+
+    __m128i delta = simdDbSum( _mm_slli_epi32( _mm_sub_epi32( q[0], p[0] ), 2 ), p[1], _mm_sub_epi32( _mm_setzero_si128(), q[1] ) );
+    delta = simdDbClip3( _mm_sub_epi32( _mm_setzero_si128(), vtc ), vtc, simdDbRound( delta, 3 ) );
+    fp[0] = simdDbClip3( minVal, maxVal, _mm_add_epi32( p[0], delta ) );
+    fq[0] = simdDbClip3( minVal, maxVal, _mm_sub_epi32( q[0], delta ) );
+  }
+
+  if( bPartPNoFilter )
+  {
+    std::copy( p, p + 4, fp );
+  }
+  if( bPartQNoFilter )
+  {
+    std::copy( q, q + 4, fq );
+  }
+
+  simdDbStoreSamples( piSrc, iOffset, step, numLines, bPartPNoFilter && iOffset != 1 ? 0 : numP, bPartQNoFilter && iOffset != 1 ? 0 : numQ, fp, fq );
+}
+#endif
+
+template <X86_VEXT vext>
+void DeblockingFilter::_initDeblockingFilterX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_pelFilterLumaLines   = simdPelFilterLumaLines<vext>;
+  m_pelFilterChromaLines = simdPelFilterChromaLines<vext>;
+#endif
+}
+
+template void DeblockingFilter::_initDeblockingFilterX86<SIMDX86>();
+#endif   // TARGET_SIMD_X86
@@ -0,0 +1,208 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DepQuantX86.h
+    \brief    SIMD trellis decision for the dependent quantization
+*/
+
+#include "CommonDefX86.h"
+#include "../DepQuant.h"
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT && defined( USE_AVX2 )
+static_assert( sizeof( DQIntern::Decision ) == 16, "the decision layout is assumed to be { int64 rdCost, int32 absLevel, int32 prevId }" );
+
+// fraction bits of the context coded part (and rice remainder) of the levels in absLevel, one lane per state
+static inline __m128i simdDqRegularBits( const int32_t* coeffBits, const __m128i& laneOffset, const __m128i& riceRow, const __m128i& absLevel )
+{
+  const __m128i lt4     = _mm_cmplt_epi32( absLevel, _mm_set1_epi32( 4 ) );
+  const __m128i bitsIdx = _mm_blendv_epi8( _mm_add_epi32( _mm_and_si128( absLevel, _mm_set1_epi32( 1 ) ), _mm_set1_epi32( 4 ) ), absLevel, lt4 );
+  __m128i       bits    = _mm_i32gather_epi32( coeffBits, _mm_add_epi32( laneOffset, bitsIdx ), 4 );
+  if( !_mm_test_all_ones( lt4 ) )
+  {
+    __m128i value = _mm_srai_epi32( _mm_sub_epi32( absLevel, _mm_set1_epi32( 4 ) ), 1 );
+    value         = _mm_andnot_si128( lt4, _mm_min_epi32( value, _mm_set1_epi32( RICEMAX - 1 ) ) );
+    bits          = _mm_add_epi32( bits, _mm_andnot_si128( lt4, _mm_i32gather_epi32( &DQIntern::g_goRiceBits[0][0], _mm_add_epi32( riceRow, value ), 4 ) ) );
+  }
+  return bits;
+}
+
+// fraction bits of the levels in absLevel coded in bypass mode, the lanes in skipMask are not evaluated
+static inline __m128i simdDqBypassBits( const __m128i& riceRow, const __m128i& goRiceZero, const __m128i& absLevel, const __m128i& skipMask )
+{
+  const __m128i leZero = _mm_cmpgt_epi32( _mm_add_epi32( goRiceZero, _mm_set1_epi32( 1 ) ), absLevel );
+  __m128i       idx    = _mm_blendv_epi8( _mm_min_epi32( absLevel, _mm_set1_epi32( RICEMAX - 1 ) ), _mm_sub_epi32( absLevel, _mm_set1_epi32( 1 ) ), leZero );
+  idx                  = _mm_andnot_si128( skipMask, idx );
+  return _mm_add_epi32( _mm_set1_epi32( 1 << SCALE_BITS ), _mm_i32gather_epi32( &DQIntern::g_goRiceBits[0][0], _mm_add_epi32( riceRow, idx ), 4 ) );
+}
+
+static inline int64_t simdDqStartCost( const DQIntern::StateMem& start, const int32_t lastOffset, const DQIntern::PQData& pqData )
+{
+  int64_t rdCost = pqData.deltaDist + lastOffset;
+  if( pqData.absLevel < 4 )
+  {
+    rdCost += start.coeffBits[0][pqData.absLevel];
+  }
+  else
+  {
+    const TCoeff value = ( pqData.absLevel - 4 ) >> 1;
+    rdCost += start.coeffBits[0][pqData.absLevel - ( value << 1 )] + DQIntern::g_goRiceBits[start.goRicePar[0]][value < RICEMAX ? value : RICEMAX - 1];
+  }
+  return rdCost;
+}
+
+// keeps the first minimum: a candidate replaces the current decision only if its cost is strictly lower
+static inline void simdDqSelect( __m256i& bestCost, __m256i& bestInfo, const __m256i& cost, const __m256i& info )
+{
+  const __m256i better = _mm256_cmpgt_epi64( bestCost, cost );
+  bestCost             = _mm256_blendv_epi8( bestCost, cost, better );
+  bestInfo             = _mm256_blendv_epi8( bestInfo, info, better );
+}
+
+// The four predecessor states are evaluated in parallel lanes. The candidates are then regrouped per target
+// state in the order of the scalar implementation, which keeps the tie breaking and the decisions identical.
+template<X86_VEXT vext>
+static void simdDecide( const DQIntern::PQData* pqData, const DQIntern::StateMem& prev, const DQIntern::StateMem& skip, const DQIntern::StateMem& start, const DQIntern::ScanPosType spt, const int32_t lastOffset, DQIntern::Decision* decisions )
+{
+  const int64_t maxCost     = std::numeric_limits<int64_t>::max();
+  const int64_t initInfo    = int64_t( ( uint64_t( uint32_t( -2 ) ) << 32 ) | uint32_t( -1 ) );
+  const int64_t startInfo   = int64_t( uint64_t( uint32_t( -1 ) ) << 32 );
+
+  // states 0 and 1 test the quantization indices of pqData[0] and pqData[2], states 2 and 3 those of pqData[3] and pqData[1]
+  const __m128i absA        = _mm_setr_epi32( pqData[0].absLevel, pqData[0].absLevel, pqData[3].absLevel, pqData[3].absLevel );
+  const __m128i absB        = _mm_setr_epi32( pqData[2].absLevel, pqData[2].absLevel, pqData[1].absLevel, pqData[1].absLevel );
+  const __m256i distA       = _mm256_setr_epi64x( pqData[0].deltaDist, pqData[0].deltaDist, pqData[3].deltaDist, pqData[3].deltaDist );
+  const __m256i distB       = _mm256_setr_epi64x( pqData[2].deltaDist, pqData[2].deltaDist, pqData[1].deltaDist, pqData[1].deltaDist );
+
+  const __m256i oddEven     = _mm256_setr_epi32( 0, 2, 4, 6, 1, 3, 5, 7 );
+  const __m128i laneOffset  = _mm_setr_epi32( 0, 8, 16, 24 );
+  const __m128i regular     = _mm_cmpgt_epi32( _mm_loadu_si128( ( const __m128i* ) prev.remRegBins ), _mm_set1_epi32( 3 ) );
+  const __m128i riceRow     = _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* ) prev.goRicePar ), _mm_set1_epi32( RICEMAX ) );
+
+  //===== rates of the levels A, B and of the zero level =====
+  const __m256i sigBits     = _mm256_permutevar8x32_epi32( _mm256_loadu_si256( ( const __m256i* ) prev.sigBits ), oddEven );
+  __m128i       sigA        = _mm256_extracti128_si256( sigBits, 1 );
+  __m128i       sigZ        = _mm256_castsi256_si128  ( sigBits );
+  __m128i       zeroOff     = _mm_setzero_si128();
+  if( spt == DQIntern::SCAN_SOCSBB )
+  {
+    const __m128i sbb1      = _mm256_extracti128_si256( _mm256_permutevar8x32_epi32( _mm256_loadu_si256( ( const __m256i* ) prev.sbbBits ), oddEven ), 1 );
+    sigA                    = _mm_add_epi32( sigA, sbb1 );
+    sigZ                    = _mm_add_epi32( sigZ, sbb1 );
+  }
+  else if( spt == DQIntern::SCAN_EOCSBB )
+  {
+    // without a significant level in the sub-block the last one is inferred, zero cannot be chosen
+    const __m128i noSig     = _mm_cmpeq_epi32( _mm_loadu_si128( ( const __m128i* ) prev.numSigSbb ), _mm_setzero_si128() );
+    sigA                    = _mm_andnot_si128( noSig, sigA );
+    sigZ                    = _mm_andnot_si128( noSig, sigZ );
+    zeroOff                 = _mm_and_si128   ( noSig, regular );
+  }
+  __m128i rateA             = _mm_add_epi32( simdDqRegularBits( prev.coeffBits[0], laneOffset, riceRow, absA ), sigA );
+  __m128i rateB             = _mm_add_epi32( simdDqRegularBits( prev.coeffBits[0], laneOffset, riceRow, absB ), sigA );
+  __m128i rateZ             = sigZ;
+  if( !_mm_test_all_ones( regular ) )
+  {
+    const __m128i goRiceZero = _mm_loadu_si128( ( const __m128i* ) prev.goRiceZero );
+    const __m128i bypassZ    = _mm_i32gather_epi32( &DQIntern::g_goRiceBits[0][0], _mm_add_epi32( riceRow, _mm_andnot_si128( regular, goRiceZero ) ), 4 );
+    rateA                    = _mm_blendv_epi8( simdDqBypassBits( riceRow, goRiceZero, absA, regular ), rateA, regular );
+    rateB                    = _mm_blendv_epi8( simdDqBypassBits( riceRow, goRiceZero, absB, regular ), rateB, regular );
+    rateZ                    = _mm_blendv_epi8( bypassZ, rateZ, regular );
+  }
+
+  //===== costs and decision info ( absLevel | prevId << 32 ) per predecessor state =====
+  const __m256i rdCost      = _mm256_loadu_si256( ( const __m256i* ) prev.rdCost );
+  const __m256i stateId     = _mm256_setr_epi64x( 0, int64_t( 1 ) << 32, int64_t( 2 ) << 32, int64_t( 3 ) << 32 );
+  __m256i       costA       = _mm256_add_epi64( _mm256_add_epi64( rdCost, distA ), _mm256_cvtepi32_epi64( rateA ) );
+  __m256i       costB       = _mm256_add_epi64( _mm256_add_epi64( rdCost, distB ), _mm256_cvtepi32_epi64( rateB ) );
+  __m256i       costZ       = _mm256_add_epi64( rdCost, _mm256_cvtepi32_epi64( rateZ ) );
+  costZ                     = _mm256_blendv_epi8( costZ, _mm256_set1_epi64x( maxCost ), _mm256_cvtepi32_epi64( zeroOff ) );
+  __m256i       infoA       = _mm256_or_si256( _mm256_cvtepu32_epi64( absA ), stateId );
+  __m256i       infoB       = _mm256_or_si256( _mm256_cvtepu32_epi64( absB ), stateId );
+  __m256i       infoZ       = stateId;
+
+  // reorder the state lanes to { 0, 2, 1, 3 }, the candidates of the target states 0..3 are then
+  // { A0, A2, B0, B2 }, { Z0, Z2, A1, A3 } and { B1, B3, Z1, Z3 } in this order
+  costA                     = _mm256_permute4x64_epi64( costA, 0xd8 );
+  costB                     = _mm256_permute4x64_epi64( costB, 0xd8 );
+  costZ                     = _mm256_permute4x64_epi64( costZ, 0xd8 );
+  infoA                     = _mm256_permute4x64_epi64( infoA, 0xd8 );
+  infoB                     = _mm256_permute4x64_epi64( infoB, 0xd8 );
+  infoZ                     = _mm256_permute4x64_epi64( infoZ, 0xd8 );
+
+  __m256i bestCost          = _mm256_set1_epi64x( maxCost >> 2 );
+  __m256i bestInfo          = _mm256_set1_epi64x( initInfo );
+  simdDqSelect( bestCost, bestInfo, _mm256_permute2x128_si256( costA, costB, 0x20 ), _mm256_permute2x128_si256( infoA, infoB, 0x20 ) );
+  simdDqSelect( bestCost, bestInfo, _mm256_blend_epi32       ( costZ, costA, 0xf0 ), _mm256_blend_epi32       ( infoZ, infoA, 0xf0 ) );
+  simdDqSelect( bestCost, bestInfo, _mm256_permute2x128_si256( costB, costZ, 0x31 ), _mm256_permute2x128_si256( infoB, infoZ, 0x31 ) );
+
+  if( spt == DQIntern::SCAN_EOCSBB )
+  {
+    const __m128i sbb0      = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( _mm256_loadu_si256( ( const __m256i* ) skip.sbbBits ), oddEven ) );
+    const __m256i costSkip  = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) skip.rdCost ), _mm256_cvtepi32_epi64( sbb0 ) );
+    simdDqSelect( bestCost, bestInfo, costSkip, _mm256_setr_epi64x( int64_t( 4 ) << 32, int64_t( 5 ) << 32, int64_t( 6 ) << 32, int64_t( 7 ) << 32 ) );
+  }
+
+  const __m256i costStart   = _mm256_setr_epi64x( simdDqStartCost( start, lastOffset, pqData[0] ), maxCost, simdDqStartCost( start, lastOffset, pqData[2] ), maxCost );
+  const __m256i infoStart   = _mm256_setr_epi64x( startInfo | uint32_t( pqData[0].absLevel ), 0, startInfo | uint32_t( pqData[2].absLevel ), 0 );
+  simdDqSelect( bestCost, bestInfo, costStart, infoStart );
+
+  //===== store, the decisions 4..7 ( skipped sub-block ) keep their initial values =====
+  const __m256i lo          = _mm256_unpacklo_epi64( bestCost, bestInfo );
+  const __m256i hi          = _mm256_unpackhi_epi64( bestCost, bestInfo );
+  _mm256_storeu_si256( ( __m256i* ) &decisions[0], _mm256_permute2x128_si256( lo, hi, 0x20 ) );
+  _mm256_storeu_si256( ( __m256i* ) &decisions[2], _mm256_permute2x128_si256( lo, hi, 0x31 ) );
+  _mm256_storeu_si256( ( __m256i* ) &decisions[4], _mm256_setr_epi64x( maxCost >> 2, int64_t( 4 ) << 32, maxCost >> 2, int64_t( 5 ) << 32 ) );
+  _mm256_storeu_si256( ( __m256i* ) &decisions[6], _mm256_setr_epi64x( maxCost >> 2, int64_t( 6 ) << 32, maxCost >> 2, int64_t( 7 ) << 32 ) );
+}
+#endif
+
+template <X86_VEXT vext>
+void DepQuant::_initDepQuantX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT && defined( USE_AVX2 )
+  if( vext >= AVX2 )
+  {
+    m_decide = simdDecide<vext>;
+  }
+#endif
+}
+
+template void DepQuant::_initDepQuantX86<SIMDX86>();
+#endif   // TARGET_SIMD_X86
@@ -0,0 +1,147 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     HashX86.h
+    \brief    SIMD block hash computation for the hash based motion estimation
+*/
+
+#include "CommonDefX86.h"
+#include "../Unit.h"
+#include "../Hash.h"
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT && defined( USE_AVX2 )
+static_assert( sizeof( bool ) == 1, "the same value flags are stored as bytes" );
+
+// remainders of the bytes in the lanes of idx, taken from the slice table of the bytes followed by numZeros zero bytes
+static inline __m256i simdHashSlice( const uint32_t* sliceTable, const int numZeros, const __m256i& idx )
+{
+  return _mm256_i32gather_epi32( ( const int* ) ( sliceTable + numZeros * 256 ), idx, 4 );
+}
+
+// stores the eight 32 bit masks as 0/1 flags
+static inline void simdHashStoreFlags( bool* dst, const __m256i& mask )
+{
+  const __m128i words = _mm_packs_epi32( _mm256_castsi256_si128( mask ), _mm256_extracti128_si256( mask, 1 ) );
+  _mm_storel_epi64( ( __m128i* ) dst, _mm_and_si128( _mm_packs_epi16( words, words ), _mm_set1_epi8( 1 ) ) );
+}
+
+template<X86_VEXT vext>
+static void simdBlockHash2x2Row( const Pel* src, const ptrdiff_t stride, const int shift, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* hash1, uint32_t* hash2, bool* rowSame, bool* colSame )
+{
+  const Pel*    srcBelow = src + stride;
+  const __m256i byteMask = _mm256_set1_epi32( 0xff );
+  const __m128i vshift   = _mm_cvtsi32_si128( shift );
+
+  int x = 0;
+  for( ; x + 8 <= num; x += 8 )
+  {
+    const __m256i p0    = _mm256_and_si256( _mm256_sra_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[x] ) ), vshift ), byteMask );
+    const __m256i p1    = _mm256_and_si256( _mm256_sra_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[x + 1] ) ), vshift ), byteMask );
+    const __m256i p2    = _mm256_and_si256( _mm256_sra_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &srcBelow[x] ) ), vshift ), byteMask );
+    const __m256i p3    = _mm256_and_si256( _mm256_sra_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &srcBelow[x + 1] ) ), vshift ), byteMask );
+
+    simdHashStoreFlags( rowSame + x, _mm256_and_si256( _mm256_cmpeq_epi32( p0, p1 ), _mm256_cmpeq_epi32( p2, p3 ) ) );
+    simdHashStoreFlags( colSame + x, _mm256_and_si256( _mm256_cmpeq_epi32( p0, p2 ), _mm256_cmpeq_epi32( p1, p3 ) ) );
+
+    __m256i crc1 = _mm256_xor_si256( simdHashSlice( sliceTable1, 3, p0 ), simdHashSlice( sliceTable1, 2, p1 ) );
+    __m256i crc2 = _mm256_xor_si256( simdHashSlice( sliceTable2, 3, p0 ), simdHashSlice( sliceTable2, 2, p1 ) );
+    crc1         = _mm256_xor_si256( crc1, _mm256_xor_si256( simdHashSlice( sliceTable1, 1, p2 ), simdHashSlice( sliceTable1, 0, p3 ) ) );
+    crc2         = _mm256_xor_si256( crc2, _mm256_xor_si256( simdHashSlice( sliceTable2, 1, p2 ), simdHashSlice( sliceTable2, 0, p3 ) ) );
+
+    _mm256_storeu_si256( ( __m256i* ) &hash1[x], crc1 );
+    _mm256_storeu_si256( ( __m256i* ) &hash2[x], crc2 );
+  }
+
+  if( x < num )
+  {
+    TComHash::blockHash2x2RowCore( src + x, stride, shift, num - x, sliceTable1, sliceTable2, hash1 + x, hash2 + x, rowSame + x, colSame + x );
+  }
+}
+
+// CRC of the 16 bytes of the four sub-block hashes of eight neighbouring blocks, the hashes have 24 bits so their
+// most significant bytes are zero and do not contribute
+static inline __m256i simdCrcOfSubBlockHashes( const uint32_t* sliceTable, const uint32_t* src, const ptrdiff_t offsetRight, const ptrdiff_t offsetBelow )
+{
+  const uint32_t* sub[4]   = { src, src + offsetRight, src + offsetBelow, src + offsetBelow + offsetRight };
+  const __m256i   byteMask = _mm256_set1_epi32( 0xff );
+
+  __m256i crc = _mm256_setzero_si256();
+  for( int i = 0; i < 4; i++ )
+  {
+    const __m256i words = _mm256_loadu_si256( ( const __m256i* ) sub[i] );
+    const int     slice = 15 - 4 * i;
+    crc = _mm256_xor_si256( crc, simdHashSlice( sliceTable, slice,     _mm256_and_si256( words, byteMask ) ) );
+    crc = _mm256_xor_si256( crc, simdHashSlice( sliceTable, slice - 1, _mm256_and_si256( _mm256_srli_epi32( words, 8 ), byteMask ) ) );
+    crc = _mm256_xor_si256( crc, simdHashSlice( sliceTable, slice - 2, _mm256_srli_epi32( words, 16 ) ) );
+  }
+  return crc;
+}
+
+template<X86_VEXT vext>
+static void simdBlockHashRow( const uint32_t* src1, const uint32_t* src2, const ptrdiff_t offsetRight, const ptrdiff_t offsetBelow, const int num, const uint32_t* sliceTable1, const uint32_t* sliceTable2, uint32_t* dst1, uint32_t* dst2 )
+{
+  int x = 0;
+  for( ; x + 8 <= num; x += 8 )
+  {
+    _mm256_storeu_si256( ( __m256i* ) &dst1[x], simdCrcOfSubBlockHashes( sliceTable1, src1 + x, offsetRight, offsetBelow ) );
+    _mm256_storeu_si256( ( __m256i* ) &dst2[x], simdCrcOfSubBlockHashes( sliceTable2, src2 + x, offsetRight, offsetBelow ) );
+  }
+
+  if( x < num )
+  {
+    TComHash::blockHashRowCore( src1 + x, src2 + x, offsetRight, offsetBelow, num - x, sliceTable1, sliceTable2, dst1 + x, dst2 + x );
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void TComHash::_initHashX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT && defined( USE_AVX2 )
+  if( vext >= AVX2 )
+  {
+    m_blockHash2x2Row = simdBlockHash2x2Row<vext>;
+    m_blockHashRow    = simdBlockHashRow<vext>;
+  }
+#endif
+}
+
+template void TComHash::_initHashX86<SIMDX86>();
+#endif   // TARGET_SIMD_X86
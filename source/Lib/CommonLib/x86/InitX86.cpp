@@ -48,6 +48,16 @@
 
 #include "CommonLib/AdaptiveLoopFilter.h"
 
+#include "CommonLib/DeblockingFilter.h"
+
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/MatrixIntraPrediction.h"
+
+#include "CommonLib/SampleAdaptiveOffset.h"
+
+#include "CommonLib/DepQuant.h"
+#include "CommonLib/Hash.h"
+
 #include "CommonLib/IbcHashMap.h"
 
 #ifdef TARGET_SIMD_X86
@@ -167,6 +177,167 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_DBLF
+void DeblockingFilter::initDeblockingFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initDeblockingFilterX86<AVX2>();
+    break;
+  case AVX:
+    _initDeblockingFilterX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initDeblockingFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_TRAFO
+void TrQuant::initTrQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initTrQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initTrQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initTrQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MIP
+void MatrixIntraPrediction::initMatrixIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initMatrixIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initMatrixIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initMatrixIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initSampleAdaptiveOffsetX86<AVX2>();
+    break;
+  case AVX:
+    _initSampleAdaptiveOffsetX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initSampleAdaptiveOffsetX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DQ
+void DepQuant::initDepQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initDepQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initDepQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initDepQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_HASH
+void TComHash::initHashX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initHashX86<AVX2>();
+    break;
+  case AVX:
+    _initHashX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initHashX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
@@ -0,0 +1,381 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredictionX86.h
+    \brief    SIMD planar, DC and angular intra prediction
+*/
+
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// pairs of 16 bit coefficients (c0, c1) for _mm_madd_epi16
+static inline __m128i simdIntraCoeffPair( const int c0, const int c1 )
+{
+  return _mm_set1_epi32( ( c1 << 16 ) | ( c0 & 0xffff ) );
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraPlanar( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height )
+{
+  const int log2W      = floorLog2( width );
+  const int log2H      = floorLog2( height );
+  const int finalShift = 1 + log2W + log2H;
+  const int bottomLeft = left[height];
+  const int topRight   = top[width];
+
+  // vertical predictor of the current row and its increment per row, both scaled by width
+  int vertPred[MAX_CU_SIZE];
+  int vertStep[MAX_CU_SIZE];
+
+  for( int x = 0; x < width; x++ )
+  {
+    vertPred[x] = ( top[x] << log2H ) << log2W;
+    vertStep[x] = ( bottomLeft - top[x] ) << log2W;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    const __m256i vOffset = _mm256_set1_epi32( 1 << ( log2W + log2H ) );
+    const __m256i vInc0   = _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 );
+    const __m256i vEight  = _mm256_set1_epi32( 8 );
+
+    for( int y = 0; y < height; y++, dst += dstStride )
+    {
+      const __m256i vHorBase = _mm256_set1_epi32( ( left[y] << log2W ) << log2H );
+      const __m256i vHorStep = _mm256_set1_epi32( ( topRight - left[y] ) << log2H );
+      __m256i vInc           = vInc0;
+
+      for( int x = 0; x < width; x += 16 )
+      {
+        __m256i vVer0 = _mm256_add_epi32( _mm256_loadu_si256( ( const __m256i* ) &vertPred[x] ), _mm256_loadu_si256( ( const __m256i* ) &vertStep[x] ) );
+        __m256i vVer1 = _mm256_add_epi32( _mm256_loadu_si256( ( const __m256i* ) &vertPred[x + 8] ), _mm256_loadu_si256( ( const __m256i* ) &vertStep[x + 8] ) );
+        _mm256_storeu_si256( ( __m256i* ) &vertPred[x], vVer0 );
+        _mm256_storeu_si256( ( __m256i* ) &vertPred[x + 8], vVer1 );
+
+        __m256i vHor0 = _mm256_add_epi32( vHorBase, _mm256_mullo_epi32( vInc, vHorStep ) );
+        vInc          = _mm256_add_epi32( vInc, vEight );
+        __m256i vHor1 = _mm256_add_epi32( vHorBase, _mm256_mullo_epi32( vInc, vHorStep ) );
+        vInc          = _mm256_add_epi32( vInc, vEight );
+
+        __m256i vSum0 = _mm256_srai_epi32( _mm256_add_epi32( _mm256_add_epi32( vHor0, vVer0 ), vOffset ), finalShift );
+        __m256i vSum1 = _mm256_srai_epi32( _mm256_add_epi32( _mm256_add_epi32( vHor1, vVer1 ), vOffset ), finalShift );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_permute4x64_epi64( _mm256_packs_epi32( vSum0, vSum1 ), 0xd8 ) );
+      }
+    }
+    return;
+  }
+#endif
+
+  const __m128i vOffset = _mm_set1_epi32( 1 << ( log2W + log2H ) );
+  const __m128i vInc0   = _mm_setr_epi32( 1, 2, 3, 4 );
+  const __m128i vFour   = _mm_set1_epi32( 4 );
+
+  for( int y = 0; y < height; y++, dst += dstStride )
+  {
+    const __m128i vHorBase = _mm_set1_epi32( ( left[y] << log2W ) << log2H );
+    const __m128i vHorStep = _mm_set1_epi32( ( topRight - left[y] ) << log2H );
+    __m128i vInc           = vInc0;
+
+    for( int x = 0; x < width; x += 4 )
+    {
+      __m128i vVer = _mm_add_epi32( _mm_loadu_si128( ( const __m128i* ) &vertPred[x] ), _mm_loadu_si128( ( const __m128i* ) &vertStep[x] ) );
+      _mm_storeu_si128( ( __m128i* ) &vertPred[x], vVer );
+
+      __m128i vHor = _mm_add_epi32( vHorBase, _mm_mullo_epi32( vInc, vHorStep ) );
+      vInc         = _mm_add_epi32( vInc, vFour );
+
+      __m128i vSum = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( vHor, vVer ), vOffset ), finalShift );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packs_epi32( vSum, vSum ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static int simdSumRefSamples( const Pel* ref, const int n )
+{
+  const __m128i vOne = _mm_set1_epi16( 1 );
+  __m128i vSum       = _mm_setzero_si128();
+  int x              = 0;
+
+  for( ; x + 8 <= n; x += 8 )
+  {
+    vSum = _mm_add_epi32( vSum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &ref[x] ), vOne ) );
+  }
+  if( x + 4 <= n )
+  {
+    vSum = _mm_add_epi32( vSum, _mm_madd_epi16( _mm_loadl_epi64( ( const __m128i* ) &ref[x] ), vOne ) );
+    x += 4;
+  }
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x4e ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) );
+
+  int sum = _mm_cvtsi128_si32( vSum );
+  for( ; x < n; x++ )
+  {
+    sum += ref[x];
+  }
+  return sum;
+}
+
+template<X86_VEXT vext>
+static void simdPdpcPlanarDc( const Pel* top, const Pel* left, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const int scale )
+{
+  // the prediction is combined as val + ( ( wL * left + wT * top - ( wL + wT ) * val + 32 ) >> 6 ),
+  // both products are formed by _mm_madd_epi16 on interleaved samples and weights
+  int16_t weightLeft[MAX_CU_SIZE];
+  for( int x = 0; x < width; x++ )
+  {
+    weightLeft[x] = 32 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+  }
+
+  const __m128i vRound = _mm_set1_epi32( 32 );
+
+  for( int y = 0; y < height; y++, dst += dstStride )
+  {
+    const int     wT     = 32 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+    const __m128i vLeft  = _mm_set1_epi16( left[y] );
+    const __m128i vWt    = _mm_set1_epi16( wT );
+    const __m128i vNegWt = _mm_set1_epi16( -wT );
+
+    for( int x = 0; x < width; x += 8 )
+    {
+      const bool half = x + 8 > width;
+      __m128i vVal    = half ? _mm_loadl_epi64( ( const __m128i* ) &dst[x] ) : _mm_loadu_si128( ( const __m128i* ) &dst[x] );
+      __m128i vTop    = half ? _mm_loadl_epi64( ( const __m128i* ) &top[x] ) : _mm_loadu_si128( ( const __m128i* ) &top[x] );
+      __m128i vWl     = half ? _mm_loadl_epi64( ( const __m128i* ) &weightLeft[x] ) : _mm_loadu_si128( ( const __m128i* ) &weightLeft[x] );
+      __m128i vNegWl  = _mm_sub_epi16( _mm_setzero_si128(), vWl );
+
+      __m128i vRefLo = _mm_unpacklo_epi16( vLeft, vTop );
+      __m128i vRefHi = _mm_unpackhi_epi16( vLeft, vTop );
+      __m128i vValLo = _mm_unpacklo_epi16( vVal, vVal );
+      __m128i vValHi = _mm_unpackhi_epi16( vVal, vVal );
+
+      __m128i vLo = _mm_add_epi32( _mm_madd_epi16( vRefLo, _mm_unpacklo_epi16( vWl, vWt ) ), _mm_madd_epi16( vValLo, _mm_unpacklo_epi16( vNegWl, vNegWt ) ) );
+      __m128i vHi = _mm_add_epi32( _mm_madd_epi16( vRefHi, _mm_unpackhi_epi16( vWl, vWt ) ), _mm_madd_epi16( vValHi, _mm_unpackhi_epi16( vNegWl, vNegWt ) ) );
+
+      vLo = _mm_add_epi32( _mm_cvtepi16_epi32( vVal ), _mm_srai_epi32( _mm_add_epi32( vLo, vRound ), 6 ) );
+      vHi = _mm_add_epi32( _mm_cvtepi16_epi32( _mm_unpackhi_epi64( vVal, vVal ) ), _mm_srai_epi32( _mm_add_epi32( vHi, vRound ), 6 ) );
+
+      __m128i vRes = _mm_packs_epi32( vLo, vHi );
+      if( half )
+      {
+        _mm_storel_epi64( ( __m128i* ) &dst[x], vRes );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[x], vRes );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraAngLumaRow( Pel* dst, const Pel* ref, const int width, const TFilterCoeff* f, const ClpRng& clpRng )
+{
+  int x = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vCoeff01 = _mm256_set1_epi32( ( f[1] << 16 ) | ( f[0] & 0xffff ) );
+    const __m256i vCoeff23 = _mm256_set1_epi32( ( f[3] << 16 ) | ( f[2] & 0xffff ) );
+    const __m256i vRound   = _mm256_set1_epi32( 32 );
+    const __m256i vMin     = _mm256_set1_epi16( clpRng.min );
+    const __m256i vMax     = _mm256_set1_epi16( clpRng.max );
+
+    for( ; x + 16 <= width; x += 16 )
+    {
+      __m256i vP0 = _mm256_loadu_si256( ( const __m256i* ) &ref[x] );
+      __m256i vP1 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 1] );
+      __m256i vP2 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 2] );
+      __m256i vP3 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 3] );
+
+      __m256i vLo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vP0, vP1 ), vCoeff01 ), _mm256_madd_epi16( _mm256_unpacklo_epi16( vP2, vP3 ), vCoeff23 ) );
+      __m256i vHi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vP0, vP1 ), vCoeff01 ), _mm256_madd_epi16( _mm256_unpackhi_epi16( vP2, vP3 ), vCoeff23 ) );
+
+      vLo = _mm256_srai_epi32( _mm256_add_epi32( vLo, vRound ), 6 );
+      vHi = _mm256_srai_epi32( _mm256_add_epi32( vHi, vRound ), 6 );
+
+      __m256i vRes = _mm256_min_epi16( _mm256_max_epi16( _mm256_packs_epi32( vLo, vHi ), vMin ), vMax );
+      _mm256_storeu_si256( ( __m256i* ) &dst[x], vRes );
+    }
+  }
+#endif
+
+  const __m128i vCoeff01 = simdIntraCoeffPair( f[0], f[1] );
+  const __m128i vCoeff23 = simdIntraCoeffPair( f[2], f[3] );
+  const __m128i vRound   = _mm_set1_epi32( 32 );
+  const __m128i vMin     = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax     = _mm_set1_epi16( clpRng.max );
+
+  for( ; x + 8 <= width; x += 8 )
+  {
+    __m128i vP0 = _mm_loadu_si128( ( const __m128i* ) &ref[x] );
+    __m128i vP1 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 1] );
+    __m128i vP2 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 2] );
+    __m128i vP3 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 3] );
+
+    __m128i vLo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vP0, vP1 ), vCoeff01 ), _mm_madd_epi16( _mm_unpacklo_epi16( vP2, vP3 ), vCoeff23 ) );
+    __m128i vHi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vP0, vP1 ), vCoeff01 ), _mm_madd_epi16( _mm_unpackhi_epi16( vP2, vP3 ), vCoeff23 ) );
+
+    vLo = _mm_srai_epi32( _mm_add_epi32( vLo, vRound ), 6 );
+    vHi = _mm_srai_epi32( _mm_add_epi32( vHi, vRound ), 6 );
+
+    __m128i vRes = _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( vLo, vHi ), vMin ), vMax );
+    _mm_storeu_si128( ( __m128i* ) &dst[x], vRes );
+  }
+  for( ; x + 4 <= width; x += 4 )
+  {
+    __m128i vP0 = _mm_loadl_epi64( ( const __m128i* ) &ref[x] );
+    __m128i vP1 = _mm_loadl_epi64( ( const __m128i* ) &ref[x + 1] );
+    __m128i vP2 = _mm_loadl_epi64( ( const __m128i* ) &ref[x + 2] );
+    __m128i vP3 = _mm_loadl_epi64( ( const __m128i* ) &ref[x + 3] );
+
+    __m128i vLo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vP0, vP1 ), vCoeff01 ), _mm_madd_epi16( _mm_unpacklo_epi16( vP2, vP3 ), vCoeff23 ) );
+    vLo         = _mm_srai_epi32( _mm_add_epi32( vLo, vRound ), 6 );
+
+    __m128i vRes = _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( vLo, vLo ), vMin ), vMax );
+    _mm_storel_epi64( ( __m128i* ) &dst[x], vRes );
+  }
+  for( ; x < width; x++ )
+  {
+    const Pel val = ( f[0] * ref[x] + f[1] * ref[x + 1] + f[2] * ref[x + 2] + f[3] * ref[x + 3] + 32 ) >> 6;
+    dst[x]        = ClipPel( val, clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraAngChromaRow( Pel* dst, const Pel* ref, const int width, const int deltaFract )
+{
+  // ref[x] + ( ( deltaFract * ( ref[x + 1] - ref[x] ) + 16 ) >> 5 ) equals ( ( 32 - deltaFract ) * ref[x] + deltaFract * ref[x + 1] + 16 ) >> 5
+  int x = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vCoeff = _mm256_set1_epi32( ( deltaFract << 16 ) | ( 32 - deltaFract ) );
+    const __m256i vRound = _mm256_set1_epi32( 16 );
+
+    for( ; x + 16 <= width; x += 16 )
+    {
+      __m256i vP0 = _mm256_loadu_si256( ( const __m256i* ) &ref[x] );
+      __m256i vP1 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 1] );
+
+      __m256i vLo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vP0, vP1 ), vCoeff ), vRound ), 5 );
+      __m256i vHi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vP0, vP1 ), vCoeff ), vRound ), 5 );
+
+      _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_packs_epi32( vLo, vHi ) );
+    }
+  }
+#endif
+
+  const __m128i vCoeff = simdIntraCoeffPair( 32 - deltaFract, deltaFract );
+  const __m128i vRound = _mm_set1_epi32( 16 );
+
+  for( ; x + 8 <= width; x += 8 )
+  {
+    __m128i vP0 = _mm_loadu_si128( ( const __m128i* ) &ref[x] );
+    __m128i vP1 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 1] );
+
+    __m128i vLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vP0, vP1 ), vCoeff ), vRound ), 5 );
+    __m128i vHi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vP0, vP1 ), vCoeff ), vRound ), 5 );
+
+    _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packs_epi32( vLo, vHi ) );
+  }
+  for( ; x + 4 <= width; x += 4 )
+  {
+    __m128i vP0 = _mm_loadl_epi64( ( const __m128i* ) &ref[x] );
+    __m128i vP1 = _mm_loadl_epi64( ( const __m128i* ) &ref[x + 1] );
+
+    __m128i vLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vP0, vP1 ), vCoeff ), vRound ), 5 );
+
+    _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packs_epi32( vLo, vLo ) );
+  }
+  for( ; x < width; x++ )
+  {
+    dst[x] = ref[x] + ( ( deltaFract * ( ref[x + 1] - ref[x] ) + 16 ) >> 5 );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterRefSamples( const Pel* src, Pel* dst, const int length )
+{
+  // ( src[i - 1] + 2 * src[i] ) and ( src[i + 1] + 2 ) are formed by _mm_madd_epi16 to stay exact in 32 bit
+  const __m128i vCoeff12 = simdIntraCoeffPair( 1, 2 );
+  const __m128i vCoeff11 = simdIntraCoeffPair( 1, 1 );
+  const __m128i vTwo     = _mm_set1_epi16( 2 );
+  int i                  = 1;
+
+  for( ; i + 8 <= length; i += 8 )
+  {
+    __m128i vP0 = _mm_loadu_si128( ( const __m128i* ) &src[i - 1] );
+    __m128i vP1 = _mm_loadu_si128( ( const __m128i* ) &src[i] );
+    __m128i vP2 = _mm_loadu_si128( ( const __m128i* ) &src[i + 1] );
+
+    __m128i vLo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vP0, vP1 ), vCoeff12 ), _mm_madd_epi16( _mm_unpacklo_epi16( vP2, vTwo ), vCoeff11 ) );
+    __m128i vHi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vP0, vP1 ), vCoeff12 ), _mm_madd_epi16( _mm_unpackhi_epi16( vP2, vTwo ), vCoeff11 ) );
+
+    _mm_storeu_si128( ( __m128i* ) &dst[i], _mm_packs_epi32( _mm_srai_epi32( vLo, 2 ), _mm_srai_epi32( vHi, 2 ) ) );
+  }
+  for( ; i < length; i++ )
+  {
+    dst[i] = ( src[i - 1] + 2 * src[i] + src[i + 1] + 2 ) >> 2;
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_predIntraPlanar       = simdPredIntraPlanar<vext>;
+  m_sumRefSamples         = simdSumRefSamples<vext>;
+  m_pdpcPlanarDc          = simdPdpcPlanarDc<vext>;
+  m_predIntraAngLumaRow   = simdPredIntraAngLumaRow<vext>;
+  m_predIntraAngChromaRow = simdPredIntraAngChromaRow<vext>;
+  m_filterRefSamples      = simdFilterRefSamples<vext>;
+#endif
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+#endif   // TARGET_SIMD_X86
@@ -0,0 +1,215 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     MatrixIntraPredictionX86.h
+    \brief    SIMD matrix product and upsampling for the matrix based intra prediction
+*/
+
+#include "CommonDefX86.h"
+#include "../MatrixIntraPrediction.h"
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// the rebased boundary samples differ by less than 1 << bitDepth and fit into 16 bit, so the products are formed by _mm_madd_epi16
+static inline __m128i simdMipRound( const __m128i& sum, const __m128i& offset, const __m128i& inputOffset, const __m128i& maxVal )
+{
+  const __m128i val = _mm_add_epi32( _mm_srai_epi32( _mm_add_epi32( sum, offset ), MIP_SHIFT_MATRIX ), inputOffset );
+  return _mm_min_epi32( _mm_max_epi32( val, _mm_setzero_si128() ), maxVal );
+}
+
+template<X86_VEXT vext>
+static void simdComputeReducedPred( int* const result, const int* const input, const int16_t* matrix, const int inputSize, const int numOutputs,
+                                    const int offset, const int inputOffset, const int bitDepth )
+{
+  const __m128i vOffset      = _mm_set1_epi32( offset );
+  const __m128i vInputOffset = _mm_set1_epi32( inputOffset );
+  const __m128i vMax         = _mm_set1_epi32( ( 1 << bitDepth ) - 1 );
+
+  if( inputSize == 4 )
+  {
+    // two matrix rows per vector
+    const __m128i vIn = _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) input ) );
+
+    for( int pos = 0; pos < numOutputs; pos += 4, matrix += 16 )
+    {
+      __m128i vSum01 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) matrix ), vIn );
+      __m128i vSum23 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( matrix + 8 ) ), vIn );
+
+      _mm_storeu_si128( ( __m128i* ) &result[pos], simdMipRound( _mm_hadd_epi32( vSum01, vSum23 ), vOffset, vInputOffset, vMax ) );
+    }
+    return;
+  }
+
+  CHECKD( inputSize != 8, "Unsupported MIP input size" );
+
+  const __m128i vIn = _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) ( input + 4 ) ) );
+  int pos           = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    // rows k and k + 4 share a vector, so the horizontal additions produce the rows in order
+    const __m256i vIn256 = _mm256_broadcastsi128_si256( vIn );
+
+    for( ; pos + 8 <= numOutputs; pos += 8, matrix += 64 )
+    {
+      __m256i vSum04 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) matrix ) ), _mm_loadu_si128( ( const __m128i* ) ( matrix + 32 ) ), 1 ), vIn256 );
+      __m256i vSum15 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) ( matrix + 8 ) ) ), _mm_loadu_si128( ( const __m128i* ) ( matrix + 40 ) ), 1 ), vIn256 );
+      __m256i vSum26 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) ( matrix + 16 ) ) ), _mm_loadu_si128( ( const __m128i* ) ( matrix + 48 ) ), 1 ), vIn256 );
+      __m256i vSum37 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) ( matrix + 24 ) ) ), _mm_loadu_si128( ( const __m128i* ) ( matrix + 56 ) ), 1 ), vIn256 );
+
+      __m256i vSum = _mm256_hadd_epi32( _mm256_hadd_epi32( vSum04, vSum15 ), _mm256_hadd_epi32( vSum26, vSum37 ) );
+      vSum         = _mm256_add_epi32( _mm256_srai_epi32( _mm256_add_epi32( vSum, _mm256_set1_epi32( offset ) ), MIP_SHIFT_MATRIX ), _mm256_set1_epi32( inputOffset ) );
+      vSum         = _mm256_min_epi32( _mm256_max_epi32( vSum, _mm256_setzero_si256() ), _mm256_set1_epi32( ( 1 << bitDepth ) - 1 ) );
+
+      _mm256_storeu_si256( ( __m256i* ) &result[pos], vSum );
+    }
+  }
+#endif
+
+  for( ; pos < numOutputs; pos += 4, matrix += 32 )
+  {
+    __m128i vSum0 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) matrix ), vIn );
+    __m128i vSum1 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( matrix + 8 ) ), vIn );
+    __m128i vSum2 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( matrix + 16 ) ), vIn );
+    __m128i vSum3 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( matrix + 24 ) ), vIn );
+
+    __m128i vSum = _mm_hadd_epi32( _mm_hadd_epi32( vSum0, vSum1 ), _mm_hadd_epi32( vSum2, vSum3 ) );
+    _mm_storeu_si128( ( __m128i* ) &result[pos], simdMipRound( vSum, vOffset, vInputOffset, vMax ) );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPredictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
+                                        const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                        const SizeType srcStep, const SizeType srcStride,
+                                        const SizeType dstStep, const SizeType dstStride,
+                                        const SizeType bndryStep,
+                                        const unsigned int upsmpFactor )
+{
+  // each output is ( before * upsmpFactor + pos * ( behind - before ) + roundingOffset ) >> log2UpsmpFactor with pos = 1..upsmpFactor
+  const int log2UpsmpFactor = floorLog2( upsmpFactor );
+  CHECKD( upsmpFactor <= 1, "Upsampling factor must be at least 2." );
+  const __m128i vRound = _mm_set1_epi32( 1 << ( log2UpsmpFactor - 1 ) );
+
+  if( srcStride == 1 && dstStride == 1 )
+  {
+    // vertical upsampling, four neighbouring columns per vector
+    CHECKD( bndryStep != 1 || ( srcSizeOrthDim & 3 ) != 0, "Unsupported vertical upsampling" );
+
+    for( int x = 0; x < srcSizeOrthDim; x += 4 )
+    {
+      __m128i vBefore = _mm_loadu_si128( ( const __m128i* ) &bndry[x] );
+      int*    currDst = dst + x;
+
+      for( int idx = 0; idx < srcSizeUpsmpDim; idx++ )
+      {
+        const __m128i vBehind = _mm_loadu_si128( ( const __m128i* ) &src[idx * srcStep + x] );
+        const __m128i vDiff   = _mm_sub_epi32( vBehind, vBefore );
+        __m128i       vScaled = _mm_add_epi32( _mm_slli_epi32( vBefore, log2UpsmpFactor ), vRound );
+
+        for( int pos = 1; pos <= upsmpFactor; pos++, currDst += dstStep )
+        {
+          vScaled = _mm_add_epi32( vScaled, vDiff );
+          _mm_storeu_si128( ( __m128i* ) currDst, _mm_srai_epi32( vScaled, log2UpsmpFactor ) );
+        }
+        vBefore = vBehind;
+      }
+    }
+    return;
+  }
+
+  // horizontal upsampling of lines of at most eight samples, the line is preceded by its boundary sample
+  CHECKD( srcStep != 1 || dstStep != 1 || srcSizeUpsmpDim > 8, "Unsupported horizontal upsampling" );
+
+  for( int line = 0; line < srcSizeOrthDim; line++ )
+  {
+    const int* srcLine = src + line * srcStride;
+    int*       dstLine = dst + line * dstStride;
+    int        ext[9];
+
+    ext[0] = bndry[bndryStep - 1 + line * bndryStep];
+    std::copy( srcLine, srcLine + srcSizeUpsmpDim, ext + 1 );
+
+    if( upsmpFactor == 2 )
+    {
+      const __m128i vPos = _mm_setr_epi32( 1, 2, 1, 2 );
+
+      for( int idx = 0; idx < srcSizeUpsmpDim; idx += 2 )
+      {
+        __m128i vBefore = _mm_loadl_epi64( ( const __m128i* ) &ext[idx] );
+        __m128i vBehind = _mm_loadl_epi64( ( const __m128i* ) &ext[idx + 1] );
+        vBefore         = _mm_unpacklo_epi32( vBefore, vBefore );
+        vBehind         = _mm_unpacklo_epi32( vBehind, vBehind );
+
+        __m128i vVal = _mm_add_epi32( _mm_slli_epi32( vBefore, 1 ), _mm_mullo_epi32( _mm_sub_epi32( vBehind, vBefore ), vPos ) );
+        _mm_storeu_si128( ( __m128i* ) &dstLine[idx << 1], _mm_srai_epi32( _mm_add_epi32( vVal, vRound ), 1 ) );
+      }
+    }
+    else
+    {
+      for( int idx = 0; idx < srcSizeUpsmpDim; idx++ )
+      {
+        const __m128i vScaled = _mm_add_epi32( _mm_set1_epi32( ext[idx] << log2UpsmpFactor ), vRound );
+        const __m128i vDiff   = _mm_set1_epi32( ext[idx + 1] - ext[idx] );
+        __m128i       vPos    = _mm_setr_epi32( 1, 2, 3, 4 );
+
+        for( int pos = 0; pos < upsmpFactor; pos += 4 )
+        {
+          __m128i vVal = _mm_add_epi32( vScaled, _mm_mullo_epi32( vDiff, vPos ) );
+          _mm_storeu_si128( ( __m128i* ) &dstLine[( idx << log2UpsmpFactor ) + pos], _mm_srai_epi32( vVal, log2UpsmpFactor ) );
+          vPos = _mm_add_epi32( vPos, _mm_set1_epi32( 4 ) );
+        }
+      }
+    }
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void MatrixIntraPrediction::_initMatrixIntraPredictionX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_computeReducedPred     = simdComputeReducedPred<vext>;
+  m_predictionUpsampling1D = simdPredictionUpsampling1D<vext>;
+#endif
+}
+
+template void MatrixIntraPrediction::_initMatrixIntraPredictionX86<SIMDX86>();
+#endif   // TARGET_SIMD_X86
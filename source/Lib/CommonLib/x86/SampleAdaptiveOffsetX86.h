@@ -0,0 +1,307 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    SIMD edge and band offset classification for SAO
+*/
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// sgn( a - b ) as 16 bit lanes
+static inline __m128i simdSaoSign( const __m128i& a, const __m128i& b )
+{
+  return _mm_sub_epi16( _mm_cmpgt_epi16( b, a ), _mm_cmpgt_epi16( a, b ) );
+}
+
+// edge class 0..4 of the eight samples at src
+static inline __m128i simdSaoEdgeClass( const Pel* src, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB )
+{
+  const __m128i cur = _mm_loadu_si128( ( const __m128i* ) src );
+  const __m128i nbA = _mm_loadu_si128( ( const __m128i* ) ( src + nbOffsetA ) );
+  const __m128i nbB = _mm_loadu_si128( ( const __m128i* ) ( src + nbOffsetB ) );
+
+  return _mm_add_epi16( _mm_add_epi16( simdSaoSign( cur, nbA ), simdSaoSign( cur, nbB ) ), _mm_set1_epi16( 2 ) );
+}
+
+// selects the 16 bit entries of table by the 16 bit indices idx < 8
+static inline __m128i simdSaoLookup( const __m128i& table, const __m128i& idx )
+{
+  return _mm_shuffle_epi8( table, _mm_add_epi16( _mm_mullo_epi16( idx, _mm_set1_epi16( 0x0202 ) ), _mm_set1_epi16( 0x0100 ) ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i simdSaoSign256( const __m256i& a, const __m256i& b )
+{
+  return _mm256_sub_epi16( _mm256_cmpgt_epi16( b, a ), _mm256_cmpgt_epi16( a, b ) );
+}
+
+static inline __m256i simdSaoEdgeClass256( const Pel* src, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB )
+{
+  const __m256i cur = _mm256_loadu_si256( ( const __m256i* ) src );
+  const __m256i nbA = _mm256_loadu_si256( ( const __m256i* ) ( src + nbOffsetA ) );
+  const __m256i nbB = _mm256_loadu_si256( ( const __m256i* ) ( src + nbOffsetB ) );
+
+  return _mm256_add_epi16( _mm256_add_epi16( simdSaoSign256( cur, nbA ), simdSaoSign256( cur, nbB ) ), _mm256_set1_epi16( 2 ) );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdOffsetLineEO( const Pel* srcLine, Pel* resLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng )
+{
+  const __m128i vTable = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+  const __m128i vMin   = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax   = _mm_set1_epi16( clpRng.max );
+  int x                = startX;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vTable256 = _mm256_broadcastsi128_si256( vTable );
+    const __m256i vMin256   = _mm256_set1_epi16( clpRng.min );
+    const __m256i vMax256   = _mm256_set1_epi16( clpRng.max );
+
+    for( ; x + 16 <= endX; x += 16 )
+    {
+      const __m256i vIdx = _mm256_add_epi16( _mm256_mullo_epi16( simdSaoEdgeClass256( srcLine + x, nbOffsetA, nbOffsetB ), _mm256_set1_epi16( 0x0202 ) ), _mm256_set1_epi16( 0x0100 ) );
+      const __m256i vOff = _mm256_shuffle_epi8( vTable256, vIdx );
+      const __m256i vRes = _mm256_adds_epi16( _mm256_loadu_si256( ( const __m256i* ) &srcLine[x] ), vOff );
+
+      _mm256_storeu_si256( ( __m256i* ) &resLine[x], _mm256_min_epi16( _mm256_max_epi16( vRes, vMin256 ), vMax256 ) );
+    }
+  }
+#endif
+
+  for( ; x + 8 <= endX; x += 8 )
+  {
+    const __m128i vOff = simdSaoLookup( vTable, simdSaoEdgeClass( srcLine + x, nbOffsetA, nbOffsetB ) );
+    const __m128i vRes = _mm_adds_epi16( _mm_loadu_si128( ( const __m128i* ) &srcLine[x] ), vOff );
+
+    _mm_storeu_si128( ( __m128i* ) &resLine[x], _mm_min_epi16( _mm_max_epi16( vRes, vMin ), vMax ) );
+  }
+  for( ; x < endX; x++ )
+  {
+    const int edgeType = sgn( srcLine[x] - srcLine[x + nbOffsetA] ) + sgn( srcLine[x] - srcLine[x + nbOffsetB] ) + 2;
+    resLine[x]         = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdOffsetBlockBO( const Pel* srcBlk, Pel* resBlk, const int srcStride, const int resStride, const int width, const int height, const int* offset, const int shiftBits, const ClpRng& clpRng )
+{
+  // only few bands carry an offset, each of them is matched by a comparison
+  int16_t bands  [NUM_SAO_BO_CLASSES];
+  int16_t offsets[NUM_SAO_BO_CLASSES];
+  int     numBands = 0;
+
+  for( int band = 0; band < NUM_SAO_BO_CLASSES; band++ )
+  {
+    if( offset[band] != 0 )
+    {
+      bands  [numBands] = band;
+      offsets[numBands] = offset[band];
+      numBands++;
+    }
+  }
+
+  const __m128i vMin = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax = _mm_set1_epi16( clpRng.max );
+
+  for( int y = 0; y < height; y++, srcBlk += srcStride, resBlk += resStride )
+  {
+    int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vMin256 = _mm256_set1_epi16( clpRng.min );
+      const __m256i vMax256 = _mm256_set1_epi16( clpRng.max );
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vSrc  = _mm256_loadu_si256( ( const __m256i* ) &srcBlk[x] );
+        const __m256i vBand = _mm256_srli_epi16( vSrc, shiftBits );
+        __m256i       vOff  = _mm256_setzero_si256();
+
+        for( int k = 0; k < numBands; k++ )
+        {
+          vOff = _mm256_or_si256( vOff, _mm256_and_si256( _mm256_cmpeq_epi16( vBand, _mm256_set1_epi16( bands[k] ) ), _mm256_set1_epi16( offsets[k] ) ) );
+        }
+        _mm256_storeu_si256( ( __m256i* ) &resBlk[x], _mm256_min_epi16( _mm256_max_epi16( _mm256_adds_epi16( vSrc, vOff ), vMin256 ), vMax256 ) );
+      }
+    }
+#endif
+
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vSrc  = _mm_loadu_si128( ( const __m128i* ) &srcBlk[x] );
+      const __m128i vBand = _mm_srli_epi16( vSrc, shiftBits );
+      __m128i       vOff  = _mm_setzero_si128();
+
+      for( int k = 0; k < numBands; k++ )
+      {
+        vOff = _mm_or_si128( vOff, _mm_and_si128( _mm_cmpeq_epi16( vBand, _mm_set1_epi16( bands[k] ) ), _mm_set1_epi16( offsets[k] ) ) );
+      }
+      _mm_storeu_si128( ( __m128i* ) &resBlk[x], _mm_min_epi16( _mm_max_epi16( _mm_adds_epi16( vSrc, vOff ), vMin ), vMax ) );
+    }
+    for( ; x < width; x++ )
+    {
+      resBlk[x] = ClipPel<int>( srcBlk[x] + offset[srcBlk[x] >> shiftBits], clpRng );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdStatsLineEO( const Pel* srcLine, const Pel* orgLine, const ptrdiff_t nbOffsetA, const ptrdiff_t nbOffsetB, const int startX, const int endX, int64_t* diff, int64_t* count )
+{
+  // the differences are summed in 32 bit and the counts in 16 bit lanes per class, the plain class 2
+  // follows from the totals
+  static const int classes[4] = { 0, 1, 3, 4 };
+
+  const __m128i vOne = _mm_set1_epi16( 1 );
+  __m128i vDiff [4];
+  __m128i vCount[4];
+  __m128i vDiffTotal = _mm_setzero_si128();
+  int     x          = startX;
+
+  for( int k = 0; k < 4; k++ )
+  {
+    vDiff [k] = _mm_setzero_si128();
+    vCount[k] = _mm_setzero_si128();
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vOne256 = _mm256_set1_epi16( 1 );
+    __m256i vDiff256 [4];
+    __m256i vCount256[4];
+    __m256i vDiffTotal256 = _mm256_setzero_si256();
+
+    for( int k = 0; k < 4; k++ )
+    {
+      vDiff256 [k] = _mm256_setzero_si256();
+      vCount256[k] = _mm256_setzero_si256();
+    }
+
+    for( ; x + 16 <= endX; x += 16 )
+    {
+      const __m256i vClass = simdSaoEdgeClass256( srcLine + x, nbOffsetA, nbOffsetB );
+      const __m256i vD     = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) &orgLine[x] ), _mm256_loadu_si256( ( const __m256i* ) &srcLine[x] ) );
+
+      vDiffTotal256 = _mm256_add_epi32( vDiffTotal256, _mm256_madd_epi16( vD, vOne256 ) );
+      for( int k = 0; k < 4; k++ )
+      {
+        const __m256i vMask = _mm256_cmpeq_epi16( vClass, _mm256_set1_epi16( classes[k] ) );
+        vDiff256 [k]        = _mm256_add_epi32( vDiff256[k], _mm256_madd_epi16( _mm256_and_si256( vD, vMask ), vOne256 ) );
+        vCount256[k]        = _mm256_sub_epi16( vCount256[k], vMask );
+      }
+    }
+
+    vDiffTotal = _mm_add_epi32( _mm256_castsi256_si128( vDiffTotal256 ), _mm256_extracti128_si256( vDiffTotal256, 1 ) );
+    for( int k = 0; k < 4; k++ )
+    {
+      vDiff [k] = _mm_add_epi32( _mm256_castsi256_si128( vDiff256[k] ), _mm256_extracti128_si256( vDiff256[k], 1 ) );
+      vCount[k] = _mm_add_epi16( _mm256_castsi256_si128( vCount256[k] ), _mm256_extracti128_si256( vCount256[k], 1 ) );
+    }
+  }
+#endif
+
+  for( ; x + 8 <= endX; x += 8 )
+  {
+    const __m128i vClass = simdSaoEdgeClass( srcLine + x, nbOffsetA, nbOffsetB );
+    const __m128i vD     = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) &orgLine[x] ), _mm_loadu_si128( ( const __m128i* ) &srcLine[x] ) );
+
+    vDiffTotal = _mm_add_epi32( vDiffTotal, _mm_madd_epi16( vD, vOne ) );
+    for( int k = 0; k < 4; k++ )
+    {
+      const __m128i vMask = _mm_cmpeq_epi16( vClass, _mm_set1_epi16( classes[k] ) );
+      vDiff [k]           = _mm_add_epi32( vDiff[k], _mm_madd_epi16( _mm_and_si128( vD, vMask ), vOne ) );
+      vCount[k]           = _mm_sub_epi16( vCount[k], vMask );
+    }
+  }
+
+  const int numVectorSamples = x - startX;
+  int       diffSum          = 0;
+  int       countSum         = 0;
+
+  for( int k = 0; k < 4; k++ )
+  {
+    __m128i vD = _mm_add_epi32( vDiff[k], _mm_shuffle_epi32( vDiff[k], 0x4e ) );
+    vD         = _mm_add_epi32( vD, _mm_shuffle_epi32( vD, 0xb1 ) );
+    __m128i vC = _mm_madd_epi16( vCount[k], vOne );
+    vC         = _mm_add_epi32( vC, _mm_shuffle_epi32( vC, 0x4e ) );
+    vC         = _mm_add_epi32( vC, _mm_shuffle_epi32( vC, 0xb1 ) );
+
+    const int d = _mm_cvtsi128_si32( vD );
+    const int c = _mm_cvtsi128_si32( vC );
+    diff [classes[k]] += d;
+    count[classes[k]] += c;
+    diffSum  += d;
+    countSum += c;
+  }
+
+  vDiffTotal = _mm_add_epi32( vDiffTotal, _mm_shuffle_epi32( vDiffTotal, 0x4e ) );
+  vDiffTotal = _mm_add_epi32( vDiffTotal, _mm_shuffle_epi32( vDiffTotal, 0xb1 ) );
+  diff [2] += _mm_cvtsi128_si32( vDiffTotal ) - diffSum;
+  count[2] += numVectorSamples - countSum;
+
+  for( ; x < endX; x++ )
+  {
+    const int edgeType = sgn( srcLine[x] - srcLine[x + nbOffsetA] ) + sgn( srcLine[x] - srcLine[x + nbOffsetB] ) + 2;
+    diff [edgeType] += ( orgLine[x] - srcLine[x] );
+    count[edgeType] ++;
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_offsetLineEO  = simdOffsetLineEO<vext>;
+  m_offsetBlockBO = simdOffsetBlockBO<vext>;
+  m_statsLineEO   = simdStatsLineEO<vext>;
+#endif
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+#endif   // TARGET_SIMD_X86
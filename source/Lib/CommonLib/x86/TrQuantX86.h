@@ -0,0 +1,454 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantX86.h
+    \brief    SIMD core and secondary transforms
+*/
+
+#include "CommonDefX86.h"
+#include "../Rom.h"
+#include "../TrQuant.h"
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// The SIMD transforms are plain matrix multiplications. Since all sums are formed in 32 bit integer arithmetic they
+// give the same results as the partial butterflies in TrQuant_EMT.cpp, including the zero-out behaviour of each
+// function, which is mirrored by simdTrCutoff.
+
+static const TMatrixCoeff* simdTrMatrix( const int trType, const int trSize, const int dir )
+{
+  switch( trType )
+  {
+  case DCT2:
+    switch( trSize )
+    {
+    case  4: return g_trCoreDCT2P4 [dir][0];
+    case  8: return g_trCoreDCT2P8 [dir][0];
+    case 16: return g_trCoreDCT2P16[dir][0];
+    case 32: return g_trCoreDCT2P32[dir][0];
+    case 64: return g_trCoreDCT2P64[dir][0];
+    }
+    break;
+  case DCT8:
+    switch( trSize )
+    {
+    case  4: return g_trCoreDCT8P4 [dir][0];
+    case  8: return g_trCoreDCT8P8 [dir][0];
+    case 16: return g_trCoreDCT8P16[dir][0];
+    case 32: return g_trCoreDCT8P32[dir][0];
+    }
+    break;
+  case DST7:
+    switch( trSize )
+    {
+    case  4: return g_trCoreDST7P4 [dir][0];
+    case  8: return g_trCoreDST7P8 [dir][0];
+    case 16: return g_trCoreDST7P16[dir][0];
+    case 32: return g_trCoreDST7P32[dir][0];
+    }
+    break;
+  }
+  THROW( "Unsupported transform" );
+  return nullptr;
+}
+
+// number of basis functions evaluated by the C implementation of the given transform
+template<int trType, int trSize>
+static inline int simdTrCutoff( const int iSkipLine2, const bool forward )
+{
+  if( trType == DCT2 )
+  {
+    return trSize < 64 ? trSize : forward ? trSize - iSkipLine2 : ( iSkipLine2 >= 32 ? 32 : 64 );
+  }
+  return trSize == 4 || ( !forward && trSize > 8 ) ? trSize : trSize - iSkipLine2;
+}
+
+// transposes four lines of a block into tmp, sample k of line l is stored at tmp[k * tmpStride + l]
+template<int trSize>
+static inline void simdTrTransposeLines( const TCoeff* src, TCoeff* tmp, const int tmpStride )
+{
+  for( int k = 0; k < trSize; k += 4 )
+  {
+    __m128i r0 = _mm_loadu_si128( ( const __m128i* ) ( src + 0 * trSize + k ) );
+    __m128i r1 = _mm_loadu_si128( ( const __m128i* ) ( src + 1 * trSize + k ) );
+    __m128i r2 = _mm_loadu_si128( ( const __m128i* ) ( src + 2 * trSize + k ) );
+    __m128i r3 = _mm_loadu_si128( ( const __m128i* ) ( src + 3 * trSize + k ) );
+    __m128i t0 = _mm_unpacklo_epi32( r0, r1 );
+    __m128i t1 = _mm_unpacklo_epi32( r2, r3 );
+    __m128i t2 = _mm_unpackhi_epi32( r0, r1 );
+    __m128i t3 = _mm_unpackhi_epi32( r2, r3 );
+    _mm_storeu_si128( ( __m128i* ) ( tmp + ( k + 0 ) * tmpStride ), _mm_unpacklo_epi64( t0, t1 ) );
+    _mm_storeu_si128( ( __m128i* ) ( tmp + ( k + 1 ) * tmpStride ), _mm_unpackhi_epi64( t0, t1 ) );
+    _mm_storeu_si128( ( __m128i* ) ( tmp + ( k + 2 ) * tmpStride ), _mm_unpacklo_epi64( t2, t3 ) );
+    _mm_storeu_si128( ( __m128i* ) ( tmp + ( k + 3 ) * tmpStride ), _mm_unpackhi_epi64( t2, t3 ) );
+  }
+}
+
+template<X86_VEXT vext, int trType, int trSize>
+static void simdFwdTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2 )
+{
+  // the DCT-II basis functions are symmetric or antisymmetric, so the even ones are applied to the sums and the odd
+  // ones to the differences of mirrored samples, which halves the multiplications
+  constexpr bool evenOdd = trType == DCT2;
+  constexpr int  numK    = evenOdd ? trSize / 2 : trSize;
+
+  const TMatrixCoeff* iT          = simdTrMatrix( trType, trSize, TRANSFORM_FORWARD );
+  const TCoeff        rnd_factor  = ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0;
+  const int           reducedLine = line - iSkipLine;
+  const int           cutoff      = simdTrCutoff<trType, trSize>( iSkipLine2, true );
+  const __m128i       vshift      = _mm_cvtsi32_si128( shift );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff tmp[trSize * 8] );
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff eo [trSize * 8] );
+  const TCoeff* in = evenOdd ? eo : tmp;
+  int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vrnd = _mm256_set1_epi32( rnd_factor );
+    for( ; i + 8 <= reducedLine; i += 8 )
+    {
+      simdTrTransposeLines<trSize>( src + i * trSize, tmp, 8 );
+      simdTrTransposeLines<trSize>( src + ( i + 4 ) * trSize, tmp + 4, 8 );
+      if( evenOdd )
+      {
+        for( int k = 0; k < numK; k++ )
+        {
+          const __m256i a = _mm256_load_si256( ( const __m256i* ) ( tmp + k * 8 ) );
+          const __m256i b = _mm256_load_si256( ( const __m256i* ) ( tmp + ( trSize - 1 - k ) * 8 ) );
+          _mm256_store_si256( ( __m256i* ) ( eo + k * 8 ), _mm256_add_epi32( a, b ) );
+          _mm256_store_si256( ( __m256i* ) ( eo + ( numK + k ) * 8 ), _mm256_sub_epi32( a, b ) );
+        }
+      }
+      for( int j = 0; j < cutoff; j++ )
+      {
+        const TMatrixCoeff* t   = iT + j * trSize;
+        const TCoeff*       x   = in + ( evenOdd && ( j & 1 ) ? numK * 8 : 0 );
+        __m256i             sum = vrnd;
+        for( int k = 0; k < numK; k++ )
+        {
+          sum = _mm256_add_epi32( sum, _mm256_mullo_epi32( _mm256_load_si256( ( const __m256i* ) ( x + k * 8 ) ), _mm256_set1_epi32( t[k] ) ) );
+        }
+        _mm256_storeu_si256( ( __m256i* ) ( dst + j * line + i ), _mm256_sra_epi32( sum, vshift ) );
+      }
+    }
+  }
+#endif
+
+  const __m128i vrnd = _mm_set1_epi32( rnd_factor );
+  for( ; i + 4 <= reducedLine; i += 4 )
+  {
+    simdTrTransposeLines<trSize>( src + i * trSize, tmp, 4 );
+    if( evenOdd )
+    {
+      for( int k = 0; k < numK; k++ )
+      {
+        const __m128i a = _mm_load_si128( ( const __m128i* ) ( tmp + k * 4 ) );
+        const __m128i b = _mm_load_si128( ( const __m128i* ) ( tmp + ( trSize - 1 - k ) * 4 ) );
+        _mm_store_si128( ( __m128i* ) ( eo + k * 4 ), _mm_add_epi32( a, b ) );
+        _mm_store_si128( ( __m128i* ) ( eo + ( numK + k ) * 4 ), _mm_sub_epi32( a, b ) );
+      }
+    }
+    for( int j = 0; j < cutoff; j++ )
+    {
+      const TMatrixCoeff* t   = iT + j * trSize;
+      const TCoeff*       x   = in + ( evenOdd && ( j & 1 ) ? numK * 4 : 0 );
+      __m128i             sum = vrnd;
+      for( int k = 0; k < numK; k++ )
+      {
+        sum = _mm_add_epi32( sum, _mm_mullo_epi32( _mm_load_si128( ( const __m128i* ) ( x + k * 4 ) ), _mm_set1_epi32( t[k] ) ) );
+      }
+      _mm_storeu_si128( ( __m128i* ) ( dst + j * line + i ), _mm_sra_epi32( sum, vshift ) );
+    }
+  }
+
+  for( ; i < reducedLine; i++ )
+  {
+    const TCoeff* s = src + i * trSize;
+    for( int j = 0; j < cutoff; j++ )
+    {
+      const TMatrixCoeff* t   = iT + j * trSize;
+      TCoeff              sum = 0;
+      for( int k = 0; k < trSize; k++ )
+      {
+        sum += s[k] * t[k];
+      }
+      dst[j * line + i] = ( sum + rnd_factor ) >> shift;
+    }
+  }
+
+  if( iSkipLine )
+  {
+    for( int j = 0; j < cutoff; j++ )
+    {
+      memset( dst + j * line + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+  }
+  if( cutoff < trSize )
+  {
+    memset( dst + cutoff * line, 0, sizeof( TCoeff ) * line * ( trSize - cutoff ) );
+  }
+}
+
+template<X86_VEXT vext, int trType, int trSize>
+static void simdInvTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const TMatrixCoeff* iT          = simdTrMatrix( trType, trSize, TRANSFORM_INVERSE );
+  const TCoeff        rnd_factor  = ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0;
+  const int           reducedLine = line - iSkipLine;
+  const int           cutoff      = simdTrCutoff<trType, trSize>( iSkipLine2, false );
+  const __m128i       vshift      = _mm_cvtsi32_si128( shift );
+
+  // for the DCT-II the even and odd basis functions are accumulated separately for the first half of the outputs,
+  // the mirrored second half is given by their difference
+#ifdef USE_AVX2
+  if( vext >= AVX2 && trSize >= 8 )
+  {
+    constexpr bool evenOdd = trType == DCT2 && trSize >= 16;
+    constexpr int  numOut  = evenOdd ? trSize / 2 : trSize;
+    constexpr int  numAcc  = numOut >= 32 ? 4 : numOut >= 16 ? 2 : 1;
+    const __m256i  vrnd    = _mm256_set1_epi32( rnd_factor );
+    const __m256i  vmin    = _mm256_set1_epi32( outputMinimum );
+    const __m256i  vmax    = _mm256_set1_epi32( outputMaximum );
+    const __m256i  vrev    = _mm256_setr_epi32( 7, 6, 5, 4, 3, 2, 1, 0 );
+
+    for( int i = 0; i < reducedLine; i++ )
+    {
+      for( int j = 0; j < numOut; j += 8 * numAcc )
+      {
+        __m256i sumE[numAcc], sumO[numAcc];
+        for( int n = 0; n < numAcc; n++ )
+        {
+          sumE[n] = vrnd;
+          sumO[n] = _mm256_setzero_si256();
+        }
+        for( int k = 0; k < cutoff; k++ )
+        {
+          const TCoeff s = src[k * line + i];
+          if( s == 0 )
+          {
+            continue;
+          }
+          const __m256i       vs  = _mm256_set1_epi32( s );
+          const TMatrixCoeff* t   = iT + k * trSize + j;
+          __m256i*            sum = evenOdd && ( k & 1 ) ? sumO : sumE;
+          for( int n = 0; n < numAcc; n++ )
+          {
+            const __m256i coef = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( t + 8 * n ) ) );
+            sum[n] = _mm256_add_epi32( sum[n], _mm256_mullo_epi32( vs, coef ) );
+          }
+        }
+        for( int n = 0; n < numAcc; n++ )
+        {
+          __m256i res = _mm256_sra_epi32( evenOdd ? _mm256_add_epi32( sumE[n], sumO[n] ) : sumE[n], vshift );
+          res = _mm256_min_epi32( _mm256_max_epi32( res, vmin ), vmax );
+          _mm256_storeu_si256( ( __m256i* ) ( dst + i * trSize + j + 8 * n ), res );
+          if( evenOdd )
+          {
+            res = _mm256_sra_epi32( _mm256_sub_epi32( sumE[n], sumO[n] ), vshift );
+            res = _mm256_min_epi32( _mm256_max_epi32( res, vmin ), vmax );
+            _mm256_storeu_si256( ( __m256i* ) ( dst + i * trSize + trSize - 8 - j - 8 * n ), _mm256_permutevar8x32_epi32( res, vrev ) );
+          }
+        }
+      }
+    }
+  }
+  else
+#endif
+  {
+    constexpr bool evenOdd = trType == DCT2 && trSize >= 8;
+    constexpr int  numOut  = evenOdd ? trSize / 2 : trSize;
+    constexpr int  numAcc  = numOut >= 16 ? 4 : numOut / 4;
+    const __m128i  vrnd    = _mm_set1_epi32( rnd_factor );
+    const __m128i  vmin    = _mm_set1_epi32( outputMinimum );
+    const __m128i  vmax    = _mm_set1_epi32( outputMaximum );
+
+    for( int i = 0; i < reducedLine; i++ )
+    {
+      for( int j = 0; j < numOut; j += 4 * numAcc )
+      {
+        __m128i sumE[numAcc], sumO[numAcc];
+        for( int n = 0; n < numAcc; n++ )
+        {
+          sumE[n] = vrnd;
+          sumO[n] = _mm_setzero_si128();
+        }
+        for( int k = 0; k < cutoff; k++ )
+        {
+          const TCoeff s = src[k * line + i];
+          if( s == 0 )
+          {
+            continue;
+          }
+          const __m128i       vs  = _mm_set1_epi32( s );
+          const TMatrixCoeff* t   = iT + k * trSize + j;
+          __m128i*            sum = evenOdd && ( k & 1 ) ? sumO : sumE;
+          for( int n = 0; n < numAcc; n++ )
+          {
+            const __m128i coef = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( t + 4 * n ) ) );
+            sum[n] = _mm_add_epi32( sum[n], _mm_mullo_epi32( vs, coef ) );
+          }
+        }
+        for( int n = 0; n < numAcc; n++ )
+        {
+          __m128i res = _mm_sra_epi32( evenOdd ? _mm_add_epi32( sumE[n], sumO[n] ) : sumE[n], vshift );
+          res = _mm_min_epi32( _mm_max_epi32( res, vmin ), vmax );
+          _mm_storeu_si128( ( __m128i* ) ( dst + i * trSize + j + 4 * n ), res );
+          if( evenOdd )
+          {
+            res = _mm_sra_epi32( _mm_sub_epi32( sumE[n], sumO[n] ), vshift );
+            res = _mm_min_epi32( _mm_max_epi32( res, vmin ), vmax );
+            _mm_storeu_si128( ( __m128i* ) ( dst + i * trSize + trSize - 4 - j - 4 * n ), _mm_shuffle_epi32( res, 0x1b ) );
+          }
+        }
+      }
+    }
+  }
+
+  if( iSkipLine )
+  {
+    memset( dst + reducedLine * trSize, 0, sizeof( TCoeff ) * trSize * iSkipLine );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFwdLfnst( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize )
+{
+  for( int j = 0; j < zeroOutSize; j++, trMat += trSize )
+  {
+    __m128i sum;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      __m256i sum256 = _mm256_setzero_si256();
+      for( int i = 0; i < trSize; i += 8 )
+      {
+        const __m256i coef = _mm256_cvtepi8_epi32( _mm_loadl_epi64( ( const __m128i* ) ( trMat + i ) ) );
+        sum256 = _mm256_add_epi32( sum256, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) ( src + i ) ), coef ) );
+      }
+      sum = _mm_add_epi32( _mm256_castsi256_si128( sum256 ), _mm256_extracti128_si256( sum256, 1 ) );
+    }
+    else
+#endif
+    {
+      sum = _mm_setzero_si128();
+      for( int i = 0; i < trSize; i += 4 )
+      {
+        const __m128i coef = _mm_cvtepi8_epi32( _mm_cvtsi32_si128( *( const int* ) ( trMat + i ) ) );
+        sum = _mm_add_epi32( sum, _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* ) ( src + i ) ), coef ) );
+      }
+    }
+    sum = _mm_hadd_epi32( sum, sum );
+    sum = _mm_hadd_epi32( sum, sum );
+    dst[j] = ( _mm_cvtsi128_si32( sum ) + 64 ) >> 7;
+  }
+
+  std::fill_n( dst + zeroOutSize, trSize - zeroOutSize, 0 );
+}
+
+template<X86_VEXT vext>
+static void simdInvLfnst( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const __m128i vrnd = _mm_set1_epi32( 64 );
+  const __m128i vmin = _mm_set1_epi32( outputMinimum );
+  const __m128i vmax = _mm_set1_epi32( outputMaximum );
+
+  // trSize is 16 or 48, the outputs are formed in groups of 16
+  for( int j = 0; j < trSize; j += 16 )
+  {
+    __m128i sum[4] = { vrnd, vrnd, vrnd, vrnd };
+    for( int i = 0; i < zeroOutSize; i++ )
+    {
+      if( src[i] == 0 )
+      {
+        continue;
+      }
+      const __m128i vs = _mm_set1_epi32( src[i] );
+      const __m128i c  = _mm_loadu_si128( ( const __m128i* ) ( trMat + i * trSize + j ) );
+      sum[0] = _mm_add_epi32( sum[0], _mm_mullo_epi32( vs, _mm_cvtepi8_epi32( c ) ) );
+      sum[1] = _mm_add_epi32( sum[1], _mm_mullo_epi32( vs, _mm_cvtepi8_epi32( _mm_srli_si128( c, 4 ) ) ) );
+      sum[2] = _mm_add_epi32( sum[2], _mm_mullo_epi32( vs, _mm_cvtepi8_epi32( _mm_srli_si128( c, 8 ) ) ) );
+      sum[3] = _mm_add_epi32( sum[3], _mm_mullo_epi32( vs, _mm_cvtepi8_epi32( _mm_srli_si128( c, 12 ) ) ) );
+    }
+    for( int n = 0; n < 4; n++ )
+    {
+      const __m128i res = _mm_min_epi32( _mm_max_epi32( _mm_srai_epi32( sum[n], 7 ), vmin ), vmax );
+      _mm_storeu_si128( ( __m128i* ) ( dst + j + 4 * n ), res );
+    }
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  // the 4-point DST-VII and DCT-VIII are already cheaper in their C form
+  m_fwdTrans[DCT2][1] = simdFwdTrans<vext, DCT2,  4>;
+  m_fwdTrans[DCT2][2] = simdFwdTrans<vext, DCT2,  8>;
+  m_fwdTrans[DCT2][3] = simdFwdTrans<vext, DCT2, 16>;
+  m_fwdTrans[DCT2][4] = simdFwdTrans<vext, DCT2, 32>;
+  m_fwdTrans[DCT2][5] = simdFwdTrans<vext, DCT2, 64>;
+  m_fwdTrans[DCT8][2] = simdFwdTrans<vext, DCT8,  8>;
+  m_fwdTrans[DCT8][3] = simdFwdTrans<vext, DCT8, 16>;
+  m_fwdTrans[DCT8][4] = simdFwdTrans<vext, DCT8, 32>;
+  m_fwdTrans[DST7][2] = simdFwdTrans<vext, DST7,  8>;
+  m_fwdTrans[DST7][3] = simdFwdTrans<vext, DST7, 16>;
+  m_fwdTrans[DST7][4] = simdFwdTrans<vext, DST7, 32>;
+
+  m_invTrans[DCT2][1] = simdInvTrans<vext, DCT2,  4>;
+  m_invTrans[DCT2][2] = simdInvTrans<vext, DCT2,  8>;
+  m_invTrans[DCT2][3] = simdInvTrans<vext, DCT2, 16>;
+  m_invTrans[DCT2][4] = simdInvTrans<vext, DCT2, 32>;
+  m_invTrans[DCT2][5] = simdInvTrans<vext, DCT2, 64>;
+  m_invTrans[DCT8][2] = simdInvTrans<vext, DCT8,  8>;
+  m_invTrans[DCT8][3] = simdInvTrans<vext, DCT8, 16>;
+  m_invTrans[DCT8][4] = simdInvTrans<vext, DCT8, 32>;
+  m_invTrans[DST7][2] = simdInvTrans<vext, DST7,  8>;
+  m_invTrans[DST7][3] = simdInvTrans<vext, DST7, 16>;
+  m_invTrans[DST7][4] = simdInvTrans<vext, DST7, 32>;
+
+  m_fwdLfnst = simdFwdLfnst<vext>;
+  m_invLfnst = simdInvLfnst<vext>;
+#endif
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+#endif   // TARGET_SIMD_X86
@@ -0,0 +1 @@
+#include "../DeblockingFilterX86.h"
@@ -0,0 +1 @@
+#include "../HashX86.h"
@@ -0,0 +1 @@
+#include "../MatrixIntraPredictionX86.h"
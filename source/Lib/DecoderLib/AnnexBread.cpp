@@ -38,6 +38,7 @@
 
 
 #include <stdint.h>
+#include <string.h>
 #include <vector>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -49,6 +50,92 @@ using namespace std;
 //! \ingroup DecoderLib
 //! \{
 
+bool InputByteStream::xFill(size_t n)
+{
+  while (m_BufferEnd - m_ReadPos < n)
+  {
+    if (m_InputEnd)
+    {
+      return false;
+    }
+    if (m_Buffer.size() - m_BufferEnd < READ_BLOCK_SIZE)
+    {
+      // drop the consumed bytes that are not needed to return from a look-ahead
+      const size_t keepPos = m_LookaheadPos == NO_LOOKAHEAD ? m_ReadPos : m_LookaheadPos;
+      if (keepPos > 0)
+      {
+        memmove(m_Buffer.data(), m_Buffer.data() + keepPos, m_BufferEnd - keepPos);
+        m_BufferEnd -= keepPos;
+        m_ReadPos   -= keepPos;
+        if (m_LookaheadPos != NO_LOOKAHEAD)
+        {
+          m_LookaheadPos -= keepPos;
+        }
+      }
+      if (m_Buffer.size() - m_BufferEnd < READ_BLOCK_SIZE)
+      {
+        m_Buffer.resize(m_BufferEnd + READ_BLOCK_SIZE);
+      }
+    }
+    const std::streamsize numRead = m_Input.rdbuf()->sgetn(reinterpret_cast<char*>(m_Buffer.data() + m_BufferEnd), std::streamsize(m_Buffer.size() - m_BufferEnd));
+    if (numRead <= 0)
+    {
+      m_InputEnd = true;
+    }
+    else
+    {
+      m_BufferEnd += size_t(numRead);
+    }
+  }
+  return true;
+}
+
+void InputByteStream::xSetEnd()
+{
+  try
+  {
+    m_Input.setstate(std::istream::eofbit | std::istream::failbit);
+  }
+  catch (...)
+  {
+    // the exception mask of the stream turns the end of input into an exception, which is reported by the callers
+  }
+}
+
+const uint8_t* InputByteStream::peekPayload(size_t& size)
+{
+  size_t scanPos = m_ReadPos;
+  while (true)
+  {
+    // each of the three-byte sequences starts with two zero bytes, find the first zero byte with memchr
+    while (scanPos + 2 < m_BufferEnd)
+    {
+      const uint8_t* zero = static_cast<const uint8_t*>(memchr(m_Buffer.data() + scanPos, 0, m_BufferEnd - 2 - scanPos));
+      if (zero == nullptr)
+      {
+        scanPos = m_BufferEnd - 2;
+        break;
+      }
+      scanPos = zero - m_Buffer.data();
+      if (zero[1] == 0 && zero[2] <= 2)
+      {
+        size = scanPos - m_ReadPos;
+        return m_Buffer.data() + m_ReadPos;
+      }
+      scanPos++;
+    }
+
+    // the sequence may continue beyond the buffered bytes, read more without losing the scanned range
+    const size_t scanned = scanPos - m_ReadPos;
+    if (!xFill(m_BufferEnd - m_ReadPos + 1))
+    {
+      size = m_BufferEnd - m_ReadPos;
+      return m_Buffer.data() + m_ReadPos;
+    }
+    scanPos = m_ReadPos + scanned;
+  }
+}
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
@@ -147,6 +234,16 @@ _byteStreamNALUnit(
   /* NB, (unsigned)x > 2 implies n!=0 && n!=1 */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::SStat &bodyStats=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+#endif
+  /* the bytes up to the next three-byte sequence are located with a scan of
+   * the read buffer and appended at once, the remaining bytes at the end of
+   * the byte stream are read one by one until EOF */
+  size_t payloadSize;
+  const uint8_t* payload = bs.peekPayload(payloadSize);
+  nalUnit.insert(nalUnit.end(), payload, payload + payloadSize);
+  bs.skipBytes(payloadSize);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  bodyStats.bits += 8 * uint32_t(payloadSize); bodyStats.count += uint32_t(payloadSize);
 #endif
   while (bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) > 2)
   {
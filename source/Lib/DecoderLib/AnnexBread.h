@@ -58,14 +58,18 @@ public:
    * istream.
    *
    * NB, it isn't safe to access istream while in use by a
-   * InputByteStream.
+   * InputByteStream.  The input is read in large blocks directly
+   * from the stream buffer of istream, the state of istream is only
+   * changed when the reader reaches the end of the input.
    *
    * Side-effects: the exception mask of istream is set to eofbit
    */
   InputByteStream(std::istream& istream)
-  : m_NumFutureBytes(0)
-  , m_FutureBytes(0)
-  , m_Input(istream)
+  : m_Input(istream)
+  , m_ReadPos(0)
+  , m_BufferEnd(0)
+  , m_LookaheadPos(NO_LOOKAHEAD)
+  , m_InputEnd(false)
   {
     istream.exceptions(std::istream::eofbit | std::istream::badbit);
   }
@@ -76,8 +80,10 @@ public:
    */
   void reset()
   {
-    m_NumFutureBytes = 0;
-    m_FutureBytes = 0;
+    m_ReadPos      = 0;
+    m_BufferEnd    = 0;
+    m_LookaheadPos = NO_LOOKAHEAD;
+    m_InputEnd     = false;
   }
 
   /**
@@ -87,25 +93,12 @@ public:
   bool eofBeforeNBytes(uint32_t n)
   {
     CHECK(n > 4, "Unsupported look-ahead value");
-    if (m_NumFutureBytes >= n)
+    if (m_BufferEnd - m_ReadPos >= n || xFill(n))
     {
       return false;
     }
-
-    n -= m_NumFutureBytes;
-    try
-    {
-      for (uint32_t i = 0; i < n; i++)
-      {
-        m_FutureBytes = (m_FutureBytes << 8) | m_Input.get();
-        m_NumFutureBytes++;
-      }
-    }
-    catch (...)
-    {
-      return true;
-    }
-    return false;
+    xSetEnd();
+    return true;
   }
 
   /**
@@ -123,7 +116,12 @@ public:
   uint32_t peekBytes(uint32_t n)
   {
     eofBeforeNBytes(n);
-    return m_FutureBytes >> 8*(m_NumFutureBytes - n);
+    uint32_t val = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+      val = (val << 8) | (m_ReadPos + i < m_BufferEnd ? m_Buffer[m_ReadPos + i] : 0);
+    }
+    return val;
   }
 
   /**
@@ -134,15 +132,12 @@ public:
    */
   uint8_t readByte()
   {
-    if (!m_NumFutureBytes)
+    if (m_ReadPos == m_BufferEnd && !xFill(1))
     {
-      uint8_t byte = m_Input.get();
-      return byte;
+      xSetEnd();
+      throw std::ios_base::failure("end of byte stream");
     }
-    m_NumFutureBytes--;
-    uint8_t wanted_byte = m_FutureBytes >> 8*m_NumFutureBytes;
-    m_FutureBytes &= ~(0xff << 8*m_NumFutureBytes);
-    return wanted_byte;
+    return m_Buffer[m_ReadPos++];
   }
 
   /**
@@ -160,14 +155,59 @@ public:
     return val;
   }
 
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  uint32_t GetNumBufferedBytes() const { return m_NumFutureBytes; }
-#endif
+  /**
+   * return a view of the bytes from the current position up to the
+   * next byte-aligned three-byte sequence 0x000000, 0x000001 or
+   * 0x000002, or up to the end of the input, without advancing the
+   * stream pointer.  The view stays valid until the next read.
+   */
+  const uint8_t* peekPayload(size_t& size);
+
+  /**
+   * consume n bytes that have been made visible by peekPayload().
+   */
+  void skipBytes(size_t n)
+  {
+    CHECK(n > m_BufferEnd - m_ReadPos, "Skipping bytes that have not been read");
+    m_ReadPos += n;
+  }
+
+  /**
+   * remember the current position, all bytes read from here on stay
+   * buffered so that endLookahead() can return to it without seeking
+   * the input stream.
+   */
+  void beginLookahead()
+  {
+    CHECK(m_LookaheadPos != NO_LOOKAHEAD, "Nested look-ahead");
+    m_LookaheadPos = m_ReadPos;
+  }
+
+  /**
+   * return to the position of beginLookahead() and clear an end of
+   * input state of the stream that was reached while looking ahead.
+   */
+  void endLookahead()
+  {
+    CHECK(m_LookaheadPos == NO_LOOKAHEAD, "No look-ahead to end");
+    m_ReadPos      = m_LookaheadPos;
+    m_LookaheadPos = NO_LOOKAHEAD;
+    m_Input.clear();
+  }
 
 private:
-  uint32_t m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
-  uint32_t m_FutureBytes; /* bytes that have been peeked */
-  std::istream& m_Input; /* Input stream to read from */
+  static const size_t NO_LOOKAHEAD    = size_t(-1);
+  static const size_t READ_BLOCK_SIZE = 1 << 20;
+
+  bool xFill(size_t n);   ///< buffer at least n bytes from the current position, returns false at the end of the input
+  void xSetEnd();         ///< set the end of input state of the stream as a failed get() would
+
+  std::istream&        m_Input;         /* Input stream to read from */
+  std::vector<uint8_t> m_Buffer;        /* bytes read from the input */
+  size_t               m_ReadPos;       /* current position in m_Buffer */
+  size_t               m_BufferEnd;     /* number of valid bytes in m_Buffer */
+  size_t               m_LookaheadPos;  /* position of beginLookahead() in m_Buffer */
+  bool                 m_InputEnd;      /* the stream buffer of the input has been read to its end */
 };
 
 /**
@@ -98,6 +98,11 @@ void DecCu::destoryDecCuReshaprBuf()
 // Public member functions
 // ====================================================================================================================
 
+void DecCu::resetIBCBuffer( const CodingStructure& cs )
+{
+  m_pcInterPred->resetIBCBuffer(cs.pcv->chrFormat, cs.slice->getSPS()->getMaxCUHeight());
+}
+
 void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
 {
 
@@ -105,7 +110,7 @@ void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
 
   if (cs.resetIBCBuffer)
   {
-    m_pcInterPred->resetIBCBuffer(cs.pcv->chrFormat, cs.slice->getSPS()->getMaxCUHeight());
+    resetIBCBuffer(cs);
     cs.resetIBCBuffer = false;
   }
   for( int ch = 0; ch < maxNumChannelType; ch++ )
@@ -114,7 +119,9 @@ void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
     Position prevTmpPos;
     prevTmpPos.x = -1; prevTmpPos.y = -1;
 
-    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, chType ), chType ) )
+    // a CTU starts with a single tree, cs.treeType belongs to the parser when the CTUs are reconstructed in parallel
+    const UnitArea area = CS::isDualITree( cs ) ? ctuArea.singleChan( chType ) : ctuArea;
+    for( auto &currCU : cs.traverseCUs( area, chType ) )
     {
       if(currCU.Y().valid())
       {
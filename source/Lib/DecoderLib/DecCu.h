@@ -68,6 +68,8 @@ public:
 
   /// destroy internal buffers
   void  decompressCtu     ( CodingStructure& cs, const UnitArea& ctuArea );
+  /// reset the IBC reference buffer at the start of a CTU row
+  void  resetIBCBuffer    ( const CodingStructure& cs );
   Reshape*          m_pcReshape;
   Reshape* getReshape     () { return m_pcReshape; }
   void initDecCuReshaper  ( Reshape* pcReshape, ChromaFormat chromaFormatIDC) ;
@@ -423,6 +423,7 @@ DecLib::DecLib()
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
 #endif
+  , m_numThreads(1)
   , m_pcPic(NULL)
   , m_prevLayerID(MAX_INT)
   , m_prevPOC(MAX_INT)
@@ -514,6 +515,19 @@ void DecLib::create()
 {
   m_apcSlicePilot = new Slice;
   m_uiSliceSegmentIdx = 0;
+
+  if( m_numThreads > 1 )
+  {
+    std::vector<DecCu*> cuDecoders( 1, &m_cCuDecoder );
+    for( int jId = 1; jId < m_numThreads; jId++ )
+    {
+      DecThreadCtx* threadCtx = new DecThreadCtx;
+      m_threadCtx.push_back( threadCtx );
+      cuDecoders.push_back( &threadCtx->m_cCuDecoder );
+    }
+    m_threadPool.create( m_numThreads );
+    m_cSliceDecoder.setReconThreads( &m_threadPool, cuDecoders );
+  }
 }
 
 void DecLib::destroy()
@@ -528,6 +542,13 @@ void DecLib::destroy()
   }
 
   m_cSliceDecoder.destroy();
+
+  m_threadPool.destroy();
+  for( auto threadCtx : m_threadCtx )
+  {
+    delete threadCtx;
+  }
+  m_threadCtx.clear();
 }
 
 void DecLib::init(
@@ -567,6 +588,11 @@ void DecLib::deletePicBuffer ( )
 #endif
   m_cCuDecoder.destoryDecCuReshaprBuf();
   m_cReshaper.destroy();
+  for( auto threadCtx : m_threadCtx )
+  {
+    threadCtx->m_cCuDecoder.destoryDecCuReshaprBuf();
+    threadCtx->m_cReshaper.destroy();
+  }
 }
 
 Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId )
@@ -650,41 +676,49 @@ void DecLib::executeLoopFilters()
 
   CodingStructure& cs = *m_pcPic->cs;
 
-  if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
+  // the CTU rows are deblocked with the tree type of the current slice, pictures mixing dual tree intra slices with
+  // other slices are filtered at picture level
+  bool uniformTreeType = true;
+  if( !cs.pcv->ISingleTree )
+  {
+    for( int ctuRsAddr = 0; ctuRsAddr < cs.pcv->sizeInCtus && uniformTreeType; ctuRsAddr++ )
+    {
+      const Position ctuPos( ( ctuRsAddr % cs.pcv->widthInCtus ) << cs.pcv->maxCUWidthLog2, ( ctuRsAddr / cs.pcv->widthInCtus ) << cs.pcv->maxCUHeightLog2 );
+      uniformTreeType = cs.getCU( ctuPos, CH_L )->slice->isIntra() == cs.slice->isIntra();
+    }
+  }
+
+  if( m_numThreads > 1 && cs.pcv->heightInCtus > 1 && uniformTreeType )
   {
-      const PreCalcValues& pcv = *cs.pcv;
-      for (uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight)
+    xExecuteLoopFiltersCtuRows( cs );
+  }
+  else
+  {
+    if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
+    {
+      for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus; ctuRow++ )
       {
-        for (uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
-        {
-          const CodingUnit* cu = cs.getCU(Position(xPos, yPos), CHANNEL_TYPE_LUMA);
-          if (cu->slice->getLmcsEnabledFlag())
-          {
-            const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
-            const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-            const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
-            cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
-          }
-        }
+        xInvReshapeCtuRow( cs, ctuRow );
       }
       m_cReshaper.setRecReshaped(false);
       m_cSAO.setReshaper(&m_cReshaper);
-  }
-  // deblocking filter
-  m_deblockingFilter.deblockingFilterPic( cs );
-  CS::setRefinedMotionField(cs);
-  if( cs.sps->getSAOEnabledFlag() )
-  {
-    m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
-  }
+    }
+    // deblocking filter
+    m_deblockingFilter.deblockingFilterPic( cs );
+    CS::setRefinedMotionField(cs);
+    if( cs.sps->getSAOEnabledFlag() )
+    {
+      m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
+    }
 
-  if( cs.sps->getALFEnabledFlag() )
-  {
-    m_cALF.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
-    // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
-    // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
-    // copy in case the APS gets used more than once.
-    m_cALF.ALFProcess(cs);
+    if( cs.sps->getALFEnabledFlag() )
+    {
+      m_cALF.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
+      // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
+      // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
+      // copy in case the APS gets used more than once.
+      m_cALF.ALFProcess(cs);
+    }
   }
 
   for (int i = 0; i < cs.pps->getNumSubPics() && m_targetSubPicIdx; i++)
@@ -714,6 +748,151 @@ void DecLib::executeLoopFilters()
   m_pcPic->cs->slice->stopProcessingTimer();
 }
 
+void DecLib::xInvReshapeCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const uint32_t yPos = ctuRow * pcv.maxCUHeight;
+  for (uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
+  {
+    const CodingUnit* cu = cs.getCU(Position(xPos, yPos), CHANNEL_TYPE_LUMA);
+    if (cu->slice->getLmcsEnabledFlag())
+    {
+      const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
+      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+      const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
+      cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
+    }
+  }
+}
+
+/**
+ - CTU row pipeline of the in-loop filters: the calling thread deblocks the rows, SAO and ALF run on two worker
+   threads and follow one CTU row behind the preceding stage, as each stage reads the first lines of the row below
+ - the row-wise processing is bit-exact with the picture-level filters
+ - the pipeline starts once the picture is completely reconstructed, it does not overlap with the reconstruction
+*/
+void DecLib::xExecuteLoopFiltersCtuRows( CodingStructure& cs )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int numCtuRows = pcv.heightInCtus;
+  const bool invReshape = cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag();
+
+  // the picture-level deblocking leaves the slice of the last CTU active, the stages use the slices of the CTUs
+  cs.slice = cs.getCU( Position( pcv.lumaWidth - 1, pcv.lumaHeight - 1 ), CH_L )->slice;
+
+  if( invReshape )
+  {
+    m_cReshaper.setRecReshaped(false);
+    m_cSAO.setReshaper(&m_cReshaper);
+  }
+  const bool applySAO = cs.sps->getSAOEnabledFlag() && m_cSAO.SAOPrepareCtuRows( cs, cs.picture->getSAO() );
+  const bool applyALF = cs.sps->getALFEnabledFlag();
+  if( applyALF )
+  {
+    m_cALF.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
+    m_cALF.ALFPrepareCtuRows( cs );
+  }
+
+  WavefrontProgress deblockProgress;
+  WavefrontProgress saoProgress;
+  deblockProgress.init( numCtuRows );
+  saoProgress.init( numCtuRows );
+  std::atomic<bool> abortFilters( false );
+
+  // on an error the stage releases the rows waited for by the following stage, the exception is re-thrown by
+  // waitForJobs()
+  const auto releaseRows = [numCtuRows]( WavefrontProgress& progress )
+  {
+    for( int ctuRow = 0; ctuRow < numCtuRows; ctuRow++ )
+    {
+      progress.setDone( ctuRow, MAX_INT );
+    }
+  };
+
+  m_threadPool.addJob( [&]( int )
+  {
+    try
+    {
+      for( int ctuRow = 0; ctuRow < numCtuRows; ctuRow++ )
+      {
+        deblockProgress.waitFor( std::min( ctuRow + 1, numCtuRows - 1 ), pcv.widthInCtus );
+        if( abortFilters )
+        {
+          break;
+        }
+        if( applySAO )
+        {
+          m_cSAO.SAOProcessCtuRow( cs, ctuRow );
+        }
+        saoProgress.setDone( ctuRow, pcv.widthInCtus );
+      }
+    }
+    catch( ... )
+    {
+      abortFilters = true;
+      releaseRows( saoProgress );
+      throw;
+    }
+    releaseRows( saoProgress );
+  } );
+  if( applyALF )
+  {
+    m_threadPool.addJob( [&]( int )
+    {
+      try
+      {
+        for( int ctuRow = 0; ctuRow < numCtuRows; ctuRow++ )
+        {
+          saoProgress.waitFor( std::min( ctuRow + 1, numCtuRows - 1 ), pcv.widthInCtus );
+          if( abortFilters )
+          {
+            break;
+          }
+          m_cALF.ALFProcessCtuRow( cs, ctuRow );
+        }
+      }
+      catch( ... )
+      {
+        abortFilters = true;
+        throw;
+      }
+    } );
+  }
+
+  try
+  {
+    for( int ctuRow = 0; ctuRow < numCtuRows && !abortFilters; ctuRow++ )
+    {
+      if( invReshape )
+      {
+        xInvReshapeCtuRow( cs, ctuRow );
+      }
+      m_deblockingFilter.deblockingFilterCtuRow( cs, ctuRow );
+      deblockProgress.setDone( ctuRow, pcv.widthInCtus );
+    }
+  }
+  catch( ... )
+  {
+    // the jobs reference the locals of this function, they have to finish before the exception leaves
+    abortFilters = true;
+    releaseRows( deblockProgress );
+    try
+    {
+      m_threadPool.waitForJobs();
+    }
+    catch( ... )
+    {
+      // the deblocking error is reported
+    }
+    throw;
+  }
+  releaseRows( deblockProgress );
+
+  m_threadPool.waitForJobs();
+
+  CS::setRefinedMotionField(cs);
+}
+
 void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
 {
   Slice*  pcSlice = m_pcPic->cs->slice;
@@ -1010,7 +1189,7 @@ void  DecLib::xCreateUnavailablePicture( const PPS *pps, const int iUnavailableP
   auto const sps = m_parameterSetManager.getSPS(pps->getSPSId());
   Picture* cFillPic = xGetNewPicBuffer( *sps, *pps, 0, layerId );
 
-  cFillPic->cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+  cFillPic->cs = new CodingStructure( cFillPic->m_unitCache.cuCache, cFillPic->m_unitCache.puCache, cFillPic->m_unitCache.tuCache );
   cFillPic->cs->sps = sps;
   cFillPic->cs->pps = pps;
   cFillPic->cs->vps = m_parameterSetManager.getVPS(sps->getVPSId());
@@ -1758,7 +1937,8 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     m_pcPic->createGrainSynthesizer(m_firstPictureInSequence, &m_grainCharacteristic, &m_grainBuf, pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getBitDepth(CHANNEL_TYPE_LUMA));
     m_pcPic->createColourTransfProcessor(m_firstPictureInSequence, &m_colourTranfParams, &m_invColourTransfBuf, pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getBitDepth(CHANNEL_TYPE_LUMA));
     m_firstPictureInSequence = false;
-    m_pcPic->createTempBuffers( m_pcPic->cs->pps->pcv->maxCUWidth );
+    // the CTU rows reconstructed in parallel need separate prediction and residual buffers
+    m_pcPic->createTempBuffers( m_pcPic->cs->pps->pcv->maxCUWidth, m_numThreads > 1 );
     m_pcPic->cs->createCoeffs((bool)m_pcPic->cs->sps->getPLTMode());
 
     m_pcPic->allocateNewSlice();
@@ -1846,6 +2026,21 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     // RdCost
     m_cRdCost.setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
 
+    // initialize the decoder instances of the additional reconstruction threads
+    for( auto threadCtx : m_threadCtx )
+    {
+      threadCtx->m_cIntraPred.init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
+      threadCtx->m_cInterPred.init( &threadCtx->m_cRdCost, sps->getChromaFormatIdc(), sps->getMaxCUHeight() );
+      threadCtx->m_cCuDecoder.init( &threadCtx->m_cTrQuant, &threadCtx->m_cIntraPred, &threadCtx->m_cInterPred );
+      if (sps->getUseLmcs())
+      {
+        threadCtx->m_cReshaper.createDec(sps->getBitDepth(CHANNEL_TYPE_LUMA));
+        threadCtx->m_cCuDecoder.initDecCuReshaper(&threadCtx->m_cReshaper, sps->getChromaFormatIdc());
+      }
+      threadCtx->m_cTrQuant.init(m_cTrQuantScalingList.getQuant(), sps->getMaxTbSize(), false, false, false, false);
+      threadCtx->m_cRdCost.setCostMode ( COST_STANDARD_LOSSY );
+    }
+
     m_cSliceDecoder.create();
 
     if( sps->getALFEnabledFlag() )
@@ -3051,10 +3246,19 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     ScalingList scalingList = scalingListAPS->getScalingList();
     quant->setScalingListDec(scalingList);
     quant->setUseScalingList(true);
+    for( auto threadCtx : m_threadCtx )
+    {
+      threadCtx->m_cTrQuant.getQuant()->setScalingListDec(scalingList);
+      threadCtx->m_cTrQuant.getQuant()->setUseScalingList(true);
+    }
   }
   else
   {
     quant->setUseScalingList( false );
+    for( auto threadCtx : m_threadCtx )
+    {
+      threadCtx->m_cTrQuant.getQuant()->setUseScalingList( false );
+    }
   }
 
   if (pcSlice->getSPS()->getUseLmcs())
@@ -3145,6 +3349,14 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     m_cReshaper.setCTUFlag(false);
     m_cReshaper.setRecReshaped(false);
   }
+  if (pcSlice->getSPS()->getUseLmcs())
+  {
+    // the reconstruction threads use copies of the reshaper state of the slice
+    for( auto threadCtx : m_threadCtx )
+    {
+      threadCtx->m_cReshaper = m_cReshaper;
+    }
+  }
 
 #if GDR_LEAK_TEST
   if (m_gdrPocRandomAccess == pcSlice->getPOC())
@@ -3662,10 +3874,8 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
   // save stream position for backup
 #if RExt__DECODER_DEBUG_STATISTICS
   CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
-  std::streampos location = bitstreamFile->tellg() - std::streampos(bytestream->GetNumBufferedBytes());
-#else
-  std::streampos location = bitstreamFile->tellg();
 #endif
+  bytestream->beginLookahead();
 
   // look ahead until picture start location is determined
   while (!finished && !!(*bitstreamFile))
@@ -3737,17 +3947,11 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
     }
   }
 
-  // restore previous stream location - minus 3 due to the need for the annexB parser to read three extra bytes
+  // restore previous stream location
+  bytestream->endLookahead();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
   CodingStatistics::SetStatistics(*backupStats);
   delete backupStats;
-#else
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location-std::streamoff(3));
-  bytestream->reset();
 #endif
 
   // return TRUE if next NAL unit is the start of a new picture
@@ -3771,10 +3975,8 @@ bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, cla
   // save stream position for backup
 #if RExt__DECODER_DEBUG_STATISTICS
   CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
-  std::streampos location = bitstreamFile->tellg() - std::streampos(bytestream->GetNumBufferedBytes());
-#else
-  std::streampos location = bitstreamFile->tellg();
 #endif
+  bytestream->beginLookahead();
 
   // look ahead until access unit start location is determined
   while (!finished && !!(*bitstreamFile))
@@ -3829,16 +4031,10 @@ bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, cla
   }
 
   // restore previous stream location
+  bytestream->endLookahead();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
   CodingStatistics::SetStatistics(*backupStats);
   delete backupStats;
-#else
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
 #endif
 
   // return TRUE if next NAL unit is the start of a new picture
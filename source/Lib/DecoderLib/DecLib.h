@@ -54,6 +54,7 @@
 #include "CommonLib/SEI.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/Reshape.h"
+#include "CommonLib/ThreadPool.h"
 
 class InputNALUnit;
 
@@ -64,6 +65,17 @@ bool tryDecodePicture( Picture* pcPic, const int expectedPoc, const std::string&
 // Class definition
 // ====================================================================================================================
 
+/// decoder instances owned by an additional reconstruction thread
+struct DecThreadCtx
+{
+  IntraPrediction         m_cIntraPred;
+  InterPrediction         m_cInterPred;
+  TrQuant                 m_cTrQuant;
+  DecCu                   m_cCuDecoder;
+  Reshape                 m_cReshaper;
+  RdCost                  m_cRdCost;
+};
+
 /// decoder class
 class DecLib
 {
@@ -119,6 +131,10 @@ private:
   HRD                     m_HRD;
   // decoder side RD cost computation
   RdCost                  m_cRdCost;                      ///< RD cost computation class
+  // parallel reconstruction, thread 0 uses the instances above
+  int                     m_numThreads;                   ///< number of threads reconstructing CTU rows in parallel to parsing
+  std::vector<DecThreadCtx*> m_threadCtx;                 ///< decoder instances of the threads 1..NumThreads-1
+  ThreadPool              m_threadPool;                   ///< worker threads reconstructing CTU rows
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   CacheModel              m_cacheModel;
 #endif
@@ -232,6 +248,8 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  /// set before create()
+  void  setNumThreads( int numThreads )               { m_numThreads = numThreads; }
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -324,6 +342,8 @@ protected:
   void  checkParameterSetsInclusionSEIconstraints(const InputNALUnit nalu);
   void  xActivateParameterSets( const InputNALUnit nalu );
   void  xCheckParameterSetConstraints( const int layerId );
+  void  xInvReshapeCtuRow( CodingStructure& cs, const int ctuRow );
+  void  xExecuteLoopFiltersCtuRows( CodingStructure& cs );
   void      xDecodePicHeader( InputNALUnit& nalu );
   bool      xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDisplay);
   void      xDecodeOPI( InputNALUnit& nalu );
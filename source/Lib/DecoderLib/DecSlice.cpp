@@ -49,6 +49,8 @@
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_pcThreadPool( nullptr )
+  , m_abortRecon  ( false )
 {
 }
 
@@ -70,6 +72,13 @@ void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
   m_pcCuDecoder     = pcCuDecoder;
 }
 
+void DecSlice::setReconThreads( ThreadPool* threadPool, const std::vector<DecCu*>& cuDecoders )
+{
+  CHECK( threadPool && threadPool->getNumThreads() != (int)cuDecoders.size(), "One CU decoder per reconstruction thread required" );
+  m_pcThreadPool     = threadPool;
+  m_threadCuDecoders = cuDecoders;
+}
+
 void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int debugCTU )
 {
   //-- For time output for each slice
@@ -135,158 +144,296 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   {
     clipMv = clipMvInPic;
   }
+
+  // reconstruct the CTU rows of the tiles on the worker threads while the slice is parsed
+  const bool parallelRecon = m_pcThreadPool != nullptr && debugCTU < 0 && !g_mctsDecCheckEnabled;
+  const unsigned numCtusInSlice = slice->getNumCtuInSlice();
+
+  // split the slice into CTU rows of tiles, a new row starts at each tile column boundary
+  std::vector<unsigned> rowStart;
+  std::vector<int>      ctuRow     ( parallelRecon ? cs.pcv->sizeInCtus : 0, -1 );
+  std::vector<int>      ctuPosInRow( parallelRecon ? cs.pcv->sizeInCtus : 0, -1 );
+  const size_t          maxNumUnits = 2 * cs.unitScale[COMPONENT_Y].scale( cs.area.blocks[COMPONENT_Y].size() ).area();
+
+  if( parallelRecon )
+  {
+    for( unsigned ctuIdx = 0; ctuIdx < numCtusInSlice; ctuIdx++ )
+    {
+      const unsigned ctuRsAddr = slice->getCtuAddrInSlice( ctuIdx );
+      if( ctuIdx == 0 || cs.pps->ctuIsTileColBd( ctuRsAddr % widthInCtus ) )
+      {
+        rowStart.push_back( ctuIdx );
+      }
+      ctuRow     [ctuRsAddr] = (int)rowStart.size() - 1;
+      ctuPosInRow[ctuRsAddr] = ctuIdx - rowStart.back();
+    }
+    const int numRows = (int)rowStart.size();
+    rowStart.push_back( numCtusInSlice );
+
+    // the unit vectors are read by the reconstruction while the parser adds units, they must not be reallocated
+    cs.cus.reserve( maxNumUnits );
+    cs.pus.reserve( maxNumUnits );
+    cs.tus.reserve( maxNumUnits );
+
+    // the HMVP table is reset at the start of each CTU row of a tile, every row gets its own one
+    cs.initCtuRowMotionLuts();
+
+    m_abortRecon = false;
+    m_parseProgress.init( 1 );
+    m_reconProgress.init( numRows );
+
+    for( int row = 0; row < numRows; row++ )
+    {
+      m_pcThreadPool->addJob( [&, row]( int threadIdx )
+      {
+        DecCu* cuDecoder = m_threadCuDecoders[threadIdx];
+        try
+        {
+          for( unsigned ctuIdx = rowStart[row]; ctuIdx < rowStart[row + 1]; ctuIdx++ )
+          {
+            const unsigned ctuRsAddr     = slice->getCtuAddrInSlice( ctuIdx );
+            const unsigned ctuXPosInCtus = ctuRsAddr % widthInCtus;
+            const unsigned ctuYPosInCtus = ctuRsAddr / widthInCtus;
+            const Position pos( ctuXPosInCtus * cs.pcv->maxCUWidth, ctuYPosInCtus * cs.pcv->maxCUHeight );
+            const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, cs.pcv->maxCUWidth, cs.pcv->maxCUHeight ) );
+
+            // the CU chain of the CTU is complete once the next CTU is parsed
+            m_parseProgress.waitFor( 0, ctuIdx + 1 );
+
+            // wait for the above-right CTU of the same tile (or the above one at the right tile boundary),
+            // prediction does not cross tile boundaries and the rows of previous slices are finished
+            if( !cs.pps->ctuIsTileRowBd( ctuYPosInCtus ) )
+            {
+              unsigned aboveRsAddr = ctuRsAddr - widthInCtus;
+              if( ctuXPosInCtus + 1 < widthInCtus && ctuRow[aboveRsAddr + 1] == ctuRow[aboveRsAddr] )
+              {
+                aboveRsAddr++;
+              }
+              if( ctuRow[aboveRsAddr] >= 0 )
+              {
+                m_reconProgress.waitFor( ctuRow[aboveRsAddr], ctuPosInRow[aboveRsAddr] + 1 );
+              }
+            }
+            if( m_abortRecon )
+            {
+              break;
+            }
+
+            if( ctuIdx == rowStart[row] && ( cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag() ) )
+            {
+              cuDecoder->resetIBCBuffer( cs );
+            }
+
+            cuDecoder->decompressCtu( cs, ctuArea );
+
+            m_reconProgress.setDone( row, ctuIdx - rowStart[row] + 1 );
+          }
+        }
+        catch( ... )
+        {
+          // let the following rows finish, the exception is re-thrown by waitForJobs()
+          m_abortRecon = true;
+          m_reconProgress.setDone( row, MAX_INT );
+          throw;
+        }
+        m_reconProgress.setDone( row, MAX_INT );
+      } );
+    }
+  }
+
   // for every CTU in the slice segment...
   unsigned subStrmId = 0;
-  for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+  const SubPic* restoreSubPic = nullptr;
+  try
   {
-    const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice(ctuIdx);
-    const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
-    const unsigned  ctuYPosInCtus   = ctuRsAddr / widthInCtus;
-    const unsigned  tileColIdx      = slice->getPPS()->ctuToTileCol( ctuXPosInCtus );
-    const unsigned  tileRowIdx      = slice->getPPS()->ctuToTileRow( ctuYPosInCtus );
-    const unsigned  tileXPosInCtus  = slice->getPPS()->getTileColumnBd( tileColIdx );
-    const unsigned  tileYPosInCtus  = slice->getPPS()->getTileRowBd( tileRowIdx );
-    const unsigned  tileColWidth    = slice->getPPS()->getTileColumnWidth( tileColIdx );
-    const unsigned  tileRowHeight   = slice->getPPS()->getTileRowHeight( tileRowIdx );
-    const unsigned  tileIdx         = slice->getPPS()->getTileIdx( ctuXPosInCtus, ctuYPosInCtus);
-    const unsigned  maxCUSize             = sps->getMaxCUWidth();
-    Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
-    UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
-    const SubPic &curSubPic = slice->getPPS()->getSubPicFromPos(pos);
-    // padding/restore at slice level
-    if (slice->getPPS()->getNumSubPics()>=2 && curSubPic.getTreatedAsPicFlag() && ctuIdx==0)
+    for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
     {
-      int subPicX      = (int)curSubPic.getSubPicLeft();
-      int subPicY      = (int)curSubPic.getSubPicTop();
-      int subPicWidth  = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+      const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice(ctuIdx);
+      const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
+      const unsigned  ctuYPosInCtus   = ctuRsAddr / widthInCtus;
+      const unsigned  tileColIdx      = slice->getPPS()->ctuToTileCol( ctuXPosInCtus );
+      const unsigned  tileRowIdx      = slice->getPPS()->ctuToTileRow( ctuYPosInCtus );
+      const unsigned  tileXPosInCtus  = slice->getPPS()->getTileColumnBd( tileColIdx );
+      const unsigned  tileYPosInCtus  = slice->getPPS()->getTileRowBd( tileRowIdx );
+      const unsigned  tileColWidth    = slice->getPPS()->getTileColumnWidth( tileColIdx );
+      const unsigned  tileRowHeight   = slice->getPPS()->getTileRowHeight( tileRowIdx );
+      const unsigned  tileIdx         = slice->getPPS()->getTileIdx( ctuXPosInCtus, ctuYPosInCtus);
+      const unsigned  maxCUSize             = sps->getMaxCUWidth();
+      Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
+      UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+      const SubPic &curSubPic = slice->getPPS()->getSubPicFromPos(pos);
+      // padding/restore at slice level
+      if (slice->getPPS()->getNumSubPics()>=2 && curSubPic.getTreatedAsPicFlag() && ctuIdx==0)
       {
-        int n = slice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
+        int subPicX      = (int)curSubPic.getSubPicLeft();
+        int subPicY      = (int)curSubPic.getSubPicTop();
+        int subPicWidth  = (int)curSubPic.getSubPicWidthInLumaSample();
+        int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+        for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
         {
-          Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
-
-          if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+          int n = slice->getNumRefIdx((RefPicList)rlist);
+          for (int idx = 0; idx < n; idx++)
           {
-            refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(true);
+            Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
+
+            if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+            {
+              refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+              refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+              refPic->setSubPicSaved(true);
+            }
           }
         }
       }
-    }
 
-    DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+      DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
 
-    cabacReader.initBitstream( ppcSubstreams[subStrmId] );
+      cabacReader.initBitstream( ppcSubstreams[subStrmId] );
 
-    // set up CABAC contexts' state for this CTU
-    if( ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus )
-    {
-      if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+      // set up CABAC contexts' state for this CTU
+      if( ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus )
       {
-        cabacReader.initCtxModels( *slice );
-        cs.resetPrevPLT(cs.prevPLT);
+        if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+          cs.resetPrevPLT(cs.prevPLT);
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
       }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
-    }
-    else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
-    {
-      // Synchronize cabac probabilities with top CTU if it's available and at the start of a line.
-      if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+      else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
       {
-        cabacReader.initCtxModels( *slice );
-        cs.resetPrevPLT(cs.prevPLT);
+        // Synchronize cabac probabilities with top CTU if it's available and at the start of a line.
+        if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+          cs.resetPrevPLT(cs.prevPLT);
+        }
+        if( cs.getCURestricted( pos.offset(0, -1), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+        {
+          // Top is available, so use it.
+          cabacReader.getCtx() = m_entropyCodingSyncContextState;
+          cabacReader.getCtx().riceStatReset(slice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA), slice->getSPS()->getSpsRangeExtension().getPersistentRiceAdaptationEnabledFlag());
+          cs.setPrevPLT(m_palettePredictorSyncState);
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
       }
-      if( cs.getCURestricted( pos.offset(0, -1), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+
+      bool updateBcwCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuIdx == 0;
+      if(updateBcwCodingOrder)
       {
-        // Top is available, so use it.
-        cabacReader.getCtx() = m_entropyCodingSyncContextState;
-        cabacReader.getCtx().riceStatReset(slice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA), slice->getSPS()->getSpsRangeExtension().getPersistentRiceAdaptationEnabledFlag());
-        cs.setPrevPLT(m_palettePredictorSyncState);
+        resetBcwCodingOrder(true, cs);
       }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
-    }
-
-    bool updateBcwCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuIdx == 0;
-    if(updateBcwCodingOrder)
-    {
-      resetBcwCodingOrder(true, cs);
-    }
 
-    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == tileXPosInCtus)
-    {
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
-      cs.resetIBCBuffer = true;
-    }
+      if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == tileXPosInCtus)
+      {
+        cs.motionLut.lut.resize(0);
+        cs.motionLut.lutIbc.resize(0);
+        if( !parallelRecon )
+        {
+          // the reconstruction jobs reset their IBC buffers at the start of each row
+          cs.resetIBCBuffer = true;
+        }
+      }
 
-    if( !cs.slice->isIntra() )
-    {
-      pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
-    }
+      if( !cs.slice->isIntra() )
+      {
+        pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
+      }
 
-    if( ctuRsAddr == debugCTU )
-    {
-      break;
-    }
-    cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+      if( ctuRsAddr == debugCTU )
+      {
+        break;
+      }
+      cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
 
-    m_pcCuDecoder->decompressCtu( cs, ctuArea );
+      if( parallelRecon )
+      {
+        CHECK( cs.cus.size() > maxNumUnits || cs.pus.size() > maxNumUnits || cs.tus.size() > maxNumUnits,
+               "The unit vectors were reallocated while being reconstructed" );
+        // the previous CTU is complete, its last CU is linked to the first CU of this one
+        m_parseProgress.setDone( 0, ctuIdx );
+      }
+      else
+      {
+        m_pcCuDecoder->decompressCtu( cs, ctuArea );
+      }
 
-    if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
-    {
-      m_entropyCodingSyncContextState = cabacReader.getCtx();
-      cs.storePrevPLT(m_palettePredictorSyncState);
-    }
+      if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+      {
+        m_entropyCodingSyncContextState = cabacReader.getCtx();
+        cs.storePrevPLT(m_palettePredictorSyncState);
+      }
 
 
-    if( ctuIdx == slice->getNumCtuInSlice()-1 )
-    {
-      unsigned binVal = cabacReader.terminating_bit();
-      CHECK( !binVal, "Expecting a terminating bit" );
-#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-      cabacReader.remaining_bytes( false );
-#endif
-    }
-    else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + tileColWidth ) &&
-             ( ctuYPosInCtus + 1 == tileYPosInCtus + tileRowHeight || wavefrontsEnabled ) )
-    {
-      // The sub-stream/stream should be terminated after this CTU.
-      // (end of slice-segment, end of tile, end of wavefront-CTU-row)
-      unsigned binVal = cabacReader.terminating_bit();
-      CHECK( !binVal, "Expecting a terminating bit" );
-      if( entryPointPresent )
+      if( ctuIdx == slice->getNumCtuInSlice()-1 )
       {
-#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-        cabacReader.remaining_bytes( true );
-#endif
-        subStrmId++;
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+  #if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( false );
+  #endif
       }
-    }
-    if (slice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (slice->getNumCtuInSlice() - 1))
-    // for last Ctu in the slice
-    {
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+      else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + tileColWidth ) &&
+               ( ctuYPosInCtus + 1 == tileYPosInCtus + tileRowHeight || wavefrontsEnabled ) )
       {
-        int n = slice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
+        // The sub-stream/stream should be terminated after this CTU.
+        // (end of slice-segment, end of tile, end of wavefront-CTU-row)
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+        if( entryPointPresent )
         {
-          Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
-          if (refPic->getSubPicSaved())
-          {
-            refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(false);
-          }
+  #if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+          cabacReader.remaining_bytes( true );
+  #endif
+          subStrmId++;
+        }
+      }
+      if (slice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (slice->getNumCtuInSlice() - 1))
+      // for last Ctu in the slice
+      {
+        if( parallelRecon )
+        {
+          restoreSubPic = &curSubPic;
+        }
+        else
+        {
+          xRestoreSubPicBorders( slice, curSubPic );
         }
       }
     }
   }
+  catch( ... )
+  {
+    if( parallelRecon )
+    {
+      // the reconstruction jobs reference the locals of this function, release the ones waiting for CTUs that
+      // will not be parsed anymore and let them finish before the exception leaves
+      m_abortRecon = true;
+      m_parseProgress.setDone( 0, MAX_INT );
+      try
+      {
+        m_pcThreadPool->waitForJobs();
+      }
+      catch( ... )
+      {
+        // the parsing error is reported
+      }
+      cs.ctuRowMotionLuts.clear();
+    }
+    throw;
+  }
+
+  if( parallelRecon )
+  {
+    m_parseProgress.setDone( 0, numCtusInSlice );
+    m_pcThreadPool->waitForJobs();
+    cs.ctuRowMotionLuts.clear();
+
+    if( restoreSubPic )
+    {
+      xRestoreSubPicBorders( slice, *restoreSubPic );
+    }
+  }
 
   // deallocate all created substreams, including internal buffers.
   for( auto substr: ppcSubstreams )
@@ -296,4 +443,25 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   slice->stopProcessingTimer();
 }
 
+void DecSlice::xRestoreSubPicBorders( Slice* slice, const SubPic& curSubPic )
+{
+  int subPicX = (int)curSubPic.getSubPicLeft();
+  int subPicY = (int)curSubPic.getSubPicTop();
+  int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
+  int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+  for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  {
+    int n = slice->getNumRefIdx((RefPicList)rlist);
+    for (int idx = 0; idx < n; idx++)
+    {
+      Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
+      if (refPic->getSubPicSaved())
+      {
+        refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->setSubPicSaved(false);
+      }
+    }
+  }
+}
+
 //! \}
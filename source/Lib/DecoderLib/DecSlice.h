@@ -44,9 +44,12 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/ThreadPool.h"
 #include "DecCu.h"
 #include "CABACReader.h"
 
+#include <atomic>
+
 //! \ingroup DecoderLib
 //! \{
 
@@ -65,15 +68,26 @@ private:
   Ctx             m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   PLTBuf          m_palettePredictorSyncState;      /// palette predictor storage at wavefront/WPP
 
+  ThreadPool*          m_pcThreadPool;                  ///< worker threads reconstructing CTU rows, nullptr for sequential decoding
+  std::vector<DecCu*>  m_threadCuDecoders;              ///< CU decoder of each worker thread
+  WavefrontProgress    m_parseProgress;                 ///< number of parsed CTUs of the slice
+  WavefrontProgress    m_reconProgress;                 ///< number of reconstructed CTUs per CTU row of a tile
+  std::atomic<bool>    m_abortRecon;                    ///< set when parsing failed, the reconstruction jobs stop
+
 public:
   DecSlice();
   virtual ~DecSlice();
 
   void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+  /// reconstruct the CTU rows in parallel to parsing, cuDecoders contains one CU decoder per thread of the pool
+  void  setReconThreads   ( ThreadPool* threadPool, const std::vector<DecCu*>& cuDecoders );
   void  create            ();
   void  destroy           ();
 
   void  decompressSlice   ( Slice* slice, InputBitstream* bitstream, int debugCTU );
+
+private:
+  void  xRestoreSubPicBorders( Slice* slice, const SubPic& curSubPic );
 };
 
 //! \}
@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 
@@ -58,42 +59,58 @@ using namespace std;
 //! \{
 static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bitstream, bool isVclNalUnit)
 {
-  uint32_t zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  uint8_t* const buf  = nalUnitBuf.data();
+  const size_t   size = nalUnitBuf.size();
+  size_t runStart = 0;    // first byte that is not yet moved to its RBSP position
+  size_t writePos = 0;
+  size_t pos      = 0;
 
-  uint32_t pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  // the emulation prevention bytes and all checked sequences follow two zero bytes, the first zero byte of
+  // each candidate is located with memchr and the bytes in between are moved in runs, not at all without
+  // emulation prevention bytes
+  while (pos + 2 < size)
   {
-    CHECK(zeroCount >= 2 && *it_read < 0x03, "Zero count is '2' and read value is small than '3'");
-    if (zeroCount == 2 && *it_read == 0x03)
+    const uint8_t* zero = static_cast<const uint8_t*>(memchr(buf + pos, 0x00, size - 2 - pos));
+    if (zero == nullptr)
+    {
+      break;
+    }
+    pos = zero - buf;
+    if (buf[pos + 1] != 0x00)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
       pos++;
-      it_read++;
-      zeroCount = 0;
+      continue;
+    }
+    CHECK(buf[pos + 2] < 0x03, "Zero count is '2' and read value is small than '3'");
+    if (buf[pos + 2] != 0x03)
+    {
+      pos += 2;
+      continue;
+    }
+    const size_t epbPos = pos + 2;
+    bitstream->pushEmulationPreventionByteLocation( uint32_t(epbPos) );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-      CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
+    CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
-      {
-        break;
-      }
-      CHECK(*it_read > 0x03, "Read a value bigger than '3'");
-    }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    memmove(buf + writePos, buf + runStart, epbPos - runStart);
+    writePos += epbPos - runStart;
+    runStart  = epbPos + 1;
+    pos       = runStart;
+    CHECK(runStart < size && buf[runStart] > 0x03, "Read a value bigger than '3'");
   }
-  CHECK(zeroCount != 0, "Zero count not '0'");
+  CHECK(size > 0 && buf[size - 1] == 0x00, "Zero count not '0'");
+  memmove(buf + writePos, buf + runStart, size - runStart);
+  writePos += size - runStart;
 
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (writePos > 0 && buf[writePos - 1] == 0x00)
     {
-      it_write--;
+      writePos--;
       n++;
     }
 
@@ -103,7 +120,7 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(writePos);
 }
 
 #if ENABLE_TRACING
@@ -170,6 +187,41 @@ void read(InputNALUnit& nalu)
   readNalUnitHeader(nalu);
 }
 
+void writeNalUnitEBSP(std::ostream& out, const InputNALUnit& nalu)
+{
+  // nal_unit_header() from the header values, which may have been changed after read()
+  const char header[2] = { char((nalu.m_forbiddenZeroBit << 7) | (nalu.m_nuhReservedZeroBit << 6) | nalu.m_nuhLayerId),
+                           char((nalu.m_nalUnitType << 3) | (nalu.m_temporalId + 1)) };
+  out.write(header, 2);
+
+  /* the emulation prevention bytes are restored at their locations in the
+   * input NAL unit, the nal_unit_header() cannot be part of an emulated start
+   * code since its second byte is not zero. Bytes before an emulation
+   * prevention byte beyond the end of the RBSP are cabac_zero_words that have
+   * been removed by read() */
+  const vector<uint8_t>&  rbsp     = nalu.getBitstream().getFifo();
+  const vector<uint32_t>& epbLocs  = nalu.getBitstream().getEmulationPreventionByteLocation();
+  size_t                  readPos  = 2;
+  size_t                  ebspPos  = 2;
+  for (const uint32_t epbPos : epbLocs)
+  {
+    const size_t numBytes = epbPos - ebspPos;
+    const size_t numRbsp  = std::min(numBytes, rbsp.size() > readPos ? rbsp.size() - readPos : 0);
+    out.write(reinterpret_cast<const char*>(rbsp.data() + readPos), numRbsp);
+    for (size_t i = numRbsp; i < numBytes; i++)
+    {
+      out.put(0x00);
+    }
+    out.put(0x03);
+    readPos += numBytes;
+    ebspPos  = epbPos + 1;
+  }
+  if (readPos < rbsp.size())
+  {
+    out.write(reinterpret_cast<const char*>(rbsp.data() + readPos), rbsp.size() - readPos);
+  }
+}
+
 bool checkPictureHeaderInSliceHeaderFlag(InputNALUnit& nalu)
 {
   InputBitstream& bitstream = nalu.getBitstream();
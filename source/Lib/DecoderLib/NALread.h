@@ -67,7 +67,14 @@ class InputNALUnit : public NALUnit
 
 void read(InputNALUnit& nalu);
 void readNalUnitHeader(InputNALUnit& nalu);
+void writeNalUnitEBSP(std::ostream& out, const InputNALUnit& nalu);   ///< write a NAL unit after read() unchanged, without a new emulation prevention
 bool checkPictureHeaderInSliceHeaderFlag(InputNALUnit & nalu);
+
+inline NALUnitEBSP::NALUnitEBSP(const InputNALUnit& nalu)
+  : NALUnit(nalu)
+{
+  writeNalUnitEBSP(m_nalUnitData, nalu);
+}
 //! \}
 
 #endif
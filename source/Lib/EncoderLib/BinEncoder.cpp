@@ -412,35 +412,6 @@ BitEstimatorBase::BitEstimatorBase( const BinProbModel* dummy )
   m_EstFracBits = 0;
 }
 
-void BitEstimatorBase::encodeRemAbsEP(unsigned bins, unsigned goRicePar, unsigned cutoff, int maxLog2TrDynamicRange)
-{
-  const unsigned threshold = cutoff << goRicePar;
-  if (bins < threshold)
-  {
-    m_EstFracBits += BinProbModelBase::estFracBitsEP((bins >> goRicePar) + 1 + goRicePar);
-  }
-  else
-  {
-    const unsigned  maxPrefixLength = 32 - cutoff - maxLog2TrDynamicRange;
-    unsigned        prefixLength = 0;
-    unsigned        codeValue = (bins >> goRicePar) - cutoff;
-    unsigned        suffixLength;
-    if (codeValue >= ((1 << maxPrefixLength) - 1))
-    {
-      prefixLength = maxPrefixLength;
-      suffixLength = maxLog2TrDynamicRange;
-    }
-    else
-    {
-      while (codeValue > ((2 << prefixLength) - 2))
-      {
-        prefixLength++;
-      }
-      suffixLength = prefixLength + goRicePar + 1; //+1 for the separator bit
-    }
-    m_EstFracBits += BinProbModelBase::estFracBitsEP(cutoff + prefixLength + suffixLength);
-  }
-}
 
 void BitEstimatorBase::align()
 {
@@ -249,8 +249,25 @@ public:
   void      encodeRemAbsEP      ( unsigned bins,
                                   unsigned goRicePar,
                                   unsigned cutoff,
-                                  int      maxLog2TrDynamicRange    );
+                                  int      maxLog2TrDynamicRange    ) { m_EstFracBits += BinProbModelBase::estFracBitsEP( numRemAbsBins( bins, goRicePar, cutoff, maxLog2TrDynamicRange ) ); }
   void      align               ();
+public:
+  // number of bypass bins of a rice/exp-golomb remainder (closed form of the binarization loop in BinEncoderBase)
+  static unsigned numRemAbsBins ( unsigned bins, unsigned goRicePar, unsigned cutoff, int maxLog2TrDynamicRange )
+  {
+    if( bins < ( cutoff << goRicePar ) )
+    {
+      return ( bins >> goRicePar ) + 1 + goRicePar;
+    }
+    const unsigned maxPrefixLength = 32 - cutoff - maxLog2TrDynamicRange;
+    const unsigned codeValue       = ( bins >> goRicePar ) - cutoff;
+    if( codeValue >= ( ( 1u << maxPrefixLength ) - 1 ) )
+    {
+      return cutoff + maxPrefixLength + maxLog2TrDynamicRange;
+    }
+    const unsigned prefixLength    = floorLog2( codeValue + 1 );
+    return cutoff + 2 * prefixLength + goRicePar + 1;
+  }
 public:
   uint32_t  getNumBins          ()                                      { THROW("Not supported"); return 0; }
   bool      isEncoding          ()                                      { return false; }
@@ -262,8 +279,9 @@ protected:
 
 
 
+// final: callers holding the concrete type (see CABACWriter::residual_coding_subblock) get non-virtual, inlined bin estimation
 template <class BinProbModel>
-class TBitEstimator : public BitEstimatorBase
+class TBitEstimator final : public BitEstimatorBase
 {
 public:
   TBitEstimator ();
@@ -51,7 +51,7 @@ class EncCu;
 class CABACWriter
 {
 public:
-  CABACWriter(BinEncIf& binEncoder)   : m_BinEncoder(binEncoder), m_Bitstream(0) { m_TestCtx = m_BinEncoder.getCtx(); m_EncCu = NULL; }
+  CABACWriter(BinEncIf& binEncoder)   : m_BinEncoder(binEncoder), m_BitEstimator(dynamic_cast<BitEstimator_Std*>(&binEncoder)), m_Bitstream(0) { m_TestCtx = m_BinEncoder.getCtx(); m_EncCu = NULL; }
   virtual ~CABACWriter() {}
 
 public:
@@ -169,6 +169,8 @@ private:
   void        unary_max_eqprob          ( unsigned symbol,                                   unsigned maxSymbol );
   void        exp_golomb_eqprob         ( unsigned symbol, unsigned count );
   void        code_unary_fixed          ( unsigned symbol, unsigned ctxId, unsigned unary_max, unsigned fixed );
+  template<class BinEnc>
+  void        residual_coding_subblock  ( BinEnc& binEncoder, CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state );
 
   // statistic
   unsigned    get_num_written_bits()    { return m_BinEncoder.getNumWrittenBits(); }
@@ -178,6 +180,7 @@ private:
   void        xEncodePLTPredIndicator    ( const CodingUnit& cu,     uint32_t    maxPltSize, ComponentID compBegin);
 private:
   BinEncIf&         m_BinEncoder;
+  BitEstimator_Std* m_BitEstimator;     // non-null in estimation mode, used for the devirtualised residual rate estimation
   OutputBitstream*  m_Bitstream;
   Ctx               m_TestCtx;
   EncCu*            m_EncCu;
@@ -365,6 +365,7 @@ protected:
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
   bool      m_HashME;
+  bool      m_HashMEIncremental;
   bool      m_AffineAmvrEncOpt;
   bool      m_DMVR;
   bool      m_MMVD;
@@ -444,6 +445,8 @@ protected:
   bool      m_bFastMEAssumingSmootherMVEnabled;
   int       m_minSearchWindow;
   bool      m_bRestrictMESampling;
+  bool      m_hierarchicalME;
+  bool      m_motionSearchCache;
 
   //====== Quality control ========
   int       m_iMaxDeltaQP;                      //  Max. absolute delta QP (1:default)
@@ -547,6 +550,10 @@ protected:
   bool      m_singleSlicePerSubPicFlag;
   bool      m_entropyCodingSyncEnabledFlag;
   bool      m_entryPointPresentFlag;                           ///< flag for the presence of entry points
+  int       m_numWppThreads;                                   ///< number of threads used for wavefront parallel CTU row encoding
+  bool      m_ensureWppBitEqual;                               ///< reset CTU-order dependent encoder state at CTU row starts
+  int       m_numFrameThreads;                                 ///< number of pictures of a GOP encoded in parallel
+  int       m_numSplitThreads;                                 ///< number of threads evaluating the split candidates of a CU in parallel
 
   HashType  m_decodedPictureHashSEIType;
   HashType  m_subpicDecodedPictureHashType;
@@ -1269,6 +1276,8 @@ public:
   bool      getAllowDisFracMMVD             ()         const { return m_allowDisFracMMVD; }
   void      setUseHashME                    ( bool b )       { m_HashME = b; }
   bool      getUseHashME                    ()         const { return m_HashME; }
+  void      setUseHashMEIncremental         ( bool b )       { m_HashMEIncremental = b; }
+  bool      getUseHashMEIncremental         ()         const { return m_HashMEIncremental; }
   void      setUseAffineAmvr                ( bool b )       { m_AffineAmvr = b;    }
   bool      getUseAffineAmvr                ()         const { return m_AffineAmvr; }
   void      setUseAffineAmvrEncOpt          ( bool b )       { m_AffineAmvrEncOpt = b;    }
@@ -1394,6 +1403,8 @@ public:
   void      setFastMEAssumingSmootherMVEnabled ( bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   void      setMinSearchWindow              ( int   i )      { m_minSearchWindow = i; }
   void      setRestrictMESampling           ( bool  b )      { m_bRestrictMESampling = b; }
+  void      setUseHierarchicalME            ( bool  b )      { m_hierarchicalME = b; }
+  void      setUseMotionSearchCache         ( bool  b )      { m_motionSearchCache = b; }
 
   //====== Quality control ========
   void      setMaxDeltaQP                   ( int   i )      { m_iMaxDeltaQP = i; }
@@ -1534,6 +1545,8 @@ public:
   bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
   int       getMinSearchWindow                 () const { return m_minSearchWindow; }
   bool      getRestrictMESampling              () const { return m_bRestrictMESampling; }
+  bool      getUseHierarchicalME               () const { return m_hierarchicalME; }
+  bool      getUseMotionSearchCache            () const { return m_motionSearchCache; }
 
   //==== Quality control ========
   int       getMaxDeltaQP                   () const { return m_iMaxDeltaQP; }
@@ -1671,6 +1684,14 @@ public:
   void  setEntropyCodingSyncEnabledFlag(bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
   void  setEntryPointPresentFlag(bool b)                             { m_entryPointPresentFlag = b; }
+  void  setNumWppThreads(int n)                                      { m_numWppThreads = n; }
+  int   getNumWppThreads() const                                     { return m_numWppThreads; }
+  void  setEnsureWppBitEqual(bool b)                                 { m_ensureWppBitEqual = b; }
+  bool  getEnsureWppBitEqual() const                                 { return m_ensureWppBitEqual; }
+  void  setNumFrameThreads(int n)                                    { m_numFrameThreads = n; }
+  int   getNumFrameThreads() const                                   { return m_numFrameThreads; }
+  void  setNumSplitThreads(int n)                                    { m_numSplitThreads = n; }
+  int   getNumSplitThreads() const                                   { return m_numSplitThreads; }
   void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   void  setSubpicDecodedPictureHashType(HashType m)                  { m_subpicDecodedPictureHashType = m; }
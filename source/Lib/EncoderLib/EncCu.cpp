@@ -227,19 +227,43 @@ EncCu::~EncCu()
 
 /** \param    pcEncLib      pointer of encoder class
  */
-void EncCu::init( EncLib* pcEncLib, const SPS& sps )
+void EncCu::init( EncLib* pcEncLib, const SPS& sps, int jId )
 {
   m_pcEncCfg           = pcEncLib;
-  m_pcIntraSearch      = pcEncLib->getIntraSearch();
-  m_pcInterSearch      = pcEncLib->getInterSearch();
-  m_pcTrQuant          = pcEncLib->getTrQuant();
-  m_pcRdCost           = pcEncLib->getRdCost ();
-  m_CABACEstimator     = pcEncLib->getCABACEncoder()->getCABACEstimator( &sps );
+  m_pcIntraSearch      = pcEncLib->getIntraSearch( jId );
+  m_pcInterSearch      = pcEncLib->getInterSearch( jId );
+  m_pcTrQuant          = pcEncLib->getTrQuant( jId );
+  m_pcRdCost           = pcEncLib->getRdCost( jId );
+  m_CABACEstimator     = pcEncLib->getCABACEncoder( jId )->getCABACEstimator( &sps );
   m_CABACEstimator->setEncCu(this);
-  m_CtxCache           = pcEncLib->getCtxCache();
+  m_CtxCache           = pcEncLib->getCtxCache( jId );
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
-  m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
-  m_deblockingFilter   = pcEncLib->getDeblockingFilter();
+  // the instances jId of a frame lane share its slice encoder and the IBC hash map of its first instance,
+  // the instances of the parallel split jobs belong to the single frame lane
+  const bool isSplitJob = jId >= pcEncLib->getNumWppThreads() * pcEncLib->getNumFrameThreads();
+  const int lId        = isSplitJob ? 0 : jId / pcEncLib->getNumWppThreads();
+  m_pcSliceEncoder     = pcEncLib->getSliceEncoder( lId );
+  m_deblockingFilter   = pcEncLib->getDeblockingFilter( jId );
+  m_pcIbcHashMap       = &pcEncLib->getCuEncoder( lId * pcEncLib->getNumWppThreads() )->getIbcHashMap();
+  m_wppCommitMutex     = nullptr;
+  m_wppMotionLut       = nullptr;
+  m_wppPrevPLT         = nullptr;
+  m_inSplitJob         = isSplitJob;
+  m_splitThreadPool    = nullptr;
+  m_splitJobCu.clear();
+  if( isSplitJob )
+  {
+    // a split job may temporarily add units to the picture (local dual tree) while the other ones read it
+    m_wppCommitMutex   = pcEncLib->getSplitCommitMutex();
+  }
+  else if( jId == 0 && pcEncLib->getNumSplitThreads() > 1 )
+  {
+    for( int jobId = 1; jobId <= PARL_SPLIT_MAX_NUM_JOBS; jobId++ )
+    {
+      m_splitJobCu.push_back( pcEncLib->getCuEncoder( pcEncLib->getSplitJobCtxId( jobId ) ) );
+    }
+    m_splitThreadPool  = pcEncLib->getSplitThreadPool();
+  }
   m_GeoCostList.init(GEO_NUM_PARTITION_MODE, m_pcEncCfg->getMaxNumGeoCand());
   m_AFFBestSATDCost = MAX_DOUBLE;
 
@@ -261,11 +285,28 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   m_modeCtrl->initCTUEncoding( *cs.slice );
   cs.treeType = TREE_D;
 
-  cs.slice->m_mapPltCost[0].clear();
-  cs.slice->m_mapPltCost[1].clear();
+  m_modeCtrl->resetPltCost();
   // init the partitioning manager
   QTBTPartitioner partitioner;
   partitioner.initCtu(area, CH_L, *cs.slice);
+  for( EncCu* jobCu : m_splitJobCu )
+  {
+    jobCu->m_modeCtrl->initCTUEncoding( *cs.slice );
+    jobCu->m_modeCtrl->resetPltCost();
+    if( !cs.slice->isIntra() && ( cs.sps->getUseSBT() || cs.sps->getExplicitMtsInterEnabled() ) )
+    {
+      const int maxSLSize = cs.sps->getUseSBT() ? cs.sps->getMaxTbSize() : MTS_INTER_MAX_CU_SIZE;
+      dynamic_cast<SaveLoadEncInfoSbt*>( jobCu->m_modeCtrl )->resetSaveloadSbt( maxSLSize );
+    }
+  }
+  if( m_pcEncCfg->getUseMotionSearchCache() )
+  {
+    m_pcInterSearch->resetMeCache();
+    for( EncCu* jobCu : m_splitJobCu )
+    {
+      jobCu->m_pcInterSearch->resetMeCache();
+    }
+  }
   if (m_pcEncCfg->getIBCMode())
   {
     if (area.lx() == 0 && area.ly() == 0)
@@ -278,7 +319,7 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   }
   if (m_pcEncCfg->getIBCMode() && m_pcEncCfg->getIBCHashSearch() && (m_pcEncCfg->getIBCFastMethod() & IBC_FAST_METHOD_ADAPTIVE_SEARCHRANGE))
   {
-    const int hashHitRatio = m_ibcHashMap.getHashHitRatio(area.Y()); // in percent
+    const int hashHitRatio = m_pcIbcHashMap->getHashHitRatio(area.Y()); // in percent
     if (hashHitRatio < 5) // 5%
     {
       m_ctuIbcSearchRangeX >>= 1;
@@ -296,19 +337,27 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   CodingStructure *tempCS = m_pTempCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
   CodingStructure *bestCS = m_pBestCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
 
-  cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
-  cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+  {
+    std::unique_lock<std::mutex> commitLock = xLockWppCommit();
+    cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
+    cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+    xLoadWppRowState(*tempCS);
+    xLoadWppRowState(*bestCS);
+  }
   tempCS->currQP[CH_L] = bestCS->currQP[CH_L] =
   tempCS->baseQP       = bestCS->baseQP       = currQP[CH_L];
   tempCS->prevQP[CH_L] = bestCS->prevQP[CH_L] = prevQP[CH_L];
 
   xCompressCU(tempCS, bestCS, partitioner);
-  cs.slice->m_mapPltCost[0].clear();
-  cs.slice->m_mapPltCost[1].clear();
+  m_modeCtrl->resetPltCost();
   // all signals were already copied during compression if the CTU was split - at this point only the structures are copied to the top level CS
   const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
-  cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType), copyUnsplitCTUSignals,
-                     false, false, copyUnsplitCTUSignals, true);
+  {
+    std::unique_lock<std::mutex> commitLock = xLockWppCommit();
+    cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType), copyUnsplitCTUSignals,
+                       false, false, copyUnsplitCTUSignals, true);
+    xStoreWppRowState(*bestCS, partitioner.chType);
+  }
 
   if (CS::isDualITree (cs) && isChromaEnabled (cs.pcv->chrFormat))
   {
@@ -316,8 +365,13 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
 
     partitioner.initCtu(area, CH_C, *cs.slice);
 
-    cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
-    cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+    {
+      std::unique_lock<std::mutex> commitLock = xLockWppCommit();
+      cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
+      cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+      xLoadWppRowState(*tempCS);
+      xLoadWppRowState(*bestCS);
+    }
     tempCS->currQP[CH_C] = bestCS->currQP[CH_C] =
     tempCS->baseQP       = bestCS->baseQP       = currQP[CH_C];
     tempCS->prevQP[CH_C] = bestCS->prevQP[CH_C] = prevQP[CH_C];
@@ -325,8 +379,10 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
     xCompressCU(tempCS, bestCS, partitioner);
 
     const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
+    std::unique_lock<std::mutex> commitLock = xLockWppCommit();
     cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType),
                        copyUnsplitCTUSignals, false, false, copyUnsplitCTUSignals, true);
+    xStoreWppRowState(*bestCS, partitioner.chType);
   }
 
   if (m_pcEncCfg->getUseRateCtrl())
@@ -349,6 +405,33 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
 // Protected member functions
 // ====================================================================================================================
 
+std::unique_lock<std::mutex> EncCu::xLockWppCommit()
+{
+  return m_wppCommitMutex ? std::unique_lock<std::mutex>( *m_wppCommitMutex ) : std::unique_lock<std::mutex>();
+}
+
+void EncCu::xLoadWppRowState( CodingStructure &cs )
+{
+  if( m_wppMotionLut )
+  {
+    cs.motionLut = *m_wppMotionLut;
+    cs.prevPLT   = *m_wppPrevPLT;
+  }
+}
+
+void EncCu::xStoreWppRowState( const CodingStructure &cs, const ChannelType chType )
+{
+  if( m_wppMotionLut )
+  {
+    // same condition as for the update of the HMVP table in CodingStructure::useSubStructure
+    if( ( !cs.slice->isIntra() || cs.slice->getSPS()->getIBCFlag() ) && chType != CHANNEL_TYPE_CHROMA )
+    {
+      *m_wppMotionLut = cs.motionLut;
+    }
+    *m_wppPrevPLT = cs.prevPLT;
+  }
+}
+
 static int xCalcHADs8x8_ISlice(const Pel *piOrg, const int iStrideOrg)
 {
   int k, i, j, jj;
@@ -673,6 +756,18 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     return;
   }
 
+  // the candidates of large CUs are evaluated in parallel, one job per split type and one for the non-split modes
+  if( !m_splitJobCu.empty() && partitioner.getImplicitSplit( *tempCS ) == CU_DONT_SPLIT
+      && std::min( tempCS->area.lwidth(), tempCS->area.lheight() ) >= PARL_SPLIT_MIN_SIZE && !m_pcIntraSearch->getSaveCuCostInSCIPU() )
+  {
+    const unsigned jobClasses = m_modeCtrl->getSplitJobClasses();
+    if( jobClasses & ( jobClasses - 1 ) )
+    {
+      xCompressCUParallel( tempCS, bestCS, partitioner, maxCostAllowed, jobClasses );
+      return;
+    }
+  }
+
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "cux", uiLPelX ) );
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "cuy", uiTPelY ) );
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "cuw", tempCS->area.lwidth() ) );
@@ -1026,6 +1121,139 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
   CHECK( bestCS->cost             == MAX_DOUBLE                , "No possible encoding found" );
 }
 
+/** evaluate the candidates of a CU in parallel jobs, one for each class of modes (see getSplitJobClass)
+ * each job runs on its own encoder instance and picture buffers (PARL_SPLIT_MAX_NUM_JOBS additional sets of picture sized
+ * reconstruction and CTU sized prediction and residual buffers for the picture being encoded)
+ * the result does not depend on the number of threads, it differs from the sequential mode decision as the fast decisions
+ * of a class cannot see the results of the other classes (enabled with AllowNonIdenticalSplitSearch only)
+ */
+void EncCu::xCompressCUParallel( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& partitioner, const double maxCostAllowed, const unsigned jobClasses )
+{
+  Picture&          picture    = *tempCS->picture;
+  const ChannelType chType     = partitioner.chType;
+  const UnitArea    currCsArea = clipArea( CS::getArea( *bestCS, bestCS->area, chType ), picture );
+  const unsigned    wIdx       = gp_sizeIdxInfo->idxFrom( tempCS->area.lwidth() );
+  const unsigned    hIdx       = gp_sizeIdxInfo->idxFrom( tempCS->area.lheight() );
+  const int         ctxOffset  = int( m_CurrCtx - m_CtxBuffer.data() );
+
+  // the modes are tested by the jobs, which restart from the ancestor CU levels
+  m_modeCtrl->finishCULevel( partitioner );
+
+  // the jobs predict from the reconstructed neighbourhood of the CU in their own picture buffers
+  const Area&    lumaArea = tempCS->area.Y();
+  const Position syncPos( std::max( 0, lumaArea.x - 8 ), std::max( 0, lumaArea.y - 8 ) );
+  const int      syncEndX = std::min<int>( picture.lwidth(),  lumaArea.x + 2 * lumaArea.width  );
+  const int      syncEndY = std::min<int>( picture.lheight(), lumaArea.y + 2 * lumaArea.height );
+  const UnitArea syncArea( tempCS->area.chromaFormat, Area( syncPos, Size( syncEndX - syncPos.x, syncEndY - syncPos.y ) ) );
+
+  CodingStructure* jobTempCS[PARL_SPLIT_MAX_NUM_JOBS];
+  CodingStructure* jobBestCS[PARL_SPLIT_MAX_NUM_JOBS];
+  QTBTPartitioner  jobPartitioner[PARL_SPLIT_MAX_NUM_JOBS];
+
+  for( int c = 0; c < PARL_SPLIT_MAX_NUM_JOBS; c++ )
+  {
+    if( !( jobClasses & ( 1u << c ) ) )
+    {
+      continue;
+    }
+    EncCu& jobCu = *m_splitJobCu[c];
+
+    picture.copyRecoToSplitBuffer( c + 1, syncArea );
+
+    jobTempCS[c] = jobCu.m_pTempCS[wIdx][hIdx];
+    jobBestCS[c] = jobCu.m_pBestCS[wIdx][hIdx];
+    for( int i = 0; i < 2; i++ )
+    {
+      CodingStructure& jobCS = i ? *jobBestCS[c] : *jobTempCS[c];
+      const CodingStructure& cs = i ? *bestCS : *tempCS;
+
+      tempCS->parent->initSubStructure( jobCS, chType, partitioner.currArea(), false );
+      jobCS.baseQP         = cs.baseQP;
+      jobCS.prevQP[chType] = cs.prevQP[chType];
+      jobCS.currQP[CH_L]   = cs.currQP[CH_L];
+      jobCS.currQP[CH_C]   = cs.currQP[CH_C];
+      jobCS.motionLut      = cs.motionLut;
+      jobCS.prevPLT        = cs.prevPLT;
+      jobCS.bestParent     = cs.bestParent;
+      jobCS.treeType       = cs.treeType;
+      jobCS.modeType       = cs.modeType;
+    }
+
+    jobCu.m_CABACEstimator->getCtx()   = m_CABACEstimator->getCtx();
+    jobCu.m_CurrCtx                    = jobCu.m_CtxBuffer.data() + ctxOffset;
+    jobCu.m_cuChromaQpOffsetIdxPlus1   = m_cuChromaQpOffsetIdxPlus1;
+    jobCu.m_modeCtrl->initSplitJob( *m_modeCtrl, c );
+
+    jobPartitioner[c].copyState( partitioner );
+    jobPartitioner[c].treeType = partitioner.treeType;
+    jobPartitioner[c].modeType = partitioner.modeType;
+  }
+
+  for( int c = 0; c < PARL_SPLIT_MAX_NUM_JOBS; c++ )
+  {
+    if( !( jobClasses & ( 1u << c ) ) )
+    {
+      continue;
+    }
+    m_splitThreadPool->addJob( [this, c, &jobTempCS, &jobBestCS, &jobPartitioner, maxCostAllowed]( int )
+    {
+      EncCu& jobCu = *m_splitJobCu[c];
+
+      Picture::setSplitJobId( c + 1 );
+      try
+      {
+        jobCu.xCompressCU( jobTempCS[c], jobBestCS[c], jobPartitioner[c], maxCostAllowed );
+      }
+      catch( ... )
+      {
+        jobCu.m_modeCtrl->finishSplitJob();
+        Picture::setSplitJobId( 0 );
+        throw;
+      }
+      jobCu.m_modeCtrl->finishSplitJob();
+      Picture::setSplitJobId( 0 );
+    } );
+  }
+  m_splitThreadPool->waitForJobs();
+
+  // take the best candidate, the lower class on equal costs
+  int bestClass = -1;
+  for( int c = 0; c < PARL_SPLIT_MAX_NUM_JOBS; c++ )
+  {
+    if( ( jobClasses & ( 1u << c ) ) && jobBestCS[c]->cost < MAX_DOUBLE && ( bestClass < 0 || jobBestCS[c]->cost < jobBestCS[bestClass]->cost ) )
+    {
+      bestClass = c;
+    }
+  }
+
+  if( bestClass < 0 )
+  {
+    // no candidate finished encoding due to early termination
+    m_CABACEstimator->getCtx() = m_CurrCtx->start;
+    return;
+  }
+
+  const CodingStructure& jobBest = *jobBestCS[bestClass];
+
+  bestCS->copyStructure( jobBest, chType, true, false );
+  bestCS->prevQP[chType] = jobBest.prevQP[chType];
+  bestCS->currQP[CH_L]   = jobBest.currQP[CH_L];
+  bestCS->currQP[CH_C]   = jobBest.currQP[CH_C];
+  bestCS->lumaCost       = jobBest.lumaCost;
+  bestCS->interHad       = jobBest.interHad;
+  bestCS->useDbCost      = jobBest.useDbCost;
+  bestCS->features       = jobBest.features;
+
+  bestCS->getRecoBuf( currCsArea ).copyFrom( jobBest.getRecoBuf( currCsArea ) );
+  bestCS->getPredBuf( currCsArea ).copyFrom( jobBest.getPredBuf( currCsArea ) );
+  bestCS->getResiBuf( currCsArea ).copyFrom( jobBest.getResiBuf( currCsArea ) );
+  picture.getPredBuf( currCsArea ).copyFrom( bestCS->getPredBuf( currCsArea ) );
+  picture.getRecoBuf( currCsArea ).copyFrom( bestCS->getRecoBuf( currCsArea ) );
+
+  m_CurrCtx->best            = m_splitJobCu[bestClass]->m_CABACEstimator->getCtx();
+  m_CABACEstimator->getCtx() = m_CurrCtx->best;
+}
+
 #if SHARP_LUMA_DELTA_QP || ENABLE_QPA_SUB_CTU
 void EncCu::updateLambda (Slice* slice, const int dQP,
  #if WCG_EXT && ER_CHROMA_QP_WCG_PPS
@@ -1318,6 +1546,8 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       }
     }
     assert( tempCS->treeType == TREE_L );
+    // the luma CUs are temporarily added to the picture, no other CTU row may commit until they are removed
+    std::unique_lock<std::mutex> commitLock = xLockWppCommit();
     uint32_t numCuPuTu[6];
     tempCS->picture->cs->getNumCuPuTuOffset( numCuPuTu );
     tempCS->picture->cs->useSubStructure( *tempCS, partitioner.chType, CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType ), false, true, false, false, false );
@@ -1353,6 +1583,10 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       m_CurrCtx--;
     }
     tempCS->picture->cs->clearCuPuTuIdxMap( partitioner.currArea(), numCuPuTu[0], numCuPuTu[1], numCuPuTu[2], numCuPuTu + 3 );
+    if( commitLock.owns_lock() )
+    {
+      commitLock.unlock();
+    }
 
 
     //recover luma tree status
@@ -1934,7 +2168,7 @@ void EncCu::xCheckPLT(CodingStructure *&tempCS, CodingStructure *&bestCS, Partit
   tempCS->useDbCost = m_pcEncCfg->getUseEncDbOpt();
 
   const Area currCuArea = cu.block(getFirstComponentOfChannel(partitioner.chType));
-  cu.slice->m_mapPltCost[isChroma(partitioner.chType)][currCuArea.pos()][currCuArea.size()] = tempCS->cost;
+  m_modeCtrl->setPltCost( partitioner.chType, currCuArea, tempCS->cost );
 #if WCG_EXT
   DTRACE_MODE_COST(*tempCS, m_pcRdCost->getLambda(true));
 #else
@@ -2489,6 +2723,7 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
         cu.mmvdSkip = true;
         pu.regularMergeFlag = true;
         const int tempNum = (mergeCtx.numValidMergeCand > 1) ? MMVD_ADD_NUM : MMVD_ADD_NUM >> 1;
+        m_pcInterSearch->resetMcWindows();
         for (int mmvdMergeCand = 0; mmvdMergeCand < tempNum; mmvdMergeCand++)
         {
           int baseIdx = mmvdMergeCand / MMVD_MAX_REFINE_NUM;
@@ -2509,6 +2744,22 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
 #endif
           mergeCtx.setMmvdMergeCandiInfo(pu, mmvdMergeCand);
 
+          // candidates with integer-pel offsets to their base share its interpolation
+          bool intOffset = true;
+          for (int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++)
+          {
+            const Mv offset = pu.mv[refList] - mergeCtx.mmvdBaseMv[baseIdx][refList].mv;
+            intOffset &= pu.refIdx[refList] < 0 || ((offset.hor | offset.ver) & ((1 << MV_FRACTIONAL_BITS_INTERNAL) - 1)) == 0;
+          }
+          if (intOffset)
+          {
+            m_pcInterSearch->enableMcWindows(pu, mergeCtx.mmvdBaseMv[baseIdx]);
+          }
+          else
+          {
+            m_pcInterSearch->disableMcWindows();
+          }
+
           PU::spanMotionInfo(pu, mergeCtx);
           pu.mvRefine = true;
           distParam.cur = singleMergeTempBuffer->Y();
@@ -2559,6 +2810,7 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
             swap(singleMergeTempBuffer, acMergeTempBuffer[insertPos]);
           }
         }
+        m_pcInterSearch->disableMcWindows();
       }
       // Try to limit number of candidates using SATD-costs
       for( uint32_t i = 1; i < uiNumMrgSATDCand; i++ )
@@ -4011,7 +4263,7 @@ void EncCu::xCheckRDCostIBCMode(CodingStructure *&tempCS, CodingStructure *&best
   pu.interDir               = 1;             // use list 0 for IBC mode
   pu.refIdx[REF_PIC_LIST_0] = MAX_NUM_REF;   // last idx in the list
   bool bValid =
-    m_pcInterSearch->predIBCSearch(cu, partitioner, m_ctuIbcSearchRangeX, m_ctuIbcSearchRangeY, m_ibcHashMap);
+    m_pcInterSearch->predIBCSearch(cu, partitioner, m_ctuIbcSearchRangeX, m_ctuIbcSearchRangeY, *m_pcIbcHashMap);
 
   if (bValid)
   {
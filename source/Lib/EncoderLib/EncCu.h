@@ -47,6 +47,7 @@
 #include "CommonLib/UnitPartitioner.h"
 #include "CommonLib/IbcHashMap.h"
 #include "CommonLib/DeblockingFilter.h"
+#include "CommonLib/ThreadPool.h"
 
 #include "DecoderLib/DecCu.h"
 
@@ -55,6 +56,8 @@
 #include "InterSearch.h"
 #include "RateCtrl.h"
 #include "EncModeCtrl.h"
+
+#include <mutex>
 //! \ingroup EncoderLib
 //! \{
 
@@ -184,8 +187,17 @@ private:
   CABACWriter*          m_CABACEstimator;
   RateCtrl*             m_pcRateCtrl;
   IbcHashMap            m_ibcHashMap;
+  IbcHashMap*           m_pcIbcHashMap;                     ///< picture hash map, owned by the encoder of the first WPP thread
   EncModeCtrl          *m_modeCtrl;
 
+  std::mutex*           m_wppCommitMutex;                   ///< guards the picture CodingStructure when CTU rows are encoded in parallel
+  LutMotionCand*        m_wppMotionLut;                     ///< HMVP table of the CTU row, replaces the picture level one
+  PLTBuf*               m_wppPrevPLT;                       ///< palette predictor of the CTU row, replaces the picture level one
+
+  std::vector<EncCu*>   m_splitJobCu;                       ///< encoders of the parallel split jobs, empty for a sequential mode decision
+  ThreadPool*           m_splitThreadPool;                  ///< worker threads running the parallel split jobs
+  bool                  m_inSplitJob;                       ///< this encoder evaluates one class of modes of a parallel split job
+
   PelStorage            m_acMergeBuffer[MMVD_MRG_MAX_RD_BUF_NUM];
   PelStorage            m_acRealMergeBuffer[MRG_MAX_NUM_CANDS];
   PelStorage            m_acMergeTmpBuffer[MRG_MAX_NUM_CANDS];
@@ -210,7 +222,9 @@ private:
   double                m_sbtCostSave[2];
 public:
   /// copy parameters from encoder class
-  void  init                ( EncLib* pcEncLib, const SPS& sps );
+  void  init                ( EncLib* pcEncLib, const SPS& sps, int jId = 0 );
+  /// set the CTU row state used for wavefront parallel encoding, all nullptr for sequential encoding
+  void  setWppRowState      ( std::mutex* commitMutex, LutMotionCand* motionLut, PLTBuf* prevPLT ) { m_wppCommitMutex = commitMutex; m_wppMotionLut = motionLut; m_wppPrevPLT = prevPLT; }
 
   void setDecCuReshaperInEncCU(EncReshape* pcReshape, ChromaFormat chromaFormatIDC) { initDecCuReshaper((Reshape*) pcReshape, chromaFormatIDC); }
   /// create internal buffers
@@ -239,10 +253,16 @@ public:
 
 protected:
 
+  std::unique_lock<std::mutex>
+       xLockWppCommit         ();
+  void xLoadWppRowState       ( CodingStructure &cs );
+  void xStoreWppRowState      ( const CodingStructure &cs, const ChannelType chType );
+
   void xCalDebCost            ( CodingStructure &cs, Partitioner &partitioner, bool calDist = false );
   Distortion getDistortionDb  ( CodingStructure &cs, CPelBuf org, CPelBuf reco, ComponentID compID, const CompArea& compArea, bool afterDb );
 
   void xCompressCU            ( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& pm, double maxCostAllowed = MAX_DOUBLE );
+  void xCompressCUParallel    ( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& pm, double maxCostAllowed, const unsigned jobClasses );
 
   bool
     xCheckBestMode         ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestmode );
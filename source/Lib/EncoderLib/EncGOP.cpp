@@ -144,6 +144,13 @@ EncGOP::EncGOP()
   m_lastLTRefPoc = 0;
   m_cnt_right_bottom = 0;
   m_cnt_right_bottom_i = 0;
+
+  m_frameSetupIdx    = 0;
+  m_frameFinishIdx   = 0;
+  m_frameBatchStart  = 0;
+  m_frameBatchClosed = true;
+  m_frameAbort       = false;
+  m_laneCtxId        = 0;
 }
 
 EncGOP::~EncGOP()
@@ -1798,6 +1805,27 @@ void trySkipOrDecodePicture( bool& decPic, bool& encPic, const EncCfg& cfg, Pict
   }
 }
 
+void EncGOP::xPicInitMePyramid( Slice *slice )
+{
+  if( !m_pcCfg->getUseHierarchicalME() )
+  {
+    return;
+  }
+
+  // the references are complete, the pyramid is built once and kept until the picture buffer is reused
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    for( int refIdx = 0; refIdx < slice->getNumRefIdx( RefPicList( l ) ); refIdx++ )
+    {
+      Picture* refPic = slice->getRefPic( RefPicList( l ), refIdx );
+      if( !refPic->hasMePyramid() )
+      {
+        refPic->buildMePyramid();
+      }
+    }
+  }
+}
+
 void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
 {
   if (! m_pcCfg->getUseHashME())
@@ -1810,7 +1838,9 @@ void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
   {
     Picture* refPic = *(iterPic++);
 
-    if (refPic->poc != pic->poc && refPic->referenced)
+    // pictures encoded in parallel are still being modified
+    const bool inFlight = std::find( m_frameBatchPOCs.begin(), m_frameBatchPOCs.end(), refPic->poc ) != m_frameBatchPOCs.end();
+    if (refPic->poc != pic->poc && refPic->referenced && !inFlight)
     {
       if (!refPic->getHashMap()->isInitial())
       {
@@ -1864,10 +1894,111 @@ void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
             break;
           }
         }
-        refPic->addPictureToHashMapForInter();
+        refPic->addPictureToHashMapForInter( m_pcCfg->getUseHashMEIncremental() ? &m_hashPyramid : nullptr );
+      }
+    }
+  }
+}
+
+/** wait until the picture may start its setup stage and assign it to a frame lane
+ * The picture joins the batch of pictures encoded in parallel if it does not reference any of them,
+ * otherwise it waits until the batch is finished and starts a new one.
+ * \param picIdInGOP  index of the picture within the GOP in coding order
+ * \returns frame lane of the picture
+ */
+int EncGOP::xWaitForPicSetup( int picIdInGOP )
+{
+  std::unique_lock<std::mutex> lock( m_frameMutex );
+  if( picIdInGOP == 0 )
+  {
+    // all pictures of the previous GOP are finished
+    m_frameSetupIdx    = 0;
+    m_frameFinishIdx   = 0;
+    m_frameBatchStart  = 0;
+    m_frameBatchClosed = true;
+    m_frameBatchGOPIds.clear();
+    m_frameBatchPOCs.clear();
+  }
+  m_frameCond.wait( lock, [&] { return m_frameAbort || m_frameSetupIdx == picIdInGOP; } );
+  CHECK( m_frameAbort, "Encoding of a picture in parallel failed" );
+
+  bool joinBatch = !m_frameBatchClosed && (int) m_frameBatchGOPIds.size() < m_pcCfg->getNumFrameThreads()
+                && !m_pcCfg->getUseRateCtrl() && m_pcCfg->getGOPEntry( picIdInGOP ).m_sliceType != 'I';
+  for( int l = 0; l < 2 && joinBatch; l++ )
+  {
+    const RPLEntry &rplEntry = m_pcCfg->getRPLEntry( l, picIdInGOP );
+    for( int i = 0; i < rplEntry.m_numRefPics && joinBatch; i++ )
+    {
+      const int refPOC = rplEntry.m_POC - rplEntry.m_deltaRefPics[i];
+      for( int gopId : m_frameBatchGOPIds )
+      {
+        joinBatch &= m_pcCfg->getGOPEntry( gopId ).m_POC != refPOC;
       }
     }
   }
+
+  if( !joinBatch )
+  {
+    m_frameBatchClosed = true;
+    m_frameCond.notify_all();
+    const int batchEnd = m_frameBatchStart + (int) m_frameBatchGOPIds.size();
+    m_frameCond.wait( lock, [&] { return m_frameAbort || m_frameFinishIdx == batchEnd; } );
+    CHECK( m_frameAbort, "Encoding of a picture in parallel failed" );
+
+    m_frameBatchStart  = picIdInGOP;
+    m_frameBatchClosed = false;
+    m_frameBatchGOPIds.clear();
+    m_frameBatchPOCs.clear();
+  }
+  m_frameBatchGOPIds.push_back( picIdInGOP );
+
+  return (int) m_frameBatchGOPIds.size() - 1;
+}
+
+/** end of the setup stage of a picture, the next picture may start its setup
+ * \param picIdInGOP  index of the picture within the GOP in coding order
+ * \param pocCurr     POC of the picture
+ * \param closeBatch  no further pictures may join the batch of the picture
+ */
+void EncGOP::xPicSetupDone( int picIdInGOP, int pocCurr, bool closeBatch )
+{
+  std::unique_lock<std::mutex> lock( m_frameMutex );
+  m_frameBatchPOCs.push_back( pocCurr );
+  m_frameSetupIdx = picIdInGOP + 1;
+  if( closeBatch || (int) m_frameBatchGOPIds.size() == m_pcCfg->getNumFrameThreads() || m_frameSetupIdx == m_iGopSize )
+  {
+    m_frameBatchClosed = true;
+  }
+  m_frameCond.notify_all();
+}
+
+/** wait until the picture may start its finishing stage (loop filters, writing, metrics)
+ * \param picIdInGOP  index of the picture within the GOP in coding order
+ */
+void EncGOP::xWaitForPicFinish( int picIdInGOP )
+{
+  std::unique_lock<std::mutex> lock( m_frameMutex );
+  m_frameCond.wait( lock, [&] { return m_frameAbort || ( m_frameBatchClosed && m_frameFinishIdx == picIdInGOP ); } );
+  CHECK( m_frameAbort, "Encoding of a picture in parallel failed" );
+}
+
+/** end of the finishing stage of a picture
+ * \param picIdInGOP  index of the picture within the GOP in coding order
+ */
+void EncGOP::xPicFinishDone( int picIdInGOP )
+{
+  std::unique_lock<std::mutex> lock( m_frameMutex );
+  m_frameFinishIdx = picIdInGOP + 1;
+  m_frameCond.notify_all();
+}
+
+/** release all pictures waiting for their stages after the encoding of a picture failed
+ */
+void EncGOP::abortFrameJobs()
+{
+  std::unique_lock<std::mutex> lock( m_frameMutex );
+  m_frameAbort = true;
+  m_frameCond.notify_all();
 }
 
 void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice)
@@ -2022,14 +2153,14 @@ void EncGOP::xPicInitLMCS(Picture *pic, PicHeader *picHeader, Slice *slice)
       if (m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_PQ)
       {
         m_pcReshaper->initLUTfromdQPModel();
-        m_pcEncLib->getRdCost()->updateReshapeLumaLevelToWeightTableChromaMD(m_pcReshaper->getInvLUT());
+        m_pcEncLib->getRdCost( m_laneCtxId )->updateReshapeLumaLevelToWeightTableChromaMD(m_pcReshaper->getInvLUT());
       }
       else if (m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_SDR || m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_HLG)
       {
         if (m_pcReshaper->getReshapeFlag())
         {
           m_pcReshaper->constructReshaperLMCS();
-          m_pcEncLib->getRdCost()->updateReshapeLumaLevelToWeightTable(m_pcReshaper->getSliceReshaperInfo(), m_pcReshaper->getWeightTable(), m_pcReshaper->getCWeight());
+          m_pcEncLib->getRdCost( m_laneCtxId )->updateReshapeLumaLevelToWeightTable(m_pcReshaper->getSliceReshaperInfo(), m_pcReshaper->getWeightTable(), m_pcReshaper->getCWeight());
         }
       }
       else
@@ -2058,7 +2189,7 @@ void EncGOP::xPicInitLMCS(Picture *pic, PicHeader *picHeader, Slice *slice)
 
       if (m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_PQ)
       {
-        m_pcEncLib->getRdCost()->restoreReshapeLumaLevelToWeightTable();
+        m_pcEncLib->getRdCost( m_laneCtxId )->restoreReshapeLumaLevelToWeightTable();
       }
       else if (m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_SDR || m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_HLG)
       {
@@ -2073,7 +2204,7 @@ void EncGOP::xPicInitLMCS(Picture *pic, PicHeader *picHeader, Slice *slice)
         {
           m_pcReshaper->getSliceReshaperInfo().setSliceReshapeModelPresentFlag(true);
           m_pcReshaper->constructReshaperLMCS();
-          m_pcEncLib->getRdCost()->updateReshapeLumaLevelToWeightTable(m_pcReshaper->getSliceReshaperInfo(), m_pcReshaper->getWeightTable(), m_pcReshaper->getCWeight());
+          m_pcEncLib->getRdCost( m_laneCtxId )->updateReshapeLumaLevelToWeightTable(m_pcReshaper->getSliceReshaperInfo(), m_pcReshaper->getWeightTable(), m_pcReshaper->getCWeight());
         }
       }
       else
@@ -2232,6 +2363,28 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
   AccessUnit::iterator  itLocationToPushSliceHeaderNALU; // used to store location where NALU containing slice header is to be inserted
   Picture* scaledRefPic[MAX_NUM_REF] = {};
 
+  // with frame parallel encoding the setup stage runs in coding order, each picture of a batch uses its own lane
+  const bool  frameParallel = m_pcCfg->getNumFrameThreads() > 1;
+  const int   lane          = frameParallel ? xWaitForPicSetup( picIdInGOP ) : 0;
+  const int   ctxId         = lane * m_pcCfg->getNumWppThreads();
+  EncSlice*   sliceEncoder  = m_pcEncLib->getSliceEncoder( lane );
+  EncReshape* reshaper      = m_pcEncLib->getReshaper( ctxId );
+  m_pcSliceEncoder = sliceEncoder;
+  m_pcReshaper     = reshaper;
+  m_pcLoopFilter   = m_pcEncLib->getDeblockingFilter( ctxId );
+  m_laneCtxId      = ctxId;
+  if( frameParallel )
+  {
+    // continue from the state the previous picture in coding order left after its setup
+    if( m_bFirst )
+    {
+      m_frameReshaper = *m_pcEncLib->getReshaper();
+      m_frameRdCost   = *m_pcEncLib->getRdCost();
+    }
+    *reshaper                       = m_frameReshaper;
+    *m_pcEncLib->getRdCost( ctxId ) = m_frameRdCost;
+  }
+
   xInitGOP( iPOCLast, iNumPicRcvd, isField, isEncodeLtRef );
 
   m_iNumPicCoded = 0;
@@ -2302,6 +2455,12 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       {
         iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
       }
+      if( frameParallel )
+      {
+        xPicSetupDone( picIdInGOP, pocCurr, false );
+        xWaitForPicFinish( picIdInGOP );
+        xPicFinishDone( picIdInGOP );
+      }
       continue;
     }
 
@@ -2356,6 +2515,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     m_pcSliceEncoder->create( picWidth, picHeight, chromaFormatIDC, maxCUWidth, maxCUHeight, maxTotalCUDepth );
 
     pcPic->createTempBuffers( pcPic->cs->pps->pcv->maxCUWidth );
+    if( m_pcCfg->getNumSplitThreads() > 1 )
+    {
+      pcPic->createSplitBuffers( pcPic->cs->pps->pcv->maxCUWidth );
+    }
     pcPic->cs->createCoeffs((bool)pcPic->cs->sps->getPLTMode());
 
     //  Slice data initialization
@@ -2650,6 +2813,17 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
     //  Set reference list
     pcSlice->constructRefPicList(rcListPic);
+    if( frameParallel )
+    {
+      for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+      {
+        for( int refIdx = 0; refIdx < pcSlice->getNumRefIdx( RefPicList( l ) ); refIdx++ )
+        {
+          CHECK( std::find( m_frameBatchPOCs.begin(), m_frameBatchPOCs.end(), pcSlice->getRefPOC( RefPicList( l ), refIdx ) ) != m_frameBatchPOCs.end(),
+                 "Reference picture is encoded in parallel" );
+        }
+      }
+    }
 
     // store sub-picture numbers, sizes, and locations with a picture
     pcSlice->getPic()->subPictures.clear();
@@ -2667,6 +2841,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
 
     xPicInitHashME( pcPic, pcSlice->getPPS(), rcListPic );
+    xPicInitMePyramid( pcSlice );
 
     if( m_pcCfg->getUseAMaxBT() )
     {
@@ -3166,6 +3341,15 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       pcSlice->setReverseLastSigCoeffFlag(m_cnt_right_bottom >= 0);
     }
 
+    if( frameParallel )
+    {
+      // a new LMCS model has to be written before it is used by later pictures
+      const bool newLmcsModel = pcSlice->getSPS()->getUseLmcs() && reshaper->getSliceReshaperInfo().getSliceReshapeModelPresentFlag();
+      m_frameReshaper = *reshaper;
+      m_frameRdCost   = *m_pcEncLib->getRdCost( ctxId );
+      xPicSetupDone( picIdInGOP, pocCurr, pcSlice->isIntra() || newLmcsModel );
+    }
+
     if( encPic )
     // now compress (trial encode) the various slice segments (slices, and dependent slices)
     {
@@ -3266,14 +3450,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
             if (pcSlice->getLmcsEnabledFlag())
             {
-              pcPic->getOrigBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getFwdLUT());
-              m_pcReshaper->setSrcReshaped(true);
-              m_pcReshaper->setRecReshaped(true);
+              pcPic->getOrigBuf(COMPONENT_Y).rspSignal(reshaper->getFwdLUT());
+              reshaper->setSrcReshaped(true);
+              reshaper->setRecReshaped(true);
             }
             else
             {
-              m_pcReshaper->setSrcReshaped(false);
-              m_pcReshaper->setRecReshaped(false);
+              reshaper->setSrcReshaped(false);
+              reshaper->setRecReshaped(false);
             }
           }
         }
@@ -3283,31 +3467,37 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         {
           isLossless = pcPic->losslessSlice(sliceIdx);
         }
-        m_pcSliceEncoder->setLosslessSlice(pcPic, isLossless);
+        sliceEncoder->setLosslessSlice(pcPic, isLossless);
 
         if( pcSlice->getSliceType() != I_SLICE && pcSlice->getRefPic( REF_PIC_LIST_0, 0 )->subPictures.size() > 1 )
         {
           clipMv = clipMvInSubpic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(true);
+          for (int jId = 0; jId < m_pcEncLib->getNumLaneCtxs(); jId++)
+          {
+            m_pcEncLib->getInterSearch(ctxId + jId)->setClipMvInSubPic(true);
+          }
         }
         else
         {
           clipMv = clipMvInPic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(false);
+          for (int jId = 0; jId < m_pcEncLib->getNumLaneCtxs(); jId++)
+          {
+            m_pcEncLib->getInterSearch(ctxId + jId)->setClipMvInSubPic(false);
+          }
         }
 
         if ( pcSlice->isIntra() && (iPOCLast == 0 || m_pcCfg->getIntraPeriod() > 1))
         {
           computeSignalling(pcPic, pcSlice);
         }
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+        sliceEncoder->precompressSlice( pcPic );
+        sliceEncoder->compressSlice   ( pcPic, false, false );
 
         if(sliceIdx < pcPic->cs->pps->getNumSlicesInPic() - 1)
         {
           uint32_t independentSliceIdx = pcSlice->getIndependentSliceIdx();
           pcPic->allocateNewSlice();
-          m_pcSliceEncoder->setSliceSegmentIdx      (uiNumSliceSegments);
+          sliceEncoder->setSliceSegmentIdx      (uiNumSliceSegments);
           // prepare for next slice
           pcSlice = pcPic->slices[uiNumSliceSegments];
           CHECK(!(pcSlice->getPPS() != 0), "Unspecified error");
@@ -3318,7 +3508,21 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
           uiNumSliceSegments++;
         }
       }
+    }
 
+    if( frameParallel )
+    {
+      // loop filters, writing and metrics follow the coding order
+      xWaitForPicFinish( picIdInGOP );
+      m_pcSliceEncoder = sliceEncoder;
+      m_pcReshaper     = reshaper;
+      m_pcLoopFilter   = m_pcEncLib->getDeblockingFilter( ctxId );
+      m_laneCtxId      = ctxId;
+      m_iNumPicCoded   = 0;
+    }
+
+    if( encPic )
+    {
       duData.clear();
 
       CodingStructure& cs = *pcPic->cs;
@@ -3423,10 +3627,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       if( pcSlice->getSPS()->getSAOEnabledFlag() )
       {
         bool sliceEnabled[MAX_NUM_COMPONENT];
-        m_pcSAO->initCABACEstimator( m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice );
+        m_pcSAO->initCABACEstimator( m_pcEncLib->getCABACEncoder( m_laneCtxId ), m_pcEncLib->getCtxCache( m_laneCtxId ), pcSlice );
         m_pcSAO->SAOProcess( cs, sliceEnabled, pcSlice->getLambdas(),
 #if ENABLE_QPA
-                             (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost ()->getChromaWeight() : 0.0),
+                             (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost( m_laneCtxId )->getChromaWeight() : 0.0),
 #endif
                              m_pcCfg->getTestSAODisableAtPictureLevel(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(), m_pcCfg->getSaoCtuBoundary(), m_pcCfg->getSaoGreedyMergeEnc(), m_pcCfg->getSaoTrueOrg() );
         //assign SAO slice header
@@ -3455,10 +3659,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         {
           pcPic->slices[s]->setAlfEnabledFlag(COMPONENT_Y, false);
         }
-        m_pcALF->initCABACEstimator(m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice, m_pcEncLib->getApsMap());
+        m_pcALF->initCABACEstimator(m_pcEncLib->getCABACEncoder(m_laneCtxId), m_pcEncLib->getCtxCache(m_laneCtxId), pcSlice, m_pcEncLib->getApsMap());
         m_pcALF->ALFProcess(cs, pcSlice->getLambdas()
 #if ENABLE_QPA
-          , (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost()->getChromaWeight() : 0.0)
+          , (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost(m_laneCtxId)->getChromaWeight() : 0.0)
 #endif
           , pcPic, uiNumSliceSegments
         );
@@ -3703,6 +3907,8 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         ParameterSetMap<APS> *apsMap = m_pcEncLib->getApsMap();
         APS* aps = apsMap->getPS((apsId << NUM_APS_TYPE_LEN) + LMCS_APS);
         bool writeAPS = aps && apsMap->getChangedFlag((apsId << NUM_APS_TYPE_LEN) + LMCS_APS);
+        // with frame parallel encoding the APS may already carry the model of a later picture of the batch
+        writeAPS &= !frameParallel || m_pcReshaper->getSliceReshaperInfo().getSliceReshapeModelPresentFlag();
 #if GDR_ENABLED // note : insert APS at every GDR picture
         if (aps && apsId >= 0)
         {
@@ -3946,6 +4152,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         {
           uint32_t numBinsCoded = 0;
           m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
+          if( frameParallel )
+          {
+            // the CABAC table selection is followed by the next picture set up on any lane
+            for( int l = 0; l < m_pcCfg->getNumFrameThreads(); l++ )
+            {
+              m_pcEncLib->getSliceEncoder( l )->setEncCABACTableIdx( m_pcSliceEncoder->getEncCABACTableIdx() );
+            }
+          }
           binCountsInNalUnits+=numBinsCoded;
           subPicStats[subpicIdx].numBinsWritten += numBinsCoded;
         }
@@ -4181,8 +4395,13 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
 
     pcPic->destroyTempBuffers();
+    pcPic->destroySplitBuffers();
     pcPic->cs->destroyCoeffs();
     pcPic->cs->releaseIntermediateData();
+    if( frameParallel )
+    {
+      xPicFinishDone( picIdInGOP );
+    }
   } // iGOPid-loop
 
   delete pcBitstreamRedirect;
@@ -4616,7 +4835,7 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
       for (int x = 0; x < pic0.width; x++)
       {
         Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[(x << getComponentScaleX(compID, chfmt))]);
+        double dW = m_pcEncLib->getRdCost(m_laneCtxId)->getWPSNRLumaLevelWeight(pSrcLuma[(x << getComponentScaleX(compID, chfmt))]);
         uiTotalDiffWPSNR += ((dW * (double)iTemp * (double)iTemp)) * (double)(1 >> rshift);
       }
       pSrc0 += pic0.stride;
@@ -4632,7 +4851,7 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
       for (int x = 0; x < pic0.width; x++)
       {
         Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[x << getComponentScaleX(compID, chfmt)]);
+        double dW = m_pcEncLib->getRdCost(m_laneCtxId)->getWPSNRLumaLevelWeight(pSrcLuma[x << getComponentScaleX(compID, chfmt)]);
         uiTotalDiffWPSNR += dW * (double)iTemp * (double)iTemp;
       }
       pSrc0 += pic0.stride;
@@ -61,6 +61,8 @@
 #include "Analyze.h"
 #include "RateCtrl.h"
 #include <vector>
+#include <mutex>
+#include <condition_variable>
 #include "EncHRD.h"
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
@@ -197,6 +199,22 @@ private:
   int                     m_lastGdrIntervalPoc;  
 #endif
 
+  // frame parallel encoding: pictures of a GOP without references among each other form a batch,
+  // setup and finishing of the pictures follow the coding order, one lane of encoder instances per batch member
+  std::mutex              m_frameMutex;                         ///< guards the picture scheduling state
+  std::condition_variable m_frameCond;
+  int                     m_frameSetupIdx;                      ///< next picture of the GOP allowed to start its setup
+  int                     m_frameFinishIdx;                     ///< next picture of the GOP allowed to start its finishing
+  int                     m_frameBatchStart;                    ///< first picture of the current batch
+  std::vector<int>        m_frameBatchGOPIds;                   ///< GOP entries of the pictures in the current batch
+  std::vector<int>        m_frameBatchPOCs;                     ///< POCs of the pictures in the current batch
+  bool                    m_frameBatchClosed;                   ///< no further pictures join the current batch
+  bool                    m_frameAbort;                         ///< a picture job failed, waiting jobs give up
+  int                     m_laneCtxId;                          ///< first encoder instance of the lane in the serial stages
+  EncReshape              m_frameReshaper;                      ///< reshaper state handed from picture to picture
+  RdCost                  m_frameRdCost;                        ///< RD cost state handed from picture to picture
+  TComHashPyramid         m_hashPyramid;                        ///< block hashes of the last picture added to a hash map
+
 #if JVET_O0756_CALCULATE_HDRMETRICS
 
   hdrtoolslib::Frame **m_ppcFrameOrg;
@@ -227,6 +245,7 @@ public:
                       bool isField, bool isTff, const InputColourSpaceConversion snr_conversion, const bool printFrameMSE,
                       bool printMSSSIM, bool isEncodeLtRef, const int picIdInGOP);
   void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, OutputBitstream* pcBitstreamRedirect);
+  void  abortFrameJobs();
 
 
   int   getGOPSize()          { return  m_iGopSize;  }
@@ -285,6 +304,11 @@ protected:
     , bool isEncodeLtRef
   );
   void  xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic );
+  void  xPicInitMePyramid( Slice *slice );
+  int   xWaitForPicSetup  ( int picIdInGOP );
+  void  xPicSetupDone     ( int picIdInGOP, int pocCurr, bool closeBatch );
+  void  xWaitForPicFinish ( int picIdInGOP );
+  void  xPicFinishDone    ( int picIdInGOP );
   void  xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice);
   void  xPicInitLMCS       (Picture *pic, PicHeader *picHeader, Slice *slice);
   void  xGetBuffer        ( PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
@@ -121,6 +121,40 @@ void EncLib::create( const int layerId )
       m_maxCUWidth, m_maxCUHeight, getBitDepth(CHANNEL_TYPE_LUMA), m_RCKeepHierarchicalBit, m_RCUseLCUSeparateModel, m_GOPList);
   }
 
+  for( int jId = 1; jId < getNumEncoderCtxs(); jId++ )
+  {
+    EncWppThreadCtx* threadCtx = new EncWppThreadCtx;
+    m_wppThreadCtx.push_back( threadCtx );
+
+    threadCtx->m_cCuEncoder.create( this );
+    threadCtx->m_deblockingFilter.create( floorLog2( m_maxCUWidth ) - MIN_CU_LOG2 );
+    if( !m_deblockingFilterDisable && m_encDbOpt )
+    {
+      threadCtx->m_deblockingFilter.initEncPicYuvBuffer( m_chromaFormatIDC, Size( getSourceWidth(), getSourceHeight() ), getMaxCUWidth() );
+    }
+  }
+  if( m_numWppThreads > 1 )
+  {
+    m_wppThreadPool.create( m_numWppThreads );
+  }
+  if( m_numSplitThreads > 1 )
+  {
+    m_splitThreadPool.create( m_numSplitThreads );
+  }
+  if( m_numFrameThreads > 1 )
+  {
+    for( int lId = 1; lId < m_numFrameThreads; lId++ )
+    {
+      EncFrameLaneCtx* laneCtx = new EncFrameLaneCtx;
+      m_frameLaneCtx.push_back( laneCtx );
+
+      if( m_numWppThreads > 1 )
+      {
+        laneCtx->m_wppThreadPool.create( m_numWppThreads );
+      }
+    }
+    m_frameThreadPool.create( m_numFrameThreads );
+  }
 }
 
 void EncLib::destroy ()
@@ -141,6 +175,28 @@ void EncLib::destroy ()
   m_cInterSearch.       destroy();
   m_cIntraSearch.       destroy();
 
+  m_frameThreadPool.    destroy();
+  for( auto laneCtx : m_frameLaneCtx )
+  {
+    laneCtx->m_wppThreadPool.destroy();
+    laneCtx->m_cSliceEncoder.destroy();
+    delete laneCtx;
+  }
+  m_frameLaneCtx.clear();
+
+  m_wppThreadPool.      destroy();
+  m_splitThreadPool.    destroy();
+  for( auto threadCtx : m_wppThreadCtx )
+  {
+    threadCtx->m_cCuEncoder.      destroy();
+    threadCtx->m_deblockingFilter.destroy();
+    threadCtx->m_cReshaper.       destroy();
+    threadCtx->m_cInterSearch.    destroy();
+    threadCtx->m_cIntraSearch.    destroy();
+    delete threadCtx;
+  }
+  m_wppThreadCtx.clear();
+
   return;
 }
 
@@ -344,6 +400,49 @@ void EncLib::init(AUWriterIf *auWriterIf)
   // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
   m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
 
+  for( int lId = 1; lId < m_numFrameThreads; lId++ )
+  {
+    getSliceEncoder( lId )->init( this, sps0, lId );
+  }
+
+  // initialize the encoder instances of the additional wavefront parallel processing threads, frame lanes and split jobs
+  for( int jId = 1; jId < getNumEncoderCtxs(); jId++ )
+  {
+    EncWppThreadCtx& threadCtx = *m_wppThreadCtx[jId - 1];
+
+    threadCtx.m_cRdCost.setCostMode( m_costMode );
+    threadCtx.m_cCuEncoder.init( this, sps0, jId );
+    threadCtx.m_cTrQuant.init( nullptr,
+                               1 << m_log2MaxTbSize,
+                               m_useRDOQ,
+                               m_useRDOQTS,
+#if T0196_SELECTIVE_RDOQ
+                               m_useSelectiveRDOQ,
+#endif
+                               true
+    );
+
+    CABACWriter* threadCabacEstimator = threadCtx.m_CABACEncoder.getCABACEstimator( &sps0 );
+    threadCtx.m_cIntraSearch.init( this,
+                                   &threadCtx.m_cTrQuant,
+                                   &threadCtx.m_cRdCost,
+                                   threadCabacEstimator,
+                                   &threadCtx.m_CtxCache, m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize
+                                 , &threadCtx.m_cReshaper
+                                 , sps0.getBitDepth(CHANNEL_TYPE_LUMA)
+    );
+    threadCtx.m_cInterSearch.init( this,
+                                   &threadCtx.m_cTrQuant,
+                                   m_iSearchRange,
+                                   m_bipredSearchRange,
+                                   m_motionEstimationSearchMethod,
+                                   getUseCompositeRef(),
+      m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize, &threadCtx.m_cRdCost, threadCabacEstimator, &threadCtx.m_CtxCache
+                                 , &threadCtx.m_cReshaper
+    );
+    threadCtx.m_cInterSearch.setTempBuffers( threadCtx.m_cIntraSearch.getSplitCSBuf(), threadCtx.m_cIntraSearch.getFullCSBuf(), threadCtx.m_cIntraSearch.getSaveCSBuf() );
+  }
+
   m_iMaxRefPicNum = 0;
 
 #if ER_CHROMA_QP_WCG_PPS
@@ -397,18 +496,24 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
     sps.getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
   };
 
-  Quant* quant = getTrQuant()->getQuant();
-
   if(getUseScalingListId() == SCALING_LIST_OFF)
   {
-    quant->setFlatScalingList(maxLog2TrDynamicRange, sps.getBitDepths());
-    quant->setUseScalingList(false);
+    for( int jId = 0; jId < getNumEncoderCtxs(); jId++ )
+    {
+      Quant* quant = getTrQuant( jId )->getQuant();
+      quant->setFlatScalingList(maxLog2TrDynamicRange, sps.getBitDepths());
+      quant->setUseScalingList(false);
+    }
   }
   else if(getUseScalingListId() == SCALING_LIST_DEFAULT)
   {
     aps.getScalingList().setDefaultScalingList ();
-    quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
-    quant->setUseScalingList(true);
+    for( int jId = 0; jId < getNumEncoderCtxs(); jId++ )
+    {
+      Quant* quant = getTrQuant( jId )->getQuant();
+      quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
+      quant->setUseScalingList(true);
+    }
   }
   else if(getUseScalingListId() == SCALING_LIST_FILE_READ)
   {
@@ -420,8 +525,12 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
       setUseScalingListId( SCALING_LIST_DEFAULT );
     }
     aps.getScalingList().setChromaScalingListPresentFlag((sps.getChromaFormatIdc()!=CHROMA_400));
-    quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
-    quant->setUseScalingList(true);
+    for( int jId = 0; jId < getNumEncoderCtxs(); jId++ )
+    {
+      Quant* quant = getTrQuant( jId )->getQuant();
+      quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
+      quant->setUseScalingList(true);
+    }
 
     sps.setDisableScalingMatrixForLfnstBlks(getDisableScalingMatrixForLfnstBlks());
   }
@@ -666,8 +775,33 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
 bool EncLib::encode( const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut, int& iNumEncoded )
 {
   // compress GOP
-  m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut,
-    false, false, snrCSC, m_printFrameMSE, m_printMSSSIM, false, m_picIdInGOP );
+  if( m_numFrameThreads > 1 )
+  {
+    // the picture is encoded by a frame thread, pictures of the GOP without references among each other run in parallel
+    const int  pocLast      = m_iPOCLast;
+    const int  numPicRcvd   = m_iNumPicRcvd;
+    const int  picIdInGOP   = m_picIdInGOP;
+    const bool printMSE     = m_printFrameMSE;
+    const bool printMSSSIM  = m_printMSSSIM;
+    std::list<PelUnitBuf*>* recBufList = &rcListPicYuvRecOut;
+    m_frameThreadPool.addJob( [=]( int )
+    {
+      try
+      {
+        m_cGOPEncoder.compressGOP( pocLast, numPicRcvd, m_cListPic, *recBufList, false, false, snrCSC, printMSE, printMSSSIM, false, picIdInGOP );
+      }
+      catch( ... )
+      {
+        m_cGOPEncoder.abortFrameJobs();
+        throw;
+      }
+    } );
+  }
+  else
+  {
+    m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut,
+      false, false, snrCSC, m_printFrameMSE, m_printMSSSIM, false, m_picIdInGOP );
+  }
 
   m_picIdInGOP++;
 
@@ -677,6 +811,11 @@ bool EncLib::encode( const InputColourSpaceConversion snrCSC, std::list<PelUnitB
     return true;
   }
 
+  if( m_numFrameThreads > 1 )
+  {
+    m_frameThreadPool.waitForJobs();
+  }
+
 #if JVET_O0756_CALCULATE_HDRMETRICS
   m_metricTime = m_cGOPEncoder.getMetricTime();
 #endif
@@ -925,6 +1064,7 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   rpcPic->reconstructed = false;
   rpcPic->referenced = true;
   rpcPic->getHashMap()->clearAll();
+  rpcPic->invalidateMePyramid();
 
   m_iPOCLast += (m_compositeRefEnabled ? 2 : 1);
   m_iNumPicRcvd++;
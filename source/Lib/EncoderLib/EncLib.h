@@ -42,6 +42,7 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/DeblockingFilter.h"
 #include "CommonLib/NAL.h"
+#include "CommonLib/ThreadPool.h"
 
 #include "Utilities/VideoIOYuv.h"
 
@@ -67,6 +68,27 @@ class EncLibCommon;
 // Class definition
 // ====================================================================================================================
 
+/// encoder instances owned by an additional wavefront parallel processing thread or frame lane
+struct EncWppThreadCtx
+{
+  InterSearch               m_cInterSearch;
+  IntraSearch               m_cIntraSearch;
+  TrQuant                   m_cTrQuant;
+  DeblockingFilter          m_deblockingFilter;
+  CABACEncoder              m_CABACEncoder;
+  EncReshape                m_cReshaper;
+  EncCu                     m_cCuEncoder;
+  RdCost                    m_cRdCost;
+  CtxCache                  m_CtxCache;
+};
+
+/// slice encoder and CTU row workers of an additional frame lane, i.e. a picture encoded in parallel to others
+struct EncFrameLaneCtx
+{
+  EncSlice                  m_cSliceEncoder;
+  ThreadPool                m_wppThreadPool;
+};
+
 /// encoder class
 class EncLib : public EncCfg
 {
@@ -106,6 +128,18 @@ private:
   // quality control
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
 
+  // wavefront parallel processing, thread 0 uses the instances above
+  // frame lane l uses the instances l * NumWppThreads .. (l + 1) * NumWppThreads - 1
+  // the parallel split jobs 1..PARL_SPLIT_MAX_NUM_JOBS use the instances following the ones of the frame lanes
+  std::vector<EncWppThreadCtx*> m_wppThreadCtx;                   ///< encoder instances of the threads 1..NumFrameThreads*NumWppThreads-1 and of the split jobs
+  ThreadPool                m_wppThreadPool;                      ///< worker threads encoding CTU rows
+  ThreadPool                m_splitThreadPool;                    ///< worker threads evaluating the split candidates of a CU
+  std::mutex                m_splitCommitMutex;                   ///< guards the picture CodingStructure while split jobs temporarily add units
+
+  // frame parallel encoding, lane 0 uses the instances above
+  std::vector<EncFrameLaneCtx*> m_frameLaneCtx;                   ///< slice encoders of the lanes 1..NumFrameThreads-1
+  ThreadPool                m_frameThreadPool;                    ///< worker threads encoding the pictures of a GOP
+
   AUWriterIf*               m_AUWriterIf;
 
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -132,8 +166,6 @@ private:
 public:
   SPS*                      getSPS( int spsId ) { return m_spsMap.getPS( spsId ); };
   APS**                     getApss() { return m_apss; }
-  Ctx                       m_entropyCodingSyncContextState;      ///< leave in addition to vector for compatibility
-  PLTBuf                    m_palettePredictorSyncState;
 
 protected:
   void  xGetNewPicBuffer  ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Picture*& rpcPic, int ppsId ); ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
@@ -165,23 +197,30 @@ public:
 
   AUWriterIf*             getAUWriterIf         ()              { return   m_AUWriterIf;           }
   PicList*                getListPic            ()              { return  &m_cListPic;             }
-  InterSearch*            getInterSearch        ()              { return  &m_cInterSearch;         }
-  IntraSearch*            getIntraSearch        ()              { return  &m_cIntraSearch;         }
+  InterSearch*            getInterSearch        ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_cInterSearch     : &m_cInterSearch;     }
+  IntraSearch*            getIntraSearch        ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_cIntraSearch     : &m_cIntraSearch;     }
 
-  TrQuant*                getTrQuant            ()              { return  &m_cTrQuant;             }
-  DeblockingFilter*       getDeblockingFilter   ()              { return  &m_deblockingFilter;     }
+  TrQuant*                getTrQuant            ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_cTrQuant         : &m_cTrQuant;         }
+  DeblockingFilter*       getDeblockingFilter   ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_deblockingFilter : &m_deblockingFilter; }
   EncSampleAdaptiveOffset* getSAO               ()              { return  &m_cEncSAO;              }
   EncAdaptiveLoopFilter*  getALF                ()              { return  &m_cEncALF;              }
   EncGOP*                 getGOPEncoder         ()              { return  &m_cGOPEncoder;          }
-  EncSlice*               getSliceEncoder       ()              { return  &m_cSliceEncoder;        }
+  EncSlice*               getSliceEncoder       ( int lId = 0 ) { return  lId ? &m_frameLaneCtx[lId - 1]->m_cSliceEncoder  : &m_cSliceEncoder;    }
   EncHRD*                 getHRD                ()              { return  &m_encHRD;               }
-  EncCu*                  getCuEncoder          ()              { return  &m_cCuEncoder;           }
+  EncCu*                  getCuEncoder          ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_cCuEncoder       : &m_cCuEncoder;       }
   HLSWriter*              getHLSWriter          ()              { return  &m_HLSWriter;            }
-  CABACEncoder*           getCABACEncoder       ()              { return  &m_CABACEncoder;         }
+  CABACEncoder*           getCABACEncoder       ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_CABACEncoder     : &m_CABACEncoder;     }
 
-  RdCost*                 getRdCost             ()              { return  &m_cRdCost;              }
-  CtxCache*               getCtxCache           ()              { return  &m_CtxCache;             }
+  RdCost*                 getRdCost             ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_cRdCost          : &m_cRdCost;          }
+  CtxCache*               getCtxCache           ( int jId = 0 ) { return  jId ? &m_wppThreadCtx[jId - 1]->m_CtxCache         : &m_CtxCache;         }
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
+  ThreadPool*             getWppThreadPool      ( int lId = 0 ) { return  lId ? &m_frameLaneCtx[lId - 1]->m_wppThreadPool  : &m_wppThreadPool;    }
+  std::mutex*             getSplitCommitMutex   ()              { return  &m_splitCommitMutex;     }
+  ThreadPool*             getSplitThreadPool    ()              { return  &m_splitThreadPool;      }
+  int                     getNumEncoderCtxs     () const        { return  m_numWppThreads * m_numFrameThreads + ( m_numSplitThreads > 1 ? PARL_SPLIT_MAX_NUM_JOBS : 0 ); }
+  int                     getSplitJobCtxId      ( int jobId ) const { return  m_numWppThreads * m_numFrameThreads + jobId - 1; }
+  // split jobs require a single frame lane and CTU row thread, so their instances directly follow the ones of the lane
+  int                     getNumLaneCtxs        () const        { return  m_numWppThreads + ( m_numSplitThreads > 1 ? PARL_SPLIT_MAX_NUM_JOBS : 0 ); }
 
 
   void                    getActiveRefPicListNumForPOC(const SPS *sps, int POCCurr, int GOPid, uint32_t *activeL0, uint32_t *activeL1);
@@ -194,7 +233,7 @@ public:
   const PPS* getPPS( int Id ) { return m_ppsMap.getPS( Id); }
   const APS*             getAPS(int Id) { return m_apsMap.getPS(Id); }
 
-  EncReshape*            getReshaper()                          { return  &m_cReshaper; }
+  EncReshape*            getReshaper( int jId = 0 )             { return  jId ? &m_wppThreadCtx[jId - 1]->m_cReshaper : &m_cReshaper; }
 
   ParameterSetMap<APS>*  getApsMap() { return &m_apsMap; }
 
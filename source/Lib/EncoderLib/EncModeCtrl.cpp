@@ -55,6 +55,7 @@ void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
   m_pcRateCtrl    = pRateCtrl;
   m_pcRdCost      = pRdCost;
   m_fastDeltaQP   = false;
+  m_splitJobClass = -1;
 #if SHARP_LUMA_DELTA_QP
   m_lumaQPOffset  = 0;
 
@@ -112,6 +113,39 @@ bool EncModeCtrl::anyMode() const
   return !m_ComprCUCtxList.back().testModes.empty();
 }
 
+/** bit mask of the mode classes (see getSplitJobClass) left to be tested at the current CU level
+ */
+unsigned EncModeCtrl::getSplitJobClasses() const
+{
+  unsigned classes = 0;
+  for( const auto& etm : m_ComprCUCtxList.back().testModes )
+  {
+    if( etm.type != ETM_POST_DONT_SPLIT )
+    {
+      classes |= 1u << getSplitJobClass( etm );
+    }
+  }
+  return classes;
+}
+
+/** prepare this mode control to evaluate one class of modes of the CU level the other one is at
+ * \param other     mode control of the encoder, whose current CU level was already finished
+ * \param jobClass  the only mode class (see getSplitJobClass) tested at the next CU level
+ */
+void EncModeCtrl::initSplitJob( const EncModeCtrl& other, const int jobClass )
+{
+  CHECK( !m_ComprCUCtxList.empty(), "Mode list is not empty at the beginning of a split job" );
+
+  // the decisions of the ancestor CU levels are used by the fast checks
+  for( const auto& cuECtx : other.m_ComprCUCtxList )
+  {
+    m_ComprCUCtxList.push_back( cuECtx );
+  }
+  m_fastDeltaQP   = other.m_fastDeltaQP;
+  m_doPlt         = other.m_doPlt;
+  m_splitJobClass = jobClass;
+}
+
 void EncModeCtrl::setBest( CodingStructure& cs )
 {
   if( cs.cost != MAX_DOUBLE && !cs.cus.empty() )
@@ -1358,6 +1392,27 @@ void EncModeCtrlMTnoRQT::initCULevel( Partitioner &partitioner, const CodingStru
     }
   }
 
+  if( m_splitJobClass >= 0 )
+  {
+    // parallel split job, only the modes of its class are tested (the data of the unsplit coding belongs to the non-split ones)
+    std::vector<EncTestMode>& testModes = m_ComprCUCtxList.back().testModes;
+    for( int j = 0; j < (int) testModes.size(); j++ )
+    {
+      if( getSplitJobClass( testModes[j] ) != m_splitJobClass )
+      {
+        testModes.erase( testModes.begin() + j );
+        j--;
+      }
+    }
+    m_splitJobClass = -1;
+
+    if( testModes.empty() )
+    {
+      m_ComprCUCtxList.back().lastTestMode = EncTestMode();
+      return;
+    }
+  }
+
   // ensure to skip unprobable modes
   if( !tryModeMaster( m_ComprCUCtxList.back().testModes.back(), cs, partitioner ) )
   {
@@ -1537,7 +1592,7 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
     const Area curr_cu = CS::getArea(cs, cs.area, partitioner.chType).blocks[getFirstComponentOfChannel(partitioner.chType)];
     try
     {
-      double stored_cost = slice.m_mapPltCost[isChroma(partitioner.chType)].at(curr_cu.pos()).at(curr_cu.size());
+      double stored_cost = m_mapPltCost[isChroma(partitioner.chType)].at(curr_cu.pos()).at(curr_cu.size());
       if (bestMode.type != ETM_INVALID && stored_cost > cuECtx.bestCS->cost)
       {
         return false;
@@ -1811,12 +1866,7 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
     CHECK( encTestmode.type != ETM_POST_DONT_SPLIT, "Unknown mode" );
     if ((cuECtx.get<double>(BEST_NO_IMV_COST) == (MAX_DOUBLE * .5) || cuECtx.get<bool>(IS_REUSING_CU)) && !slice.isIntra())
     {
-      unsigned idx1, idx2, idx3, idx4;
-      getAreaIdx(partitioner.currArea().Y(), *slice.getPPS()->pcv, idx1, idx2, idx3, idx4);
-      if (g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4])
-      {
-        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), g_reusedUniMVs[idx1][idx2][idx3][idx4]);
-      }
+      m_pcInterSearch->insertReusedUniMvCands(partitioner.currArea().Y(), *slice.getPPS()->pcv);
     }
     if( !bestCS || ( bestCS && isModeSplit( bestMode ) ) )
     {
@@ -128,6 +128,12 @@ inline bool isModeSplit( const EncTestMode& encTestmode )
   }
 }
 
+/// class of a mode for the parallel evaluation of the split candidates: 0 for all non-split modes, 1 + split type otherwise
+inline int getSplitJobClass( const EncTestMode& encTestmode )
+{
+  return isModeSplit( encTestmode ) ? 1 + int( encTestmode.type - ETM_SPLIT_QT ) : 0;
+}
+
 inline bool isModeNoSplit( const EncTestMode& encTestmode )
 {
   return !isModeSplit( encTestmode ) && encTestmode.type != ETM_POST_DONT_SPLIT;
@@ -282,6 +288,8 @@ protected:
   InterSearch*          m_pcInterSearch;
 
   bool                  m_doPlt;
+  std::unordered_map< Position, std::unordered_map< Size, double> > m_mapPltCost[2];
+  int                   m_splitJobClass;                      ///< mode class the next CU level is restricted to, -1 for all modes
 
 public:
 
@@ -312,6 +320,9 @@ public:
   bool         getIsHashPerfectMatch() { return m_ComprCUCtxList.back().isHashPerfectMatch; }
   virtual void setBest              ( CodingStructure& cs );
   bool         anyMode              () const;
+  unsigned     getSplitJobClasses   () const;
+  void         initSplitJob         ( const EncModeCtrl& other, const int jobClass );
+  void         finishSplitJob       ()       { m_ComprCUCtxList.clear(); m_splitJobClass = -1; }
 
   const ComprCUCtx& getComprCUCtx   () { CHECK( m_ComprCUCtxList.empty(), "Accessing empty list!"); return m_ComprCUCtxList.back(); }
 
@@ -322,6 +333,8 @@ public:
   int                                 calculateLumaDQPsmooth(const CPelBuf& rcOrg, int baseQP, double threshold, double scale, double offset, int limit);
   void setFastDeltaQp                 ( bool b )                {        m_fastDeltaQP = b;                               }
   bool getFastDeltaQp                 ()                  const { return m_fastDeltaQP;                                   }
+  void resetPltCost                   ()                        { m_mapPltCost[0].clear(); m_mapPltCost[1].clear();       }
+  void setPltCost                     ( const ChannelType chType, const Area& area, double cost ) { m_mapPltCost[isChroma( chType )][area.pos()][area.size()] = cost; }
 
   double getBestInterCost             ()                  const { return m_ComprCUCtxList.back().bestInterCost;           }
   Distortion getInterHad              ()                  const { return m_ComprCUCtxList.back().interHad;                }
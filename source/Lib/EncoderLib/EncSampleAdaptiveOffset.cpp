@@ -1130,6 +1130,14 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                         , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
                         )
 {
+  if (!isCtuCrossedByVirtualBoundaries)
+  {
+    xGetBlkStatsAllTypes(compIdx, channelBitDepth, statsDataTypes, srcBlk, orgBlk, srcStride, orgStride, width, height, isLeftAvail, isRightAvail,
+                         isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isCalculatePreDeblockSamples);
+    return;
+  }
+
+  // virtual boundaries exclude single samples from the statistics
   int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
   int8_t signLeft, signRight, signDown;
   int64_t *diff, *count;
@@ -1539,6 +1547,107 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
   }
 }
 
+void EncSampleAdaptiveOffset::xGetBlkStatsAllTypes(const ComponentID compIdx, const int channelBitDepth, SAOStatData* statsDataTypes
+                        , const Pel* srcBlk, const Pel* orgBlk, int srcStride, int orgStride, int width, int height
+                        , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail
+                        , bool isCalculatePreDeblockSamples
+                        )
+{
+  // The samples of each type are described by up to three line ranges with a sample range each: the first line,
+  // the following lines and, for the pre-deblocking statistics, the lines skipped at the bottom of the CTU.
+  // All types are gathered in a single pass over the lines of the block.
+  struct LineRange
+  {
+    int startY, endY, startX, endX;
+    bool contains(const int y) const { return y >= startY && y < endY && startX < endX; }
+  };
+
+  const int* skipLinesR = m_skipLinesR[compIdx];
+  const int* skipLinesB = m_skipLinesB[compIdx];
+  const bool pre        = isCalculatePreDeblockSamples;
+
+  LineRange ranges[NUM_SAO_NEW_TYPES][3];
+  ptrdiff_t nbOffsets[NUM_SAO_NEW_TYPES][2] = { { -1, 1 }, { -srcStride, srcStride }, { -srcStride - 1, srcStride + 1 }, { -srcStride + 1, srcStride - 1 }, { 0, 0 } };
+
+  for (int typeIdx = 0; typeIdx < NUM_SAO_NEW_TYPES; typeIdx++)
+  {
+    statsDataTypes[typeIdx].reset();
+
+    const int skipR = skipLinesR[typeIdx];
+    const int skipB = skipLinesB[typeIdx];
+    LineRange* r    = ranges[typeIdx];
+
+    if (typeIdx == SAO_TYPE_EO_90 || typeIdx == SAO_TYPE_BO)
+    {
+      const int startX = !pre ? 0 : (isRightAvail ? (width - skipR) : width);
+      const int endX   = !pre ? (isRightAvail ? (width - skipR) : width) : width;
+      const int startY = (typeIdx == SAO_TYPE_BO || isAboveAvail) ? 0 : 1;
+      const int endY   = isBelowAvail ? (height - skipB) : (typeIdx == SAO_TYPE_BO ? height : (height - 1));
+
+      r[0] = { startY, endY, startX, endX };
+      r[1] = { 0, 0, 0, 0 };
+      r[2] = { endY, (pre && isBelowAvail) ? (endY + skipB) : endY, 0, width };
+    }
+    else
+    {
+      const int startX = !pre ? (isLeftAvail ? 0 : 1) : (isRightAvail ? (width - skipR) : (width - 1));
+      const int endX   = !pre ? (isRightAvail ? (width - skipR) : (width - 1)) : (isRightAvail ? width : (width - 1));
+      const int endY   = isBelowAvail ? (height - skipB) : (typeIdx == SAO_TYPE_EO_0 ? height : (height - 1));
+
+      if (typeIdx == SAO_TYPE_EO_0)
+      {
+        r[0] = { 0, 0, 0, 0 };
+        r[1] = { 0, endY, startX, endX };
+      }
+      else if (typeIdx == SAO_TYPE_EO_135)
+      {
+        r[0] = { 0, 1, !pre ? (isAboveLeftAvail ? 0 : 1) : startX, !pre ? (isAboveAvail ? endX : 1) : endX };
+        r[1] = { 1, endY, startX, endX };
+      }
+      else
+      {
+        r[0] = { 0, 1, !pre ? (isAboveAvail ? startX : endX) : startX, !pre ? ((!isRightAvail && isAboveRightAvail) ? width : endX) : endX };
+        r[1] = { 1, endY, startX, endX };
+      }
+      r[2] = { endY, (pre && isBelowAvail) ? (endY + skipB) : endY, isLeftAvail ? 0 : 1, isRightAvail ? width : (width - 1) };
+    }
+  }
+
+  const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
+
+  for (int y = 0; y < height; y++)
+  {
+    const Pel* srcLine = srcBlk + y * srcStride;
+    const Pel* orgLine = orgBlk + y * orgStride;
+
+    for (int typeIdx = 0; typeIdx < NUM_SAO_NEW_TYPES; typeIdx++)
+    {
+      SAOStatData& statsData = statsDataTypes[typeIdx];
+
+      for (const LineRange& r: ranges[typeIdx])
+      {
+        if (!r.contains(y))
+        {
+          continue;
+        }
+        if (typeIdx == SAO_TYPE_BO)
+        {
+          for (int x = r.startX; x < r.endX; x++)
+          {
+            const int bandIdx = srcLine[x] >> shiftBits;
+            statsData.diff [bandIdx] += (orgLine[x] - srcLine[x]);
+            statsData.count[bandIdx] ++;
+          }
+        }
+        else
+        {
+          m_statsLineEO(srcLine, orgLine, nbOffsets[typeIdx][0], nbOffsets[typeIdx][1], r.startX, r.endX, statsData.diff, statsData.count);
+        }
+      }
+    }
+  }
+}
+
 void EncSampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos, bool& isLeftAvail, bool& isAboveAvail, bool& isAboveLeftAvail) const
 {
   bool isLoopFiltAcrossSlicePPS = cs.pps->getLoopFilterAcrossSlicesEnabledFlag();
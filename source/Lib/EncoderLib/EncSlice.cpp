@@ -55,7 +55,9 @@
 // ====================================================================================================================
 
 EncSlice::EncSlice()
- : m_encCABACTableIdx(I_SLICE)
+ : m_laneId(0)
+ , m_ctxId(0)
+ , m_encCABACTableIdx(I_SLICE)
 #if ENABLE_QPA
  , m_adaptedLumaQP(-1)
 #endif
@@ -79,19 +81,21 @@ void EncSlice::destroy()
   m_viRdPicQp.clear();
 }
 
-void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
+void EncSlice::init( EncLib* pcEncLib, const SPS& sps, int lId )
 {
   m_pcCfg             = pcEncLib;
   m_pcLib             = pcEncLib;
   m_pcListPic         = pcEncLib->getListPic();
+  m_laneId            = lId;
+  m_ctxId             = lId * pcEncLib->getNumWppThreads();
 
   m_pcGOPEncoder      = pcEncLib->getGOPEncoder();
-  m_pcCuEncoder       = pcEncLib->getCuEncoder();
-  m_pcInterSearch     = pcEncLib->getInterSearch();
-  m_CABACWriter       = pcEncLib->getCABACEncoder()->getCABACWriter   (&sps);
-  m_CABACEstimator    = pcEncLib->getCABACEncoder()->getCABACEstimator(&sps);
-  m_pcTrQuant         = pcEncLib->getTrQuant();
-  m_pcRdCost          = pcEncLib->getRdCost();
+  m_pcCuEncoder       = pcEncLib->getCuEncoder( m_ctxId );
+  m_pcInterSearch     = pcEncLib->getInterSearch( m_ctxId );
+  m_CABACWriter       = pcEncLib->getCABACEncoder( m_ctxId )->getCABACWriter   (&sps);
+  m_CABACEstimator    = pcEncLib->getCABACEncoder( m_ctxId )->getCABACEstimator(&sps);
+  m_pcTrQuant         = pcEncLib->getTrQuant( m_ctxId );
+  m_pcRdCost          = pcEncLib->getRdCost( m_ctxId );
 
   // create lambda and QP arrays
   m_vdRdPicLambda.resize(m_pcCfg->getDeltaQpRD() * 2 + 1 );
@@ -1312,7 +1316,10 @@ void EncSlice::setSearchRange( Slice* pcSlice )
     {
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
       int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
-      m_pcInterSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      for (int jId = 0; jId < m_pcLib->getNumLaneCtxs(); jId++)
+      {
+        m_pcLib->getInterSearch(m_ctxId + jId)->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      }
     }
   }
 }
@@ -1560,7 +1567,7 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 #endif
   m_pcInterSearch->resetAffineMVList();
   m_pcInterSearch->resetUniMvList();
-  ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
+  m_pcInterSearch->resetReusedUniMvs();
   encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, m_pcLib );
   if (checkPLTRatio)
   {
@@ -1655,9 +1662,9 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   const int iQPIndex              = pcSlice->getSliceQpBase();
 #endif
 
-  CABACWriter*    pCABACWriter    = pEncLib->getCABACEncoder()->getCABACEstimator( pcSlice->getSPS() );
-  TrQuant*        pTrQuant        = pEncLib->getTrQuant();
-  RdCost*         pRdCost         = pEncLib->getRdCost();
+  CABACWriter*    pCABACWriter    = pEncLib->getCABACEncoder( m_ctxId )->getCABACEstimator( pcSlice->getSPS() );
+  TrQuant*        pTrQuant        = pEncLib->getTrQuant( m_ctxId );
+  RdCost*         pRdCost         = pEncLib->getRdCost( m_ctxId );
   EncCfg*         pCfg            = pEncLib;
   RateCtrl*       pRateCtrl       = pEncLib->getRateCtrl();
   pRdCost->setLosslessRDCost(pcSlice->isLossless());
@@ -1714,6 +1721,40 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
   }
 
+  if (pCfg->getNumWppThreads() > 1)
+  {
+    xEncodeCtusWpp(pcPic, pEncLib);
+    return;
+  }
+
+  // the search instances of the parallel split jobs start from the state of this slice
+  if (pCfg->getNumSplitThreads() > 1)
+  {
+    for (int jobId = 1; jobId <= PARL_SPLIT_MAX_NUM_JOBS; jobId++)
+    {
+      const int jId = pEncLib->getSplitJobCtxId(jobId);
+      *pEncLib->getRdCost(jId)   = *pEncLib->getRdCost(m_ctxId);
+      *pEncLib->getReshaper(jId) = *pEncLib->getReshaper(m_ctxId);
+#if RDOQ_CHROMA_LAMBDA
+      pEncLib->getTrQuant(jId)->setLambdas(pcSlice->getLambdas());
+#else
+      pEncLib->getTrQuant(jId)->setLambda(pcSlice->getLambdas()[0]);
+#endif
+      pEncLib->getCABACEncoder(jId)->getCABACEstimator(pcSlice->getSPS())->initCtxModels(*pcSlice);
+      if (pcSlice->getSPS()->getUseLmcs())
+      {
+        pEncLib->getCuEncoder(jId)->setDecCuReshaperInEncCU(pEncLib->getReshaper(jId), pcSlice->getSPS()->getChromaFormatIdc());
+      }
+      xResetCtuRowState(jId);
+    }
+
+    // the unit vectors of the picture are read by all jobs while one of them temporarily adds units, they must not be reallocated
+    const size_t maxNumUnits = 2 * cs.unitScale[COMPONENT_Y].scale(cs.area.blocks[COMPONENT_Y].size()).area();
+    cs.cus.reserve(maxNumUnits);
+    cs.pus.reserve(maxNumUnits);
+    cs.tus.reserve(maxNumUnits);
+  }
+
   // for every CTU in the slice
   for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
   {
@@ -1733,31 +1774,16 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       cs.motionLut.lut.resize(0);
       cs.motionLut.lutIbc.resize(0);
     }
+    if (pCfg->getEnsureWppBitEqual() && cs.pps->ctuIsTileColBd( ctuXPosInCtus ))
+    {
+      xResetCtuRowState(m_ctxId);
+    }
 
     const SubPic &curSubPic = pcSlice->getPPS()->getSubPicFromPos(pos);
     // padding/restore at slice level
     if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == 0)
     {
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
-
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
-      {
-        int n = pcSlice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
-        {
-          Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
-
-          if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
-          {
-            refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(true);
-          }
-        }
-      }
+      xSaveSubPicBorders(pcSlice, curSubPic);
     }
     if (cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && cs.pps->ctuIsTileRowBd( ctuYPosInCtus ))
     {
@@ -1773,11 +1799,11 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       if( cs.getCURestricted( pos.offset(0, -1), pos, pcSlice->getIndependentSliceIdx(), cs.pps->getTileIdx( pos ), CH_L ) )
       {
         // Top is available, we use it.
-        pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextState;
+        pCABACWriter->getCtx() = m_entropyCodingSyncContextState;
         pCABACWriter->getCtx().riceStatReset(
           pcSlice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA),
           pcSlice->getSPS()->getSpsRangeExtension().getPersistentRiceAdaptationEnabledFlag());
-        cs.setPrevPLT(pEncLib->m_palettePredictorSyncState);
+        cs.setPrevPLT(m_palettePredictorSyncState);
       }
       prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
     }
@@ -1871,10 +1897,17 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     {
       resetBcwCodingOrder(false, cs);
       m_pcInterSearch->initWeightIdxBits();
+      if (pCfg->getNumSplitThreads() > 1)
+      {
+        for (int jobId = 1; jobId <= PARL_SPLIT_MAX_NUM_JOBS; jobId++)
+        {
+          pEncLib->getInterSearch(pEncLib->getSplitJobCtxId(jobId))->initWeightIdxBits();
+        }
+      }
     }
     if (pcSlice->getSPS()->getUseLmcs())
     {
-      m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper(), pcSlice->getSPS()->getChromaFormatIdc());
+      m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper(m_ctxId), pcSlice->getSPS()->getChromaFormatIdc());
     }
     if( !cs.slice->isIntra() && pCfg->getMCTSEncConstraint() )
     {
@@ -1898,8 +1931,8 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     // Store probabilities of first CTU in line into buffer - used only if wavefront-parallel-processing is enabled.
     if( cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && pEncLib->getEntropyCodingSyncEnabledFlag() )
     {
-      pEncLib->m_entropyCodingSyncContextState = pCABACWriter->getCtx();
-      cs.storePrevPLT(pEncLib->m_palettePredictorSyncState);
+      m_entropyCodingSyncContextState = pCABACWriter->getCtx();
+      cs.storePrevPLT(m_palettePredictorSyncState);
     }
 
     int actualBits = int(cs.fracBits >> SCALE_BITS);
@@ -1969,32 +2002,306 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     // for last Ctu in the slice
     if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (pcSlice->getNumCtuInSlice() - 1))
     {
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+      xRestoreSubPicBorders(pcSlice, curSubPic);
+    }
+  }
+  m_pcCuEncoder->setWppRowState(nullptr, nullptr, nullptr);
+
+  // this is wpp exclusive section
+
+//  m_uiPicTotalBits += actualBits;
+//  m_uiPicDist       = cs.dist;
+
+}
+
+/** reset the encoder search state that depends on the CTU coding order
+ * \param jId  index of the encoder instance whose search state is reset
+ */
+void EncSlice::xResetCtuRowState( int jId )
+{
+  InterSearch* pInterSearch = m_pcLib->getInterSearch( jId );
+
+  pInterSearch->resetAffineMVList();
+  pInterSearch->resetUniMvList();
+  pInterSearch->resetReusedUniMvs();
+  if (m_pcCfg->getIBCMode())
+  {
+    pInterSearch->resetIbcSearch();
+  }
+}
+
+void EncSlice::xSaveSubPicBorders( Slice* pcSlice, const SubPic& curSubPic )
+{
+  int subPicX = (int)curSubPic.getSubPicLeft();
+  int subPicY = (int)curSubPic.getSubPicTop();
+  int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
+  int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+
+  for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  {
+    int n = pcSlice->getNumRefIdx((RefPicList)rlist);
+    for (int idx = 0; idx < n; idx++)
+    {
+      Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
+
+      if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+      {
+        refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->setSubPicSaved(true);
+      }
+    }
+  }
+}
+
+void EncSlice::xRestoreSubPicBorders( Slice* pcSlice, const SubPic& curSubPic )
+{
+  int subPicX = (int)curSubPic.getSubPicLeft();
+  int subPicY = (int)curSubPic.getSubPicTop();
+  int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
+  int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+
+  for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  {
+    int n = pcSlice->getNumRefIdx((RefPicList)rlist);
+    for (int idx = 0; idx < n; idx++)
+    {
+      Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
+      if (refPic->getSubPicSaved())
+      {
+        refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->setSubPicSaved(false);
+      }
+    }
+  }
+}
+
+/** encode the CTUs of the slice with one job per CTU row (wavefront parallel processing)
+ * \param pcPic     picture containing the slice
+ * \param pEncLib   encoder owning the per-thread encoder instances and the thread pool
+ *
+ * Each CTU row is compressed and RD-estimated by one worker thread, which starts a CTU when the
+ * above-right CTU of the previous row is finished. Commits to the picture CodingStructure are
+ * serialized by m_wppCommitMutex, HMVP table and palette predictor are kept per row. The worker jId uses the encoder
+ * instances m_ctxId + jId of the frame lane.
+ */
+void EncSlice::xEncodeCtusWpp( Picture* pcPic, EncLib* pEncLib )
+{
+  CodingStructure&     cs          = *pcPic->cs;
+  Slice*               pcSlice     = cs.slice;
+  const PreCalcValues& pcv         = *cs.pcv;
+  const uint32_t       widthInCtus = pcv.widthInCtus;
+  const uint32_t       numCtus     = pcSlice->getNumCtuInSlice();
+  EncCfg*              pCfg        = pEncLib;
+
+  // split the slice into CTU rows, a new row starts at each tile column boundary
+  std::vector<uint32_t> rowStart;
+  std::vector<int>      ctuRow     ( pcv.sizeInCtus, -1 );
+  std::vector<int>      ctuPosInRow( pcv.sizeInCtus, -1 );
+  for( uint32_t ctuIdx = 0; ctuIdx < numCtus; ctuIdx++ )
+  {
+    const uint32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+    if( ctuIdx == 0 || cs.pps->ctuIsTileColBd( ctuRsAddr % widthInCtus ) )
+    {
+      rowStart.push_back( ctuIdx );
+    }
+    ctuRow     [ctuRsAddr] = (int)rowStart.size() - 1;
+    ctuPosInRow[ctuRsAddr] = ctuIdx - rowStart.back();
+  }
+  const int numRows = (int)rowStart.size();
+  rowStart.push_back( numCtus );
 
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  // the search instances of all threads start from the state of the first one
+  for( int jId = m_ctxId + 1; jId < m_ctxId + pCfg->getNumWppThreads(); jId++ )
+  {
+    *pEncLib->getRdCost( jId )   = *pEncLib->getRdCost( m_ctxId );
+    *pEncLib->getReshaper( jId ) = *pEncLib->getReshaper( m_ctxId );
+#if RDOQ_CHROMA_LAMBDA
+    pEncLib->getTrQuant( jId )->setLambdas( pcSlice->getLambdas() );
+#else
+    pEncLib->getTrQuant( jId )->setLambda ( pcSlice->getLambdas()[0] );
+#endif
+    pEncLib->getCuEncoder( jId )->getModeCtrl()->setFastDeltaQp( m_pcCuEncoder->getModeCtrl()->getFastDeltaQp() );
+    pEncLib->getCuEncoder( jId )->getModeCtrl()->setPltEnc( m_pcCuEncoder->getModeCtrl()->getPltEnc() );
+  }
+  for( int jId = m_ctxId; jId < m_ctxId + pCfg->getNumWppThreads(); jId++ )
+  {
+    if( cs.slice->getSliceType() == B_SLICE )
+    {
+      pEncLib->getInterSearch( jId )->initWeightIdxBits();
+    }
+    if (pcSlice->getSPS()->getUseLmcs())
+    {
+      pEncLib->getCuEncoder( jId )->setDecCuReshaperInEncCU( pEncLib->getReshaper( jId ), pcSlice->getSPS()->getChromaFormatIdc() );
+    }
+  }
+  if( cs.slice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder( false, cs );
+  }
+
+  // padding/restore at slice level
+  const Position firstCtuPos( ( pcSlice->getCtuAddrInSlice( 0 ) % widthInCtus ) * pcv.maxCUWidth, ( pcSlice->getCtuAddrInSlice( 0 ) / widthInCtus ) * pcv.maxCUHeight );
+  const SubPic &sliceSubPic = pcSlice->getPPS()->getSubPicFromPos( firstCtuPos );
+  const bool subPicPadding  = pcSlice->getPPS()->getNumSubPics() >= 2 && sliceSubPic.getTreatedAsPicFlag();
+  if( subPicPadding )
+  {
+    xSaveSubPicBorders( pcSlice, sliceSubPic );
+  }
+
+  // the unit vectors of the picture are read while other rows add units, they must not be reallocated
+  const size_t maxNumUnits = 2 * cs.unitScale[COMPONENT_Y].scale( cs.area.blocks[COMPONENT_Y].size() ).area();
+  cs.cus.reserve( maxNumUnits );
+  cs.pus.reserve( maxNumUnits );
+  cs.tus.reserve( maxNumUnits );
+  const size_t firstNewCu = cs.cus.size();
+
+  const LutMotionCand sliceMotionLut = cs.motionLut;
+  const PLTBuf        slicePrevPLT   = cs.prevPLT;
+
+  m_wppProgress.init( numRows );
+  m_wppSyncContextState.resize( numRows );
+  m_wppPalettePredictorSyncState.resize( numRows );
+  std::vector<uint64_t> rowBits( numRows, 0 );
+
+  ThreadPool* pThreadPool = pEncLib->getWppThreadPool( m_laneId );
+  for( int row = 0; row < numRows; row++ )
+  {
+    pThreadPool->addJob( [&, row]( int jId )
+    {
+      CABACWriter*  pCABACWriter = pEncLib->getCABACEncoder( m_ctxId + jId )->getCABACEstimator( pcSlice->getSPS() );
+      EncCu*        pCuEncoder   = pEncLib->getCuEncoder( m_ctxId + jId );
+      LutMotionCand motionLut    = sliceMotionLut;
+      PLTBuf        prevPLT      = slicePrevPLT;
+      int prevQP[2];
+      int currQP[2];
+      prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+      currQP[0] = currQP[1] = pcSlice->getSliceQp();
+
+      pCuEncoder->setWppRowState( &m_wppCommitMutex, &motionLut, &prevPLT );
+      xResetCtuRowState( m_ctxId + jId );
+      try
       {
-        int n = pcSlice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
+        for( uint32_t ctuIdx = rowStart[row]; ctuIdx < rowStart[row + 1]; ctuIdx++ )
         {
-          Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
-          if (refPic->getSubPicSaved())
+          const uint32_t ctuRsAddr     = pcSlice->getCtuAddrInSlice( ctuIdx );
+          const uint32_t ctuXPosInCtus = ctuRsAddr % widthInCtus;
+          const uint32_t ctuYPosInCtus = ctuRsAddr / widthInCtus;
+
+          const Position pos (ctuXPosInCtus * pcv.maxCUWidth, ctuYPosInCtus * pcv.maxCUHeight);
+          const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) );
+
+          // wait for the above-right CTU (or the above one at the right tile boundary)
+          if( ctuYPosInCtus > 0 )
+          {
+            uint32_t aboveRsAddr = ctuRsAddr - widthInCtus;
+            if( ctuXPosInCtus + 1 < widthInCtus && ctuRow[aboveRsAddr + 1] == ctuRow[aboveRsAddr] )
+            {
+              aboveRsAddr++;
+            }
+            if( ctuRow[aboveRsAddr] >= 0 )
+            {
+              m_wppProgress.waitFor( ctuRow[aboveRsAddr], ctuPosInRow[aboveRsAddr] + 1 );
+            }
+          }
+
+          if( ctuIdx == rowStart[row] )
+          {
+            pCABACWriter->initCtxModels( *pcSlice );
+            if( cs.pps->ctuIsTileColBd( ctuXPosInCtus ) )
+            {
+              motionLut.lut.resize( 0 );
+              motionLut.lutIbc.resize( 0 );
+              cs.resetPrevPLT( prevPLT );
+              if( !cs.pps->ctuIsTileRowBd( ctuYPosInCtus ) && cs.getCURestricted( pos.offset( 0, -1 ), pos, pcSlice->getIndependentSliceIdx(), cs.pps->getTileIdx( pos ), CH_L ) )
+              {
+                // Top is available, we use it.
+                const int aboveRow = ctuRow[ctuRsAddr - widthInCtus];
+                pCABACWriter->getCtx() = m_wppSyncContextState[aboveRow];
+                pCABACWriter->getCtx().riceStatReset(
+                  pcSlice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA),
+                  pcSlice->getSPS()->getSpsRangeExtension().getPersistentRiceAdaptationEnabledFlag());
+                prevPLT = m_wppPalettePredictorSyncState[aboveRow];
+              }
+            }
+          }
+
+          if (pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU())
+          {
+            pCuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
+          }
+
+          pCABACWriter->resetBits();
+          pCABACWriter->coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr, true, true );
+          rowBits[row] += pCABACWriter->getEstFracBits() >> SCALE_BITS;
+
+          // Store probabilities of first CTU in line into buffer, used by the next CTU row
+          if( ctuIdx == rowStart[row] && cs.pps->ctuIsTileColBd( ctuXPosInCtus ) )
           {
-            refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(false);
+            m_wppSyncContextState[row]          = pCABACWriter->getCtx();
+            m_wppPalettePredictorSyncState[row] = prevPLT;
           }
+          m_wppProgress.setDone( row, ctuIdx - rowStart[row] + 1 );
         }
       }
-    }
+      catch( ... )
+      {
+        // let the following rows finish, the exception is re-thrown by waitForJobs()
+        m_wppProgress.setDone( row, MAX_INT );
+        pCuEncoder->setWppRowState( nullptr, nullptr, nullptr );
+        throw;
+      }
+      pCuEncoder->setWppRowState( nullptr, nullptr, nullptr );
+    } );
   }
+  pThreadPool->waitForJobs();
 
-  // this is wpp exclusive section
+  if( subPicPadding )
+  {
+    xRestoreSubPicBorders( pcSlice, sliceSubPic );
+  }
 
-//  m_uiPicTotalBits += actualBits;
-//  m_uiPicDist       = cs.dist;
+  for( int row = 0; row < numRows; row++ )
+  {
+    pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + rowBits[row] ) );
+  }
+  m_uiPicTotalBits = cs.fracBits >> SCALE_BITS;
+  m_uiPicDist      = cs.dist;
 
+  // the CUs were added in completion order, restore the coding order of the CU chain
+  // (the CU vector itself must keep its order, it is indexed by CodingUnit::idx)
+  std::vector<CodingUnit*> cusInCodingOrder( cs.cus.begin() + firstNewCu, cs.cus.end() );
+  std::stable_sort( cusInCodingOrder.begin(), cusInCodingOrder.end(), [&]( const CodingUnit* a, const CodingUnit* b )
+  {
+    const Position posA = a->blocks[a->chType].lumaPos();
+    const Position posB = b->blocks[b->chType].lumaPos();
+    const uint32_t ctuA = ( posA.y / pcv.maxCUHeight ) * widthInCtus + posA.x / pcv.maxCUWidth;
+    const uint32_t ctuB = ( posB.y / pcv.maxCUHeight ) * widthInCtus + posB.x / pcv.maxCUWidth;
+    return rowStart[ctuRow[ctuA]] + ctuPosInRow[ctuA] < rowStart[ctuRow[ctuB]] + ctuPosInRow[ctuB];
+  } );
+  CodingUnit* prevCU = firstNewCu > 0 ? cs.cus[firstNewCu - 1] : nullptr;
+  for( CodingUnit* cu : cusInCodingOrder )
+  {
+    if( prevCU )
+    {
+      prevCU->next = cu;
+    }
+    prevCU = cu;
+  }
+  if( prevCU )
+  {
+    prevCU->next = nullptr;
+  }
+
+#if K0149_BLOCK_STATISTICS
+  for( uint32_t ctuIdx = 0; ctuIdx < numCtus; ctuIdx++ )
+  {
+    const uint32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+    const Position pos ( ( ctuRsAddr % widthInCtus ) * pcv.maxCUWidth, ( ctuRsAddr / widthInCtus ) * pcv.maxCUHeight );
+    const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) );
+    getAndStoreBlockStatistics( cs, ctuArea );
+  }
+#endif
 }
 
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
@@ -45,6 +45,9 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Picture.h"
+#include "CommonLib/ThreadPool.h"
+
+#include <mutex>
 
 //! \ingroup EncoderLib
 //! \{
@@ -65,6 +68,8 @@ private:
   EncCfg*                 m_pcCfg;                              ///< encoder configuration class
 
   EncLib*                 m_pcLib;
+  int                     m_laneId;                             ///< frame lane of the slice encoder
+  int                     m_ctxId;                              ///< first encoder instance of the frame lane
 
   // pictures
   PicList*                m_pcListPic;                          ///< list of pictures
@@ -93,6 +98,10 @@ private:
   Ctx                     m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   SliceType               m_encCABACTableIdx;
   PLTBuf                  m_palettePredictorSyncState;
+  std::mutex              m_wppCommitMutex;                     ///< guards the picture CodingStructure during parallel CTU row encoding
+  WavefrontProgress       m_wppProgress;                        ///< number of finished CTUs per CTU row
+  std::vector<Ctx>        m_wppSyncContextState;                ///< context storage after the first CTU of each CTU row
+  std::vector<PLTBuf>     m_wppPalettePredictorSyncState;       ///< palette predictor after the first CTU of each CTU row
 #if SHARP_LUMA_DELTA_QP || ENABLE_QPA_SUB_CTU
   int                     m_gopID;
 #endif
@@ -114,7 +123,7 @@ public:
 
   void    create              ( int iWidth, int iHeight, ChromaFormat chromaFormat, uint32_t iMaxCUWidth, uint32_t iMaxCUHeight, uint8_t uhTotalDepth );
   void    destroy             ();
-  void    init                ( EncLib* pcEncLib, const SPS& sps );
+  void    init                ( EncLib* pcEncLib, const SPS& sps, int lId = 0 );
 
   /// preparation of slice encoding (reference marking, QP and lambda)
   void    initEncSlice        ( Picture*  pcPic, const int pocLast, const int pocCurr,
@@ -144,6 +153,10 @@ public:
   void    setEncCABACTableIdx (SliceType b)         { m_encCABACTableIdx = b; }
 private:
   double  xGetQPValueAccordingToLambda ( double lambda );
+  void    xResetCtuRowState   ( int jId );
+  void    xSaveSubPicBorders  ( Slice* pcSlice, const SubPic& curSubPic );
+  void    xRestoreSubPicBorders( Slice* pcSlice, const SubPic& curSubPic );
+  void    xEncodeCtusWpp      ( Picture* pcPic, EncLib* pEncLib );
 };
 
 //! \}
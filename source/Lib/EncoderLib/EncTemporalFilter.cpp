@@ -91,7 +91,8 @@ void EncTemporalFilter::init(const int frameSkip, const int inputBitDepth[MAX_NU
                              const int *pad, const bool rec709, const std::string &filename,
                              const ChromaFormat inputChromaFormatIDC, const InputColourSpaceConversion colorSpaceConv,
                              const int qp, const std::map<int, double> &temporalFilterStrengths, const int pastRefs,
-                             const int futureRefs, const int firstValidFrame, const int lastValidFrame)
+                             const int futureRefs, const int firstValidFrame, const int lastValidFrame,
+                             const int numThreads)
 {
   m_FrameSkip = frameSkip;
   for (int i = 0; i < MAX_NUM_CHANNEL_TYPE; i++)
@@ -119,6 +120,11 @@ void EncTemporalFilter::init(const int frameSkip, const int inputBitDepth[MAX_NU
   m_futureRefs      = futureRefs;
   m_firstValidFrame = firstValidFrame;
   m_lastValidFrame  = lastValidFrame;
+
+  if (numThreads > 1 && m_threadPool.getNumThreads() == 0)
+  {
+    m_threadPool.create(numThreads);
+  }
 }
 
 // ====================================================================================================================
@@ -165,7 +171,7 @@ bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
     subsampleLuma(origPadded, origSubsampled2);
     subsampleLuma(origSubsampled2, origSubsampled4);
 
-    // determine motion vectors
+    // read the reference frames
     for (int poc = firstFrame; poc <= lastFrame; poc++)
     {
       if (poc == currentFilePoc)
@@ -188,11 +194,15 @@ bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
       }
       srcPic.picBuffer.extendBorderPel(m_padding, m_padding);
       srcPic.mvs.allocate(m_sourceWidth / 4, m_sourceHeight / 4);
-
-      motionEstimation(srcPic.mvs, origPadded, srcPic.picBuffer, origSubsampled2, origSubsampled4);
       srcPic.origOffset = poc - currentFilePoc;
     }
 
+    // determine motion vectors, the references are independent of each other
+    runJobs(int(srcFrameInfo.size()), [&](int i)
+    {
+      motionEstimation(srcFrameInfo[i].mvs, origPadded, srcFrameInfo[i].picBuffer, origSubsampled2, origSubsampled4);
+    });
+
     // filter
     PelStorage newOrgPic;
     newOrgPic.create(m_chromaFormatIDC, m_area, 0, m_padding);
@@ -222,6 +232,23 @@ bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
 // Private member functions
 // ====================================================================================================================
 
+void EncTemporalFilter::runJobs(const int numJobs, const std::function<void(int)> &job)
+{
+  if (m_threadPool.getNumThreads() == 0)
+  {
+    for (int i = 0; i < numJobs; i++)
+    {
+      job(i);
+    }
+    return;
+  }
+  for (int i = 0; i < numJobs; i++)
+  {
+    m_threadPool.addJob([&job, i](int) { job(i); });
+  }
+  m_threadPool.waitForJobs();
+}
+
 void EncTemporalFilter::subsampleLuma(const PelStorage &input, PelStorage &output, const int factor) const
 {
   const int newWidth  = input.Y().width  / factor;
@@ -263,82 +290,23 @@ int EncTemporalFilter::motionErrorLuma(const PelStorage &orig,
   const Pel* buffOrigin = buffer.Y().buf;
   const int  buffStride = buffer.Y().stride;
 
-  int error = 0;
   if (((dx | dy) & 0xF) == 0)
   {
     dx /= m_motionVectorFactor;
     dy /= m_motionVectorFactor;
-    for (int y1 = 0; y1 < bs; y1++)
-    {
-      const Pel* origRowStart   = origOrigin + (y + y1) * origStride + x;
-      const Pel* bufferRowStart = buffOrigin + (y + y1 + dy) * buffStride + (x + dx);
-      for (int x1 = 0; x1 < bs; x1 += 2)
-      {
-        int diff = origRowStart[x1] - bufferRowStart[x1];
-        error += diff * diff;
-        diff = origRowStart[x1 + 1] - bufferRowStart[x1 + 1];
-        error += diff * diff;
-      }
-      if (error > besterror)
-      {
-        return error;
-      }
-    }
+    return g_pelBufOP.mctfSse(origOrigin + y * origStride + x, origStride, buffOrigin + (y + dy) * buffStride + (x + dx),
+                              buffStride, bs, bs, besterror);
   }
-  else
-  {
-    const int *xFilter = m_interpolationFilter[dx & 0xF];
-    const int *yFilter = m_interpolationFilter[dy & 0xF];
-    int tempArray[64 + 8][64];
 
-    int sum, base;
-    for (int y1 = 1; y1 < bs + 7; y1++)
-    {
-      const int yOffset = y + y1 + (dy >> 4) - 3;
-      const Pel *sourceRow = buffOrigin + yOffset * buffStride + 0;
-      for (int x1 = 0; x1 < bs; x1++)
-      {
-        sum = 0;
-        base = x + x1 + (dx >> 4) - 3;
-        const Pel *rowStart = sourceRow + base;
-
-        sum += xFilter[1] * rowStart[1];
-        sum += xFilter[2] * rowStart[2];
-        sum += xFilter[3] * rowStart[3];
-        sum += xFilter[4] * rowStart[4];
-        sum += xFilter[5] * rowStart[5];
-        sum += xFilter[6] * rowStart[6];
-
-        tempArray[y1][x1] = sum;
-      }
-    }
+  const int *xFilter = m_interpolationFilter[dx & 0xF];
+  const int *yFilter = m_interpolationFilter[dy & 0xF];
+  Pel predBlock[64 * 64];
 
-    const Pel maxSampleValue = (1 << m_internalBitDepth[CHANNEL_TYPE_LUMA]) - 1;
-    for (int y1 = 0; y1 < bs; y1++)
-    {
-      const Pel *origRow = origOrigin + (y + y1) * origStride;
-      for (int x1 = 0; x1 < bs; x1++)
-      {
-        sum = 0;
-        sum += yFilter[1] * tempArray[y1 + 1][x1];
-        sum += yFilter[2] * tempArray[y1 + 2][x1];
-        sum += yFilter[3] * tempArray[y1 + 3][x1];
-        sum += yFilter[4] * tempArray[y1 + 4][x1];
-        sum += yFilter[5] * tempArray[y1 + 5][x1];
-        sum += yFilter[6] * tempArray[y1 + 6][x1];
-
-        sum = (sum + (1 << 11)) >> 12;
-        sum = sum < 0 ? 0 : (sum > maxSampleValue ? maxSampleValue : sum);
-
-        error += (sum - origRow[x + x1]) * (sum - origRow[x + x1]);
-      }
-      if (error > besterror)
-      {
-        return error;
-      }
-    }
-  }
-  return error;
+  const Pel maxSampleValue = (1 << m_internalBitDepth[CHANNEL_TYPE_LUMA]) - 1;
+  g_pelBufOP.mctfInterp(buffOrigin + (y + (dy >> 4)) * buffStride + (x + (dx >> 4)), buffStride, predBlock, bs, bs, bs,
+                        xFilter, yFilter, maxSampleValue);
+
+  return g_pelBufOP.mctfSse(origOrigin + y * origStride + x, origStride, predBlock, bs, bs, bs, besterror);
 }
 
 void EncTemporalFilter::motionEstimationLuma(Array2D<MotionVector> &mvs, const PelStorage &orig, const PelStorage &buffer, const int blockSize,
@@ -529,52 +497,9 @@ void EncTemporalFilter::applyMotion(const Array2D<MotionVector> &mvs, const PelS
 
         const int *xFilter = m_interpolationFilter[dx & 0xf];
         const int *yFilter = m_interpolationFilter[dy & 0xf]; // will add 6 bit.
-        const int numFilterTaps   = 7;
-        const int centerTapOffset = 3;
-
-        int tempArray[lumaBlockSize + numFilterTaps][lumaBlockSize];
-
-        for (int by = 1; by < blockSizeY + numFilterTaps; by++)
-        {
-          const int yOffset = y + by + yInt - centerTapOffset;
-          const Pel *sourceRow = srcImage + yOffset * srcStride;
-          for (int bx = 0; bx < blockSizeX; bx++)
-          {
-            int base = x + bx + xInt - centerTapOffset;
-            const Pel *rowStart = sourceRow + base;
-
-            int sum = 0;
-            sum += xFilter[1] * rowStart[1];
-            sum += xFilter[2] * rowStart[2];
-            sum += xFilter[3] * rowStart[3];
-            sum += xFilter[4] * rowStart[4];
-            sum += xFilter[5] * rowStart[5];
-            sum += xFilter[6] * rowStart[6];
-
-            tempArray[by][bx] = sum;
-          }
-        }
 
-        Pel *dstRow = dstImage + y * dstStride;
-        for (int by = 0; by < blockSizeY; by++, dstRow += dstStride)
-        {
-          Pel *dstPel = dstRow + x;
-          for (int bx = 0; bx < blockSizeX; bx++, dstPel++)
-          {
-            int sum = 0;
-
-            sum += yFilter[1] * tempArray[by + 1][bx];
-            sum += yFilter[2] * tempArray[by + 2][bx];
-            sum += yFilter[3] * tempArray[by + 3][bx];
-            sum += yFilter[4] * tempArray[by + 4][bx];
-            sum += yFilter[5] * tempArray[by + 5][bx];
-            sum += yFilter[6] * tempArray[by + 6][bx];
-
-            sum = (sum + (1 << 11)) >> 12;
-            sum = sum < 0 ? 0 : (sum > maxValue ? maxValue : sum);
-            *dstPel = sum;
-          }
-        }
+        g_pelBufOP.mctfInterp(srcImage + (y + yInt) * srcStride + (x + xInt), srcStride, dstImage + y * dstStride + x,
+                              dstStride, blockSizeX, blockSizeY, xFilter, yFilter, maxValue);
       }
     }
   }
@@ -583,118 +508,125 @@ void EncTemporalFilter::applyMotion(const Array2D<MotionVector> &mvs, const PelS
 void EncTemporalFilter::bilateralFilter(const PelStorage &orgPic,
   std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo,
   PelStorage &newOrgPic,
-  double overallStrength) const
+  double overallStrength)
 {
   const int numRefs = int(srcFrameInfo.size());
   std::vector<PelStorage> correctedPics(numRefs);
   for (int i = 0; i < numRefs; i++)
   {
     correctedPics[i].create(m_chromaFormatIDC, m_area, 0, m_padding);
-    applyMotion(srcFrameInfo[i].mvs, srcFrameInfo[i].picBuffer, correctedPics[i]);
   }
+  runJobs(numRefs, [&](int i) { applyMotion(srcFrameInfo[i].mvs, srcFrameInfo[i].picBuffer, correctedPics[i]); });
 
   const int refStrengthRow = m_futureRefs > 0 ? 0 : 1;
 
   const double lumaSigmaSq = (m_QP - m_sigmaZeroPoint) * (m_QP - m_sigmaZeroPoint) * m_sigmaMultiplier;
   const double chromaSigmaSq = 30 * 30;
 
-  for(int c = 0; c < getNumberValidComponents(m_chromaFormatIDC); c++)
+  // the block rows are independent, the noise of a block is only used within its own block row
+  const int lumaBlockSize = 8;
+  const int numBlockRows  = (orgPic.bufs[COMPONENT_Y].height + lumaBlockSize - 1) / lumaBlockSize;
+  runJobs(numBlockRows, [&](int blockRow)
   {
-    const ComponentID compID = (ComponentID)c;
-    const int height = orgPic.bufs[c].height;
-    const int width  = orgPic.bufs[c].width;
-    const Pel* srcPelRow = orgPic.bufs[c].buf;
-    const int  srcStride = orgPic.bufs[c].stride;
-          Pel* dstPelRow = newOrgPic.bufs[c].buf;
-    const int  dstStride = newOrgPic.bufs[c].stride;
-    const double sigmaSq = isChroma(compID) ? chromaSigmaSq : lumaSigmaSq;
-    const double weightScaling = overallStrength * (isChroma(compID) ? m_chromaFactor : 0.4);
-    const Pel maxSampleValue   = (1 << m_internalBitDepth[toChannelType(compID)]) - 1;
-    const double bitDepthDiffWeighting = 1024.0 / (maxSampleValue + 1);
-    const int lumaBlockSize = 8;
-    const int csx = getComponentScaleX(compID, m_chromaFormatIDC);
-    const int csy = getComponentScaleY(compID, m_chromaFormatIDC);
-    const int blockSizeX = lumaBlockSize >> csx;
-    const int blockSizeY = lumaBlockSize >> csy;
-
-    for (int y = 0; y < height; y++, srcPelRow += srcStride, dstPelRow += dstStride)
+    for(int c = 0; c < getNumberValidComponents(m_chromaFormatIDC); c++)
     {
-      const Pel *srcPel = srcPelRow;
-      Pel *dstPel = dstPelRow;
-      for (int x = 0; x < width; x++, srcPel++, dstPel++)
+      const ComponentID compID = (ComponentID)c;
+      const int height = orgPic.bufs[c].height;
+      const int width  = orgPic.bufs[c].width;
+      const int  srcStride = orgPic.bufs[c].stride;
+      const int  dstStride = newOrgPic.bufs[c].stride;
+      const double sigmaSq = isChroma(compID) ? chromaSigmaSq : lumaSigmaSq;
+      const double weightScaling = overallStrength * (isChroma(compID) ? m_chromaFactor : 0.4);
+      const Pel maxSampleValue   = (1 << m_internalBitDepth[toChannelType(compID)]) - 1;
+      const double bitDepthDiffWeighting = 1024.0 / (maxSampleValue + 1);
+      const int csx = getComponentScaleX(compID, m_chromaFormatIDC);
+      const int csy = getComponentScaleY(compID, m_chromaFormatIDC);
+      const int blockSizeX = lumaBlockSize >> csx;
+      const int blockSizeY = lumaBlockSize >> csy;
+      const int yStart     = blockRow * blockSizeY;
+      const int yEnd       = std::min(height, yStart + blockSizeY);
+      const Pel* srcPelRow = orgPic.bufs[c].buf + yStart * srcStride;
+            Pel* dstPelRow = newOrgPic.bufs[c].buf + yStart * dstStride;
+
+      for (int y = yStart; y < yEnd; y++, srcPelRow += srcStride, dstPelRow += dstStride)
       {
-        const int orgVal = (int) *srcPel;
-        double temporalWeightSum = 1.0;
-        double newVal = (double) orgVal;
-        if ((y % blockSizeY == 0) && (x % blockSizeX == 0))
+        const Pel *srcPel = srcPelRow;
+        Pel *dstPel = dstPelRow;
+        for (int x = 0; x < width; x++, srcPel++, dstPel++)
         {
-          for (int i = 0; i < numRefs; i++)
+          const int orgVal = (int) *srcPel;
+          double temporalWeightSum = 1.0;
+          double newVal = (double) orgVal;
+          if ((y % blockSizeY == 0) && (x % blockSizeX == 0))
           {
-            double variance = 0, diffsum = 0;
-            const ptrdiff_t refStride = correctedPics[i].bufs[c].stride;
-            const Pel *     refPel    = correctedPics[i].bufs[c].buf + y * refStride + x;
-            for (int y1 = 0; y1 < blockSizeY; y1++)
+            for (int i = 0; i < numRefs; i++)
             {
-              for (int x1 = 0; x1 < blockSizeX; x1++)
+              double variance = 0, diffsum = 0;
+              const ptrdiff_t refStride = correctedPics[i].bufs[c].stride;
+              const Pel *     refPel    = correctedPics[i].bufs[c].buf + y * refStride + x;
+              for (int y1 = 0; y1 < blockSizeY; y1++)
               {
-                const Pel pix  = *(srcPel + srcStride * y1 + x1);
-                const Pel ref  = *(refPel + refStride * y1 + x1);
-                const int diff = pix - ref;
-                variance += diff * diff;
-                if (x1 != blockSizeX - 1)
-                {
-                  const Pel pixR  = *(srcPel + srcStride * y1 + x1 + 1);
-                  const Pel refR  = *(refPel + refStride * y1 + x1 + 1);
-                  const int diffR = pixR - refR;
-                  diffsum += (diffR - diff) * (diffR - diff);
-                }
-                if (y1 != blockSizeY - 1)
+                for (int x1 = 0; x1 < blockSizeX; x1++)
                 {
-                  const Pel pixD  = *(srcPel + srcStride * y1 + x1 + srcStride);
-                  const Pel refD  = *(refPel + refStride * y1 + x1 + refStride);
-                  const int diffD = pixD - refD;
-                  diffsum += (diffD - diff) * (diffD - diff);
+                  const Pel pix  = *(srcPel + srcStride * y1 + x1);
+                  const Pel ref  = *(refPel + refStride * y1 + x1);
+                  const int diff = pix - ref;
+                  variance += diff * diff;
+                  if (x1 != blockSizeX - 1)
+                  {
+                    const Pel pixR  = *(srcPel + srcStride * y1 + x1 + 1);
+                    const Pel refR  = *(refPel + refStride * y1 + x1 + 1);
+                    const int diffR = pixR - refR;
+                    diffsum += (diffR - diff) * (diffR - diff);
+                  }
+                  if (y1 != blockSizeY - 1)
+                  {
+                    const Pel pixD  = *(srcPel + srcStride * y1 + x1 + srcStride);
+                    const Pel refD  = *(refPel + refStride * y1 + x1 + refStride);
+                    const int diffD = pixD - refD;
+                    diffsum += (diffD - diff) * (diffD - diff);
+                  }
                 }
               }
+              const int cntV = blockSizeX * blockSizeY;
+              const int cntD = 2 * cntV - blockSizeX - blockSizeY;
+              srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).noise =
+                (int) round((15.0 * cntD / cntV * variance + 5.0) / (diffsum + 5.0));
             }
-            const int cntV = blockSizeX * blockSizeY;
-            const int cntD = 2 * cntV - blockSizeX - blockSizeY;
-            srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).noise =
-              (int) round((15.0 * cntD / cntV * variance + 5.0) / (diffsum + 5.0));
           }
+          double minError = 9999999;
+          for (int i = 0; i < numRefs; i++)
+          {
+            minError = std::min(minError, (double) srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).error);
+          }
+          for (int i = 0; i < numRefs; i++)
+          {
+            const int error = srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).error;
+            const int noise = srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).noise;
+            const Pel *pCorrectedPelPtr = correctedPics[i].bufs[c].buf + (y * correctedPics[i].bufs[c].stride + x);
+            const int refVal = (int) *pCorrectedPelPtr;
+            double diff = (double)(refVal - orgVal);
+            diff *= bitDepthDiffWeighting;
+            double diffSq = diff * diff;
+            const int index = std::min(3, std::abs(srcFrameInfo[i].origOffset) - 1);
+            double ww = 1, sw = 1;
+            ww *= (noise < 25) ? 1.0 : 0.6;
+            sw *= (noise < 25) ? 1.0 : 0.8;
+            ww *= (error < 50) ? 1.2 : ((error > 100) ? 0.6 : 1.0);
+            sw *= (error < 50) ? 1.0 : 0.8;
+            ww *= ((minError + 1) / (error + 1));
+            double weight = weightScaling * m_refStrengths[refStrengthRow][index] * ww * exp(-diffSq / (2 * sw * sigmaSq));
+            newVal += weight * refVal;
+            temporalWeightSum += weight;
+          }
+          newVal /= temporalWeightSum;
+          Pel sampleVal = (Pel)round(newVal);
+          sampleVal = (sampleVal < 0 ? 0 : (sampleVal > maxSampleValue ? maxSampleValue : sampleVal));
+          *dstPel = sampleVal;
         }
-        double minError = 9999999;
-        for (int i = 0; i < numRefs; i++)
-        {
-          minError = std::min(minError, (double) srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).error);
-        }
-        for (int i = 0; i < numRefs; i++)
-        {
-          const int error = srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).error;
-          const int noise = srcFrameInfo[i].mvs.get(x / blockSizeX, y / blockSizeY).noise;
-          const Pel *pCorrectedPelPtr = correctedPics[i].bufs[c].buf + (y * correctedPics[i].bufs[c].stride + x);
-          const int refVal = (int) *pCorrectedPelPtr;
-          double diff = (double)(refVal - orgVal);
-          diff *= bitDepthDiffWeighting;
-          double diffSq = diff * diff;
-          const int index = std::min(3, std::abs(srcFrameInfo[i].origOffset) - 1);
-          double ww = 1, sw = 1;
-          ww *= (noise < 25) ? 1.0 : 0.6;
-          sw *= (noise < 25) ? 1.0 : 0.8;
-          ww *= (error < 50) ? 1.2 : ((error > 100) ? 0.6 : 1.0);
-          sw *= (error < 50) ? 1.0 : 0.8;
-          ww *= ((minError + 1) / (error + 1));
-          double weight = weightScaling * m_refStrengths[refStrengthRow][index] * ww * exp(-diffSq / (2 * sw * sigmaSq));
-          newVal += weight * refVal;
-          temporalWeightSum += weight;
-        }
-        newVal /= temporalWeightSum;
-        Pel sampleVal = (Pel)round(newVal);
-        sampleVal = (sampleVal < 0 ? 0 : (sampleVal > maxSampleValue ? maxSampleValue : sampleVal));
-        *dstPel = sampleVal;
       }
     }
-  }
+  });
 }
 
 //! \}
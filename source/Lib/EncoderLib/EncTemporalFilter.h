@@ -39,6 +39,7 @@
 #define __TEMPORAL_FILTER__
 #include "EncLib.h"
 #include "CommonLib/Buffer.h"
+#include "CommonLib/ThreadPool.h"
 #include <sstream>
 #include <map>
 #include <deque>
@@ -109,7 +110,7 @@ public:
             const int width, const int height, const int *pad, const bool rec709, const std::string &filename,
             const ChromaFormat inputChroma, const InputColourSpaceConversion colorSpaceConv, const int qp,
             const std::map<int, double> &temporalFilterStrengths, const int pastRefs, const int futureRefs,
-            const int firstValidFrame, const int lastValidFrame);
+            const int firstValidFrame, const int lastValidFrame, const int numThreads = 1);
 
   bool filter(PelStorage *orgPic, int frame);
 
@@ -144,14 +145,17 @@ private:
   int m_firstValidFrame;
   int m_lastValidFrame;
 
+  ThreadPool m_threadPool;                 ///< worker threads for the motion estimation of the references and the filtering of block rows
+
   // Private functions
+  void runJobs(const int numJobs, const std::function<void(int)> &job);
   void subsampleLuma(const PelStorage &input, PelStorage &output, const int factor = 2) const;
   int motionErrorLuma(const PelStorage &orig, const PelStorage &buffer, const int x, const int y, int dx, int dy, const int bs, const int besterror) const;
   void motionEstimationLuma(Array2D<MotionVector> &mvs, const PelStorage &orig, const PelStorage &buffer, const int bs,
     const Array2D<MotionVector> *previous=0, const int factor = 1, const bool doubleRes = false) const;
   void motionEstimation(Array2D<MotionVector> &mvs, const PelStorage &orgPic, const PelStorage &buffer, const PelStorage &origSubsampled2, const PelStorage &origSubsampled4) const;
 
-  void bilateralFilter(const PelStorage &orgPic, std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, PelStorage &newOrgPic, double overallStrength) const;
+  void bilateralFilter(const PelStorage &orgPic, std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, PelStorage &newOrgPic, double overallStrength);
   void applyMotion(const Array2D<MotionVector> &mvs, const PelStorage &input, PelStorage &output) const;
 }; // END CLASS DEFINITION EncTemporalFilter
 
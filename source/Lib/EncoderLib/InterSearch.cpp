@@ -118,6 +118,8 @@ InterSearch::InterSearch()
   m_uniMvList = nullptr;
   m_uniMvListSize = 0;
   m_uniMvListIdx = 0;
+  m_reusedUniMVs = nullptr;
+  m_isReusedUniMVsFilled = nullptr;
   m_histBestSbt    = MAX_UCHAR;
   m_histBestMtsIdx = MAX_UCHAR;
 
@@ -143,6 +145,10 @@ void InterSearch::destroy()
   }
   m_tmpStorageLCU.destroy();
   m_tmpAffiStorage.destroy();
+  for( int level = 0; level < ME_PYRAMID_LEVELS; level++ )
+  {
+    m_mePyramidOrg[level].destroy();
+  }
 
   if ( m_tmpAffiError != NULL )
   {
@@ -178,6 +184,10 @@ void InterSearch::destroy()
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  delete[] m_reusedUniMVs;
+  m_reusedUniMVs = nullptr;
+  delete[] m_isReusedUniMVsFilled;
+  m_isReusedUniMVsFilled = nullptr;
   m_isInitialized = false;
 }
 
@@ -260,6 +270,10 @@ void InterSearch::init( EncCfg*        pcEncCfg,
     m_tmpPredStorage[i].create( UnitArea( cform, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
   }
   m_tmpStorageLCU.create( UnitArea( cform, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
+  for( int level = 0; level < ME_PYRAMID_LEVELS; level++ )
+  {
+    m_mePyramidOrg[level].create( CHROMA_400, Area( 0, 0, MAX_CU_SIZE >> ( level + 1 ), MAX_CU_SIZE >> ( level + 1 ) ) );
+  }
   m_tmpAffiStorage.create( UnitArea( cform, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
   m_tmpAffiError = new Pel[MAX_CU_SIZE * MAX_CU_SIZE];
   m_tmpAffiDeri[0] = new int[MAX_CU_SIZE * MAX_CU_SIZE];
@@ -285,9 +299,25 @@ void InterSearch::init( EncCfg*        pcEncCfg,
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  if (!m_reusedUniMVs)
+  {
+    m_reusedUniMVs = new Mv[32][32][8][8][2][33];
+    m_isReusedUniMVsFilled = new bool[32][32][8][8];
+  }
+  resetReusedUniMvs();
   m_isInitialized = true;
 }
 
+void InterSearch::insertReusedUniMvCands( const CompArea& blkArea, const PreCalcValues& pcv )
+{
+  unsigned idx1, idx2, idx3, idx4;
+  getAreaIdx( blkArea, pcv, idx1, idx2, idx3, idx4 );
+  if( m_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] )
+  {
+    insertUniMvCands( blkArea, m_reusedUniMVs[idx1][idx2][idx3][idx4] );
+  }
+}
+
 void InterSearch::resetSavedAffineMotion()
 {
   for ( int i = 0; i < 2; i++ )
@@ -3196,8 +3226,8 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 
         unsigned idx1, idx2, idx3, idx4;
         getAreaIdx(cu.Y(), *cu.slice->getPPS()->pcv, idx1, idx2, idx3, idx4);
-        ::memcpy(&(g_reusedUniMVs[idx1][idx2][idx3][idx4][0][0]), cMvTemp, 2 * 33 * sizeof(Mv));
-        g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] = true;
+        ::memcpy(&(m_reusedUniMVs[idx1][idx2][idx3][idx4][0][0]), cMvTemp, 2 * 33 * sizeof(Mv));
+        m_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] = true;
       }
       //  Bi-predictive Motion estimation
       if( ( cs.slice->isInterB() ) && ( PU::isBipredRestriction( pu ) == false )
@@ -5033,6 +5063,11 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
     }
   }
 
+  if( !bBi && m_pcEncCfg->getUseMotionSearchCache() )
+  {
+    xStoreMeCache( pu, eRefPicList, iRefIdxPred, rcMv, ruiCost );
+  }
+
   DTRACE( g_trace_ctx, D_ME, "%d %d %d :MECostFPel<L%d,%d>: %d,%d,%dx%d, %d", DTRACE_GET_COUNTER( g_trace_ctx, D_ME ), pu.cu->slice->getPOC(), 0, ( int ) eRefPicList, ( int ) bBi, pu.Y().x, pu.Y().y, pu.Y().width, pu.Y().height, ruiCost );
   // sub-pel refinement for sub-pel resolution
   if ( pu.cu->imv == 0 || pu.cu->imv == IMV_HPEL )
@@ -5269,6 +5304,190 @@ void InterSearch::xPatternSearchFast( const PredictionUnit& pu,
 }
 
 
+bool InterSearch::xPyramidSearch( const PredictionUnit& pu,
+                                  RefPicList            eRefPicList,
+                                  int                   iRefIdxPred,
+                                  IntTZSearchStruct&    cStruct )
+{
+  const Picture*  refPic = pu.cu->slice->getRefPic( eRefPicList, iRefIdxPred );
+  const CompArea& area   = pu.Y();
+
+  if( !refPic->hasMePyramid() || cStruct.inCtuSearch || cStruct.zeroMV || m_pcEncCfg->getMCTSEncConstraint() || refPic->isWrapAroundEnabled( pu.cs->pps )
+    || refPic->getPicWidthInLumaSamples() != pu.cs->picture->getPicWidthInLumaSamples() || refPic->getPicHeightInLumaSamples() != pu.cs->picture->getPicHeightInLumaSamples()
+    || ( area.width >> ME_PYRAMID_LEVELS ) < 4 || ( area.height >> ME_PYRAMID_LEVELS ) < 4 )
+  {
+    return false;
+  }
+#if GDR_ENABLED
+  if( m_pcEncCfg->getGdrEnabled() )
+  {
+    return false;
+  }
+#endif
+
+  // subsample the original block like the reference picture
+  CPelBuf orgLevel[ME_PYRAMID_LEVELS + 1];
+  orgLevel[0] = *cStruct.pcPatternKey;
+  for( int level = 1; level <= ME_PYRAMID_LEVELS; level++ )
+  {
+    const PelBuf dst( m_mePyramidOrg[level - 1].Y().buf, m_mePyramidOrg[level - 1].Y().stride, area.width >> level, area.height >> level );
+    Picture::subsampleMePyramidLevel( orgLevel[level - 1], dst );
+    orgLevel[level] = dst;
+  }
+
+  const SearchRange& sr = cStruct.searchRange;
+  DistParam          distParam;
+  int                bestX = 0;
+  int                bestY = 0;
+
+  // full search within the search range on the coarsest level, +-1 refinement around the doubled best vector on the finer levels
+  for( int level = ME_PYRAMID_LEVELS; level > 0; level-- )
+  {
+    const CPelBuf ref    = refPic->getMePyramid( level );
+    const int     width  = area.width >> level;
+    const int     height = area.height >> level;
+    const int     posX   = area.x >> level;
+    const int     posY   = area.y >> level;
+
+    int left   = std::max( sr.left >> level, -posX );
+    int right  = std::min( sr.right >> level, int( ref.width ) - width - posX );
+    int top    = std::max( sr.top >> level, -posY );
+    int bottom = std::min( sr.bottom >> level, int( ref.height ) - height - posY );
+    if( level < ME_PYRAMID_LEVELS )
+    {
+      bestX <<= 1;
+      bestY <<= 1;
+      left   = std::max( left, bestX - 1 );
+      right  = std::min( right, bestX + 1 );
+      top    = std::max( top, bestY - 1 );
+      bottom = std::min( bottom, bestY + 1 );
+    }
+
+    m_pcRdCost->setDistParam( distParam, orgLevel[level], ref.buf, ref.stride, m_lumaClpRng.bd, COMPONENT_Y );
+    Distortion bestCost = std::numeric_limits<Distortion>::max();
+    for( int y = top; y <= bottom; y++ )
+    {
+      for( int x = left; x <= right; x++ )
+      {
+        distParam.cur.buf     = ref.bufAt( posX + x, posY + y );
+        const Distortion cost = ( distParam.distFunc( distParam ) << ( 2 * level ) ) + m_pcRdCost->getCostOfVectorWithPredictor( x << level, y << level, cStruct.imvShift );
+        if( cost < bestCost )
+        {
+          bestCost = cost;
+          bestX    = x;
+          bestY    = y;
+        }
+      }
+    }
+    if( bestCost == std::numeric_limits<Distortion>::max() )
+    {
+      return false;
+    }
+  }
+
+  xTZSearchHelp( cStruct, Clip3( sr.left, sr.right, bestX << 1 ), Clip3( sr.top, sr.bottom, bestY << 1 ), 0, 0 );
+  return true;
+}
+
+void InterSearch::resetMeCache()
+{
+  for( int refList = 0; refList < MAX_NUM_REF_LIST_ADAPT_SR; refList++ )
+  {
+    for( int refIdx = 0; refIdx < MAX_IDX_ADAPT_SR; refIdx++ )
+    {
+      m_meCache[refList][refIdx].clear();
+    }
+  }
+}
+
+void InterSearch::xStoreMeCache( const PredictionUnit& pu,
+                                 RefPicList            eRefPicList,
+                                 int                   iRefIdxPred,
+                                 const Mv&             rcMv,
+                                 Distortion            uiCost )
+{
+  std::vector<MeCacheEntry>& cache = m_meCache[eRefPicList][iRefIdxPred];
+  const Area&                area  = pu.Y();
+
+  for( MeCacheEntry& entry : cache )
+  {
+    if( entry.area == area )
+    {
+      if( uiCost < entry.cost )
+      {
+        entry.mv   = rcMv;
+        entry.cost = uiCost;
+      }
+      return;
+    }
+  }
+  cache.push_back( { area, rcMv, uiCost } );
+}
+
+bool InterSearch::xMeCacheSearch( const PredictionUnit& pu,
+                                  RefPicList            eRefPicList,
+                                  int                   iRefIdxPred,
+                                  IntTZSearchStruct&    cStruct )
+{
+  if( cStruct.inCtuSearch || cStruct.zeroMV || m_pcEncCfg->getMCTSEncConstraint() )
+  {
+    return false;
+  }
+#if GDR_ENABLED
+  if( m_pcEncCfg->getGdrEnabled() )
+  {
+    return false;
+  }
+#endif
+
+  const std::vector<MeCacheEntry>& cache = m_meCache[eRefPicList][iRefIdxPred];
+  const Area&                      area  = pu.Y();
+
+  // nearest overlapping blocks in terms of the distance of their corners
+  const MeCacheEntry* nearest[ME_CACHE_NUM_CANDS];
+  int                 nearestDist[ME_CACHE_NUM_CANDS];
+  int                 numNearest = 0;
+
+  for( const MeCacheEntry& entry : cache )
+  {
+    if( entry.area.x >= area.x + area.width || area.x >= entry.area.x + entry.area.width || entry.area.y >= area.y + area.height || area.y >= entry.area.y + entry.area.height )
+    {
+      continue;
+    }
+    const int dist = abs( entry.area.x - area.x ) + abs( entry.area.y - area.y )
+                   + abs( int( entry.area.x + entry.area.width ) - int( area.x + area.width ) ) + abs( int( entry.area.y + entry.area.height ) - int( area.y + area.height ) );
+
+    int pos = std::min( numNearest, ME_CACHE_NUM_CANDS - 1 );
+    if( numNearest == ME_CACHE_NUM_CANDS && dist >= nearestDist[pos] )
+    {
+      continue;
+    }
+    for( ; pos > 0 && nearestDist[pos - 1] > dist; pos-- )
+    {
+      nearest[pos]     = nearest[pos - 1];
+      nearestDist[pos] = nearestDist[pos - 1];
+    }
+    nearest[pos]     = &entry;
+    nearestDist[pos] = dist;
+    numNearest       = std::min( numNearest + 1, ME_CACHE_NUM_CANDS );
+  }
+
+  const SearchRange& sr = cStruct.searchRange;
+  for( int i = 0; i < numNearest; i++ )
+  {
+    const int mvX = Clip3( sr.left, sr.right, nearest[i]->mv.getHor() );
+    const int mvY = Clip3( sr.top, sr.bottom, nearest[i]->mv.getVer() );
+    if( mvX != cStruct.iBestX || mvY != cStruct.iBestY )
+    {
+      xTZSearchHelp( cStruct, mvX, mvY, 0, 0 );
+    }
+  }
+
+  // the search of an enclosing block (same block of another mode, parent of a split) only needs a local refinement
+  return numNearest > 0 && nearest[0]->area.contains( area );
+}
+
+
 void InterSearch::xTZSearch( const PredictionUnit& pu,
                              RefPicList            eRefPicList,
                              int                   iRefIdxPred,
@@ -5464,6 +5683,19 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
     }
   }
 
+  // a seed from the subsampled references leaves only a local search around the best candidate
+  const bool pyramidSeeded = m_pcEncCfg->getUseHierarchicalME() && xPyramidSearch( pu, eRefPicList, iRefIdxPred, cStruct );
+  if( pyramidSeeded )
+  {
+    iSearchRange = std::min( iSearchRange, 1 << ME_PYRAMID_LEVELS );
+  }
+  // so does the cached result of an enclosing block searched before in the same CTU
+  const bool cacheSeeded = m_pcEncCfg->getUseMotionSearchCache() && xMeCacheSearch( pu, eRefPicList, iRefIdxPred, cStruct );
+  if( cacheSeeded )
+  {
+    iSearchRange = std::min( iSearchRange, ME_CACHE_SEARCH_RANGE );
+  }
+
   // start search
   int  iDist = 0;
   int  iStartX = cStruct.iBestX;
@@ -5537,7 +5769,7 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
   }
 
   // raster search if distance is too big
-  if (bUseAdaptiveRaster)
+  if (bUseAdaptiveRaster && !pyramidSeeded && !cacheSeeded)
   {
     int iWindowSize     = iRaster;
     SearchRange localsr = sr;
@@ -5561,7 +5793,7 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
   }
   else
   {
-    if ( bEnableRasterSearch && ( ((int)(cStruct.uiBestDistance) >= iRaster) || bAlwaysRasterSearch ) )
+    if ( bEnableRasterSearch && !pyramidSeeded && !cacheSeeded && ( ((int)(cStruct.uiBestDistance) >= iRaster) || bAlwaysRasterSearch ) )
     {
       cStruct.uiBestDistance = iRaster;
       for ( iStartY = sr.top; iStartY <= sr.bottom; iStartY += iRaster )
@@ -89,6 +89,13 @@ struct BlkUniMvInfo
   int x, y, w, h;
 };
 
+struct MeCacheEntry
+{
+  Area       area;
+  Mv         mv;     // integer-pel result of the uni-directional motion search
+  Distortion cost;
+};
+
 typedef struct
 {
   Mv acMvAffine4Para[2][3];
@@ -114,6 +121,7 @@ private:
 
   PelStorage      m_tmpPredStorage              [NUM_REF_PIC_LIST_01];
   PelStorage      m_tmpStorageLCU;
+  PelStorage      m_mePyramidOrg                [ME_PYRAMID_LEVELS];
   PelStorage      m_tmpAffiStorage;
   Pel*            m_tmpAffiError;
   int*            m_tmpAffiDeri[2];
@@ -128,6 +136,7 @@ private:
   BcwMotionParam  m_uniMotions;
   bool            m_affineModeSelected;
   std::unordered_map< Position, std::unordered_map< Size, BlkRecord> > m_ctuRecord;
+  std::vector<MeCacheEntry> m_meCache[MAX_NUM_REF_LIST_ADAPT_SR][MAX_IDX_ADAPT_SR];
   AffineMVInfo       *m_affMVList;
 #if GDR_ENABLED  
   AffineMVInfoSolid  *m_affMVListSolid;
@@ -139,6 +148,8 @@ private:
   int             m_uniMvListIdx;
   int             m_uniMvListSize;
   int             m_uniMvListMaxSize;
+  Mv            (*m_reusedUniMVs)[32][8][8][2][33];
+  bool          (*m_isReusedUniMVsFilled)[32][8][8];
   Distortion      m_hevcCost;
 #if GDR_ENABLED  
   bool            m_hevcCostOk;
@@ -223,6 +234,7 @@ public:
 
   void setTempBuffers               (CodingStructure ****pSlitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS );
   void resetCtuRecord               ()             { m_ctuRecord.clear(); }
+  void resetMeCache                 ();
   void setAffineModeSelected        ( bool flag) { m_affineModeSelected = flag; }
   void resetAffineMVList() { m_affMVListIdx = 0; m_affMVListSize = 0; }
 #if GDR_ENABLED
@@ -287,6 +299,8 @@ public:
     }
   }
   void resetUniMvList() { m_uniMvListIdx = 0; m_uniMvListSize = 0; }
+  void resetReusedUniMvs() { ::memset( m_isReusedUniMVsFilled, 0, sizeof( m_isReusedUniMVsFilled[0] ) * 32 ); }
+  void insertReusedUniMvCands( const CompArea& blkArea, const PreCalcValues& pcv );
   void insertUniMvCands(CompArea blkArea, Mv cMvTemp[2][33])
   {
     BlkUniMvInfo* curMvInfo = m_uniMvList + m_uniMvListIdx;
@@ -576,6 +590,25 @@ protected:
                                     Distortion&           ruiSAD
                                   );
 
+  bool xPyramidSearch             ( const PredictionUnit& pu,
+                                    RefPicList            eRefPicList,
+                                    int                   iRefIdxPred,
+                                    IntTZSearchStruct&    cStruct
+                                  );
+
+  void xStoreMeCache              ( const PredictionUnit& pu,
+                                    RefPicList            eRefPicList,
+                                    int                   iRefIdxPred,
+                                    const Mv&             rcMv,
+                                    Distortion            uiCost
+                                  );
+
+  bool xMeCacheSearch             ( const PredictionUnit& pu,
+                                    RefPicList            eRefPicList,
+                                    int                   iRefIdxPred,
+                                    IntTZSearchStruct&    cStruct
+                                  );
+
   void xPatternSearchIntRefine    ( PredictionUnit&     pu,
                                     IntTZSearchStruct&  cStruct,
                                     Mv&                 rcMv,
@@ -986,7 +986,7 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               double mipHadCost[MAX_NUM_MIP_MODE] = { MAX_DOUBLE };
 
               initIntraPatternChType(cu, pu.Y());
-              initIntraMip(pu, pu.Y());
+              initIntraMip(pu, pu.Y(), true);
 
               const int transpOff    = getNumModesMip(pu.Y());
               const int numModesFull = (transpOff << 1);
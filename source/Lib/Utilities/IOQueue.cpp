@@ -0,0 +1,320 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IOQueue.cpp
+    \brief    bounded read-ahead and write-behind queues of file data
+*/
+
+#include "IOQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+//! \ingroup Utilities
+//! \{
+
+// ====================================================================================================================
+// ReadAheadQueue
+// ====================================================================================================================
+
+ReadAheadQueue::ReadAheadQueue()
+  : m_numFilled( 0 )
+  , m_fillIdx  ( 0 )
+  , m_readIdx  ( 0 )
+  , m_readPos  ( 0 )
+  , m_hasBlock ( false )
+  , m_sourceEnd( false )
+  , m_end      ( false )
+  , m_stop     ( false )
+{
+}
+
+ReadAheadQueue::~ReadAheadQueue()
+{
+  stop();
+}
+
+void ReadAheadQueue::start( Source source, int depth, size_t blockSize )
+{
+  stop();
+
+  m_source = source;
+  m_blocks.resize( std::max( depth, 1 ) );
+  for( auto &block : m_blocks )
+  {
+    block.data.resize( std::max<size_t>( blockSize, 1 ) );
+    block.size = 0;
+  }
+  m_numFilled = 0;
+  m_fillIdx   = 0;
+  m_readIdx   = 0;
+  m_readPos   = 0;
+  m_hasBlock  = false;
+  m_sourceEnd = false;
+  m_end       = false;
+  m_stop      = false;
+  m_thread    = std::thread( &ReadAheadQueue::xReadLoop, this );
+}
+
+void ReadAheadQueue::stop()
+{
+  if( !m_thread.joinable() )
+  {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_released.notify_all();
+  m_thread.join();
+  m_blocks.clear();
+}
+
+const uint8_t* ReadAheadQueue::read( uint8_t* buf, size_t size )
+{
+  while( !m_end && ( !m_hasBlock || m_readPos == m_blocks[m_readIdx].size ) )
+  {
+    m_end = !xNextBlock();
+  }
+  if( m_end )
+  {
+    return nullptr;
+  }
+
+  const Block &block = m_blocks[m_readIdx];
+  if( block.size - m_readPos >= size )
+  {
+    const uint8_t *data = block.data.data() + m_readPos;
+    m_readPos += size;
+    return data;
+  }
+
+  // the data spans several blocks, gather it in buf
+  size_t done = 0;
+  while( done < size )
+  {
+    if( m_readPos == m_blocks[m_readIdx].size )
+    {
+      if( !xNextBlock() )
+      {
+        m_end = true;
+        return nullptr;
+      }
+      continue;
+    }
+    const Block &cur = m_blocks[m_readIdx];
+    const size_t num = std::min( size - done, cur.size - m_readPos );
+    memcpy( buf + done, cur.data.data() + m_readPos, num );
+    m_readPos += num;
+    done      += num;
+  }
+  return buf;
+}
+
+bool ReadAheadQueue::skip( uint64_t size )
+{
+  while( size > 0 && !m_end )
+  {
+    if( !m_hasBlock || m_readPos == m_blocks[m_readIdx].size )
+    {
+      m_end = !xNextBlock();
+      continue;
+    }
+    const size_t num = size_t( std::min<uint64_t>( size, m_blocks[m_readIdx].size - m_readPos ) );
+    m_readPos += num;
+    size      -= num;
+  }
+  return !m_end;
+}
+
+bool ReadAheadQueue::xNextBlock()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  if( m_hasBlock )
+  {
+    m_hasBlock = false;
+    m_readIdx  = ( m_readIdx + 1 ) % int( m_blocks.size() );
+    m_numFilled--;
+    m_released.notify_one();
+  }
+
+  m_filled.wait( lock, [this] { return m_numFilled > 0 || m_sourceEnd; } );
+  if( m_numFilled == 0 )
+  {
+    return false;
+  }
+
+  m_hasBlock = true;
+  m_readPos  = 0;
+  return true;
+}
+
+void ReadAheadQueue::xReadLoop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( !m_sourceEnd )
+  {
+    m_released.wait( lock, [this] { return m_stop || m_numFilled < int( m_blocks.size() ); } );
+    if( m_stop )
+    {
+      return;
+    }
+
+    // the block is not visible to the consumer until it is counted as filled
+    Block &block = m_blocks[m_fillIdx];
+    lock.unlock();
+    block.size = m_source( block.data.data(), block.data.size() );
+    lock.lock();
+
+    m_sourceEnd = block.size < block.data.size();
+    m_fillIdx   = ( m_fillIdx + 1 ) % int( m_blocks.size() );
+    m_numFilled++;
+    m_filled.notify_one();
+  }
+}
+
+// ====================================================================================================================
+// WriteBehindQueue
+// ====================================================================================================================
+
+WriteBehindQueue::WriteBehindQueue()
+  : m_depth( 1 )
+  , m_fail ( false )
+  , m_stop ( false )
+{
+}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+  stop();
+}
+
+void WriteBehindQueue::start( Sink sink, int depth )
+{
+  stop();
+
+  m_sink  = sink;
+  m_depth = std::max( depth, 1 );
+  m_fail  = false;
+  m_stop  = false;
+  m_block.clear();
+  m_thread = std::thread( &WriteBehindQueue::xWriteLoop, this );
+}
+
+void WriteBehindQueue::stop()
+{
+  if( !m_thread.joinable() )
+  {
+    return;
+  }
+  commit();
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_committed.notify_all();
+  m_thread.join();
+  m_free.clear();
+}
+
+void WriteBehindQueue::write( const uint8_t* src, size_t size )
+{
+  m_block.insert( m_block.end(), src, src + size );
+}
+
+void WriteBehindQueue::commit()
+{
+  if( m_block.empty() )
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_written.wait( lock, [this] { return int( m_pending.size() ) < m_depth; } );
+    m_pending.push_back( std::move( m_block ) );
+    m_block.clear();
+    if( !m_free.empty() )
+    {
+      std::swap( m_block, m_free.back() );
+      m_free.pop_back();
+      m_block.clear();
+    }
+  }
+  m_committed.notify_one();
+}
+
+void WriteBehindQueue::flush()
+{
+  commit();
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_written.wait( lock, [this] { return m_pending.empty(); } );
+}
+
+bool WriteBehindQueue::isFail()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  return m_fail;
+}
+
+void WriteBehindQueue::xWriteLoop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true )
+  {
+    m_committed.wait( lock, [this] { return m_stop || !m_pending.empty(); } );
+
+    if( m_pending.empty() )
+    {
+      return;
+    }
+
+    // references to deque elements stay valid while the producer appends blocks
+    const std::vector<uint8_t> &block = m_pending.front();
+    lock.unlock();
+    const bool ok = m_sink( block.data(), block.size() );
+    lock.lock();
+
+    m_fail = m_fail || !ok;
+    m_free.push_back( std::move( m_pending.front() ) );
+    m_pending.pop_front();
+    m_written.notify_all();
+  }
+}
+
+//! \}
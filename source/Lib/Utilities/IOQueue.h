@@ -0,0 +1,145 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IOQueue.h
+    \brief    bounded read-ahead and write-behind queues of file data (header)
+*/
+
+#ifndef __IOQUEUE__
+#define __IOQUEUE__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup Utilities
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// reads blocks of a sequential input on a separate thread, at most depth blocks are buffered ahead of the consumer
+class ReadAheadQueue
+{
+public:
+  /// read up to size bytes into dst, returns the number of bytes read, less than size only at the end of the input
+  typedef std::function<size_t( uint8_t* dst, size_t size )> Source;
+
+  ReadAheadQueue();
+  ~ReadAheadQueue();
+
+  void start    ( Source source, int depth, size_t blockSize );
+  void stop     ();
+  bool isActive () const { return m_thread.joinable(); }
+
+  /// next size bytes of the input, copied into buf if they span two blocks, nullptr at the end of the input
+  const uint8_t* read( uint8_t* buf, size_t size );
+  /// skip size bytes of the input, returns false at the end of the input
+  bool  skip    ( uint64_t size );
+  /// a read or skip went beyond the end of the input
+  bool  isEnd   () const { return m_end; }
+
+private:
+  struct Block
+  {
+    std::vector<uint8_t> data;
+    size_t               size;
+  };
+
+  void  xReadLoop   ();
+  bool  xNextBlock  ();                          ///< release the current block and wait for the next one
+
+  Source                    m_source;
+  std::vector<Block>        m_blocks;            ///< ring of blocks
+  int                       m_numFilled;         ///< blocks read by the I/O thread and not yet released by the consumer
+  int                       m_fillIdx;           ///< next block filled by the I/O thread
+  int                       m_readIdx;           ///< block read by the consumer
+  size_t                    m_readPos;           ///< read position in the consumer block
+  bool                      m_hasBlock;          ///< the consumer holds block m_readIdx
+  bool                      m_sourceEnd;         ///< the I/O thread reached the end of the input
+  bool                      m_end;               ///< the consumer reached the end of the input
+  bool                      m_stop;
+  std::mutex                m_mutex;
+  std::condition_variable   m_filled;
+  std::condition_variable   m_released;
+  std::thread               m_thread;
+};
+
+/// writes blocks to a sequential output on a separate thread, the producer blocks while depth blocks are pending
+class WriteBehindQueue
+{
+public:
+  /// write size bytes from src, returns false on a write error
+  typedef std::function<bool( const uint8_t* src, size_t size )> Sink;
+
+  WriteBehindQueue();
+  ~WriteBehindQueue();
+
+  void start    ( Sink sink, int depth );
+  /// write all pending blocks and terminate the I/O thread
+  void stop     ();
+  bool isActive () const { return m_thread.joinable(); }
+
+  /// append data to the block that is built by the producer
+  void write    ( const uint8_t* src, size_t size );
+  /// pass the current block to the I/O thread
+  void commit   ();
+  /// block until all committed blocks are written
+  void flush    ();
+  /// a write of the I/O thread failed
+  bool isFail   ();
+
+private:
+  void xWriteLoop();
+
+  Sink                              m_sink;
+  std::vector<uint8_t>              m_block;     ///< block built by the producer
+  std::deque<std::vector<uint8_t>>  m_pending;   ///< committed blocks in output order, the front one is written by the I/O thread
+  std::vector<std::vector<uint8_t>> m_free;      ///< written blocks kept to reuse their memory
+  int                               m_depth;
+  bool                              m_fail;
+  bool                              m_stop;
+  std::mutex                        m_mutex;
+  std::condition_variable           m_committed;
+  std::condition_variable           m_written;
+  std::thread                       m_thread;
+};
+
+//! \}
+
+#endif // __IOQUEUE__
@@ -41,6 +41,13 @@
 #include <fstream>
 #include <iostream>
 #include <memory.h>
+#if defined( __linux__ ) || defined( __APPLE__ )
+#define VIDEOIO_MMAP_INPUT 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define VIDEOIO_MMAP_INPUT 0
+#endif
 
 #include "CommonLib/Rom.h"
 #include "VideoIOYuv.h"
@@ -155,7 +162,7 @@ void VideoIOYuv::open( const std::string &fileName, bool bWriteMode, const int f
       EXIT( "Failed to write reconstructed YUV file: " << fileName.c_str() );
     }
   }
-  else
+  else if( !xMapFile( fileName ) )
   {
     m_cHandle.open( fileName.c_str(), ios::binary | ios::in );
 
@@ -170,17 +177,157 @@ void VideoIOYuv::open( const std::string &fileName, bool bWriteMode, const int f
 
 void VideoIOYuv::close()
 {
+  // the I/O threads finish before the file is released, pending output frames are written
+  m_readQueue.stop();
+  m_writeQueue.stop();
+  xUnmapFile();
   m_cHandle.close();
 }
 
 bool VideoIOYuv::isEof()
 {
-  return m_cHandle.eof();
+  if( m_readQueue.isActive() )
+  {
+    return m_readQueue.isEnd();
+  }
+  return m_mapBase ? m_mapEof : m_cHandle.eof();
 }
 
 bool VideoIOYuv::isFail()
 {
-  return m_cHandle.fail();
+  if( m_readQueue.isActive() )
+  {
+    return m_readQueue.isEnd();
+  }
+  return m_mapBase ? m_mapEof : m_cHandle.fail();
+}
+
+/**
+ * Map a regular input file into memory, so that frames are converted
+ * directly from the page cache and seeking does not touch the file.
+ *
+ * \param fileName  file name string
+ * \return true if the file is mapped, false if it has to be read as a stream
+ */
+bool VideoIOYuv::xMapFile( const std::string &fileName )
+{
+#if VIDEOIO_MMAP_INPUT
+  const int fd = ::open( fileName.c_str(), O_RDONLY );
+  if( fd < 0 )
+  {
+    return false;
+  }
+
+  struct stat fileStat;
+  void*       base = MAP_FAILED;
+  if( fstat( fd, &fileStat ) == 0 && S_ISREG( fileStat.st_mode ) && fileStat.st_size > 0 && uint64_t( fileStat.st_size ) <= uint64_t( SIZE_MAX ) )
+  {
+    base = mmap( nullptr, size_t( fileStat.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+  }
+  ::close( fd );
+  if( base == MAP_FAILED )
+  {
+    return false;
+  }
+  madvise( base, size_t( fileStat.st_size ), MADV_SEQUENTIAL );
+
+  m_mapBase = static_cast<const uint8_t*>( base );
+  m_mapSize = uint64_t( fileStat.st_size );
+  m_mapPos  = 0;
+  m_mapEof  = false;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void VideoIOYuv::xUnmapFile()
+{
+#if VIDEOIO_MMAP_INPUT
+  if( m_mapBase )
+  {
+    munmap( const_cast<uint8_t*>( m_mapBase ), size_t( m_mapSize ) );
+  }
+#endif
+  m_mapBase = nullptr;
+  m_mapSize = 0;
+  m_mapPos  = 0;
+  m_mapEof  = false;
+}
+
+size_t VideoIOYuv::xReadSource( uint8_t* dst, size_t size )
+{
+  if( m_mapBase )
+  {
+    const size_t num = size_t( std::min<uint64_t>( size, m_mapSize - m_mapPos ) );
+    memcpy( dst, m_mapBase + m_mapPos, num );
+    m_mapPos += num;
+    return num;
+  }
+
+  m_cHandle.read( reinterpret_cast<char*>( dst ), size );
+  return size_t( m_cHandle.gcount() );
+}
+
+const uint8_t* VideoIOYuv::readBytes( uint8_t* buf, uint32_t size )
+{
+  if( m_readQueue.isActive() )
+  {
+    return m_readQueue.read( buf, size );
+  }
+
+  if( m_mapBase )
+  {
+    if( m_mapEof || size > m_mapSize - m_mapPos )
+    {
+      m_mapPos = m_mapSize;
+      m_mapEof = true;
+      return nullptr;
+    }
+    const uint8_t* data = m_mapBase + m_mapPos;
+    m_mapPos += size;
+    return data;
+  }
+
+  m_cHandle.read( reinterpret_cast<char*>( buf ), size );
+  return m_cHandle.eof() || m_cHandle.fail() ? nullptr : buf;
+}
+
+bool VideoIOYuv::skipBytes( uint64_t size )
+{
+  if( m_readQueue.isActive() )
+  {
+    return m_readQueue.skip( size );
+  }
+
+  if( m_mapBase )
+  {
+    m_mapPos = std::min( m_mapPos + size, m_mapSize );
+    return !m_mapEof;
+  }
+
+  m_cHandle.seekg( size, ios::cur );
+  return !( m_cHandle.eof() || m_cHandle.fail() );
+}
+
+bool VideoIOYuv::writeBytes( const uint8_t* buf, uint32_t size )
+{
+  if( m_queueDepth > 0 )
+  {
+    if( !m_writeQueue.isActive() )
+    {
+      m_writeQueue.start( [this]( const uint8_t* src, size_t num ) {
+        m_cHandle.write( reinterpret_cast<const char*>( src ), num );
+        return !( m_cHandle.eof() || m_cHandle.fail() );
+      }, m_queueDepth );
+    }
+    // write errors of the I/O thread are reported when the frame is committed
+    m_writeQueue.write( buf, size );
+    return true;
+  }
+
+  m_cHandle.write( reinterpret_cast<const char*>( buf ), size );
+  return !( m_cHandle.eof() || m_cHandle.fail() );
 }
 
 /**
@@ -218,6 +365,12 @@ void VideoIOYuv::skipFrames(uint32_t numFrames, uint32_t width, uint32_t height,
 
   const streamoff offset = frameSize * numFrames;
 
+  if (m_mapBase || m_readQueue.isActive())
+  {
+    skipBytes(offset);
+    return;
+  }
+
   /* attempt to seek */
   if (!!m_cHandle.seekg(offset, ios::cur))
   {
@@ -241,7 +394,7 @@ void VideoIOYuv::skipFrames(uint32_t numFrames, uint32_t width, uint32_t height,
  * either 8bit or 16bit little-endian lsb-aligned words.
  *
  * @param dst          destination image plane
- * @param fd           input file stream
+ * @param file         input file
  * @param is16bit      true if input file carries > 8bit data, false otherwise.
  * @param stride444    distance between vertically adjacent pixels of dst.
  * @param width444     width of active area in dst.
@@ -255,7 +408,7 @@ void VideoIOYuv::skipFrames(uint32_t numFrames, uint32_t width, uint32_t height,
  * @return true for success, false in case of error
  */
 static bool readPlane(Pel* dst,
-                      istream& fd,
+                      VideoIOYuv& file,
                       bool is16bit,
                       uint32_t stride444,
                       uint32_t width444,
@@ -286,7 +439,7 @@ static bool readPlane(Pel* dst,
 
   const uint32_t stride_file      = (width444 * (is16bit ? 2 : 1)) >> csx_file;
   std::vector<uint8_t> bufVec(stride_file);
-  uint8_t *buf=&(bufVec[0]);
+  const uint8_t *buf = nullptr;
 
   Pel  *pDstPad              = dst + stride_dest * height_dest;
   Pel  *pDstBuf              = dst;
@@ -310,8 +463,7 @@ static bool readPlane(Pel* dst,
     if (fileFormat!=CHROMA_400)
     {
       const uint32_t height_file      = height444>>csy_file;
-      fd.seekg(height_file*stride_file, ios::cur);
-      if (fd.eof() || fd.fail() )
+      if (!file.skipBytes(uint64_t(height_file)*stride_file))
       {
         return false;
       }
@@ -325,9 +477,9 @@ static bool readPlane(Pel* dst,
     {
       if ((y444&mask_y_file)==0)
       {
-        // read a new line
-        fd.read(reinterpret_cast<char*>(buf), stride_file);
-        if (fd.eof() || fd.fail() )
+        // read a new line, data that is contiguous in memory is converted in place
+        buf = file.readBytes(bufVec.data(), stride_file);
+        if (buf == nullptr)
         {
           return false;
         }
@@ -336,7 +488,25 @@ static bool readPlane(Pel* dst,
       if ((y444&mask_y_dest)==0)
       {
         // process current destination line
-        if (csx_file < csx_dest)
+        if (csx_file == csx_dest)
+        {
+          // same format in file and destination: plain widening of the samples
+          if (!is16bit)
+          {
+            for (uint32_t x = 0; x < width_dest; x++)
+            {
+              pDstBuf[x] = buf[x];
+            }
+          }
+          else
+          {
+            for (uint32_t x = 0; x < width_dest; x++)
+            {
+              pDstBuf[x] = Pel(buf[x*2+0]) | (Pel(buf[x*2+1])<<8);
+            }
+          }
+        }
+        else if (csx_file < csx_dest)
         {
           // eg file is 444, dest is 422.
           const uint32_t sx=csx_dest-csx_file;
@@ -439,9 +609,9 @@ static bool verifyPlane(Pel* dst,
 
 
 /**
- * Write an image plane (width444*height444 pixels) from src into output stream fd.
+ * Write an image plane (width444*height444 pixels) from src into output file.
  *
- * @param fd         output file stream
+ * @param file       output file
  * @param src        source image
  * @param is16bit    true if input file carries > 8bit data, false otherwise.
  * @param stride444  distance between vertically adjacent pixels of src.
@@ -453,7 +623,7 @@ static bool verifyPlane(Pel* dst,
  * @param fileBitDepth component bit depth in file
  * @return true for success, false in case of error
  */
-static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, const Pel* src,
+static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, VideoIOYuv& file, const Pel* src,
                        const bool is16bit,
                        const uint32_t stride_src,
                        uint32_t width444, uint32_t height444,
@@ -560,8 +730,7 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
           }
         }
 
-        fd.write (reinterpret_cast<const char*>(buf), stride_file);
-        if (fd.eof() || fd.fail())
+        if (!file.writeBytes(buf, stride_file))
         {
           return false;
         }
@@ -582,8 +751,7 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
         {
           memset (reinterpret_cast<char*>(buf), 0, stride_file);
 
-          fd.write (reinterpret_cast<const char*>(buf), stride_file);
-          if (fd.eof() || fd.fail())
+          if (!file.writeBytes(buf, stride_file))
           {
             return false;
           }
@@ -623,8 +791,7 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
           }
         }
 
-        fd.write(reinterpret_cast<const char*>(buf), stride_file);
-        if (fd.eof() || fd.fail() )
+        if (!file.writeBytes(buf, stride_file))
         {
           return false;
         }
@@ -682,8 +849,7 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
           }
         }
 
-        fd.write (reinterpret_cast<const char*>(buf), stride_file);
-        if (fd.eof() || fd.fail())
+        if (!file.writeBytes(buf, stride_file))
         {
           return false;
         }
@@ -715,8 +881,7 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
             buf[2 * x + 1] = 0;
           }
         }
-        fd.write( reinterpret_cast<const char*>( buf ), stride_file );
-        if( fd.eof() || fd.fail() )
+        if (!file.writeBytes(buf, stride_file))
         {
           return false;
         }
@@ -732,7 +897,7 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
   return true;
 }
 
-static bool writeField(ostream& fd, const Pel* top, const Pel* bottom,
+static bool writeField(VideoIOYuv& file, const Pel* top, const Pel* bottom,
                        const bool is16bit,
                        const uint32_t stride_src,
                        uint32_t width444, uint32_t height444,
@@ -791,8 +956,7 @@ static bool writeField(ostream& fd, const Pel* top, const Pel* bottom,
           }
         }
 
-        fd.write(reinterpret_cast<const char*>(buf), (stride_file * 2));
-        if (fd.eof() || fd.fail() )
+        if (!file.writeBytes(buf, (stride_file * 2)))
         {
           return false;
         }
@@ -855,8 +1019,7 @@ static bool writeField(ostream& fd, const Pel* top, const Pel* bottom,
           }
         }
 
-        fd.write(reinterpret_cast<const char*>(buf), (stride_file * 2));
-        if (fd.eof() || fd.fail() )
+        if (!file.writeBytes(buf, (stride_file * 2)))
         {
           return false;
         }
@@ -926,6 +1089,18 @@ bool VideoIOYuv::read ( PelUnitBuf& pic, PelUnitBuf& picOrg, const InputColourSp
   const uint32_t width444       = width_full444 - pad_h444;
   const uint32_t height444      = height_full444 - pad_v444;
 
+  if( m_queueDepth > 0 && !m_readQueue.isActive() )
+  {
+    // one block of the read-ahead queue holds one frame of the file
+    size_t frameSize = 0;
+    for( uint32_t comp = 0; comp < ::getNumberValidComponents( format ); comp++ )
+    {
+      const ComponentID compID = ComponentID( comp );
+      frameSize += size_t( ( width444 * ( is16bit ? 2 : 1 ) ) >> getComponentScaleX( compID, format ) ) * ( height444 >> getComponentScaleY( compID, format ) );
+    }
+    m_readQueue.start( [this]( uint8_t* dst, size_t size ) { return xReadSource( dst, size ); }, m_queueDepth, frameSize );
+  }
+
   for( uint32_t comp=0; comp < ::getNumberValidComponents(format); comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -941,7 +1116,7 @@ bool VideoIOYuv::read ( PelUnitBuf& pic, PelUnitBuf& picOrg, const InputColourSp
 #if EXTENSION_360_VIDEO
     const uint32_t stride444 = picOrg.get(compID).stride;
 #endif
-    if ( ! readPlane( dst, m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, picOrg.chromaFormat, format, m_fileBitdepth[chType]))
+    if ( ! readPlane( dst, *this, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, picOrg.chromaFormat, format, m_fileBitdepth[chType]))
     {
       return false;
     }
@@ -1068,7 +1243,7 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
     const uint32_t    csy         = ::getComponentScaleY(compID, format);
     const CPelBuf     area        = picO.get(compID);
     const int         planeOffset = (confLeft >> csx) + (confTop >> csy) * area.stride;
-    if( !writePlane( orgWidth, orgHeight, m_cHandle, area.bufAt( 0, 0 ) + planeOffset, is16bit, area.stride,
+    if( !writePlane( orgWidth, orgHeight, *this, area.bufAt( 0, 0 ) + planeOffset, is16bit, area.stride,
                      width444, height444, compID, picO.chromaFormat, format, m_fileBitdepth[ch],
                      bPackedYUVOutputMode ? 1 : 0))
     {
@@ -1076,6 +1251,12 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
     }
   }
 
+  if( m_writeQueue.isActive() )
+  {
+    m_writeQueue.commit();
+    retval = retval && !m_writeQueue.isFail();
+  }
+
   return retval;
 }
 
@@ -1174,7 +1355,7 @@ bool VideoIOYuv::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBottom,
     const uint32_t csy = ::getComponentScaleY(compID, dstChrFormat );
     const int planeOffset  = (confLeft>>csx) + ( confTop>>csy) * areaTop.stride; //offset is for entire frame - round up for top field and down for bottom field
 
-    if (!writeField (m_cHandle,
+    if (!writeField (*this,
                      (areaTop.   bufAt(0,0) + planeOffset),
                      (areaBottom.bufAt(0,0) + planeOffset),
                      is16bit,
@@ -1186,6 +1367,12 @@ bool VideoIOYuv::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBottom,
     }
   }
 
+  if( m_writeQueue.isActive() )
+  {
+    m_writeQueue.commit();
+    retval = retval && !m_writeQueue.isFail();
+  }
+
   return retval;
 }
 
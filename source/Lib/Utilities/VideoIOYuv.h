@@ -43,6 +43,7 @@
 #include <iostream>
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Unit.h"
+#include "IOQueue.h"
 
 using namespace std;
 
@@ -61,10 +62,21 @@ private:
   int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
+  const uint8_t* m_mapBase;                               ///< memory mapping of an input file, the file stream is only used for inputs that cannot be mapped
+  uint64_t  m_mapSize;                                    ///< size of the mapped input file
+  uint64_t  m_mapPos;                                     ///< read position in the mapped input file
+  bool      m_mapEof;                                     ///< a read went beyond the end of the mapped input file
+  int       m_queueDepth;                                 ///< number of frames read ahead or written behind by an I/O thread (0: synchronous I/O)
+  ReadAheadQueue   m_readQueue;                           ///< frames read ahead from the input file or mapping
+  WriteBehindQueue m_writeQueue;                          ///< frames pending to be written to the output file
+
+  bool  xMapFile   ( const std::string &fileName );      ///< map an input file into memory
+  void  xUnmapFile ();
+  size_t xReadSource( uint8_t* dst, size_t size );       ///< read from the mapping or file stream on the read-ahead thread
 
 public:
-  VideoIOYuv()           {}
-  virtual ~VideoIOYuv()  {}
+  VideoIOYuv() : m_mapBase( nullptr ), m_mapSize( 0 ), m_mapPos( 0 ), m_mapEof( false ), m_queueDepth( 0 ) {}
+  virtual ~VideoIOYuv()  { close(); }
 
   void  open  ( const std::string &fileName, bool bWriteMode, const int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const int internalBitDepth[MAX_NUM_CHANNEL_TYPE] ); ///< open or create file
   void  close ();                                           ///< close file
@@ -95,7 +107,11 @@ public:
 
   bool  isEof ();                                           ///< check for end-of-file
   bool  isFail();                                           ///< check for failure
-  bool  isOpen() { return m_cHandle.is_open(); }
+  bool  isOpen() { return m_mapBase != nullptr || m_cHandle.is_open(); }
+  void  setQueueDepth( int depth ) { m_queueDepth = depth; } ///< move the file I/O to a separate thread, buffering up to depth frames
+  const uint8_t* readBytes( uint8_t* buf, uint32_t size ); ///< next size bytes of the input, read into buf unless they are contiguous in memory, nullptr at end-of-file
+  bool  skipBytes( uint64_t size );                         ///< skip size bytes of the input
+  bool  writeBytes( const uint8_t* buf, uint32_t size );    ///< append size bytes to the output
   void  setBitdepthShift( int ch, int bd )  { m_bitdepthShift[ch] = bd;   }
   int   getBitdepthShift( int ch )          { return m_bitdepthShift[ch]; }
   int   getFileBitdepth( int ch )           { return m_fileBitdepth[ch];  }